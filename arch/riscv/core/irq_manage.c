@@ -68,3 +68,46 @@ int arch_irq_disconnect_dynamic(unsigned int irq, unsigned int priority,
 }
 #endif /* CONFIG_SHARED_INTERRUPTS */
 #endif /* CONFIG_DYNAMIC_INTERRUPTS */
+
+struct interrupted_trace {
+	uintptr_t *buf;
+	size_t size;
+	size_t len;
+};
+
+#if defined(CONFIG_FRAME_POINTER) && defined(CONFIG_EXCEPTION_STACK_TRACE)
+static bool interrupted_trace_store(void *cookie, unsigned long addr)
+{
+	struct interrupted_trace *trace = cookie;
+
+	trace->buf[trace->len++] = addr;
+
+	return trace->len < trace->size;
+}
+#endif
+
+size_t arch_interrupted_stack_trace(uintptr_t *buf, size_t size)
+{
+	struct interrupted_trace trace = { .buf = buf, .size = size };
+	const struct arch_esf *esf;
+
+	/* Only the outermost interrupt saves the pointer to the frame of the
+	 * interrupted thread at the top of the interrupt stack, see isr.S.
+	 */
+	if ((size == 0) || (_current_cpu->nested != 1)) {
+		return 0;
+	}
+
+	esf = *(const struct arch_esf **)((uintptr_t)_current_cpu->irq_stack - 16);
+
+#if defined(CONFIG_FRAME_POINTER) && defined(CONFIG_EXCEPTION_STACK_TRACE)
+	arch_stack_walk(interrupted_trace_store, &trace, _current, esf);
+#endif
+
+	if (trace.len == 0) {
+		/* Without frame pointers only the interrupted address is reliable. */
+		buf[trace.len++] = esf->mepc;
+	}
+
+	return trace.len;
+}
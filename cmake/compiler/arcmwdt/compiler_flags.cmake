@@ -162,6 +162,9 @@ set_compiler_property(PROPERTY no_common -fno-common)
 # at present, zephyr only support gnu coverage
 set_compiler_property(PROPERTY coverage "")
 
+# mwdt does not support -finstrument-functions
+set_compiler_property(PROPERTY instrument_functions "")
+
 # mwdt compiler flags for imacros. The specific header must be appended by user.
 set_compiler_property(PROPERTY imacros -imacros)
 
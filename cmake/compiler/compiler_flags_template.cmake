@@ -90,6 +90,9 @@ set_compiler_property(PROPERTY no_printf_return_value)
 # Flags for coverage generation
 set_compiler_property(PROPERTY coverage)
 
+# Flags for function entry and exit instrumentation
+set_compiler_property(PROPERTY instrument_functions)
+
 # Security canaries flags.
 set_compiler_property(PROPERTY security_canaries)
 
@@ -165,6 +165,9 @@ set_property(TARGET compiler-cpp PROPERTY no_rtti "-fno-rtti")
 # gcc flags for coverage generation
 set_compiler_property(PROPERTY coverage -fprofile-arcs -ftest-coverage -fno-inline)
 
+# gcc flags for function entry and exit instrumentation
+set_compiler_property(PROPERTY instrument_functions -finstrument-functions)
+
 # Security canaries.
 set_compiler_property(PROPERTY security_canaries -fstack-protector-all)
 
@@ -22,6 +22,9 @@ if(CONFIG_PM_DEVICE)
 endif()
 
 zephyr_iterable_section(NAME log_dynamic GROUP DATA_REGION ${XIP_ALIGN_WITH_INPUT} SUBALIGN CONFIG_LINKER_ITERABLE_SUBALIGN)
+if(CONFIG_LOG_CALL_SITE_FILTERING)
+  zephyr_iterable_section(NAME log_call_site GROUP DATA_REGION ${XIP_ALIGN_WITH_INPUT} SUBALIGN CONFIG_LINKER_ITERABLE_SUBALIGN)
+endif()
 
 if(CONFIG_USERSPACE)
   # All kernel objects within are assumed to be either completely
@@ -1800,6 +1800,88 @@ function(zephyr_blobs_verify)
   endif()
 endfunction()
 
+# Usage:
+#   zephyr_instrument_functions(<path>...)
+#
+# Compile source files with function entry and exit instrumentation for the
+# function tracer, see CONFIG_TRACING_FUNCTIONS. Each <path> is either a source
+# file or a directory, in which case all the source files below it are
+# instrumented. Relative paths are relative to the current source directory.
+#
+# The instrumentation is applied at the end of the configuration to the
+# sources of the zephyr, app and Zephyr library targets, so the function can
+# be called before or after the sources are added to their target.
+# Nothing is done when CONFIG_TRACING_FUNCTIONS is not enabled.
+#
+# Example:
+#   zephyr_instrument_functions(${ZEPHYR_BASE}/subsys/net/ip src/protocol.c)
+function(zephyr_instrument_functions)
+  if(NOT CONFIG_TRACING_FUNCTIONS)
+    return()
+  endif()
+
+  foreach(path ${ARGN})
+    cmake_path(ABSOLUTE_PATH path BASE_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR} NORMALIZE)
+    set_property(GLOBAL APPEND PROPERTY ZEPHYR_INSTRUMENT_FUNCTIONS_PATHS ${path})
+  endforeach()
+endfunction()
+
+# Internal function which applies the paths given to
+# zephyr_instrument_functions(), deferred to the end of the configuration.
+function(zephyr_instrument_functions_apply)
+  get_property(paths GLOBAL PROPERTY ZEPHYR_INSTRUMENT_FUNCTIONS_PATHS)
+  get_property(libs GLOBAL PROPERTY ZEPHYR_LIBS)
+  get_property(flags TARGET compiler PROPERTY instrument_functions)
+
+  if(NOT paths)
+    return()
+  elseif(NOT flags)
+    message(WARNING "Function instrumentation is not supported by the compiler, "
+                    "CONFIG_TRACING_FUNCTIONS has no effect.")
+    return()
+  endif()
+
+  # The tracing subsystem itself is not instrumented.
+  cmake_path(APPEND ZEPHYR_BASE subsys tracing OUTPUT_VARIABLE tracing_dir)
+
+  foreach(target zephyr app ${libs})
+    if(NOT TARGET ${target})
+      continue()
+    endif()
+
+    get_property(type TARGET ${target} PROPERTY TYPE)
+    get_property(imported TARGET ${target} PROPERTY IMPORTED)
+    if(imported OR type STREQUAL "INTERFACE_LIBRARY")
+      continue()
+    endif()
+
+    get_property(sources TARGET ${target} PROPERTY SOURCES)
+    get_property(source_dir TARGET ${target} PROPERTY SOURCE_DIR)
+
+    foreach(source ${sources})
+      if(source MATCHES "\\$<" OR NOT source MATCHES "\\.(c|cc|cpp|cxx)$")
+        continue()
+      endif()
+
+      cmake_path(ABSOLUTE_PATH source BASE_DIRECTORY ${source_dir} NORMALIZE
+                 OUTPUT_VARIABLE file)
+      cmake_path(IS_PREFIX tracing_dir ${file} NORMALIZE in_tracing)
+      if(in_tracing)
+        continue()
+      endif()
+
+      foreach(path ${paths})
+        cmake_path(IS_PREFIX path ${file} NORMALIZE instrument)
+        if(instrument)
+          set_property(SOURCE ${file} TARGET_DIRECTORY ${target}
+                       APPEND PROPERTY COMPILE_OPTIONS ${flags})
+          break()
+        endif()
+      endforeach()
+    endforeach()
+  endforeach()
+endfunction()
+
 ########################################################
 # 2. Kconfig-aware extensions
 ########################################################
@@ -1278,6 +1278,21 @@ typedef bool (*stack_trace_callback_fn)(void *cookie, unsigned long addr);
 void arch_stack_walk(stack_trace_callback_fn callback_fn, void *cookie,
 		     const struct k_thread *thread, const struct arch_esf *esf);
 
+/**
+ * @brief Get the call stack of the thread interrupted by the current interrupt
+ *
+ * Must be called from an interrupt service routine. The first entry is the
+ * address at which the thread was interrupted, followed by the return
+ * addresses of the callers when the architecture can unwind the stack.
+ *
+ * @param buf Buffer for the addresses
+ * @param size Size of the buffer, in number of addresses
+ *
+ * @return Number of addresses stored in the buffer. 0 if the interrupted context
+ *         is not known, e.g. when the current interrupt is nested.
+ */
+size_t arch_interrupted_stack_trace(uintptr_t *buf, size_t size);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
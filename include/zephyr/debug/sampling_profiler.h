@@ -0,0 +1,135 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_
+#define ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/kernel/thread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sampling_profiler Sampling profiler
+ * @ingroup os_services
+ * @brief Statistical profiler sampling the call stack from a periodic interrupt.
+ * @{
+ */
+
+/** @brief Call stack sampled by the profiler. */
+struct sampling_profiler_stack {
+	/** Interrupted thread. NULL if an interrupt was interrupted. The thread
+	 * may not exist anymore.
+	 */
+	const struct k_thread *thread;
+	/** Number of samples with this call stack. */
+	uint32_t count;
+	/** Number of addresses in the call stack. 0 if an interrupt was
+	 * interrupted.
+	 */
+	uint8_t depth;
+	/** Addresses of the functions in the call stack, starting with the
+	 * interrupted function. Addresses are rounded down to the start of the
+	 * function when it is found in the symbol table.
+	 */
+	uintptr_t addr[CONFIG_SAMPLING_PROFILER_STACK_DEPTH];
+};
+
+/** @brief Profiler statistics. */
+struct sampling_profiler_stats {
+	/** Number of samples in the histogram. */
+	uint32_t samples;
+	/** Number of samples dropped because the buffer was full. */
+	uint32_t dropped;
+	/** Number of samples lost because the histogram was full. */
+	uint32_t lost;
+	/** Number of unique call stacks in the histogram. */
+	uint32_t stacks;
+};
+
+/**
+ * @brief Callback called for each sampled call stack.
+ *
+ * @param stack     Call stack.
+ * @param user_data User data.
+ */
+typedef void (*sampling_profiler_cb_t)(const struct sampling_profiler_stack *stack,
+				       void *user_data);
+
+/**
+ * @brief Start sampling.
+ *
+ * Samples are added to the histogram collected so far.
+ *
+ * @param freq Sampling frequency in Hz.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if the profiler is already running.
+ * @retval -EINVAL if the frequency is not supported by the sampling source.
+ * @retval -errno other negative error code from the sampling source.
+ */
+int sampling_profiler_start(uint32_t freq);
+
+/**
+ * @brief Stop sampling.
+ *
+ * Buffered samples are added to the histogram.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if the profiler is not running.
+ */
+int sampling_profiler_stop(void);
+
+/**
+ * @brief Check if the profiler is running.
+ *
+ * @return True if sampling is in progress.
+ */
+bool sampling_profiler_is_running(void);
+
+/** @brief Discard the histogram and reset the statistics. */
+void sampling_profiler_reset(void);
+
+/**
+ * @brief Add buffered samples to the histogram.
+ *
+ * This is done periodically while the profiler is running, see
+ * @kconfig{CONFIG_SAMPLING_PROFILER_PROCESS_INTERVAL}.
+ */
+void sampling_profiler_process(void);
+
+/**
+ * @brief Iterate over the sampled call stacks.
+ *
+ * Buffered samples are added to the histogram first. Must not be called from
+ * the callback.
+ *
+ * @param cb        Callback.
+ * @param user_data User data passed to the callback.
+ *
+ * @return Number of reported call stacks.
+ */
+int sampling_profiler_foreach(sampling_profiler_cb_t cb, void *user_data);
+
+/**
+ * @brief Get the profiler statistics.
+ *
+ * @param stats Statistics.
+ */
+void sampling_profiler_stats_get(struct sampling_profiler_stats *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_ */
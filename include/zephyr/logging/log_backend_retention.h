@@ -0,0 +1,61 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LOG_BACKEND_RETENTION_H_
+#define ZEPHYR_LOG_BACKEND_RETENTION_H_
+
+#include <zephyr/logging/log_msg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Callback called for each retained log message.
+ *
+ * @param msg       Log message. NULL indicates a reboot, messages which follow
+ *                  were logged after the reboot.
+ * @param user_data User data.
+ */
+typedef void (*log_backend_retention_cb_t)(struct log_msg *msg, void *user_data);
+
+/**
+ * @brief Iterate over retained log messages, from the oldest to the newest.
+ *
+ * @details Messages from previous boots (if the image has not changed) and
+ *          the current boot are reported. Messages can be formatted using
+ *          @ref log_output_msg_process. Messages logged while iterating are
+ *          not reported and messages which are overwritten while iterating
+ *          are skipped. Thread identifiers of messages from previous boots
+ *          are cleared. Function must be called from the thread context.
+ *
+ * @param cb        Callback.
+ * @param user_data User data passed to the callback.
+ *
+ * @return Number of reported messages or negative error code if the backend
+ *         is not initialized.
+ */
+int log_backend_retention_foreach(log_backend_retention_cb_t cb, void *user_data);
+
+/**
+ * @brief Discard all retained log messages.
+ *
+ * @return 0 on success or negative error code.
+ */
+int log_backend_retention_clear(void);
+
+/**
+ * @brief Get the retention logger backend.
+ *
+ * @return Pointer to the retention logger backend.
+ */
+const struct log_backend *log_backend_retention_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_LOG_BACKEND_RETENTION_H_ */
@@ -214,6 +214,38 @@ static inline char z_log_minimal_level_to_char(int level)
 #define LOG_STRING_WARNING(_mode, _src, ...)
 #endif
 
+/*****************************************************************************/
+/****************** Macros for runtime filtering *****************************/
+/*****************************************************************************/
+bool z_log_call_site_register(struct log_call_site *site,
+			      struct log_source_dynamic_data *source);
+
+#ifdef CONFIG_LOG_CALL_SITE_FILTERING
+/* Each call site has a flag which is updated whenever runtime level of the
+ * source changes, a disabled call site costs a single test of that flag.
+ * The source is assigned when the call site is reached for the first time
+ * since it is not a compile time constant.
+ */
+#define Z_LOG_CALL_SITE_FILTERED(_level, _dsource) ({ \
+	static STRUCT_SECTION_ITERABLE(log_call_site, _log_call_site) = { \
+		.level = (_level), \
+		.enabled = true, \
+	}; \
+	!_log_call_site.enabled || \
+	(unlikely(_log_call_site.source == NULL) && \
+	 !z_log_call_site_register(&_log_call_site, (_dsource))); \
+})
+
+/* Instances are resolved at runtime so their level is always read. */
+#define Z_LOG_RUNTIME_FILTERED(_level, _inst, _dsource) \
+	(COND_CODE_0(_inst, \
+		(Z_LOG_CALL_SITE_FILTERED(_level, _dsource)), \
+		((_level) > Z_LOG_RUNTIME_FILTER((_dsource)->filters))))
+#else
+#define Z_LOG_RUNTIME_FILTERED(_level, _inst, _dsource) \
+	((_level) > Z_LOG_RUNTIME_FILTER((_dsource)->filters))
+#endif
+
 /*****************************************************************************/
 /****************** Macros for standard logging ******************************/
 /*****************************************************************************/
@@ -252,7 +284,7 @@ static inline char z_log_minimal_level_to_char(int level)
 	\
 	bool is_user_context = k_is_user_context(); \
 	if (IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) && \
-	    !is_user_context && _level > Z_LOG_RUNTIME_FILTER((_dsource)->filters)) { \
+	    !is_user_context && Z_LOG_RUNTIME_FILTERED(_level, _inst, _dsource)) { \
 		break; \
 	} \
 	int _mode; \
@@ -326,8 +358,6 @@ static inline char z_log_minimal_level_to_char(int level)
 		} \
 	} \
 	bool is_user_context = k_is_user_context(); \
-	uint32_t filters = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
-						(_dsource)->filters : 0;\
 	\
 	if (IS_ENABLED(CONFIG_LOG_MODE_MINIMAL)) { \
 		Z_LOG_TO_PRINTK(_level, "%s", _str); \
@@ -336,7 +366,7 @@ static inline char z_log_minimal_level_to_char(int level)
 		break; \
 	} \
 	if (IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) && \
-	    !is_user_context && (_level) > Z_LOG_RUNTIME_FILTER(filters)) { \
+	    !is_user_context && Z_LOG_RUNTIME_FILTERED(_level, _inst, _dsource)) { \
 		break; \
 	} \
 	int mode; \
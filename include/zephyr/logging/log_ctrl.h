@@ -272,7 +272,8 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage);
 /**
  * @brief Get maximum memory usage.
  *
- * Requires CONFIG_LOG_MEM_UTILIZATION option.
+ * Requires CONFIG_LOG_MEM_UTILIZATION option. With CONFIG_LOG_PER_CPU_BUFFERS,
+ * this is the sum of the maximum usage of each CPU buffer.
  *
  * @param[out] max Maximum number of bytes used for pending log messages.
  *
@@ -284,6 +285,36 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage);
  */
 int log_mem_get_max_usage(uint32_t *max);
 
+/**
+ * @brief Set rate limit of a log source.
+ *
+ * Requires CONFIG_LOG_RATE_LIMIT option. Messages of the source which exceed
+ * the limit are dropped and reported as dropped messages.
+ *
+ * @param source_id Source ID.
+ * @param rate Average number of messages per second. 0 removes the limit.
+ * @param burst Number of messages which can be logged at once.
+ *
+ * @retval 0 on successful operation.
+ * @retval -EINVAL if source ID or burst is invalid.
+ * @retval -ENOMEM if maximum number of rate limited sources is reached.
+ */
+int log_rate_limit_set(int16_t source_id, uint32_t rate, uint32_t burst);
+
+/**
+ * @brief Get rate limit of a log source.
+ *
+ * Requires CONFIG_LOG_RATE_LIMIT option.
+ *
+ * @param source_id Source ID.
+ * @param[out] rate Average number of messages per second. 0 if not limited.
+ * @param[out] burst Number of messages which can be logged at once.
+ *
+ * @retval 0 on successful operation.
+ * @retval -EINVAL if source ID is invalid.
+ */
+int log_rate_limit_get(int16_t source_id, uint32_t *rate, uint32_t *burst);
+
 #if defined(CONFIG_LOG) && !defined(CONFIG_LOG_MODE_MINIMAL)
 #define LOG_CORE_INIT() log_core_init()
 #define LOG_PANIC() log_panic()
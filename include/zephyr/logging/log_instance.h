@@ -7,6 +7,7 @@
 #define ZEPHYR_INCLUDE_LOGGING_LOG_INSTANCE_H_
 
 #include <zephyr/types.h>
+#include <stdbool.h>
 #include <zephyr/sys/iterable_sections.h>
 
 #ifdef __cplusplus
@@ -42,6 +43,24 @@ struct log_source_dynamic_data {
 #endif
 };
 
+/** @internal
+ * @brief Data associated with a single logging call site.
+ *
+ * Used with CONFIG_LOG_CALL_SITE_FILTERING. @p enabled is kept in sync with
+ * the aggregated runtime level of the source, so that a disabled call site is
+ * filtered out by testing a single flag. Source is assigned the first time the
+ * call site is reached.
+ */
+struct log_call_site {
+	struct log_source_dynamic_data *source;
+	uint8_t level;
+	bool enabled;
+#ifdef CONFIG_NIOS2
+	/* Workaround alert! Dummy data to ensure that structure is >8 bytes. */
+	uint32_t dummy;
+#endif
+};
+
 /** @internal
  *
  * Creates name of variable and section for constant log data.
@@ -60,6 +60,19 @@ void z_log_free(void *buf);
 /* Initialize runtime filters */
 void z_log_runtime_filters_init(void);
 
+#ifdef CONFIG_LOG_CALL_SITE_FILTERING
+/* Defer update of call sites while runtime filters of many sources are changed.
+ * Call sites are updated once when the last hold is released.
+ */
+void z_log_call_sites_hold(void);
+
+void z_log_call_sites_release(void);
+#else
+static inline void z_log_call_sites_hold(void) {}
+
+static inline void z_log_call_sites_release(void) {}
+#endif
+
 /* Initialize links. */
 void z_log_links_initiate(void);
 
@@ -110,6 +123,29 @@ void z_log_msg_init(void);
  */
 void z_log_msg_commit(struct log_msg *msg);
 
+/** @brief Number of dropped repeats of a message. */
+struct log_msg_repeats {
+	const void *source;
+	uint32_t cnt;
+	uint8_t level;
+};
+
+/** @brief Check if message is dropped by deduplication or rate limiting.
+ *
+ * @param msg Message with timestamp set.
+ * @param[out] repeats Repeats of an earlier message which shall be reported
+ * with @ref z_log_msg_repeats_report once @p msg is committed.
+ *
+ * @return True if message shall be dropped.
+ */
+bool z_log_msg_limit(struct log_msg *msg, struct log_msg_repeats *repeats);
+
+/** @brief Create message reporting dropped repeats, if there are any.
+ *
+ * @param repeats Repeats.
+ */
+void z_log_msg_repeats_report(const struct log_msg_repeats *repeats);
+
 /** @brief Get pending log message.
  *
  * @param[out] backoff Recommended backoff needed to maintain ordering of processed
@@ -499,7 +499,26 @@ do { \
  *
  * @param ...  Optional string with arguments (fmt, ...). It may be empty.
  */
-#if defined(CONFIG_LOG_ALWAYS_RUNTIME) || !defined(CONFIG_LOG)
+#if defined(CONFIG_LOG_PACKAGE_LAYOUT) && defined(CONFIG_LOG)
+/* Layout of the string package is computed at compile time from the types of
+ * the arguments, so that it is created without scanning the format string.
+ */
+#define Z_LOG_MSG_CREATE2(_try_0cpy, _mode,  _cstr_cnt, _domain_id, _source,\
+			  _level, _data, _dlen, ...) \
+do {\
+	Z_LOG_MSG_STR_VAR(_fmt, ##__VA_ARGS__) \
+	_Pragma("GCC diagnostic push") \
+	_Pragma("GCC diagnostic ignored \"-Wpointer-arith\"") \
+	uint32_t _layout = COND_CODE_0(NUM_VA_ARGS_LESS_1(_, ##__VA_ARGS__), \
+				       (0U), (CBPRINTF_PACKAGE_LAYOUT(__VA_ARGS__))); \
+	_Pragma("GCC diagnostic pop") \
+	z_log_msg_runtime_layout_create((_domain_id), (void *)(_source), \
+				  (_level), (uint8_t *)(_data), (_dlen),\
+				  Z_LOG_MSG_CBPRINTF_FLAGS(_cstr_cnt), _layout, \
+				  Z_LOG_FMT_ARGS(_fmt, ##__VA_ARGS__));\
+	(_mode) = Z_LOG_MSG_MODE_RUNTIME; \
+} while (false)
+#elif defined(CONFIG_LOG_ALWAYS_RUNTIME) || !defined(CONFIG_LOG)
 #define Z_LOG_MSG_CREATE2(_try_0cpy, _mode,  _cstr_cnt, _domain_id, _source,\
 			  _level, _data, _dlen, ...) \
 do {\
@@ -716,6 +735,70 @@ static inline void z_log_msg_runtime_create(uint8_t domain_id,
 	va_end(ap);
 }
 
+/** @brief Create message at runtime using precomputed package layout.
+ *
+ * Same as @ref z_log_msg_runtime_vcreate but string package is created
+ * without scanning the format string if @p layout is not
+ * @ref CBPRINTF_PACKAGE_LAYOUT_NONE.
+ *
+ * @param domain_id Domain ID.
+ *
+ * @param source Source.
+ *
+ * @param level Log level.
+ *
+ * @param data Data.
+ *
+ * @param dlen Data length.
+ *
+ * @param package_flags Package flags.
+ *
+ * @param layout Package layout computed with @ref CBPRINTF_PACKAGE_LAYOUT.
+ *
+ * @param fmt String.
+ *
+ * @param ap Variable list of string arguments.
+ */
+void z_log_msg_runtime_vcreate_layout(uint8_t domain_id, const void *source,
+				       uint8_t level, const void *data,
+				       size_t dlen, uint32_t package_flags,
+				       uint32_t layout, const char *fmt,
+				       va_list ap);
+
+/** @brief Create message at runtime using precomputed package layout.
+ *
+ * @param domain_id Domain ID.
+ *
+ * @param source Source.
+ *
+ * @param level Log level.
+ *
+ * @param data Data.
+ *
+ * @param dlen Data length.
+ *
+ * @param package_flags Package flags.
+ *
+ * @param layout Package layout computed with @ref CBPRINTF_PACKAGE_LAYOUT.
+ *
+ * @param fmt String.
+ *
+ * @param ... String arguments.
+ */
+static inline void z_log_msg_runtime_layout_create(uint8_t domain_id,
+						   const void *source,
+						   uint8_t level, const void *data,
+						   size_t dlen, uint32_t package_flags,
+						   uint32_t layout, const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	z_log_msg_runtime_vcreate_layout(domain_id, source, level, data, dlen,
+					 package_flags, layout, fmt, ap);
+	va_end(ap);
+}
+
 static inline bool z_log_item_is_msg(const union log_msg_generic *msg)
 {
 	return msg->generic.type == Z_LOG_MSG_LOG;
@@ -85,11 +85,23 @@ extern "C" {
  */
 typedef int (*log_output_func_t)(uint8_t *buf, size_t size, void *ctx);
 
+#if defined(CONFIG_LOG_DICTIONARY_COMPACT)
+/* @brief Frame of compact dictionary-based records pending output. */
+struct log_output_dict_frame {
+	log_timestamp_t timestamp;
+	size_t len;
+	uint8_t buf[CONFIG_LOG_DICTIONARY_COMPACT_FRAME_SIZE];
+};
+#endif
+
 /* @brief Control block structure for log_output instance.  */
 struct log_output_control_block {
 	atomic_t offset;
 	void *ctx;
 	const char *hostname;
+#if defined(CONFIG_LOG_DICTIONARY_COMPACT)
+	struct log_output_dict_frame frame;
+#endif
 };
 
 /** @brief Log_output instance structure. */
@@ -23,6 +23,7 @@ extern "C" {
 enum log_dict_output_msg_type {
 	MSG_NORMAL = 0,
 	MSG_DROPPED_MSG = 1,
+	MSG_COMPACT_FRAME = 2,
 };
 
 /**
@@ -47,6 +48,24 @@ struct log_dict_output_dropped_msg_t {
 	uint16_t num_dropped_messages;
 } __packed;
 
+/**
+ * Output header for a frame of compact dictionary based log records
+ * (CONFIG_LOG_DICTIONARY_COMPACT).
+ *
+ * It is followed by @p len bytes of records. Each record consists of
+ * a byte holding the domain (bits 4-6) and the level (bits 0-2), followed
+ * by unsigned LEB128 varints for the zigzag encoded timestamp delta from
+ * the previous record of the frame (the first record of a frame carries
+ * the absolute timestamp), the source ID, the length of the package and
+ * the length of the hexdump data. Then comes the package, where the
+ * argument words following the package descriptor are varint encoded,
+ * and the hexdump data.
+ */
+struct log_dict_output_compact_frame_hdr_t {
+	uint8_t type;
+	uint16_t len;
+} __packed;
+
 /** @brief Process log messages v2 for dictionary-based logging.
  *
  * Function is using provided context with the buffer and output function to
@@ -68,6 +87,17 @@ void log_dict_output_msg_process(const struct log_output *log_output,
  */
 void log_dict_output_dropped_process(const struct log_output *output, uint32_t cnt);
 
+/** @brief Write the pending compact dictionary-based records.
+ *
+ * Records are batched when CONFIG_LOG_DICTIONARY_COMPACT is enabled. The
+ * batch is written when no more log messages are pending, so this only
+ * needs to be called by backends which must not hold back any data,
+ * e.g. when entering panic mode. It does nothing otherwise.
+ *
+ * @param output Pointer to the log output instance.
+ */
+void log_dict_output_flush(const struct log_output *output);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1211,6 +1211,18 @@ void coap_replies_clear(struct coap_reply *replies, size_t len);
  */
 int coap_resource_notify(struct coap_resource *resource);
 
+/**
+ * @brief Advance the age of a resource that was updated.
+ *
+ * Only needed when the notifications are not sent from the @a notify
+ * callback, coap_resource_notify() already advances the age.
+ *
+ * @param resource Resource that was updated
+ *
+ * @return the new age, to be used as the Observe option of the notifications.
+ */
+int coap_resource_next_age(struct coap_resource *resource);
+
 /**
  * @brief Returns if this request is enabling observing a resource.
  *
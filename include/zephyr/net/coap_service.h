@@ -44,6 +44,20 @@ struct coap_service_data {
 	int sock_fd;
 	struct coap_observer observers[CONFIG_COAP_SERVICE_OBSERVERS];
 	struct coap_pending pending[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+	/* Observers hashed by token, chains and free list hold index + 1 */
+	uint16_t observer_buckets[2 * CONFIG_COAP_SERVICE_OBSERVERS];
+	uint16_t observer_next[CONFIG_COAP_SERVICE_OBSERVERS];
+	uint16_t observer_free;
+	uint16_t observer_used;
+	/* Pending messages hashed by message id, same layout as the observers */
+	uint16_t pending_buckets[2 * CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+	uint16_t pending_next[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+	uint16_t pending_free;
+	uint16_t pending_used;
+	/* Min-heap of the pending messages by retransmission deadline */
+	uint16_t pending_heap[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+	uint16_t pending_heap_pos[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+	uint16_t pending_count;
 };
 
 struct coap_service {
@@ -258,6 +272,34 @@ int coap_resource_send(const struct coap_resource *resource, const struct coap_p
 		       const struct sockaddr *addr, socklen_t addr_len,
 		       const struct coap_transmission_parameters *params);
 
+/**
+ * @brief Send a notification to all the observers of the provided @p resource .
+ *
+ * @note This function is suitable for a @p resource defined with @ref COAP_RESOURCE_DEFINE.
+ *
+ * The notification is encoded once by the caller and sent to every observer with the token of
+ * the observer and a new message id, the token and message id of @p cpkt are ignored. The
+ * Observe option of @p cpkt should hold the value returned by coap_resource_next_age(). If
+ * @p cpkt is confirmable, a retransmission is scheduled for every observer.
+ *
+ * @code{.c}
+ *     coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_NON_CON, 0, NULL,
+ *                      COAP_RESPONSE_CODE_CONTENT, 0);
+ *     coap_append_option_int(&cpkt, COAP_OPTION_OBSERVE, coap_resource_next_age(resource));
+ *     coap_packet_append_payload_marker(&cpkt);
+ *     coap_packet_append_payload(&cpkt, payload, payload_len);
+ *
+ *     coap_resource_notify_observers(resource, &cpkt, NULL);
+ * @endcode
+ *
+ * @param resource Pointer to CoAP resource
+ * @param cpkt CoAP notification to send
+ * @param params Pointer to transmission parameters structure or NULL to use default values.
+ * @return the number of notifications sent in case of success or negative in case of error.
+ */
+int coap_resource_notify_observers(struct coap_resource *resource, const struct coap_packet *cpkt,
+				   const struct coap_transmission_parameters *params);
+
 /**
  * @brief Parse a CoAP observe request for the provided @p resource .
  *
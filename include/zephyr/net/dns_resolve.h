@@ -416,6 +416,19 @@ struct dns_resolve_context {
 		 * cannot be used to find correct pending query.
 		 */
 		uint16_t query_hash;
+
+		/** DNS id of the query whose response this query shares,
+		 * valid if coalesced is set.
+		 */
+		uint16_t leader_id;
+
+		/** This query was not sent, it waits for the response of an
+		 * identical query that was already pending.
+		 */
+		bool coalesced;
+
+		/** This query was sent to an LLMNR responder */
+		bool llmnr;
 	} queries[DNS_NUM_CONCUR_QUERIES];
 
 	/** Is this context in use */
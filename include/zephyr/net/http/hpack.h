@@ -12,6 +12,7 @@
 #ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 #define ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -102,6 +103,19 @@ enum http_hpack_static_key {
 #define HTTP_SERVER_HUFFMAN_DECODE_BUFFER_SIZE 0
 #endif
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+#define HTTP_SERVER_HPACK_TABLE_SIZE CONFIG_HTTP_SERVER_HPACK_TABLE_SIZE
+#else
+#define HTTP_SERVER_HPACK_TABLE_SIZE 0
+#endif
+
+/* Size of a dynamic table entry on top of its name and value, RFC7541 ch 4.1 */
+#define HTTP_HPACK_ENTRY_OVERHEAD 32
+
+#define HTTP_HPACK_TABLE_MAX_ENTRIES \
+	(HTTP_SERVER_HPACK_TABLE_SIZE / HTTP_HPACK_ENTRY_OVERHEAD)
+#define HTTP_HPACK_TABLE_BUCKETS (2 * HTTP_HPACK_TABLE_MAX_ENTRIES)
+
 /** @endcond */
 
 /** HTTP2 header field with decoding buffer. */
@@ -127,6 +141,55 @@ struct http_hpack_header_buf {
 
 /** @cond INTERNAL_HIDDEN */
 
+struct http_hpack_dynamic_entry {
+	/* Position of the name in the table data, the value follows it */
+	uint32_t pos;
+	/* Hash of the name and value */
+	uint32_t hash;
+	/* Sequence number + 1 of the previous entry with the same bucket */
+	uint32_t next;
+	uint16_t name_len;
+	uint16_t value_len;
+};
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+
+/* HPACK dynamic table, RFC7541 ch 2.3.2. Entries are identified by a
+ * sequence number that grows with each insertion, the newest one has the
+ * lowest index. The names and values are stored back to back in data, in
+ * insertion order.
+ */
+struct http_hpack_table {
+	struct http_hpack_dynamic_entry entries[HTTP_HPACK_TABLE_MAX_ENTRIES];
+	/* Sequence number + 1 of the newest entry of each hash bucket */
+	uint32_t buckets[HTTP_HPACK_TABLE_BUCKETS];
+	uint8_t data[HTTP_SERVER_HPACK_TABLE_SIZE];
+	/* Position of data[0] and of the end of the newest entry */
+	uint32_t data_start;
+	uint32_t data_end;
+	/* Sequence numbers of the oldest and of the next entry */
+	uint32_t first;
+	uint32_t next;
+	/* Current and maximum size of the table, as defined in RFC7541 */
+	uint32_t size;
+	uint32_t max_size;
+	/* The encoder must tell the peer about a new maximum size */
+	bool size_update;
+};
+
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
+
+struct http_hpack_table;
+
+void http_hpack_table_init(struct http_hpack_table *table, uint32_t max_size);
+void http_hpack_table_set_max_size(struct http_hpack_table *table, uint32_t max_size);
+int http_hpack_table_decode_header(struct http_hpack_table *table,
+				   const uint8_t *buf, size_t datalen,
+				   struct http_hpack_header_buf *header);
+int http_hpack_table_encode_header(struct http_hpack_table *table,
+				   uint8_t *buf, size_t buflen,
+				   struct http_hpack_header_buf *header);
+
 int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			      uint8_t *buf, size_t buflen);
 int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
@@ -367,6 +367,11 @@ struct http_client_ctx {
 /** @cond INTERNAL_HIDDEN */
 	/** Websocket security key. */
 	IF_ENABLED(CONFIG_WEBSOCKET, (uint8_t ws_sec_key[HTTP_SERVER_WS_MAX_SEC_KEY_LEN]));
+
+	/** HPACK dynamic tables of the HTTP/2 connection. */
+	IF_ENABLED(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE,
+		   (struct http_hpack_table hpack_decoder;
+		    struct http_hpack_table hpack_encoder;));
 /** @endcond */
 
 	/** Flag indicating that HTTP2 preface was sent. */
@@ -467,6 +467,41 @@ struct mqtt_transport {
 #endif
 };
 
+#if CONFIG_MQTT_PUBLISH_WINDOW > 0
+/** @brief QoS 1 or QoS 2 publication waiting for its acknowledgment. */
+struct mqtt_inflight_entry {
+	/** Message id of the publication. */
+	uint16_t message_id;
+
+	/** Next entry in the same bucket, index + 1 or 0. */
+	uint16_t next;
+
+	/** QoS of the publication. */
+	uint8_t qos;
+
+	/** PUBREC received, waiting for PUBCOMP (QoS 2 only). */
+	bool received;
+};
+
+/** @brief Publications in flight, indexed by message id. */
+struct mqtt_inflight {
+	/** Table entries. */
+	struct mqtt_inflight_entry entries[CONFIG_MQTT_PUBLISH_WINDOW];
+
+	/** Heads of the bucket chains, index + 1 or 0. */
+	uint16_t buckets[2 * CONFIG_MQTT_PUBLISH_WINDOW];
+
+	/** Number of publications in flight. */
+	uint16_t count;
+
+	/** Number of entries handed out at least once. */
+	uint16_t used;
+
+	/** Head of the released entries, index + 1 or 0. */
+	uint16_t free;
+};
+#endif /* CONFIG_MQTT_PUBLISH_WINDOW > 0 */
+
 /** @brief MQTT internal state. */
 struct mqtt_internal {
 	/** Internal. Mutex to protect access to the client instance. */
@@ -485,6 +520,11 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	uint32_t remaining_payload;
+
+#if CONFIG_MQTT_PUBLISH_WINDOW > 0
+	/** Internal. QoS 1 and QoS 2 publications not acknowledged yet. */
+	struct mqtt_inflight inflight;
+#endif
 };
 
 /**
@@ -627,6 +667,24 @@ int mqtt_connect(struct mqtt_client *client);
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+/**
+ * @brief API to get the number of QoS 1 and QoS 2 publications in flight.
+ *
+ * A publication is in flight from its successful mqtt_publish() until the
+ * PUBACK (QoS 1) or the PUBCOMP (QoS 2) of its message id is received, or
+ * until the client disconnects. At most @kconfig{CONFIG_MQTT_PUBLISH_WINDOW}
+ * publications can be in flight, further QoS 1 and QoS 2 mqtt_publish() calls
+ * fail with -EAGAIN until an acknowledgment is processed by mqtt_input().
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ *
+ * @return Number of publications in flight, -ENOTSUP if
+ *         @kconfig{CONFIG_MQTT_PUBLISH_WINDOW} is 0 or another negative error
+ *         code (errno.h) indicating reason of failure.
+ */
+int mqtt_publish_inflight_count(struct mqtt_client *client);
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
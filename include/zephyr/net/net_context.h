@@ -119,6 +119,42 @@ typedef void (*net_context_send_cb_t)(struct net_context *context,
 				      int status,
 				      void *user_data);
 
+struct net_zc_tx;
+
+/**
+ * @typedef net_zc_tx_done_cb_t
+ * @brief Zero-copy transmit completion callback.
+ *
+ * @details Called once the network stack has released every reference to
+ * the caller buffers of a zero-copy send, i.e. after the data has been
+ * transmitted (datagram sockets) or acknowledged by the peer (stream
+ * sockets). The buffers may be reused or freed from this point on. The
+ * callback can be called from the TX or RX thread, or from the interrupt
+ * context of the network driver, so keep it minimal.
+ *
+ * @param zc The zero-copy descriptor given to the send call.
+ */
+typedef void (*net_zc_tx_done_cb_t)(struct net_zc_tx *zc);
+
+/**
+ * @brief Zero-copy transmit descriptor.
+ *
+ * @details Tracks the caller buffers of one zero-copy send. The descriptor
+ * must stay valid until the @a done callback has been called. It can be
+ * embedded into a larger structure to carry user data.
+ */
+struct net_zc_tx {
+	/** Called when the stack no longer references the caller buffers */
+	net_zc_tx_done_cb_t done;
+
+	/** @cond INTERNAL_HIDDEN */
+	/* Number of network buffers referencing the caller data, plus one
+	 * held by the sender for the duration of the send call.
+	 */
+	atomic_t refs;
+	/** @endcond */
+};
+
 /**
  * @typedef net_tcp_accept_cb_t
  * @brief Accept callback
@@ -286,6 +322,11 @@ __net_socket struct net_context {
 		/** Mutex used by condition variable */
 		struct k_mutex *lock;
 	} cond;
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	/** epoll interest list entries watching this socket */
+	sys_slist_t epoll_items;
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
 #endif /* CONFIG_NET_SOCKETS */
 
 #if defined(CONFIG_NET_OFFLOAD)
@@ -1206,6 +1247,68 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+/**
+ * @brief Send data in iovec without copying it into network buffers.
+ *
+ * @details Same as net_context_sendmsg(), but the network buffers sent out
+ * reference the data in @a msghdr instead of holding a copy of it. The
+ * caller must keep the data intact until the @a done callback of @a zc is
+ * called. Before the first send with a descriptor the caller must
+ * initialize it with net_zc_tx_init() and, after the last one,
+ * release its own reference with net_zc_tx_unref().
+ * Only UDP and native TCP contexts support zero-copy sends.
+ *
+ * @param context The network context to use.
+ * @param msghdr The data to send
+ * @param zc Zero-copy descriptor tracking the data references.
+ * @param timeout Currently this value is not used.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_sendmsg_zc(struct net_context *context,
+			   const struct msghdr *msghdr,
+			   struct net_zc_tx *zc,
+			   k_timeout_t timeout);
+
+/**
+ * @brief Initialize a zero-copy transmit descriptor.
+ *
+ * @details Takes the reference of the sender, so the completion callback
+ * cannot be called while the data is still being queued.
+ *
+ * @param zc Zero-copy descriptor.
+ * @param done Completion callback.
+ */
+static inline void net_zc_tx_init(struct net_zc_tx *zc, net_zc_tx_done_cb_t done)
+{
+	zc->done = done;
+	atomic_set(&zc->refs, 1);
+}
+
+/**
+ * @brief Take a reference to a zero-copy transmit descriptor.
+ *
+ * @param zc Zero-copy descriptor.
+ */
+static inline void net_zc_tx_ref(struct net_zc_tx *zc)
+{
+	(void)atomic_inc(&zc->refs);
+}
+
+/**
+ * @brief Release a reference to a zero-copy transmit descriptor.
+ *
+ * @details Calls the completion callback when the last reference is gone.
+ *
+ * @param zc Zero-copy descriptor.
+ */
+static inline void net_zc_tx_unref(struct net_zc_tx *zc)
+{
+	if (atomic_dec(&zc->refs) == 1 && zc->done != NULL) {
+		zc->done(zc);
+	}
+}
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
@@ -142,6 +142,11 @@ struct net_pkt {
 	};
 #endif /* CONFIG_NET_PKT_RXTIME_STATS || CONFIG_NET_PKT_TXTIME_STATS */
 
+#if defined(CONFIG_NET_RX_STEERING)
+	/** Flow hash used to select the RX queue, 0 if not known yet */
+	uint32_t flow_hash;
+#endif
+
 	/** Reference counter */
 	atomic_t atomic_ref;
 
@@ -1132,6 +1137,41 @@ static inline void net_pkt_set_create_time(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_PKT_RXTIME_STATS || CONFIG_NET_PKT_TXTIME_STATS */
 
+#if defined(CONFIG_NET_RX_STEERING)
+static inline uint32_t net_pkt_flow_hash(struct net_pkt *pkt)
+{
+	return pkt->flow_hash;
+}
+
+/**
+ * @brief Set the flow hash of a received packet.
+ *
+ * Drivers with hardware receive side scaling can pass the hash computed by
+ * the hardware, so that the stack does not need to parse the headers to
+ * select the RX queue. The value 0 means that the hash is not known.
+ *
+ * @param pkt Network packet
+ * @param hash Flow hash
+ */
+static inline void net_pkt_set_flow_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	pkt->flow_hash = hash;
+}
+#else
+static inline uint32_t net_pkt_flow_hash(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0U;
+}
+
+static inline void net_pkt_set_flow_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hash);
+}
+#endif /* CONFIG_NET_RX_STEERING */
+
 /**
  * @deprecated Use @ref net_pkt_timestamp or @ref net_pkt_timestamp_ns instead.
  */
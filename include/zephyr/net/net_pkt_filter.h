@@ -57,10 +57,18 @@ extern struct npf_rule npf_default_ok;
 /** @brief Default rule list termination for rejecting a packet */
 extern struct npf_rule npf_default_drop;
 
+/** @cond INTERNAL_HIDDEN */
+struct npf_classifier;
+/** @endcond */
+
 /** @brief rule set for a given test location */
 struct npf_rule_list {
 	sys_slist_t rule_head;   /**< List head */
 	struct k_spinlock lock;  /**< Lock protecting the list access */
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED) || defined(__DOXYGEN__)
+	/** Compiled form of the list, rebuilt on every list change */
+	struct npf_classifier *classifier;
+#endif
 };
 
 /** @brief  rule list applied to outgoing packets */
@@ -191,6 +199,11 @@ bool npf_remove_all_rules(struct npf_rule_list *rules);
  * the fate of the packet. If one condition is false then the next rule in
  * the list is evaluated.
  *
+ * With :kconfig:option:`CONFIG_NET_PKT_FILTER_COMPILED` the rule lists are
+ * indexed on the Ethernet type and addresses they require, so only the rules
+ * that can match a packet are evaluated. The result is the same, but rules
+ * must not be modified while they are part of a rule list.
+ *
  * @param _name Name for this rule.
  * @param _result Fate of the packet if all conditions are true, either
  *                <tt>NET_OK</tt> or <tt>NET_DROP</tt>.
@@ -29,6 +29,7 @@
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/socket_select.h>
 #include <zephyr/net/socket_poll.h>
+#include <zephyr/net/socket_epoll.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/fdtable.h>
 #include <zephyr/net/dns_resolve.h>
@@ -74,6 +75,8 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: Turn on ZSOCK_MSG_DONTWAIT after the first message */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
 /**
@@ -232,6 +235,11 @@ extern "C" {
  *  will take place in consecutive send()/recv() call.
  */
 #define TLS_DTLS_HANDSHAKE_ON_CONNECT 18
+/** Read-only socket option to get TLS handshake and session cache
+ *  statistics, shared by all TLS/DTLS sockets.
+ *  The option accepts a pointer to a @ref tls_session_stats structure.
+ */
+#define TLS_SESSION_STATS 19
 
 /* Valid values for @ref TLS_PEER_VERIFY option */
 #define TLS_PEER_VERIFY_NONE 0     /**< Peer verification disabled. */
@@ -261,6 +269,16 @@ extern "C" {
 #define TLS_DTLS_CID_STATUS_UPLINK		2 /**< CID is in use by peer */
 #define TLS_DTLS_CID_STATUS_BIDIRECTIONAL	3 /**< CID is in use by us and peer */
 /** @} */ /* for @name */
+
+/** Statistics returned by the @ref TLS_SESSION_STATS option. */
+struct tls_session_stats {
+	uint32_t handshakes;      /**< Completed handshakes */
+	uint32_t resumed;         /**< Handshakes that resumed a session */
+	uint32_t cache_hits;      /**< Client sessions found in the cache */
+	uint32_t cache_misses;    /**< Client sessions not found or expired */
+	uint32_t cache_evictions; /**< Client sessions replaced by newer ones */
+};
+
 /** @} */ /* for @defgroup */
 
 /**
@@ -522,6 +540,130 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Message header used by zsock_recvmmsg() and zsock_sendmmsg()
+ */
+struct zsock_mmsghdr {
+	struct msghdr msg_hdr; /**< Message header */
+	unsigned int msg_len;  /**< Number of bytes transferred for the message */
+};
+
+/**
+ * @brief Receive multiple messages from a socket
+ *
+ * @details
+ * Receive up to @a vlen messages with a single call, taking the socket lock
+ * only once. This amortizes the per-call overhead when a datagram socket
+ * has a burst of packets queued. Each message is received as with
+ * zsock_recvmsg(), and its length is stored into the @a msg_len field.
+ * If @ref ZSOCK_MSG_WAITFORONE is set, only the first message may block.
+ *
+ * Unlike the Linux call, there is no timeout parameter; the
+ * ``SO_RCVTIMEO`` option of the socket applies to each blocking receive.
+ *
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Array of message headers
+ * @param vlen Number of entries in @a msgvec
+ * @param flags Same flags as for zsock_recvmsg(), plus
+ *        @ref ZSOCK_MSG_WAITFORONE
+ *
+ * @return Number of messages received, or -1 with errno set if no
+ *         message could be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * Send up to @a vlen messages with a single call, taking the socket lock
+ * only once. Each message is sent as with zsock_sendmsg(), and the number
+ * of bytes sent is stored into its @a msg_len field.
+ *
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Array of message headers
+ * @param vlen Number of entries in @a msgvec
+ * @param flags Same flags as for zsock_sendmsg()
+ *
+ * @return Number of messages sent, or -1 with errno set if no
+ *         message could be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+struct net_buf;
+struct net_zc_tx;
+
+/**
+ * @brief Send a message without copying the data
+ *
+ * @details
+ * Same as zsock_sendmsg(), but the network stack references the data in
+ * @p msg instead of copying it into network buffers. The data must be kept
+ * intact until @p done is called with @p zc, which happens once the data
+ * has been transmitted (datagram sockets) or acknowledged by the peer
+ * (stream sockets). If nothing was queued, for example because of an error,
+ * @p done is called before this function returns. A stream socket may queue
+ * less than the whole message, the return value tells how much was queued.
+ *
+ * Only native UDP and TCP sockets support zero-copy sends. This function
+ * is not available to user mode threads, and requires
+ * :kconfig:option:`CONFIG_NET_CONTEXT_ZEROCOPY`.
+ *
+ * @param sock Socket to send on.
+ * @param msg Message to send.
+ * @param flags Same flags as for zsock_sendmsg().
+ * @param zc Zero-copy descriptor, must stay valid until @p done is called.
+ * @param done Completion callback.
+ *
+ * @return Number of bytes queued, or -1 with errno set on error.
+ */
+ssize_t zsock_sendmsg_zc(int sock, const struct msghdr *msg, int flags,
+			 struct net_zc_tx *zc, void (*done)(struct net_zc_tx *zc));
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * Instead of copying the received data into a caller buffer, the network
+ * buffers holding it are lent to the application. On success @p frags
+ * points to a fragment chain containing one datagram (datagram sockets) or
+ * one received segment (stream sockets). The chain must be given back with
+ * zsock_recv_zc_release(). For stream sockets the receive window is opened
+ * only when the data is released.
+ *
+ * This function is not available to user mode threads, and requires
+ * :kconfig:option:`CONFIG_NET_CONTEXT_ZEROCOPY`.
+ *
+ * @param sock Socket to receive from.
+ * @param frags Returned fragment chain, NULL if nothing was received.
+ * @param flags Same flags as for zsock_recv(), except ZSOCK_MSG_PEEK.
+ * @param src_addr Source address of the datagram, can be NULL.
+ * @param addrlen Length of @p src_addr, value-result argument.
+ *
+ * @return Number of bytes lent, 0 on end of stream, or -1 with errno set.
+ */
+ssize_t zsock_recv_zc(int sock, struct net_buf **frags, int flags,
+		      struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Give back network buffers lent by zsock_recv_zc()
+ *
+ * @param sock Socket the data was received from.
+ * @param frags Fragment chain returned by zsock_recv_zc().
+ *
+ * @return 0 on success, -1 with errno set if the socket is no longer valid
+ *         (the buffers are released anyway).
+ */
+int zsock_recv_zc_release(int sock, struct net_buf *frags);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -952,6 +1094,28 @@ static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
 	return zsock_recvmsg(sock, msg, flags);
 }
 
+/** POSIX wrapper for @ref zsock_mmsghdr */
+#define mmsghdr zsock_mmsghdr
+
+/** POSIX wrapper for @ref zsock_recvmmsg, @a timeout must be NULL */
+static inline int recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags, void *timeout)
+{
+	if (timeout != NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
+/** POSIX wrapper for @ref zsock_sendmmsg */
+static inline int sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_poll */
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
@@ -1058,6 +1222,8 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 /** POSIX wrapper for @ref ZSOCK_MSG_WAITALL */
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+/** POSIX wrapper for @ref ZSOCK_MSG_WAITFORONE */
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 /** POSIX wrapper for @ref ZSOCK_SHUT_RD */
 #define SHUT_RD ZSOCK_SHUT_RD
@@ -0,0 +1,179 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file socket_epoll.h
+ *
+ * @brief BSD epoll support functions.
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+#include <zephyr/sys/util_macro.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name Events for zsock_epoll_ctl() and zsock_epoll_wait()
+ * @{
+ */
+/** zsock_epoll: Data is available to be read */
+#define ZSOCK_EPOLLIN 0x001
+/** zsock_epoll: Data can be written */
+#define ZSOCK_EPOLLOUT 0x004
+/** zsock_epoll: Error condition, always reported */
+#define ZSOCK_EPOLLERR 0x008
+/** zsock_epoll: Peer closed the connection, always reported */
+#define ZSOCK_EPOLLHUP 0x010
+/** zsock_epoll: Disable the entry after one event has been reported */
+#define ZSOCK_EPOLLONESHOT BIT(30)
+/** zsock_epoll: Report only changes of the readiness state */
+#define ZSOCK_EPOLLET BIT(31)
+/** @} */
+
+/**
+ * @name Operations for zsock_epoll_ctl()
+ * @{
+ */
+/** Add a descriptor to the interest list */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** Remove a descriptor from the interest list */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** Change the events of a descriptor in the interest list */
+#define ZSOCK_EPOLL_CTL_MOD 3
+/** @} */
+
+/** User data attached to an epoll interest list entry */
+typedef union zsock_epoll_data {
+	void *ptr;     /**< Pointer */
+	int fd;        /**< File descriptor */
+	uint32_t u32;  /**< 32-bit value */
+	uint64_t u64;  /**< 64-bit value */
+} zsock_epoll_data_t;
+
+/** Event description used by zsock_epoll_ctl() and zsock_epoll_wait() */
+struct zsock_epoll_event {
+	uint32_t events;          /**< Requested or returned events */
+	zsock_epoll_data_t data;  /**< User data */
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @details
+ * An epoll instance keeps a persistent interest list of sockets and a
+ * list of sockets that are ready. The ready list is fed directly by the
+ * network stack when data arrives, so the cost of zsock_epoll_wait() does
+ * not depend on the number of monitored sockets. The instance is a file
+ * descriptor and is released with zsock_close().
+ * This function is also exposed as ``epoll_create()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ *
+ * @param size Ignored, but must be greater than zero.
+ *
+ * @return epoll file descriptor, or -1 with errno set.
+ */
+__syscall int zsock_epoll_create(int size);
+
+/**
+ * @brief Control the interest list of an epoll instance
+ *
+ * @details
+ * Only native network sockets can be added to an epoll instance.
+ * A socket is removed from all interest lists when it is closed.
+ * This function is also exposed as ``epoll_ctl()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ *
+ * @param epfd epoll file descriptor
+ * @param op One of ZSOCK_EPOLL_CTL_ADD, ZSOCK_EPOLL_CTL_MOD or
+ *        ZSOCK_EPOLL_CTL_DEL
+ * @param fd Socket descriptor
+ * @param event Events and user data, ignored for ZSOCK_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, or -1 with errno set.
+ */
+__syscall int zsock_epoll_ctl(int epfd, int op, int fd,
+			      struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for events on an epoll instance
+ *
+ * @details
+ * This function is also exposed as ``epoll_wait()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ *
+ * @param epfd epoll file descriptor
+ * @param events Array receiving the ready events
+ * @param maxevents Number of entries in @a events
+ * @param timeout Timeout in milliseconds, or -1 to wait forever
+ *
+ * @return Number of ready events, 0 on timeout, or -1 with errno set.
+ */
+__syscall int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			       int maxevents, int timeout);
+
+/** @cond INTERNAL_HIDDEN */
+
+#ifdef CONFIG_NET_SOCKETS_POSIX_NAMES
+
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+#define EPOLLONESHOT ZSOCK_EPOLLONESHOT
+#define EPOLLET ZSOCK_EPOLLET
+
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+
+#define epoll_data zsock_epoll_data
+#define epoll_data_t zsock_epoll_data_t
+#define epoll_event zsock_epoll_event
+
+static inline int epoll_create(int size)
+{
+	return zsock_epoll_create(size);
+}
+
+static inline int epoll_ctl(int epfd, int op, int fd,
+			    struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#endif /* CONFIG_NET_SOCKETS_POSIX_NAMES */
+
+/** @endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <zephyr/syscalls/socket_epoll.h>
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
@@ -33,6 +33,10 @@ extern const struct shell_transport_api shell_uart_transport_api;
 #define CONFIG_SHELL_BACKEND_SERIAL_ASYNC_RX_BUFFER_SIZE 0
 #endif
 
+#ifndef CONFIG_SHELL_BACKEND_SERIAL_ASYNC_TX_BUFFER_SIZE
+#define CONFIG_SHELL_BACKEND_SERIAL_ASYNC_TX_BUFFER_SIZE 0
+#endif
+
 #define ASYNC_RX_BUF_SIZE (CONFIG_SHELL_BACKEND_SERIAL_ASYNC_RX_BUFFER_COUNT * \
 		(CONFIG_SHELL_BACKEND_SERIAL_ASYNC_RX_BUFFER_SIZE + \
 		 UART_ASYNC_RX_BUF_OVERHEAD))
@@ -64,6 +68,16 @@ struct shell_uart_async {
 	struct uart_async_rx_config async_rx_config;
 	atomic_t pending_rx_req;
 	uint8_t rx_data[ASYNC_RX_BUF_SIZE];
+	struct k_spinlock tx_lock;
+	/* Number of bytes in the buffer which is being filled. */
+	size_t tx_len;
+	/* Length of the last transfer and number of its bytes which were sent. */
+	size_t tx_xfer_len;
+	size_t tx_xfer_sent;
+	/* Index of the buffer which is being filled. */
+	uint8_t tx_idx;
+	bool tx_busy;
+	uint8_t tx_data[2][CONFIG_SHELL_BACKEND_SERIAL_ASYNC_TX_BUFFER_SIZE];
 };
 
 struct shell_uart_polling {
@@ -393,6 +393,25 @@ typedef int (*cbvprintf_external_formatter_func)(cbprintf_cb out, void *ctx,
 	Z_CBPRINTF_STATIC_PACKAGE(packaged, inlen, outlen, \
 				  align_offset, flags, __VA_ARGS__)
 
+/** @brief Value of a package layout which could not be computed. */
+#define CBPRINTF_PACKAGE_LAYOUT_NONE Z_CBPRINTF_LAYOUT_NONE
+
+/** @brief Compute package layout at compile time.
+ *
+ * Layout describes how arguments are stored in the package. It is computed
+ * from the types of the arguments, as a constant expression, and can be given
+ * to @ref cbvprintf_package_layout to create the package without scanning
+ * the format string.
+ *
+ * Layout cannot be computed if _Generic is not supported, if any argument is
+ * a character pointer or a long double, or if there are more than 15
+ * arguments. @ref CBPRINTF_PACKAGE_LAYOUT_NONE is returned then.
+ *
+ * @param ... formatted string with arguments. Arguments are not evaluated.
+ */
+#define CBPRINTF_PACKAGE_LAYOUT(... /* fmt, ... */) \
+	Z_CBPRINTF_PACKAGE_LAYOUT(__VA_ARGS__)
+
 /** @brief Capture state required to output formatted data later.
  *
  * Like cbprintf() but instead of processing the arguments and emitting the
@@ -480,6 +499,40 @@ int cbvprintf_package(void *packaged,
 		      const char *format,
 		      va_list ap);
 
+/** @brief Capture state required to output formatted data later, using
+ * a layout computed at compile time.
+ *
+ * Like cbvprintf_package() but arguments are stored according to @p layout
+ * instead of the conversion specifications found within @p format, so the
+ * format string is not scanned. Package is the same as the one created by
+ * cbvprintf_package() when the types of the arguments match the conversion
+ * specifications.
+ *
+ * @param packaged pointer to where the packaged data can be stored. See
+ * cbvprintf_package().
+ *
+ * @param len number of bytes available at @p packaged or buffer alignment
+ * offset if @p packaged is null. See cbvprintf_package().
+ *
+ * @param flags option flags. See @ref CBPRINTF_PACKAGE_FLAGS.
+ *
+ * @param layout layout computed with @ref CBPRINTF_PACKAGE_LAYOUT. If it is
+ * @ref CBPRINTF_PACKAGE_LAYOUT_NONE then cbvprintf_package() is used.
+ *
+ * @param format a standard ISO C format string with characters and conversion
+ * specifications.
+ *
+ * @param ap captured stack arguments.
+ *
+ * @return Same values as cbvprintf_package().
+ */
+int cbvprintf_package_layout(void *packaged,
+			     size_t len,
+			     uint32_t flags,
+			     uint32_t layout,
+			     const char *format,
+			     va_list ap);
+
 /** @brief Convert a package.
  *
  * Converting may include appending strings used in the package to the package body.
@@ -545,6 +545,63 @@ extern "C" {
 #define Z_CBPRINTF_MUST_RUNTIME_PACKAGE(flags, ...) 1
 #endif
 
+/* Storage classes of the arguments in a package layout, 2 bits per argument.
+ * Class 0 marks the end of the arguments.
+ */
+#define Z_CBPRINTF_LAYOUT_INT 1
+#define Z_CBPRINTF_LAYOUT_LONG_LONG 2
+#define Z_CBPRINTF_LAYOUT_DOUBLE 3
+#define Z_CBPRINTF_LAYOUT_CLASS_BITS 2
+#define Z_CBPRINTF_LAYOUT_CLASS_MASK BIT_MASK(Z_CBPRINTF_LAYOUT_CLASS_BITS)
+#define Z_CBPRINTF_LAYOUT_MAX_ARGS 15
+#define Z_CBPRINTF_LAYOUT_NONE BIT(31)
+
+#if Z_C_GENERIC && !defined(__cplusplus)
+/** @brief Get storage class of an argument in a package layout.
+ *
+ * @note Macro triggers a pointer arithmetic warning and usage shall be wrapped in
+ * the pragma that suppresses this warning.
+ *
+ * @param x Argument.
+ *
+ * @return Storage class or Z_CBPRINTF_LAYOUT_NONE if argument may be a string
+ * or it is not stored the same way by the runtime packaging.
+ */
+#define Z_CBPRINTF_LAYOUT_CLASS(x) \
+	(Z_CBPRINTF_IS_PCHAR(x, 0) ? Z_CBPRINTF_LAYOUT_NONE : \
+	 _Generic((x) + 0, \
+		float : Z_CBPRINTF_LAYOUT_DOUBLE, \
+		double : Z_CBPRINTF_LAYOUT_DOUBLE, \
+		long double : Z_CBPRINTF_LAYOUT_NONE, \
+		default : \
+			(sizeof((x) + 0) <= sizeof(int) ? Z_CBPRINTF_LAYOUT_INT : \
+			 (sizeof((x) + 0) == sizeof(long long) ? \
+			  Z_CBPRINTF_LAYOUT_LONG_LONG : Z_CBPRINTF_LAYOUT_NONE))))
+
+#define Z_CBPRINTF_LAYOUT_ARG(idx, x) \
+	(Z_CBPRINTF_LAYOUT_CLASS(x) == Z_CBPRINTF_LAYOUT_NONE ? Z_CBPRINTF_LAYOUT_NONE : \
+	 ((uint32_t)Z_CBPRINTF_LAYOUT_CLASS(x) << \
+	  (Z_CBPRINTF_LAYOUT_CLASS_BITS * MIN(idx, Z_CBPRINTF_LAYOUT_MAX_ARGS - 1))))
+
+#define Z_CBPRINTF_LAYOUT_ARGS(...) \
+	(FOR_EACH_IDX(Z_CBPRINTF_LAYOUT_ARG, (|), __VA_ARGS__))
+
+/** @brief Compute package layout from the types of the arguments.
+ *
+ * @param ... String with arguments (fmt, ...).
+ *
+ * @return Layout as a constant expression.
+ */
+#define Z_CBPRINTF_PACKAGE_LAYOUT(...) \
+	COND_CODE_0(NUM_VA_ARGS_LESS_1(__VA_ARGS__), \
+		    (0U), \
+		    ((NUM_VA_ARGS_LESS_1(__VA_ARGS__) > Z_CBPRINTF_LAYOUT_MAX_ARGS) ? \
+		     Z_CBPRINTF_LAYOUT_NONE : \
+		     Z_CBPRINTF_LAYOUT_ARGS(GET_ARGS_LESS_N(1, __VA_ARGS__))))
+#else
+#define Z_CBPRINTF_PACKAGE_LAYOUT(...) Z_CBPRINTF_LAYOUT_NONE
+#endif
+
 /** @brief Get storage size for given argument.
  *
  * Floats are promoted to double so they use size of double, others int storage
@@ -108,6 +108,51 @@ uint32_t sys_hash32_djb2(const void *str, size_t n);
  */
 uint32_t sys_hash32_murmur3(const void *str, size_t n);
 
+/** @brief Initial value of an incremental FNV-1a hash (the FNV offset basis) */
+#define SYS_HASH32_FNV1A_INIT 2166136261U
+
+/**
+ * @brief Update a 32-bit Fowler-Noll-Vo (FNV-1a) hash
+ *
+ * Hashes data given in several pieces, starting from @ref SYS_HASH32_FNV1A_INIT.
+ * The result is the same as hashing the concatenation of the pieces with
+ * @ref sys_hash32_fnv1a.
+ *
+ * @param hash the hash of the previous pieces
+ * @param str a string of input data
+ * @param n the number of bytes in @p str
+ *
+ * @return the numeric hash associated with the previous pieces and @p str
+ */
+static inline uint32_t sys_hash32_fnv1a_update(uint32_t hash, const void *str, size_t n)
+{
+	const uint8_t *p = str;
+
+	for (size_t i = 0; i < n; i++) {
+		hash = (hash ^ p[i]) * 16777619U;
+	}
+
+	return hash;
+}
+
+/**
+ * @brief Fowler-Noll-Vo (FNV-1a) hash function
+ *
+ * A small and fast hash function for short keys. It is implemented as a
+ * static inline function.
+ *
+ * @param str a string of input data
+ * @param n the number of bytes in @p str
+ *
+ * @return the numeric hash associated with @p str
+ *
+ * @see http://www.isthe.com/chongo/tech/comp/fnv/
+ */
+static inline uint32_t sys_hash32_fnv1a(const void *str, size_t n)
+{
+	return sys_hash32_fnv1a_update(SYS_HASH32_FNV1A_INIT, str, n);
+}
+
 /**
  * @brief System default 32-bit hash function
  *
@@ -130,6 +175,10 @@ static inline uint32_t sys_hash32(const void *str, size_t n)
 		return sys_hash32_murmur3(str, n);
 	}
 
+	if (IS_ENABLED(CONFIG_SYS_HASH_FUNC32_CHOICE_FNV1A)) {
+		return sys_hash32_fnv1a(str, n);
+	}
+
 	__ASSERT(0, "No default 32-bit hash. See CONFIG_SYS_HASH_FUNC32_CHOICE");
 
 	return 0;
@@ -180,6 +180,18 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 void mpsc_pbuf_commit(struct mpsc_pbuf_buffer *buffer,
 			union mpsc_pbuf_generic *packet);
 
+/** @brief Discard a packet.
+ *
+ * Packet is released without being committed. Space is reclaimed when the
+ * consumer reaches the packet.
+ *
+ * @param buffer Buffer.
+ *
+ * @param packet Pointer to a packet allocated by @ref mpsc_pbuf_alloc.
+ */
+void mpsc_pbuf_discard(struct mpsc_pbuf_buffer *buffer,
+		       union mpsc_pbuf_generic *packet);
+
 /** @brief Put single word packet into a buffer.
  *
  * Function is optimized for storing a packet which fit into a single word.
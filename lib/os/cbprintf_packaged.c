@@ -827,6 +827,126 @@ int cbprintf_package(void *packaged, size_t len, uint32_t flags,
 	return ret;
 }
 
+int cbvprintf_package_layout(void *packaged, size_t len, uint32_t flags,
+			     uint32_t layout, const char *fmt, va_list ap)
+{
+	uint8_t *buf0 = packaged;
+	union cbprintf_package_hdr *pkg_hdr = packaged;
+	/* Format string is the only string, it is always read-only. */
+	unsigned int ro_cnt = (flags & CBPRINTF_PACKAGE_ADD_RO_STR_POS) ? 1 : 0;
+	uintptr_t start = (buf0 != NULL) ? (uintptr_t)buf0 : len % CBPRINTF_PACKAGE_ALIGNMENT;
+	uintptr_t pos = start;
+	unsigned int size;
+	unsigned int align;
+
+	if ((layout & Z_CBPRINTF_LAYOUT_NONE) ||
+	    ((flags & CBPRINTF_PACKAGE_ARGS_ARE_TAGGED) == CBPRINTF_PACKAGE_ARGS_ARE_TAGGED)) {
+		return cbvprintf_package(packaged, len, flags, fmt, ap);
+	}
+
+	/* Buffer must be aligned at least to size of a pointer. */
+	if ((uintptr_t)packaged % sizeof(void *)) {
+		return -EFAULT;
+	}
+
+#if defined(__xtensa__)
+	/* Xtensa requires package to be 16 bytes aligned. */
+	if ((uintptr_t)packaged % CBPRINTF_PACKAGE_ALIGNMENT) {
+		return -EFAULT;
+	}
+#endif
+
+	pos += sizeof(*pkg_hdr);
+	if (buf0 != NULL) {
+		if ((pos - start + sizeof(char *)) > len) {
+			return -ENOSPC;
+		}
+		*(const char **)pos = fmt;
+	}
+	pos += sizeof(char *);
+
+	for (; layout != 0U; layout >>= Z_CBPRINTF_LAYOUT_CLASS_BITS) {
+		switch (layout & Z_CBPRINTF_LAYOUT_CLASS_MASK) {
+		case Z_CBPRINTF_LAYOUT_INT:
+			align = VA_STACK_ALIGN(int);
+			size = sizeof(int);
+			break;
+		case Z_CBPRINTF_LAYOUT_LONG_LONG:
+			align = VA_STACK_ALIGN(long long);
+			size = sizeof(long long);
+			break;
+		default:
+			align = VA_STACK_ALIGN(double);
+			size = sizeof(double);
+			break;
+		}
+
+		pos = ROUND_UP(pos, align);
+
+		if (buf0 == NULL) {
+			pos += size;
+			continue;
+		}
+
+		if ((pos - start + size) > len) {
+			return -ENOSPC;
+		}
+
+		if (size == sizeof(int)) {
+			*(int *)pos = va_arg(ap, int);
+		} else if ((layout & Z_CBPRINTF_LAYOUT_CLASS_MASK) == Z_CBPRINTF_LAYOUT_LONG_LONG) {
+			long long v = va_arg(ap, long long);
+
+			if (Z_CBPRINTF_VA_STACK_LL_DBL_MEMCPY) {
+				memcpy((void *)pos, (uint8_t *)&v, sizeof(long long));
+			} else {
+				*(long long *)pos = v;
+			}
+		} else {
+			double v = va_arg(ap, double);
+
+			if (Z_CBPRINTF_VA_STACK_LL_DBL_MEMCPY) {
+				memcpy((void *)pos, (uint8_t *)&v, sizeof(double));
+			} else {
+				*(double *)pos = v;
+			}
+		}
+		pos += size;
+	}
+
+	if (((pos - start) / sizeof(int)) > 255) {
+		__ASSERT(false, "too many format args");
+		return -EINVAL;
+	}
+
+	if (buf0 == NULL) {
+		return pos - start + ro_cnt;
+	}
+
+	if ((pos - start + ro_cnt) > len) {
+		return -ENOSPC;
+	}
+
+	/* Clear our buffer header. */
+	*(char **)buf0 = NULL;
+
+	pkg_hdr->desc.len = (pos - start) / sizeof(int);
+	pkg_hdr->desc.str_cnt = 0;
+	pkg_hdr->desc.ro_str_cnt = ro_cnt;
+	pkg_hdr->desc.rw_str_cnt = 0;
+
+#ifdef CONFIG_CBPRINTF_PACKAGE_HEADER_STORE_CREATION_FLAGS
+	pkg_hdr->desc.pkg_flags = flags;
+#endif
+
+	if (ro_cnt != 0U) {
+		/* Location of the format string pointer. */
+		*(uint8_t *)pos = sizeof(*pkg_hdr) / sizeof(int);
+	}
+
+	return pos - start + ro_cnt;
+}
+
 int cbpprintf_external(cbprintf_cb out,
 		       cbvprintf_external_formatter_func formatter,
 		       void *ctx, void *packaged)
@@ -421,6 +421,23 @@ void mpsc_pbuf_commit(struct mpsc_pbuf_buffer *buffer,
 	MPSC_PBUF_DBG(buffer, "committed %p", item);
 }
 
+void mpsc_pbuf_discard(struct mpsc_pbuf_buffer *buffer,
+		       union mpsc_pbuf_generic *item)
+{
+	uint32_t wlen = buffer->get_wlen(item);
+	union mpsc_pbuf_generic skip = {
+		.skip = { .valid = 0, .busy = 1, .len = wlen }
+	};
+
+	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+
+	/* Packet is converted to a skip packet which is dropped on claim. */
+	item->raw = skip.raw;
+	buffer->wr_idx = idx_inc(buffer, buffer->wr_idx, wlen);
+	k_spin_unlock(&buffer->lock, key);
+	MPSC_PBUF_DBG(buffer, "discarded %p", item);
+}
+
 void mpsc_pbuf_put_word_ext(struct mpsc_pbuf_buffer *buffer,
 			    const union mpsc_pbuf_generic item,
 			    const void *data)
@@ -14,6 +14,7 @@
 #include <zephyr/posix/netinet/in.h>
 #include <zephyr/posix/net/if.h>
 #include <zephyr/posix/sys/socket.h>
+#include <zephyr/posix/sys/epoll.h>
 
 /* From arpa/inet.h */
 
@@ -355,6 +356,18 @@ ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
 	return zsock_recvmsg(sock, msg, flags);
 }
 
+int recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen, int flags,
+	     struct timespec *timeout)
+{
+	/* The receive timeout is taken from SO_RCVTIMEO instead */
+	if (timeout != NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 ssize_t send(int sock, const void *buf, size_t len, int flags)
 {
 	return zsock_send(sock, buf, len, flags);
@@ -365,6 +378,11 @@ ssize_t sendmsg(int sock, const struct msghdr *message, int flags)
 	return zsock_sendmsg(sock, message, flags);
 }
 
+int sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 ssize_t sendto(int sock, const void *buf, size_t len, int flags, const struct sockaddr *dest_addr,
 	       socklen_t addrlen)
 {
@@ -398,3 +416,22 @@ int socketpair(int family, int type, int proto, int sv[2])
 {
 	return zsock_socketpair(family, type, proto, sv);
 }
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+/* From sys/epoll.h */
+
+int epoll_create(int size)
+{
+	return zsock_epoll_create(size);
+}
+
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
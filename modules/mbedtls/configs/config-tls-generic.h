@@ -445,6 +445,14 @@
 #define MBEDTLS_SSL_CACHE_DEFAULT_MAX_ENTRIES CONFIG_MBEDTLS_SSL_CACHE_DEFAULT_MAX_ENTRIES
 #endif
 
+#if defined(CONFIG_MBEDTLS_SSL_SESSION_TICKETS)
+#define MBEDTLS_SSL_SESSION_TICKETS
+#endif
+
+#if defined(CONFIG_MBEDTLS_SSL_TICKET_C)
+#define MBEDTLS_SSL_TICKET_C
+#endif
+
 #if defined(CONFIG_MBEDTLS_SSL_EXTENDED_MASTER_SECRET)
 #define MBEDTLS_SSL_EXTENDED_MASTER_SECRET
 #endif
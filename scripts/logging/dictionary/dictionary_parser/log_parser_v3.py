@@ -46,6 +46,7 @@ FMT_MSG_HDR_64 = "BHHQ"
 # Message type
 # 0: normal message
 # 1: number of dropped messages
+# 2: frame of compact messages
 FMT_MSG_TYPE = "B"
 
 # Depends on CONFIG_LOG_TIMESTAMP_64BIT
@@ -55,10 +56,23 @@ FMT_MSG_TIMESTAMP_64 = "Q"
 # Keep message types in sync with include/logging/log_output_dict.h
 MSG_TYPE_NORMAL = 0
 MSG_TYPE_DROPPED = 1
+MSG_TYPE_COMPACT_FRAME = 2
 
 # Number of dropped messages
 FMT_DROPPED_CNT = "H"
 
+# Need to keep sync with struct log_dict_output_compact_frame_hdr_t in
+# include/logging/log_output_dict.h.
+#
+# struct log_dict_output_compact_frame_hdr_t {
+#     uint8_t type;
+#     uint16_t len;
+# } __packed;
+FMT_COMPACT_FRAME_LEN = "H"
+
+# Argument words of packages in compact messages
+FMT_PKG_WORD = "I"
+
 
 logger = logging.getLogger("parser")
 
@@ -77,6 +91,8 @@ class LogParserV3(LogParser):
 
         self.fmt_msg_type = endian + FMT_MSG_TYPE
         self.fmt_dropped_cnt = endian + FMT_DROPPED_CNT
+        self.fmt_compact_frame_len = endian + FMT_COMPACT_FRAME_LEN
+        self.fmt_pkg_word = endian + FMT_PKG_WORD
 
         if self.database.is_tgt_64bit():
             self.fmt_msg_hdr = endian + FMT_MSG_HDR_64
@@ -352,6 +368,112 @@ class LogParserV3(LogParser):
         return next_msg_offset
 
 
+    @staticmethod
+    def read_varint(data, offset):
+        """Read one unsigned LEB128 varint, return its value and the next offset"""
+        value = 0
+        shift = 0
+
+        while True:
+            byte = data[offset]
+            offset += 1
+            value |= (byte & 0x7F) << shift
+            shift += 7
+
+            if byte & 0x80 == 0:
+                return value, offset
+
+
+    def parse_one_compact_msg(self, logdata, offset, prev_timestamp):
+        """Parse one compact log message and print the encoded message.
+
+        The message is expanded to a normal message which is then parsed as
+        such. Returns the offset of the next message and the timestamp, or
+        None on error.
+        """
+        domain_lvl = logdata[offset]
+        offset += 1
+
+        domain_id = (domain_lvl >> 4) & 0x07
+        level = domain_lvl & 0x07
+
+        delta, offset = self.read_varint(logdata, offset)
+        source_id, offset = self.read_varint(logdata, offset)
+        pkg_len, offset = self.read_varint(logdata, offset)
+        data_len, offset = self.read_varint(logdata, offset)
+
+        # Zigzag encoded
+        delta = (delta >> 1) ^ -(delta & 1)
+        timestamp = prev_timestamp + delta
+
+        if "CONFIG_LOG_TIMESTAMP_64BIT" not in self.database.get_kconfigs():
+            timestamp &= 0xFFFFFFFF
+
+        # The words following the package descriptor up to the end of the
+        # arguments are varint encoded, the rest is copied as is.
+        pkg = bytearray()
+
+        if pkg_len >= struct.calcsize(self.fmt_pkg_word):
+            word_size = struct.calcsize(self.fmt_pkg_word)
+            num_words = min(logdata[offset], pkg_len // word_size)
+
+            pkg += logdata[offset:(offset + word_size)]
+            offset += word_size
+
+            for _ in range(1, num_words):
+                word, offset = self.read_varint(logdata, offset)
+                pkg += struct.pack(self.fmt_pkg_word, word)
+
+        tail_len = pkg_len - len(pkg)
+        pkg += logdata[offset:(offset + tail_len)]
+        offset += tail_len
+
+        extra_data = logdata[offset:(offset + data_len)]
+        offset += data_len
+
+        if self.is_big_endian:
+            domain_lvl = (domain_id << 4) | level
+        else:
+            domain_lvl = (level << 4) | domain_id
+
+        msg = struct.pack(self.fmt_msg_hdr, domain_lvl, pkg_len, data_len, source_id)
+        msg += struct.pack(self.fmt_msg_timestamp, timestamp)
+        msg += pkg + extra_data
+
+        if self.parse_one_normal_msg(msg, 0) is None:
+            return None
+
+        return offset, timestamp
+
+
+    def parse_compact_frame(self, logdata, offset):
+        """Parse one frame of compact log messages"""
+        frame_len = struct.unpack_from(self.fmt_compact_frame_len, logdata, offset)[0]
+        offset += struct.calcsize(self.fmt_compact_frame_len)
+
+        end = offset + frame_len
+        if end > len(logdata):
+            logger.error("------ Truncated frame of compact messages")
+            return None
+
+        # The first message of a frame has an absolute timestamp
+        timestamp = 0
+
+        while offset < end:
+            try:
+                ret = self.parse_one_compact_msg(logdata[:end], offset, timestamp)
+            except IndexError:
+                logger.error("------ Truncated compact message")
+                ret = None
+
+            if ret is None:
+                return None
+
+            offset, timestamp = ret
+
+        return offset
+
+
     def parse_log_data(self, logdata, debug=False):
         """Parse binary log data and print the encoded log messages"""
         offset = 0
@@ -374,6 +496,13 @@ class LogParserV3(LogParser):
 
                 offset = ret
 
+            elif msg_type == MSG_TYPE_COMPACT_FRAME:
+                ret = self.parse_compact_frame(logdata, offset)
+                if ret is None:
+                    return False
+
+                offset = ret
+
             else:
                 logger.error("------ Unknown message type: %s", msg_type)
                 return False
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Tests for the LatencyCollector class of func_latency.py
+"""
+
+import os
+import sys
+
+ZEPHYR_BASE = os.getenv("ZEPHYR_BASE")
+sys.path.insert(0, os.path.join(ZEPHYR_BASE, "scripts/tracing"))
+
+from func_latency import LatencyCollector
+
+FUNC_A = 0x1000
+FUNC_B = 0x2000
+FUNC_C = 0x3000
+THREAD_1 = 0x20000100
+THREAD_2 = 0x20000200
+
+
+def feed(collector, events, stream_id=0):
+    for cycles, name, fields in events:
+        collector.event(stream_id, cycles, name, fields)
+
+
+def test_nested_calls():
+    """Nested calls are matched with their own entry"""
+    collector = LatencyCollector()
+
+    feed(collector, [
+        (0, "thread_switched_in", {"thread_id": THREAD_1}),
+        (100, "func_enter", {"func": FUNC_A}),
+        (200, "func_enter", {"func": FUNC_B}),
+        (250, "func_exit", {"func": FUNC_B}),
+        (300, "func_enter", {"func": FUNC_A}),
+        (320, "func_exit", {"func": FUNC_A}),
+        (400, "func_exit", {"func": FUNC_A}),
+    ])
+
+    assert collector.latencies[FUNC_A] == [20, 300]
+    assert collector.latencies[FUNC_B] == [50]
+    assert collector.unmatched == 0
+
+
+def test_unmatched_calls():
+    """Exits without entry and entries without exit are counted as unmatched"""
+    collector = LatencyCollector()
+
+    feed(collector, [
+        (0, "thread_switched_in", {"thread_id": THREAD_1}),
+        # Entered before the start of the trace.
+        (50, "func_exit", {"func": FUNC_C}),
+        (100, "func_enter", {"func": FUNC_A}),
+        # Left with longjmp() or exit event dropped.
+        (200, "func_enter", {"func": FUNC_B}),
+        (300, "func_exit", {"func": FUNC_A}),
+    ])
+
+    assert collector.latencies[FUNC_A] == [200]
+    assert FUNC_B not in collector.latencies
+    assert FUNC_C not in collector.latencies
+    assert collector.unmatched == 2
+
+
+def test_thread_switch():
+    """Calls are tracked per thread, including the time the thread is switched out"""
+    collector = LatencyCollector()
+
+    feed(collector, [
+        (0, "thread_switched_in", {"thread_id": THREAD_1}),
+        (100, "func_enter", {"func": FUNC_A}),
+        (200, "thread_switched_in", {"thread_id": THREAD_2}),
+        (210, "func_enter", {"func": FUNC_A}),
+        (230, "func_exit", {"func": FUNC_A}),
+        (300, "thread_switched_in", {"thread_id": THREAD_1}),
+        (400, "func_exit", {"func": FUNC_A}),
+    ])
+
+    assert collector.latencies[FUNC_A] == [20, 300]
+    assert collector.unmatched == 0
+
+
+def test_isr_calls():
+    """Calls made from interrupts do not match calls of the interrupted thread"""
+    collector = LatencyCollector()
+
+    feed(collector, [
+        (0, "thread_switched_in", {"thread_id": THREAD_1}),
+        (100, "func_enter", {"func": FUNC_A}),
+        (150, "isr_enter", {}),
+        (160, "func_enter", {"func": FUNC_A}),
+        (170, "isr_enter", {}),
+        (175, "func_enter", {"func": FUNC_C}),
+        (180, "func_exit", {"func": FUNC_C}),
+        (185, "isr_exit", {}),
+        (190, "func_exit", {"func": FUNC_A}),
+        (200, "isr_exit_to_scheduler", {}),
+        (300, "func_exit", {"func": FUNC_A}),
+    ])
+
+    assert collector.latencies[FUNC_A] == [30, 200]
+    assert collector.latencies[FUNC_C] == [5]
+    assert collector.unmatched == 0
+
+
+def test_streams_and_frequency():
+    """Streams are tracked separately and timestamps are scaled by their frequency"""
+    collector = LatencyCollector()
+
+    feed(collector, [
+        (0, "clock_sync", {"frequency": 1000000}),
+        (0, "thread_switched_in", {"thread_id": THREAD_1}),
+        (10, "func_enter", {"func": FUNC_A}),
+    ], stream_id=0)
+    feed(collector, [
+        (0, "thread_switched_in", {"thread_id": THREAD_1}),
+        (500, "func_exit", {"func": FUNC_A}),
+    ], stream_id=1)
+    feed(collector, [
+        (30, "func_exit", {"func": FUNC_A}),
+    ], stream_id=0)
+
+    assert collector.latencies[FUNC_A] == [20000]
+    assert collector.unmatched == 1
@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Script to compute the latency of the functions traced with
+CONFIG_TRACING_FUNCTIONS from CTF data, and print a summary and the latency
+histogram of each function.
+
+The latency of a call is the time between the func_enter and the func_exit
+events, including the time the calling thread was preempted or blocked.
+Calls are tracked per thread, using the thread_switched_in events, and per
+stream, so traces split with split_cpu_streams.py are supported. Calls made
+from interrupts are tracked separately when CONFIG_TRACING_ISR is enabled.
+
+    mkdir ctf
+    cp build/channel0_0 ctf/
+    cp subsys/tracing/ctf/tsdl/metadata ctf/
+    ./scripts/tracing/func_latency.py -t ctf -e build/zephyr/zephyr.elf
+"""
+
+import sys
+import argparse
+from collections import defaultdict
+
+NSEC_PER_SEC = 1000000000
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+            description=__doc__,
+            formatter_class=argparse.RawDescriptionHelpFormatter, allow_abbrev=False)
+    parser.add_argument("-t", "--trace",
+            required=True,
+            help="tracing data (directory with metadata and trace file)")
+    parser.add_argument("-e", "--elf",
+            help="ELF file used to resolve the function names")
+    parser.add_argument("-f", "--function", action="append",
+            help="only report the given function, can be repeated")
+    parser.add_argument("--histogram", action="store_true",
+            help="print the latency histogram of each function")
+    args = parser.parse_args()
+    return args
+
+def load_symbols(elf_path):
+    try:
+        from elftools.elf.elffile import ELFFile
+        from elftools.elf.sections import SymbolTableSection
+    except ImportError:
+        sys.exit("Missing dependency: You need to install pyelftools.")
+
+    symbols = {}
+
+    with open(elf_path, "rb") as f:
+        elf = ELFFile(f)
+        for section in elf.iter_sections():
+            if not isinstance(section, SymbolTableSection):
+                continue
+
+            for sym in section.iter_symbols():
+                if sym['st_info']['type'] == 'STT_FUNC':
+                    # Events only carry the 32 low bits of the address, the
+                    # Thumb bit is kept as the compiler passes it.
+                    symbols[sym['st_value'] & 0xFFFFFFFF] = sym.name
+
+    return symbols
+
+class Stream:
+    def __init__(self):
+        self.frequency = NSEC_PER_SEC
+        self.thread = None
+        self.isr_depth = 0
+        self.calls = defaultdict(list)
+
+    def context(self):
+        return "isr" if self.isr_depth > 0 else self.thread
+
+class LatencyCollector:
+    def __init__(self):
+        self.streams = defaultdict(Stream)
+        self.latencies = defaultdict(list)
+        self.unmatched = 0
+
+    def event(self, stream_id, cycles, name, fields):
+        stream = self.streams[stream_id]
+
+        if name == "clock_sync":
+            stream.frequency = fields["frequency"]
+        elif name == "thread_switched_in":
+            stream.thread = fields["thread_id"]
+        elif name == "isr_enter":
+            stream.isr_depth += 1
+        elif name in ["isr_exit", "isr_exit_to_scheduler"]:
+            stream.isr_depth = max(stream.isr_depth - 1, 0)
+        elif name == "func_enter":
+            ns = cycles * NSEC_PER_SEC // stream.frequency
+            stream.calls[stream.context()].append((fields["func"], ns))
+        elif name == "func_exit":
+            ns = cycles * NSEC_PER_SEC // stream.frequency
+            self.func_exit(stream.calls[stream.context()], fields["func"], ns)
+
+    def func_exit(self, calls, func, ns):
+        # Calls which did not return normally, e.g. because of longjmp(), or
+        # whose events were dropped, are discarded.
+        for i in range(len(calls) - 1, -1, -1):
+            if calls[i][0] == func:
+                self.latencies[func].append(ns - calls[i][1])
+                self.unmatched += len(calls) - i - 1
+                del calls[i:]
+                return
+
+        # Function entered before the start of the trace.
+        self.unmatched += 1
+
+def read_trace(path, collector):
+    try:
+        import bt2
+    except ImportError:
+        sys.exit("Missing dependency: You need to install python bindings of babeltrace.")
+
+    msg_it = bt2.TraceCollectionMessageIterator(path)
+
+    for msg in msg_it:
+        if not isinstance(msg, bt2._EventMessageConst):
+            continue
+
+        event = msg.event
+        # The timestamp field of the event header is mapped to the clock
+        # declared in the metadata, its value is the raw timestamp extended
+        # when it wraps around.
+        cycles = msg.default_clock_snapshot.value
+        fields = {k: int(v) for k, v in event.payload_field.items()
+                  if isinstance(v, bt2._IntegerFieldConst)}
+
+        collector.event(event.stream.addr, cycles, event.name, fields)
+
+def percentile(values, pct):
+    return values[min(len(values) - 1, (len(values) * pct) // 100)]
+
+def print_histogram(values):
+    buckets = defaultdict(int)
+
+    for ns in values:
+        buckets[max(ns // 1000, 1).bit_length() - 1] += 1
+
+    peak = max(buckets.values())
+    for bucket in range(min(buckets), max(buckets) + 1):
+        count = buckets.get(bucket, 0)
+        bar = "#" * ((count * 40 + peak - 1) // peak)
+        print(f"    [{1 << bucket:>8}, {2 << bucket:>8}) us |{bar:<40}| {count}")
+
+def main():
+    args = parse_args()
+
+    symbols = load_symbols(args.elf) if args.elf else {}
+    collector = LatencyCollector()
+    read_trace(args.trace, collector)
+
+    def func_name(func):
+        return symbols.get(func, f"0x{func:08x}")
+
+    results = []
+    for func, values in collector.latencies.items():
+        name = func_name(func)
+        if args.function and name not in args.function:
+            continue
+        results.append((sum(values), name, sorted(values)))
+
+    results.sort(reverse=True)
+
+    print(f"{'function':<40} {'calls':>8} {'total_us':>10} {'min_us':>8} {'avg_us':>8} "
+          f"{'p50_us':>8} {'p99_us':>8} {'max_us':>8}")
+
+    for total, name, values in results:
+        print(f"{name[:40]:<40} {len(values):>8} {total / 1000:>10.1f} "
+              f"{values[0] / 1000:>8.1f} {total / len(values) / 1000:>8.1f} "
+              f"{percentile(values, 50) / 1000:>8.1f} {percentile(values, 99) / 1000:>8.1f} "
+              f"{values[-1] / 1000:>8.1f}")
+
+        if args.histogram:
+            print_histogram(values)
+
+    if collector.unmatched:
+        print(f"{collector.unmatched} function events without a matching event were ignored")
+
+if __name__=="__main__":
+    main()
@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Script to split tracing data captured with CONFIG_TRACING_PER_CPU_BUFFERS
+in one stream per CPU.
+
+The data of each CPU is output in chunks, each starting with the 0xC5 byte,
+the CPU index and the 16-bit little endian length of the chunk. The data of
+CPU n is written to the channel0_<n> file of the output directory, which
+can then be used as a CTF trace with the metadata file:
+
+    ./scripts/tracing/split_cpu_streams.py channel0 -o ctf
+    cp subsys/tracing/ctf/tsdl/metadata ctf/
+    ./scripts/tracing/parse_ctf.py -t ctf
+"""
+
+import os
+import sys
+import argparse
+
+CHUNK_MAGIC = 0xC5
+CHUNK_HDR_LEN = 4
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+            description=__doc__,
+            formatter_class=argparse.RawDescriptionHelpFormatter, allow_abbrev=False)
+    parser.add_argument("input", help="captured tracing data")
+    parser.add_argument("-o", "--output", default=".",
+            help="output directory for the per-CPU streams")
+    args = parser.parse_args()
+    return args
+
+def main():
+    args = parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    os.makedirs(args.output, exist_ok=True)
+
+    streams = {}
+    offset = 0
+
+    while offset + CHUNK_HDR_LEN <= len(data):
+        if data[offset] != CHUNK_MAGIC:
+            sys.exit(f"Invalid chunk header at offset {offset}")
+
+        cpu = data[offset + 1]
+        length = data[offset + 2] | (data[offset + 3] << 8)
+        offset += CHUNK_HDR_LEN
+
+        if cpu not in streams:
+            streams[cpu] = open(os.path.join(args.output, f"channel0_{cpu}"), "wb")
+
+        streams[cpu].write(data[offset:offset + length])
+        offset += length
+
+    if offset < len(data):
+        print(f"Ignoring {len(data) - offset} trailing bytes")
+
+    for cpu, stream in sorted(streams.items()):
+        print(f"CPU {cpu}: {stream.tell()} bytes")
+        stream.close()
+
+if __name__=="__main__":
+    main()
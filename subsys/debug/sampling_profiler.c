@@ -0,0 +1,324 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Statistical sampling profiler
+ *
+ *  A periodic interrupt stores the call stack of the interrupted thread in a
+ *  lock-free buffer of the CPU which handles it. Buffered samples are
+ *  aggregated from the system work queue into a fixed size hash table of
+ *  unique call stacks.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/counter.h>
+#include <zephyr/debug/sampling_profiler.h>
+#include <zephyr/debug/symtab.h>
+#include <zephyr/sys/hash_function.h>
+#include <zephyr/sys/spsc_lockfree.h>
+
+#define STACK_DEPTH CONFIG_SAMPLING_PROFILER_STACK_DEPTH
+#define N_STACKS CONFIG_SAMPLING_PROFILER_STACKS
+#define BUF_SIZE CONFIG_SAMPLING_PROFILER_BUFFER_SIZE
+
+BUILD_ASSERT(IS_POWER_OF_TWO(BUF_SIZE), "Buffer size must be a power of two");
+
+struct sample {
+	const struct k_thread *thread;
+	uint8_t depth;
+	uintptr_t addr[STACK_DEPTH];
+};
+
+static struct sample sample_buf[CONFIG_MP_MAX_NUM_CPUS][BUF_SIZE];
+
+#define SAMPLE_Q_INIT(i, _) SPSC_INITIALIZER(BUF_SIZE, sample_buf[i])
+
+/* The sampling interrupt is the only producer of the queue of the CPU which
+ * handles it and the aggregation, done with the lock held, the only consumer.
+ */
+SPSC_DECLARE(sample_q, struct sample) sample_q[CONFIG_MP_MAX_NUM_CPUS] = {
+	LISTIFY(CONFIG_MP_MAX_NUM_CPUS, SAMPLE_Q_INIT, (,))
+};
+
+static struct sampling_profiler_stack stacks[N_STACKS];
+static K_MUTEX_DEFINE(lock);
+static bool running;
+static uint32_t samples;
+static uint32_t lost;
+static uint32_t stack_cnt;
+static atomic_t dropped;
+
+static void process_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(process_work, process_work_handler);
+
+static void sample(void)
+{
+	struct spsc_sample_q *q = &sample_q[arch_curr_cpu()->id];
+	struct sample *s = spsc_acquire(q);
+
+	if (s == NULL) {
+		atomic_inc(&dropped);
+		return;
+	}
+
+	s->depth = arch_interrupted_stack_trace(s->addr, STACK_DEPTH);
+	s->thread = (s->depth > 0) ? _current : NULL;
+	spsc_produce(q);
+}
+
+#if defined(CONFIG_SAMPLING_PROFILER_SOURCE_TIMER)
+
+static void sample_timer_expiry(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	sample();
+}
+
+static K_TIMER_DEFINE(sample_timer, sample_timer_expiry, NULL);
+
+static int source_start(uint32_t freq)
+{
+	if (freq > CONFIG_SYS_CLOCK_TICKS_PER_SEC) {
+		return -EINVAL;
+	}
+
+	k_timer_start(&sample_timer, K_USEC(USEC_PER_SEC / freq), K_USEC(USEC_PER_SEC / freq));
+
+	return 0;
+}
+
+static void source_stop(void)
+{
+	k_timer_stop(&sample_timer);
+}
+
+#elif defined(CONFIG_SAMPLING_PROFILER_SOURCE_COUNTER)
+
+static const struct device *const counter_dev =
+	DEVICE_DT_GET(DT_CHOSEN(zephyr_sampling_profiler_counter));
+
+static void sample_counter_top(const struct device *dev, void *user_data)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(user_data);
+
+	sample();
+}
+
+static int source_start(uint32_t freq)
+{
+	struct counter_top_cfg cfg = {
+		.callback = sample_counter_top,
+	};
+	int err;
+
+	if (!device_is_ready(counter_dev)) {
+		return -ENODEV;
+	}
+
+	cfg.ticks = counter_us_to_ticks(counter_dev, USEC_PER_SEC / freq);
+	if (cfg.ticks == 0) {
+		return -EINVAL;
+	}
+
+	err = counter_set_top_value(counter_dev, &cfg);
+	if (err < 0) {
+		return err;
+	}
+
+	return counter_start(counter_dev);
+}
+
+static void source_stop(void)
+{
+	(void)counter_stop(counter_dev);
+}
+
+#endif /* CONFIG_SAMPLING_PROFILER_SOURCE_TIMER */
+
+static uint32_t sample_hash(const struct sample *s)
+{
+	uint32_t hash = sys_hash32_fnv1a(&s->thread, sizeof(s->thread));
+
+	return sys_hash32_fnv1a_update(hash, s->addr, s->depth * sizeof(s->addr[0]));
+}
+
+static bool stack_match(const struct sampling_profiler_stack *stack, const struct sample *s)
+{
+	return (stack->thread == s->thread) && (stack->depth == s->depth) &&
+	       (memcmp(stack->addr, s->addr, s->depth * sizeof(s->addr[0])) == 0);
+}
+
+/* Called with the lock held. */
+static void sample_add(struct sample *s)
+{
+	struct sampling_profiler_stack *stack;
+	uint32_t offset;
+	uint32_t idx;
+
+	/* Samples in the same function are counted together. */
+	for (uint8_t i = 0; i < s->depth; i++) {
+		offset = 0;
+		(void)symtab_find_symbol_name(s->addr[i], &offset);
+		s->addr[i] -= offset;
+	}
+
+	idx = sample_hash(s) % N_STACKS;
+	for (uint32_t i = 0; i < N_STACKS; i++) {
+		stack = &stacks[(idx + i) % N_STACKS];
+
+		if (stack->count == 0) {
+			stack->thread = s->thread;
+			stack->depth = s->depth;
+			memcpy(stack->addr, s->addr, s->depth * sizeof(s->addr[0]));
+			stack_cnt++;
+		} else if (!stack_match(stack, s)) {
+			continue;
+		}
+
+		stack->count++;
+		samples++;
+		return;
+	}
+
+	lost++;
+}
+
+/* Called with the lock held. */
+static void samples_consume(bool discard)
+{
+	struct sample *s;
+
+	for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		while ((s = spsc_consume(&sample_q[cpu])) != NULL) {
+			if (!discard) {
+				sample_add(s);
+			}
+			spsc_release(&sample_q[cpu]);
+		}
+	}
+}
+
+static void process_work_handler(struct k_work *work)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	samples_consume(false);
+
+	if (running) {
+		k_work_reschedule(k_work_delayable_from_work(work),
+				  K_MSEC(CONFIG_SAMPLING_PROFILER_PROCESS_INTERVAL));
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+int sampling_profiler_start(uint32_t freq)
+{
+	int err;
+
+	if (freq == 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (running) {
+		err = -EALREADY;
+	} else {
+		err = source_start(freq);
+		if (err == 0) {
+			running = true;
+			k_work_reschedule(&process_work,
+					  K_MSEC(CONFIG_SAMPLING_PROFILER_PROCESS_INTERVAL));
+		}
+	}
+
+	k_mutex_unlock(&lock);
+
+	return err;
+}
+
+int sampling_profiler_stop(void)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (!running) {
+		k_mutex_unlock(&lock);
+		return -EALREADY;
+	}
+
+	source_stop();
+	running = false;
+	(void)k_work_cancel_delayable(&process_work);
+	samples_consume(false);
+
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+bool sampling_profiler_is_running(void)
+{
+	return running;
+}
+
+void sampling_profiler_reset(void)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	samples_consume(true);
+	memset(stacks, 0, sizeof(stacks));
+	samples = 0;
+	lost = 0;
+	stack_cnt = 0;
+	atomic_clear(&dropped);
+
+	k_mutex_unlock(&lock);
+}
+
+void sampling_profiler_process(void)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	samples_consume(false);
+	k_mutex_unlock(&lock);
+}
+
+int sampling_profiler_foreach(sampling_profiler_cb_t cb, void *user_data)
+{
+	int cnt = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	samples_consume(false);
+
+	for (int i = 0; i < N_STACKS; i++) {
+		if (stacks[i].count > 0) {
+			cb(&stacks[i], user_data);
+			cnt++;
+		}
+	}
+
+	k_mutex_unlock(&lock);
+
+	return cnt;
+}
+
+void sampling_profiler_stats_get(struct sampling_profiler_stats *stats)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	samples_consume(false);
+	stats->samples = samples;
+	stats->dropped = (uint32_t)atomic_get(&dropped);
+	stats->lost = lost;
+	stats->stacks = stack_cnt;
+
+	k_mutex_unlock(&lock);
+}
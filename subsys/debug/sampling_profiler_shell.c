@@ -0,0 +1,246 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/debug/sampling_profiler.h>
+#include <zephyr/debug/symtab.h>
+
+#define DEFAULT_FREQ 100
+#define DEFAULT_TOP 10
+
+struct func_count {
+	uintptr_t addr;
+	uint32_t count;
+};
+
+struct top_ctx {
+	struct func_count funcs[CONFIG_SAMPLING_PROFILER_STACKS];
+	uint32_t len;
+	uint32_t total;
+};
+
+struct thread_lookup {
+	const struct k_thread *thread;
+	bool found;
+};
+
+static void thread_lookup_cb(const struct k_thread *thread, void *user_data)
+{
+	struct thread_lookup *lookup = user_data;
+
+	if (thread == lookup->thread) {
+		lookup->found = true;
+	}
+}
+
+static void thread_print(const struct shell *sh, const struct k_thread *thread)
+{
+	struct thread_lookup lookup = { .thread = thread };
+	const char *name = NULL;
+
+	if (thread == NULL) {
+		shell_fprintf(sh, SHELL_NORMAL, "[isr]");
+		return;
+	}
+
+	/* The thread may have been aborted since it was sampled. */
+	if (IS_ENABLED(CONFIG_THREAD_MONITOR)) {
+		k_thread_foreach_unlocked(thread_lookup_cb, &lookup);
+		if (lookup.found) {
+			name = k_thread_name_get((k_tid_t)thread);
+		}
+	}
+
+	if ((name != NULL) && (name[0] != '\0')) {
+		shell_fprintf(sh, SHELL_NORMAL, "%s", name);
+	} else {
+		shell_fprintf(sh, SHELL_NORMAL, "%p", (void *)thread);
+	}
+}
+
+static void func_print(const struct shell *sh, uintptr_t addr)
+{
+	const char *name;
+
+	if (addr == 0) {
+		shell_fprintf(sh, SHELL_NORMAL, "[isr]");
+		return;
+	}
+
+	name = symtab_find_symbol_name(addr, NULL);
+	if (strcmp(name, "?") != 0) {
+		shell_fprintf(sh, SHELL_NORMAL, "%s", name);
+	} else {
+		shell_fprintf(sh, SHELL_NORMAL, "0x%lx", (unsigned long)addr);
+	}
+}
+
+static int cmd_start(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t freq = DEFAULT_FREQ;
+	int err;
+
+	if (argc > 1) {
+		freq = (uint32_t)strtoul(argv[1], NULL, 0);
+	}
+
+	err = sampling_profiler_start(freq);
+	if (err < 0) {
+		shell_error(sh, "Failed to start (err: %d)", err);
+		return err;
+	}
+
+	shell_print(sh, "Sampling at %u Hz", freq);
+
+	return 0;
+}
+
+static int cmd_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (sampling_profiler_stop() < 0) {
+		shell_error(sh, "Profiler is not running");
+		return -EALREADY;
+	}
+
+	return 0;
+}
+
+static int cmd_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(sh);
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	sampling_profiler_reset();
+
+	return 0;
+}
+
+static int cmd_status(const struct shell *sh, size_t argc, char **argv)
+{
+	struct sampling_profiler_stats stats;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	sampling_profiler_stats_get(&stats);
+
+	shell_print(sh, "%s, samples: %u, dropped: %u, lost: %u, stacks: %u",
+		    sampling_profiler_is_running() ? "running" : "stopped",
+		    stats.samples, stats.dropped, stats.lost, stats.stacks);
+
+	return 0;
+}
+
+static void top_add(const struct sampling_profiler_stack *stack, void *user_data)
+{
+	struct top_ctx *ctx = user_data;
+	uintptr_t addr = (stack->depth > 0) ? stack->addr[0] : 0;
+	uint32_t i;
+
+	ctx->total += stack->count;
+
+	for (i = 0; i < ctx->len; i++) {
+		if (ctx->funcs[i].addr == addr) {
+			break;
+		}
+	}
+
+	if (i == ctx->len) {
+		ctx->funcs[ctx->len++] = (struct func_count){ .addr = addr };
+	}
+
+	ctx->funcs[i].count += stack->count;
+}
+
+static int cmd_top(const struct shell *sh, size_t argc, char **argv)
+{
+	static struct top_ctx ctx;
+	uint32_t n = DEFAULT_TOP;
+	struct func_count tmp;
+	uint32_t permille;
+
+	if (argc > 1) {
+		n = (uint32_t)strtoul(argv[1], NULL, 0);
+	}
+
+	ctx.len = 0;
+	ctx.total = 0;
+	(void)sampling_profiler_foreach(top_add, &ctx);
+
+	if (ctx.total == 0) {
+		shell_print(sh, "No samples");
+		return 0;
+	}
+
+	n = MIN(n, ctx.len);
+	shell_print(sh, "samples      %%  function");
+
+	for (uint32_t i = 0; i < n; i++) {
+		/* Partial selection sort, only the top entries are ordered. */
+		for (uint32_t j = i + 1; j < ctx.len; j++) {
+			if (ctx.funcs[j].count > ctx.funcs[i].count) {
+				tmp = ctx.funcs[i];
+				ctx.funcs[i] = ctx.funcs[j];
+				ctx.funcs[j] = tmp;
+			}
+		}
+
+		permille = (uint32_t)(((uint64_t)ctx.funcs[i].count * 1000U) / ctx.total);
+
+		shell_fprintf(sh, SHELL_NORMAL, "%7u  %3u.%u  ", ctx.funcs[i].count,
+			      permille / 10U, permille % 10U);
+		func_print(sh, ctx.funcs[i].addr);
+		shell_fprintf(sh, SHELL_NORMAL, "\n");
+	}
+
+	return 0;
+}
+
+static void collapsed_print(const struct sampling_profiler_stack *stack, void *user_data)
+{
+	const struct shell *sh = user_data;
+
+	/* Frames are printed from the outermost caller to the sampled function. */
+	thread_print(sh, stack->thread);
+	for (int i = stack->depth - 1; i >= 0; i--) {
+		shell_fprintf(sh, SHELL_NORMAL, ";");
+		func_print(sh, stack->addr[i]);
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, " %u\n", stack->count);
+}
+
+static int cmd_collapsed(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	(void)sampling_profiler_foreach(collapsed_print, (void *)sh);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_profiler,
+	SHELL_CMD_ARG(start, NULL, "Start sampling\n"
+				   "usage: start [<frequency in Hz>]", cmd_start, 1, 1),
+	SHELL_CMD_ARG(stop, NULL, "Stop sampling", cmd_stop, 1, 0),
+	SHELL_CMD_ARG(reset, NULL, "Discard the samples", cmd_reset, 1, 0),
+	SHELL_CMD_ARG(status, NULL, "Print the profiler status", cmd_status, 1, 0),
+	SHELL_CMD_ARG(top, NULL, "Print the most sampled functions\n"
+				 "usage: top [<number of functions>]", cmd_top, 1, 1),
+	SHELL_CMD_ARG(collapsed, NULL, "Print the call stacks in the collapsed format",
+		      cmd_collapsed, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(profiler, &sub_profiler, "Sampling profiler commands", NULL);
@@ -0,0 +1,515 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ * @brief Retained memory (flight recorder) backend.
+ *
+ * Log messages are copied in binary form to a ring located in a retention
+ * area. Area starts with a header which is followed by the ring of records.
+ * Each record starts with a 32 bit word which holds the record type and length
+ * of the message which follows. Header is updated after the record is written
+ * so the ring is consistent if reset occurs at any point. Oldest records are
+ * overwritten when there is no space for the new record.
+ *
+ * On initialization the ring is validated and messages from the previous boot
+ * are kept if the image has not changed, which is checked using a hash of its
+ * read-only data. A record which marks the reboot is then added.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/version.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/linker/linker-defs.h>
+#include <zephyr/retention/retention.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_backend_retention.h>
+#include <zephyr/logging/log_internal.h>
+
+#define RECORD_MAGIC 0xA5U
+#define RECORD_MSG 1U
+#define RECORD_BOOT 2U
+/* Remaining part of the ring is not used, next record is at the beginning. */
+#define RECORD_WRAP 3U
+
+#define RECORD_HDR(_type, _len) ((RECORD_MAGIC << 24) | ((_type) << 16) | (_len))
+#define RECORD_HDR_VALID(_hdr) (((_hdr) >> 24) == RECORD_MAGIC)
+#define RECORD_HDR_TYPE(_hdr) (((_hdr) >> 16) & 0xFFU)
+#define RECORD_HDR_LEN(_hdr) ((_hdr) & 0xFFFFU)
+
+#define MSG_MAX_SIZE CONFIG_LOG_BACKEND_RETENTION_MSG_MAX_SIZE
+
+#if defined(BUILD_VERSION) && !IS_EMPTY(BUILD_VERSION)
+#define IMAGE_VERSION STRINGIFY(BUILD_VERSION)
+#else
+#define IMAGE_VERSION KERNEL_VERSION_STRING
+#endif
+
+BUILD_ASSERT((MSG_MAX_SIZE % sizeof(uint32_t)) == 0);
+
+/* Header located at the beginning of the retention area. */
+struct ring_hdr {
+	/* Identifies the image which has written the records. */
+	uint32_t image_id;
+	/* Offset of the oldest record. */
+	uint32_t rd;
+	/* Offset at which the next record is written. */
+	uint32_t wr;
+	/* Number of bytes occupied by records, including unused end of the ring. */
+	uint32_t used;
+};
+
+static const struct device *const retention_dev =
+	DEVICE_DT_GET(DT_CHOSEN(zephyr_log_retention));
+
+static struct k_spinlock lock;
+static struct ring_hdr hdr;
+static uint32_t ring_size;
+static bool initialized;
+
+/* Number of bytes freed and written since boot. Used by the reader to detect
+ * that records were overwritten while it was iterating over the ring.
+ */
+static uint32_t rd_total;
+static uint32_t wr_total;
+/* Value of wr_total after the reboot record was written. */
+static uint32_t boot_total;
+
+static int ring_read(uint32_t off, void *buf, size_t len)
+{
+	return retention_read(retention_dev, sizeof(struct ring_hdr) + off, buf, len);
+}
+
+static int ring_write(uint32_t off, const void *buf, size_t len)
+{
+	return retention_write(retention_dev, sizeof(struct ring_hdr) + off, buf, len);
+}
+
+static int hdr_store(void)
+{
+	return retention_write(retention_dev, 0, (const uint8_t *)&hdr, sizeof(hdr));
+}
+
+static uint32_t ring_next(uint32_t off, uint32_t len)
+{
+	return ((off + len) == ring_size) ? 0 : (off + len);
+}
+
+#ifdef CONFIG_LOG_FMT_SECTION
+TYPE_SECTION_START_EXTERN(const char *, log_strings);
+TYPE_SECTION_END_EXTERN(const char *, log_strings);
+#endif
+
+static uint32_t region_hash(uint32_t id, const void *start, const void *end)
+{
+	uintptr_t bounds[] = { (uintptr_t)start, (uintptr_t)end };
+
+	id = crc32_ieee_update(id, (const uint8_t *)bounds, sizeof(bounds));
+
+	return crc32_ieee_update(id, (const uint8_t *)start,
+				 (const uint8_t *)end - (const uint8_t *)start);
+}
+
+/* Records refer to format strings, string arguments and sources located in
+ * the read-only data of the image, so the content of these sections is hashed
+ * and not only their location. A new build which moves or changes any of
+ * them invalidates the ring.
+ */
+static uint32_t image_id(void)
+{
+	static const char version[] = IMAGE_VERSION;
+	uint32_t id = crc32_ieee((const uint8_t *)version, sizeof(version));
+
+	id = region_hash(id, TYPE_SECTION_START(log_const), TYPE_SECTION_END(log_const));
+#ifdef CONFIG_LOG_FMT_SECTION
+	id = region_hash(id, TYPE_SECTION_START(log_strings), TYPE_SECTION_END(log_strings));
+#endif
+#ifndef CONFIG_ARCH_POSIX
+	id = region_hash(id, __rodata_region_start, __rodata_region_end);
+#endif
+
+	return id;
+}
+
+static bool source_valid(const void *source)
+{
+	uintptr_t addr = (uintptr_t)source;
+	uintptr_t start = (uintptr_t)TYPE_SECTION_START(log_const);
+	uintptr_t end = (uintptr_t)TYPE_SECTION_END(log_const);
+
+	if ((source == NULL) ||
+	    ((addr >= start) && (addr < end) &&
+	     (((addr - start) % sizeof(struct log_source_const_data)) == 0))) {
+		return true;
+	}
+
+#ifdef CONFIG_LOG_RUNTIME_FILTERING
+	start = (uintptr_t)TYPE_SECTION_START(log_dynamic);
+	end = (uintptr_t)TYPE_SECTION_END(log_dynamic);
+
+	return (addr >= start) && (addr < end) &&
+	       (((addr - start) % sizeof(struct log_source_dynamic_data)) == 0);
+#else
+	return false;
+#endif
+}
+
+static bool msg_valid(struct log_msg *msg, uint32_t len)
+{
+	return (msg->hdr.desc.type == Z_LOG_MSG_LOG) &&
+	       ((log_msg_get_total_wlen(msg->hdr.desc) * sizeof(uint32_t)) == len) &&
+	       source_valid(log_msg_get_source(msg));
+}
+
+/* Read the header of the record at @p off.
+ *
+ * @return Space occupied by the record or negative error if record is corrupted.
+ */
+static int record_hdr_read(uint32_t off, uint32_t *rec)
+{
+	uint32_t len;
+	int err;
+
+	err = ring_read(off, rec, sizeof(*rec));
+	if (err < 0) {
+		return err;
+	}
+
+	if (!RECORD_HDR_VALID(*rec)) {
+		return -EBADMSG;
+	}
+
+	switch (RECORD_HDR_TYPE(*rec)) {
+	case RECORD_WRAP:
+		return ring_size - off;
+	case RECORD_BOOT:
+		return sizeof(*rec);
+	case RECORD_MSG:
+		len = RECORD_HDR_LEN(*rec);
+		if ((len < sizeof(struct log_msg)) || (len > MSG_MAX_SIZE) ||
+		    ((off + sizeof(*rec) + len) > ring_size)) {
+			return -EBADMSG;
+		}
+
+		return sizeof(*rec) + len;
+	default:
+		return -EBADMSG;
+	}
+}
+
+/* Read the record at @p off. Message is validated and copied to @p buf.
+ *
+ * @return Space occupied by the record or negative error if record is corrupted.
+ */
+static int record_read(uint32_t off, uint32_t *rec, uint8_t *buf)
+{
+	int len = record_hdr_read(off, rec);
+	int err;
+
+	if ((len < 0) || (RECORD_HDR_TYPE(*rec) != RECORD_MSG)) {
+		return len;
+	}
+
+	err = ring_read(off + sizeof(*rec), buf, RECORD_HDR_LEN(*rec));
+	if (err < 0) {
+		return err;
+	}
+
+	return msg_valid((struct log_msg *)buf, RECORD_HDR_LEN(*rec)) ? len : -EBADMSG;
+}
+
+/* Check that the header and all records in the ring are valid. */
+static bool ring_valid(uint32_t id)
+{
+	uint8_t buf[MSG_MAX_SIZE] __aligned(Z_LOG_MSG_ALIGNMENT);
+	uint32_t off = hdr.rd;
+	uint32_t left = hdr.used;
+	uint32_t rec;
+
+	if ((hdr.image_id != id) || (hdr.rd >= ring_size) || (hdr.wr >= ring_size) ||
+	    (hdr.used > ring_size) || ((hdr.rd % sizeof(uint32_t)) != 0) ||
+	    ((hdr.wr % sizeof(uint32_t)) != 0)) {
+		return false;
+	}
+
+	while (left > 0) {
+		int len = record_read(off, &rec, buf);
+
+		if ((len < 0) || ((uint32_t)len > left)) {
+			return false;
+		}
+
+		off = ring_next(off, len);
+		left -= len;
+	}
+
+	return off == hdr.wr;
+}
+
+/* Free the oldest record. */
+static int record_free(void)
+{
+	uint32_t rec;
+	int len = record_hdr_read(hdr.rd, &rec);
+
+	if (len < 0) {
+		return len;
+	}
+
+	hdr.rd = ring_next(hdr.rd, len);
+	hdr.used -= len;
+	rd_total += len;
+
+	return 0;
+}
+
+/* Free records which start in the given range. Header is stored before the
+ * records are overwritten.
+ */
+static int space_claim(uint32_t off, uint32_t len)
+{
+	bool freed = false;
+	int err;
+
+	while ((hdr.used > 0) && (hdr.rd >= off) && (hdr.rd < (off + len))) {
+		err = record_free();
+		if (err < 0) {
+			return err;
+		}
+
+		freed = true;
+	}
+
+	return freed ? hdr_store() : 0;
+}
+
+static int record_write(uint32_t rec, const void *data, uint32_t len)
+{
+	uint32_t space = sizeof(rec) + len;
+	int err;
+
+	if ((hdr.wr + space) > ring_size) {
+		uint32_t wrap = RECORD_HDR(RECORD_WRAP, 0);
+		uint32_t pad = ring_size - hdr.wr;
+
+		err = space_claim(hdr.wr, pad);
+		if (err < 0) {
+			return err;
+		}
+
+		err = ring_write(hdr.wr, &wrap, sizeof(wrap));
+		if (err < 0) {
+			return err;
+		}
+
+		hdr.wr = 0;
+		hdr.used += pad;
+		wr_total += pad;
+	}
+
+	err = space_claim(hdr.wr, space);
+	if (err < 0) {
+		return err;
+	}
+
+	err = ring_write(hdr.wr, &rec, sizeof(rec));
+	if ((err == 0) && (len > 0)) {
+		err = ring_write(hdr.wr + sizeof(rec), data, len);
+	}
+
+	if (err < 0) {
+		return err;
+	}
+
+	hdr.wr = ring_next(hdr.wr, space);
+	hdr.used += space;
+	wr_total += space;
+
+	return hdr_store();
+}
+
+static int ring_init(void)
+{
+	ssize_t size = retention_size(retention_dev);
+	uint32_t id = image_id();
+	bool valid = false;
+	int err;
+
+	if (size < 0) {
+		return (int)size;
+	}
+
+	/* At least two messages of the maximum size must fit. */
+	if ((size_t)size < (sizeof(hdr) + 2 * (sizeof(uint32_t) + MSG_MAX_SIZE))) {
+		return -ENOSPC;
+	}
+
+	ring_size = ROUND_DOWN(size - sizeof(hdr), sizeof(uint32_t));
+
+	err = retention_is_valid(retention_dev);
+	if ((err == 1) || (err == -ENOTSUP)) {
+		err = retention_read(retention_dev, 0, (uint8_t *)&hdr, sizeof(hdr));
+		if (err < 0) {
+			return err;
+		}
+
+		valid = ring_valid(id);
+	} else if (err < 0) {
+		return err;
+	}
+
+	if (!valid) {
+		hdr = (struct ring_hdr){ .image_id = id };
+	}
+
+	rd_total = 0;
+	wr_total = hdr.used;
+
+	err = record_write(RECORD_HDR(RECORD_BOOT, 0), NULL, 0);
+	boot_total = wr_total;
+
+	return err;
+}
+
+static void process(const struct log_backend *const backend,
+		    union log_msg_generic *msg)
+{
+	uint32_t len;
+	k_spinlock_key_t key;
+
+	/* Messages from other domains refer to data which is not in this image. */
+	if (!z_log_item_is_msg(msg) || !z_log_is_local_domain(log_msg_get_domain(&msg->log))) {
+		return;
+	}
+
+	len = log_msg_get_total_wlen(msg->log.hdr.desc) * sizeof(uint32_t);
+	if (len > MSG_MAX_SIZE) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	(void)record_write(RECORD_HDR(RECORD_MSG, len), msg, len);
+	k_spin_unlock(&lock, key);
+}
+
+static void panic(struct log_backend const *const backend)
+{
+	/* Messages are written synchronously, nothing to flush. */
+}
+
+static void init_retention(struct log_backend const *const backend)
+{
+	if (device_is_ready(retention_dev)) {
+		initialized = (ring_init() == 0);
+	}
+}
+
+static int is_ready(struct log_backend const *const backend)
+{
+	if (!initialized) {
+		init_retention(backend);
+	}
+
+	return initialized ? 0 : -EBUSY;
+}
+
+int log_backend_retention_foreach(log_backend_retention_cb_t cb, void *user_data)
+{
+	uint8_t buf[MSG_MAX_SIZE] __aligned(Z_LOG_MSG_ALIGNMENT);
+	struct log_msg *msg = (struct log_msg *)buf;
+	k_spinlock_key_t key;
+	uint32_t pos;
+	uint32_t end;
+	uint32_t off;
+	int cnt = 0;
+
+	if (!initialized) {
+		return -ENODEV;
+	}
+
+	key = k_spin_lock(&lock);
+	pos = rd_total;
+	off = hdr.rd;
+	end = wr_total;
+	k_spin_unlock(&lock, key);
+
+	/* Lock is held only while a single record is read. */
+	while ((int32_t)(end - pos) > 0) {
+		uint32_t rec;
+		bool prev_boot;
+		int len;
+
+		key = k_spin_lock(&lock);
+		if ((int32_t)(rd_total - pos) > 0) {
+			/* Records were overwritten in the meantime. */
+			pos = rd_total;
+			off = hdr.rd;
+		}
+
+		len = ((int32_t)(end - pos) > 0) ? record_read(off, &rec, buf) : 0;
+		k_spin_unlock(&lock, key);
+
+		if (len <= 0) {
+			return (len < 0) ? len : cnt;
+		}
+
+		prev_boot = (int32_t)(boot_total - pos) > 0;
+		pos += len;
+		off = ring_next(off, len);
+
+		if (RECORD_HDR_TYPE(rec) == RECORD_BOOT) {
+			cb(NULL, user_data);
+		} else if (RECORD_HDR_TYPE(rec) == RECORD_MSG) {
+#ifdef CONFIG_LOG_THREAD_ID_PREFIX
+			if (prev_boot) {
+				msg->hdr.tid = NULL;
+			}
+#else
+			ARG_UNUSED(prev_boot);
+#endif
+			cb(msg, user_data);
+			cnt++;
+		}
+	}
+
+	return cnt;
+}
+
+int log_backend_retention_clear(void)
+{
+	k_spinlock_key_t key;
+	int err;
+
+	if (!initialized) {
+		return -ENODEV;
+	}
+
+	key = k_spin_lock(&lock);
+	hdr.rd = hdr.wr;
+	hdr.used = 0;
+	rd_total = wr_total;
+	err = hdr_store();
+	k_spin_unlock(&lock, key);
+
+	return err;
+}
+
+const struct log_backend_api log_backend_retention_api = {
+	.process = process,
+	.panic = panic,
+	.init = init_retention,
+	.is_ready = is_ready,
+};
+
+LOG_BACKEND_DEFINE(log_backend_retention, log_backend_retention_api,
+		   IS_ENABLED(CONFIG_LOG_BACKEND_RETENTION_AUTOSTART));
+
+const struct log_backend *log_backend_retention_get(void)
+{
+	return &log_backend_retention;
+}
@@ -203,6 +203,11 @@ static void panic(struct log_backend const *const backend)
 #endif /* CONFIG_PM_DEVICE */
 
 	data->in_panic = true;
+
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_UART_OUTPUT_DICTIONARY)) {
+		log_dict_output_flush(ctx->output);
+	}
+
 	log_backend_std_panic(ctx->output);
 }
 
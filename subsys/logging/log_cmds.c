@@ -8,6 +8,9 @@
 #include <zephyr/logging/log_ctrl.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/logging/log_internal.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_backend_std.h>
+#include <zephyr/logging/log_backend_retention.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <string.h>
 
@@ -182,6 +185,9 @@ static void filters_set(const struct shell *sh,
 		shell_warn(sh, "Backend not active.");
 	}
 
+	/* Call sites are updated once all levels are set. */
+	z_log_call_sites_hold();
+
 	for (i = 0; i < cnt; i++) {
 		id = all ? i : module_id_get(argv[i]);
 		if (id >= 0) {
@@ -206,6 +212,8 @@ static void filters_set(const struct shell *sh,
 			shell_error(sh, "%s: unknown source name.", argv[i]);
 		}
 	}
+
+	z_log_call_sites_release();
 }
 
 static int severity_level_get(const char *str)
@@ -418,6 +426,117 @@ static int cmd_log_mem(const struct shell *sh, size_t argc, char **argv)
 	return 0;
 }
 
+static int cmd_log_rate_limit(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t modules_cnt = log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID);
+	uint32_t rate;
+	uint32_t burst;
+	int err = 0;
+
+	if (argc == 1) {
+		shell_fprintf(sh, SHELL_NORMAL, "%-40s | rate/s | burst\r\n", "module_name");
+		shell_fprintf(sh, SHELL_NORMAL,
+		      "----------------------------------------------------------\r\n");
+
+		for (int16_t i = 0U; i < modules_cnt; i++) {
+			if ((log_rate_limit_get(i, &rate, &burst) == 0) && (rate > 0U)) {
+				shell_fprintf(sh, SHELL_NORMAL, "%-40s | %-6u | %u\r\n",
+					      log_source_name_get(Z_LOG_LOCAL_DOMAIN_ID, i),
+					      rate, burst);
+			}
+		}
+
+		return 0;
+	}
+
+	if (argc < 4) {
+		shell_help(sh);
+		return -EINVAL;
+	}
+
+	rate = shell_strtoul(argv[1], 0, &err);
+	burst = shell_strtoul(argv[2], 0, &err);
+	if (err != 0) {
+		shell_error(sh, "Invalid rate or burst.");
+		return -EINVAL;
+	}
+
+	for (int i = 3; i < argc; i++) {
+		int id = module_id_get(argv[i]);
+
+		if (id < 0) {
+			shell_error(sh, "%s: unknown source name.", argv[i]);
+			continue;
+		}
+
+		err = log_rate_limit_set(id, rate, burst);
+		if (err != 0) {
+			shell_error(sh, "%s: failed to set rate limit (err %d).", argv[i], err);
+		}
+	}
+
+	return 0;
+}
+
+static int retained_out(uint8_t *data, size_t length, void *ctx)
+{
+	shell_fprintf((const struct shell *)ctx, SHELL_NORMAL, "%.*s", (int)length, data);
+
+	return length;
+}
+
+static uint8_t retained_buf[32];
+LOG_OUTPUT_DEFINE(log_output_retained, retained_out, retained_buf, sizeof(retained_buf));
+
+static void retained_msg_print(struct log_msg *msg, void *user_data)
+{
+	const struct shell *sh = user_data;
+
+	if (msg == NULL) {
+		shell_print(sh, "--- reboot ---");
+		return;
+	}
+
+	log_output_msg_process(&log_output_retained, msg, log_backend_std_get_flags());
+}
+
+static int cmd_log_retained_show(const struct shell *sh, size_t argc, char **argv)
+{
+	int cnt;
+
+	log_output_ctx_set(&log_output_retained, (void *)sh);
+
+	cnt = log_backend_retention_foreach(retained_msg_print, (void *)sh);
+	if (cnt < 0) {
+		shell_error(sh, "Failed to read retained messages (err %d).", cnt);
+		return -ENOEXEC;
+	}
+
+	shell_print(sh, "%d retained messages", cnt);
+
+	return 0;
+}
+
+static int cmd_log_retained_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	int err = log_backend_retention_clear();
+
+	if (err < 0) {
+		shell_error(sh, "Failed to clear retained messages (err %d).", err);
+		return -ENOEXEC;
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_retained,
+	SHELL_CMD_ARG(show, NULL, "Print retained messages, including messages "
+		      "logged before the reboot.", cmd_log_retained_show, 1, 0),
+	SHELL_CMD_ARG(clear, NULL, "Discard retained messages.",
+		      cmd_log_retained_clear, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_backend,
 	SHELL_CMD_ARG(disable, &dsub_module_name,
 		  "'log disable <module_0> .. <module_n>' disables logs in "
@@ -477,6 +596,14 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 		       cmd_log_self_status),
 	SHELL_COND_CMD(CONFIG_LOG_MODE_DEFERRED, mem, NULL, "Logger memory usage",
 		       cmd_log_mem),
+	SHELL_COND_CMD_ARG(CONFIG_LOG_RATE_LIMIT, rate_limit, NULL,
+			   "'log rate_limit <rate> <burst> <module_0> .. <module_n>' limits "
+			   "logs of specified modules to <rate> messages per second with bursts "
+			   "of up to <burst> messages, rate 0 removes the limit. Without "
+			   "arguments, lists rate limited modules.",
+			   cmd_log_rate_limit, 1, 255),
+	SHELL_COND_CMD(CONFIG_LOG_BACKEND_RETENTION, retained, &sub_log_retained,
+		       "Messages retained by the retention backend", NULL),
 	SHELL_COND_CMD(CONFIG_LOG_FRONTEND, FRONTEND_NAME, &sub_log_backend,
 		"Frontend control", NULL),
 	SHELL_SUBCMD_SET_END);
@@ -115,20 +115,30 @@ static log_timestamp_t prev_timestamp;
 static atomic_t unordered_cnt;
 static uint64_t last_failure_report;
 
-static STRUCT_SECTION_ITERABLE(log_msg_ptr, log_msg_ptr);
-static STRUCT_SECTION_ITERABLE_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer, log_buffer);
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+#define LOG_BUFFER_COUNT CONFIG_MP_MAX_NUM_CPUS
+#else
+#define LOG_BUFFER_COUNT 1
+#endif
+
+/* With per-CPU buffers, each core allocates its messages from its own buffer
+ * and the buffers are merged by timestamp when messages are processed.
+ */
+static STRUCT_SECTION_ITERABLE_ARRAY(log_msg_ptr, log_msg_ptr, LOG_BUFFER_COUNT);
+static STRUCT_SECTION_ITERABLE_ARRAY_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer, log_buffer,
+					       LOG_BUFFER_COUNT);
 static struct mpsc_pbuf_buffer *curr_log_buffer;
 
 #ifdef CONFIG_MPSC_PBUF
 static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
-	buf32[CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+	buf32[LOG_BUFFER_COUNT][CONFIG_LOG_BUFFER_SIZE / sizeof(int) / LOG_BUFFER_COUNT];
 
 static void z_log_notify_drop(const struct mpsc_pbuf_buffer *buffer,
 			      const union mpsc_pbuf_generic *item);
 
 static const struct mpsc_pbuf_buffer_config mpsc_config = {
-	.buf = (uint32_t *)buf32,
-	.size = ARRAY_SIZE(buf32),
+	.buf = (uint32_t *)buf32[0],
+	.size = ARRAY_SIZE(buf32[0]),
 	.notify_drop = z_log_notify_drop,
 	.get_wlen = log_msg_generic_get_wlen,
 	.flags = (IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW) ?
@@ -536,7 +546,8 @@ void z_log_notify_backend_enabled(void)
 
 static inline bool z_log_unordered_pending(void)
 {
-	return IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && unordered_cnt;
+	return (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) &&
+	       unordered_cnt;
 }
 
 bool z_impl_log_process(void)
@@ -631,8 +642,39 @@ bool z_log_dropped_pending(void)
 void z_log_msg_init(void)
 {
 #ifdef CONFIG_MPSC_PBUF
-	mpsc_pbuf_init(&log_buffer, &mpsc_config);
-	curr_log_buffer = &log_buffer;
+	struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+	for (int i = 0; i < LOG_BUFFER_COUNT; i++) {
+		config.buf = (uint32_t *)buf32[i];
+		mpsc_pbuf_init(&log_buffer[i], &config);
+	}
+
+	curr_log_buffer = &log_buffer[0];
+#endif
+}
+
+/* Buffer of the CPU the caller is running on. The caller may migrate to
+ * another CPU right after, the message is then simply stored in the buffer
+ * of the previous CPU.
+ */
+static inline struct mpsc_pbuf_buffer *local_log_buffer(void)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	return &log_buffer[arch_curr_cpu()->id];
+#else
+	return &log_buffer[0];
+#endif
+}
+
+/* Buffer from which a local message was allocated. */
+static inline struct mpsc_pbuf_buffer *msg_log_buffer(struct log_msg *msg)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	return &log_buffer[((uintptr_t)msg - (uintptr_t)buf32) / sizeof(buf32[0])];
+#else
+	ARG_UNUSED(msg);
+
+	return &log_buffer[0];
 #endif
 }
 
@@ -651,7 +693,7 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	return msg_alloc(local_log_buffer(), wlen);
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -670,23 +712,51 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 	z_log_msg_post_finalize();
 }
 
+static void msg_discard(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
+{
+	if (IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
+		return;
+	}
+
+#ifdef CONFIG_MPSC_PBUF
+	mpsc_pbuf_discard(buffer, (union mpsc_pbuf_generic *)msg);
+#endif
+}
+
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+
+	if (IS_ENABLED(CONFIG_LOG_DEDUP) || IS_ENABLED(CONFIG_LOG_RATE_LIMIT)) {
+		struct log_msg_repeats repeats;
+
+		if (z_log_msg_limit(msg, &repeats)) {
+			msg_discard(msg_log_buffer(msg), msg);
+			return;
+		}
+
+		msg_commit(msg_log_buffer(msg), msg);
+		/* Repeats of an evicted message are reported after the message. */
+		z_log_msg_repeats_report(&repeats);
+		return;
+	}
+
+	msg_commit(msg_log_buffer(msg), msg);
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
 {
 #ifdef CONFIG_MPSC_PBUF
-	return (union log_msg_generic *)mpsc_pbuf_claim(&log_buffer);
+	return (union log_msg_generic *)mpsc_pbuf_claim(&log_buffer[0]);
 #else
 	return NULL;
 #endif
 
 }
 
-/* If there are buffers dedicated for each link, claim the oldest message (lowest timestamp). */
+/* If there are buffers dedicated for each link or for each CPU, claim the oldest message
+ * (lowest timestamp).
+ */
 union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 {
 	union log_msg_generic *msg = NULL;
@@ -742,13 +812,13 @@ union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 		}
 
 		(*chosen).msg = NULL;
-	}
 
-	if (t_min < prev_timestamp) {
-		atomic_inc(&unordered_cnt);
-	}
+		if (t_min < prev_timestamp) {
+			atomic_inc(&unordered_cnt);
+		}
 
-	prev_timestamp = t_min;
+		prev_timestamp = t_min;
+	}
 
 	return msg;
 }
@@ -760,7 +830,8 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if ((IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) &&
+	    len > 1) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -795,8 +866,9 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
-	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
-		return msg_pending(&log_buffer);
+	if ((!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && !IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) ||
+	    (len == 1)) {
+		return msg_pending(&log_buffer[0]);
 	}
 
 	STRUCT_SECTION_FOREACH(log_msg_ptr, msg_ptr) {
@@ -822,7 +894,8 @@ void z_log_msg_enqueue(const struct log_link *link, const void *data, size_t len
 {
 	struct log_msg *log_msg = (struct log_msg *)data;
 	size_t wlen = DIV_ROUND_UP(ROUND_UP(len, Z_LOG_MSG_ALIGNMENT), sizeof(int));
-	struct mpsc_pbuf_buffer *mpsc_pbuffer = link->mpsc_pbuf ? link->mpsc_pbuf : &log_buffer;
+	struct mpsc_pbuf_buffer *mpsc_pbuffer = link->mpsc_pbuf ? link->mpsc_pbuf :
+				 local_log_buffer();
 	struct log_msg *local_msg = msg_alloc(mpsc_pbuffer, wlen);
 
 	if (!local_msg) {
@@ -875,7 +948,17 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 		return -EINVAL;
 	}
 
-	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
+	*buf_size = 0;
+	*usage = 0;
+
+	for (int i = 0; i < LOG_BUFFER_COUNT; i++) {
+		uint32_t size;
+		uint32_t now;
+
+		mpsc_pbuf_get_utilization(&log_buffer[i], &size, &now);
+		*buf_size += size;
+		*usage += now;
+	}
 
 	return 0;
 }
@@ -888,7 +971,22 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
-	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+	*max = 0;
+
+	/* With per-CPU buffers, this is the sum of the peak usage of each buffer. */
+	for (int i = 0; i < LOG_BUFFER_COUNT; i++) {
+		uint32_t peak;
+		int err;
+
+		err = mpsc_pbuf_get_max_utilization(&log_buffer[i], &peak);
+		if (err < 0) {
+			return err;
+		}
+
+		*max += peak;
+	}
+
+	return 0;
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
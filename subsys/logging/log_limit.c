@@ -0,0 +1,350 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_internal.h>
+#include <zephyr/logging/log_msg.h>
+#include <zephyr/sys/cbprintf.h>
+#include <zephyr/sys/hash_function.h>
+
+/* Tokens are counted in thousandths of a message so that a bucket is refilled
+ * with rate (in messages per second) tokens every millisecond.
+ */
+#define RATE_LIMIT_TOKEN 1000U
+
+static const char repeats_fmt[] = "%u repeated messages suppressed";
+
+#ifdef CONFIG_LOG_DEDUP
+struct dedup_entry {
+	const void *source;
+	uint32_t hash;
+	uint32_t start;
+	uint32_t repeats;
+	uint8_t level;
+};
+
+static void dedup_timer_expiry_fn(struct k_timer *timer);
+
+static struct dedup_entry dedup_entries[CONFIG_LOG_DEDUP_ENTRIES];
+static struct k_spinlock dedup_lock;
+static atomic_t dedup_repeats;
+/* Expires at the end of the earliest window with pending repeats. */
+static K_TIMER_DEFINE(dedup_timer, dedup_timer_expiry_fn, NULL);
+#endif
+
+#ifdef CONFIG_LOG_RATE_LIMIT
+struct rate_limit {
+	/* Entry is not used when rate is 0. */
+	uint32_t rate;
+	uint32_t burst;
+	uint32_t tokens;
+	uint32_t last;
+	int16_t source_id;
+};
+
+static struct rate_limit rate_limits[CONFIG_LOG_RATE_LIMIT_SOURCES];
+static struct k_spinlock rate_limit_lock;
+static uint32_t rate_limit_cnt;
+#endif
+
+#ifdef CONFIG_LOG_DEDUP
+/* Hash covers the string package (format string pointer and arguments) and
+ * hexdump data which directly follows the package.
+ */
+static uint32_t msg_hash(struct log_msg *msg)
+{
+	size_t plen;
+	size_t dlen;
+	uint8_t *package = log_msg_get_package(msg, &plen);
+	uint8_t level = log_msg_get_level(msg);
+
+	(void)log_msg_get_data(msg, &dlen);
+
+	return sys_hash32_fnv1a_update(sys_hash32_fnv1a(&level, sizeof(level)),
+				       package, plen + dlen);
+}
+
+/* Returns true if message shall be dropped. Repeats of the entry which is
+ * reused for the message are returned in @p repeats.
+ */
+static bool dedup_check(struct log_msg *msg, uint32_t now, struct log_msg_repeats *repeats)
+{
+	const void *source = log_msg_get_source(msg);
+	struct dedup_entry *entry = NULL;
+	struct dedup_entry *victim = &dedup_entries[0];
+	uint32_t hash = msg_hash(msg);
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&dedup_lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(dedup_entries); i++) {
+		struct dedup_entry *e = &dedup_entries[i];
+
+		if ((e->source == source) && (e->hash == hash)) {
+			entry = e;
+			break;
+		}
+
+		/* Prefer empty entries, then the least recently seen message. */
+		if ((victim->source != NULL) &&
+		    ((e->source == NULL) || ((now - e->start) > (now - victim->start)))) {
+			victim = e;
+		}
+	}
+
+	if ((entry != NULL) && ((now - entry->start) < CONFIG_LOG_DEDUP_WINDOW_MS)) {
+		uint32_t remaining = CONFIG_LOG_DEDUP_WINDOW_MS - (now - entry->start);
+		bool first = (entry->repeats++ == 0U);
+
+		k_spin_unlock(&dedup_lock, key);
+		atomic_inc(&dedup_repeats);
+
+		/* Repeats are reported when the window expires, even if nothing
+		 * is logged afterwards.
+		 */
+		if (first) {
+			uint32_t armed = k_timer_remaining_get(&dedup_timer);
+
+			if ((armed == 0U) || (armed > remaining)) {
+				k_timer_start(&dedup_timer, K_MSEC(remaining), K_NO_WAIT);
+			}
+		}
+
+		return true;
+	}
+
+	if (entry == NULL) {
+		entry = victim;
+	}
+
+	repeats->source = entry->source;
+	repeats->level = entry->level;
+	repeats->cnt = entry->repeats;
+	if (entry->repeats > 0U) {
+		atomic_sub(&dedup_repeats, entry->repeats);
+	}
+
+	entry->source = source;
+	entry->hash = hash;
+	entry->level = log_msg_get_level(msg);
+	entry->start = now;
+	entry->repeats = 0U;
+
+	k_spin_unlock(&dedup_lock, key);
+
+	return false;
+}
+
+/* Report repeats of messages for which the window has expired. Reports are
+ * created from the timer context so that they are processed like messages
+ * logged from an interrupt: immediately in the immediate mode and by waking up
+ * the processing thread in the deferred mode.
+ */
+static void dedup_timer_expiry_fn(struct k_timer *timer)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t next = UINT32_MAX;
+
+	if (atomic_get(&dedup_repeats) == 0) {
+		return;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(dedup_entries); i++) {
+		struct dedup_entry *e = &dedup_entries[i];
+		struct log_msg_repeats repeats = { .cnt = 0U };
+		k_spinlock_key_t key = k_spin_lock(&dedup_lock);
+
+		if ((e->repeats > 0U) && ((now - e->start) >= CONFIG_LOG_DEDUP_WINDOW_MS)) {
+			repeats.source = e->source;
+			repeats.level = e->level;
+			repeats.cnt = e->repeats;
+			/* Next occurrence starts a new window. */
+			atomic_sub(&dedup_repeats, e->repeats);
+			e->repeats = 0U;
+		} else if (e->repeats > 0U) {
+			next = MIN(next, CONFIG_LOG_DEDUP_WINDOW_MS - (now - e->start));
+		}
+
+		k_spin_unlock(&dedup_lock, key);
+
+		z_log_msg_repeats_report(&repeats);
+	}
+
+	if (next != UINT32_MAX) {
+		k_timer_start(timer, K_MSEC(next), K_NO_WAIT);
+	}
+}
+#endif /* CONFIG_LOG_DEDUP */
+
+#ifdef CONFIG_LOG_RATE_LIMIT
+static struct rate_limit *rate_limit_find(int16_t source_id)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(rate_limits); i++) {
+		if ((rate_limits[i].rate > 0U) && (rate_limits[i].source_id == source_id)) {
+			return &rate_limits[i];
+		}
+	}
+
+	return NULL;
+}
+
+static bool rate_limit_check(struct log_msg *msg, uint32_t now)
+{
+	struct rate_limit *rl;
+	bool drop = false;
+	k_spinlock_key_t key;
+
+	if (rate_limit_cnt == 0U) {
+		return false;
+	}
+
+	key = k_spin_lock(&rate_limit_lock);
+
+	rl = rate_limit_find(log_msg_get_source_id(msg));
+	if (rl != NULL) {
+		uint64_t tokens = rl->tokens + (uint64_t)(now - rl->last) * rl->rate;
+
+		rl->tokens = MIN(tokens, (uint64_t)rl->burst * RATE_LIMIT_TOKEN);
+		rl->last = now;
+
+		if (rl->tokens >= RATE_LIMIT_TOKEN) {
+			rl->tokens -= RATE_LIMIT_TOKEN;
+		} else {
+			drop = true;
+		}
+	}
+
+	k_spin_unlock(&rate_limit_lock, key);
+
+	return drop;
+}
+
+int log_rate_limit_set(int16_t source_id, uint32_t rate, uint32_t burst)
+{
+	struct rate_limit *rl;
+	k_spinlock_key_t key;
+	int err = 0;
+
+	if ((source_id < 0) || (source_id >= log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID))) {
+		return -EINVAL;
+	}
+
+	if ((rate > 0U) && ((burst == 0U) || (burst > (UINT32_MAX / RATE_LIMIT_TOKEN)))) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&rate_limit_lock);
+
+	rl = rate_limit_find(source_id);
+	if (rate == 0U) {
+		if (rl != NULL) {
+			rl->rate = 0U;
+			rate_limit_cnt--;
+		}
+	} else {
+		for (size_t i = 0; (rl == NULL) && (i < ARRAY_SIZE(rate_limits)); i++) {
+			if (rate_limits[i].rate == 0U) {
+				rl = &rate_limits[i];
+				rate_limit_cnt++;
+			}
+		}
+
+		if (rl != NULL) {
+			rl->source_id = source_id;
+			rl->rate = rate;
+			rl->burst = burst;
+			rl->tokens = burst * RATE_LIMIT_TOKEN;
+			rl->last = k_uptime_get_32();
+		} else {
+			err = -ENOMEM;
+		}
+	}
+
+	k_spin_unlock(&rate_limit_lock, key);
+
+	return err;
+}
+
+int log_rate_limit_get(int16_t source_id, uint32_t *rate, uint32_t *burst)
+{
+	struct rate_limit *rl;
+	k_spinlock_key_t key;
+
+	if ((source_id < 0) || (source_id >= log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID))) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&rate_limit_lock);
+
+	rl = rate_limit_find(source_id);
+	*rate = (rl != NULL) ? rl->rate : 0U;
+	*burst = (rl != NULL) ? rl->burst : 0U;
+
+	k_spin_unlock(&rate_limit_lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_LOG_RATE_LIMIT */
+
+void z_log_msg_repeats_report(const struct log_msg_repeats *repeats)
+{
+	if (IS_ENABLED(CONFIG_LOG_DEDUP) && (repeats->cnt > 0U)) {
+		z_log_msg_runtime_create(Z_LOG_LOCAL_DOMAIN_ID, repeats->source,
+					 repeats->level, NULL, 0, 0,
+					 repeats_fmt, repeats->cnt);
+	}
+}
+
+/* Reports of repeats are identified by their format string, which is stored
+ * as a pointer since the package is created without any flags.
+ */
+static bool is_repeats_report(struct log_msg *msg)
+{
+	size_t len;
+	const struct cbprintf_package_hdr_ext *hdr =
+		(const struct cbprintf_package_hdr_ext *)log_msg_get_package(msg, &len);
+
+	return (len >= sizeof(*hdr)) && (hdr->fmt == repeats_fmt);
+}
+
+bool z_log_msg_limit(struct log_msg *msg, struct log_msg_repeats *repeats)
+{
+	uint32_t now;
+
+	repeats->cnt = 0U;
+
+	/* Only logging messages from local sources are limited. */
+	if ((log_msg_get_level(msg) == LOG_LEVEL_NONE) || (log_msg_get_source(msg) == NULL)) {
+		return false;
+	}
+
+	/* Reports are never dropped and do not take a deduplication entry,
+	 * which could evict another message with pending repeats and report
+	 * them recursively.
+	 */
+	if (is_repeats_report(msg)) {
+		return false;
+	}
+
+	now = k_uptime_get_32();
+
+#ifdef CONFIG_LOG_RATE_LIMIT
+	if (rate_limit_check(msg, now)) {
+		z_log_dropped(false);
+
+		return true;
+	}
+#endif
+
+#ifdef CONFIG_LOG_DEDUP
+	if (dedup_check(msg, now, repeats)) {
+		return true;
+	}
+#endif
+
+	return false;
+}
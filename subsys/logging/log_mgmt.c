@@ -338,6 +338,72 @@ static uint32_t *get_dynamic_filter(uint8_t domain_id, uint32_t source_id)
 	return z_log_link_get_dynamic_filter(domain_id, source_id);
 }
 
+#ifdef CONFIG_LOG_CALL_SITE_FILTERING
+static struct k_spinlock call_site_lock;
+static atomic_t call_site_hold;
+static atomic_t call_site_pending;
+
+/* Needs to be called with call_site_lock held. */
+static void call_site_update(struct log_call_site *site)
+{
+	site->enabled = site->level <= LOG_FILTER_AGGR_SLOT_GET(&site->source->filters);
+}
+
+bool z_log_call_site_register(struct log_call_site *site,
+			      struct log_source_dynamic_data *source)
+{
+	k_spinlock_key_t key = k_spin_lock(&call_site_lock);
+
+	site->source = source;
+	call_site_update(site);
+
+	k_spin_unlock(&call_site_lock, key);
+
+	return site->enabled;
+}
+
+static void call_sites_update(const struct log_source_dynamic_data *source)
+{
+	if (atomic_get(&call_site_hold) != 0) {
+		/* Call sites are updated once hold is released. */
+		atomic_set(&call_site_pending, 1);
+		return;
+	}
+
+	/* Lock is taken for each call site so that interrupts are not locked
+	 * for the whole section.
+	 */
+	STRUCT_SECTION_FOREACH(log_call_site, site) {
+		k_spinlock_key_t key = k_spin_lock(&call_site_lock);
+
+		if ((site->source != NULL) &&
+		    ((source == NULL) || (site->source == source))) {
+			call_site_update(site);
+		}
+
+		k_spin_unlock(&call_site_lock, key);
+	}
+}
+
+void z_log_call_sites_hold(void)
+{
+	atomic_inc(&call_site_hold);
+}
+
+void z_log_call_sites_release(void)
+{
+	if ((atomic_dec(&call_site_hold) == 1) &&
+	    atomic_cas(&call_site_pending, 1, 0)) {
+		call_sites_update(NULL);
+	}
+}
+#else
+static inline void call_sites_update(const struct log_source_dynamic_data *source)
+{
+	ARG_UNUSED(source);
+}
+#endif /* CONFIG_LOG_CALL_SITE_FILTERING */
+
 void z_log_runtime_filters_init(void)
 {
 	/*
@@ -358,6 +424,8 @@ void z_log_runtime_filters_init(void)
 				    LOG_FILTER_AGGR_SLOT_IDX,
 				    level);
 	}
+
+	call_sites_update(NULL);
 }
 
 int log_source_id_get(const char *name)
@@ -407,7 +475,13 @@ static void set_runtime_filter(uint8_t backend_id, uint8_t domain_id,
 
 	LOG_FILTER_SLOT_SET(filters, LOG_FILTER_AGGR_SLOT_IDX, new_max);
 
-	if (!z_log_is_local_domain(domain_id) && (new_max != prev_max)) {
+	if (new_max == prev_max) {
+		return;
+	}
+
+	if (z_log_is_local_domain(domain_id)) {
+		call_sites_update(&TYPE_SECTION_START(log_dynamic)[source_id]);
+	} else {
 		(void)z_log_link_set_runtime_level(domain_id, source_id, level);
 	}
 }
@@ -524,9 +598,11 @@ static void backend_filter_set(struct log_backend const *const backend,
 		return;
 	}
 
+	z_log_call_sites_hold();
 	for (uint16_t s = 0; s < log_src_cnt_get(0); s++) {
 		log_filter_set(backend, 0, s, level);
 	}
+	z_log_call_sites_release();
 
 	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN)) {
 		return;
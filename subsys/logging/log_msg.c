@@ -345,6 +345,15 @@ static inline void z_vrfy_z_log_msg_static_create(const void *source,
 void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 				uint8_t level, const void *data, size_t dlen,
 				uint32_t package_flags, const char *fmt, va_list ap)
+{
+	z_log_msg_runtime_vcreate_layout(domain_id, source, level, data, dlen, package_flags,
+					 CBPRINTF_PACKAGE_LAYOUT_NONE, fmt, ap);
+}
+
+void z_log_msg_runtime_vcreate_layout(uint8_t domain_id, const void *source,
+				       uint8_t level, const void *data, size_t dlen,
+				       uint32_t package_flags, uint32_t layout,
+				       const char *fmt, va_list ap)
 {
 	int plen;
 
@@ -352,8 +361,8 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 		va_list ap2;
 
 		va_copy(ap2, ap);
-		plen = cbvprintf_package(NULL, Z_LOG_MSG_ALIGN_OFFSET,
-					 package_flags, fmt, ap2);
+		plen = cbvprintf_package_layout(NULL, Z_LOG_MSG_ALIGN_OFFSET,
+						package_flags, layout, fmt, ap2);
 		__ASSERT_NO_MSG(plen >= 0);
 		va_end(ap2);
 	} else {
@@ -385,7 +394,7 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 	}
 
 	if (pkg && fmt) {
-		plen = cbvprintf_package(pkg, (size_t)plen, package_flags, fmt, ap);
+		plen = cbvprintf_package_layout(pkg, (size_t)plen, package_flags, layout, fmt, ap);
 		__ASSERT_NO_MSG(plen >= 0);
 	}
 
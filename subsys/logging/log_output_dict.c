@@ -11,6 +11,7 @@
 #include <zephyr/logging/log_output_dict.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/util.h>
+#include <string.h>
 
 static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 			 void *ctx)
@@ -24,12 +25,221 @@ static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 	} while (len != 0);
 }
 
-void log_dict_output_msg_process(const struct log_output *output,
-				 struct log_msg *msg, uint32_t flags)
+static uint32_t msg_source_id(struct log_msg *msg)
 {
-	struct log_dict_output_normal_msg_hdr_t output_hdr;
 	void *source = (void *)log_msg_get_source(msg);
 
+	return (source != NULL) ?
+		(IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?
+			log_dynamic_source_id(source) :
+			log_const_source_id(source)) :
+		0U;
+}
+
+#if defined(CONFIG_LOG_DICTIONARY_COMPACT)
+/*
+ * Compact records are batched in a frame of the output which is written with
+ * a single call to the output function once no more messages are pending, or
+ * when the next record does not fit. The first record of a frame carries an
+ * absolute timestamp, so every frame can be decoded on its own. Frames are
+ * not locked, messages are only processed by the logging thread
+ * (CONFIG_LOG_MODE_DEFERRED).
+ */
+#define FRAME_HDR_LEN sizeof(struct log_dict_output_compact_frame_hdr_t)
+
+/* Domain and level byte, and up to four varints */
+#define RECORD_HDR_MAX_LEN (1 + 10 + 3 * 5)
+
+static size_t varint_len(uint64_t value)
+{
+	size_t len = 1;
+
+	while (value >= 0x80) {
+		value >>= 7;
+		len++;
+	}
+
+	return len;
+}
+
+static size_t varint_put(uint8_t *buf, uint64_t value)
+{
+	size_t len = 0;
+
+	while (value >= 0x80) {
+		buf[len++] = (uint8_t)value | 0x80;
+		value >>= 7;
+	}
+
+	buf[len++] = (uint8_t)value;
+
+	return len;
+}
+
+static uint64_t timestamp_delta(const struct log_output_dict_frame *frame,
+			       log_timestamp_t timestamp)
+{
+	int64_t delta = (int64_t)timestamp;
+
+	if (frame->len > FRAME_HDR_LEN) {
+		delta -= (int64_t)frame->timestamp;
+	}
+
+	/* Zigzag encoding, messages from different buffers may be unordered */
+	return ((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63);
+}
+
+/* Number of 32-bit words of the package which are encoded as varints */
+static size_t package_words(const uint8_t *package, size_t len)
+{
+	return (len >= sizeof(uint32_t)) ? MIN(package[0], len / sizeof(uint32_t)) : 0U;
+}
+
+static size_t package_compact_len(const uint8_t *package, size_t len)
+{
+	const uint32_t *words = (const uint32_t *)package;
+	size_t nwords = package_words(package, len);
+	size_t compact_len = len;
+
+	/* The first word (package descriptor) is copied as is */
+	for (size_t i = 1; i < nwords; i++) {
+		compact_len += varint_len(words[i]) - sizeof(uint32_t);
+	}
+
+	return compact_len;
+}
+
+static void frame_flush(const struct log_output *output)
+{
+	struct log_output_dict_frame *frame = &output->control_block->frame;
+
+	if (frame->len > 0U) {
+		buffer_write(output->func, frame->buf, frame->len,
+			     (void *)output->control_block->ctx);
+		frame->len = 0U;
+	}
+}
+
+static void frame_put(const struct log_output *output, const uint8_t *data, size_t len)
+{
+	struct log_output_dict_frame *frame = &output->control_block->frame;
+
+	while (len > 0U) {
+		size_t chunk = MIN(len, sizeof(frame->buf) - frame->len);
+
+		if (chunk == 0U) {
+			frame_flush(output);
+			continue;
+		}
+
+		memcpy(&frame->buf[frame->len], data, chunk);
+		frame->len += chunk;
+		data += chunk;
+		len -= chunk;
+	}
+}
+
+static void frame_start(struct log_output_dict_frame *frame, size_t len)
+{
+	struct log_dict_output_compact_frame_hdr_t hdr = {
+		.type = MSG_COMPACT_FRAME,
+		.len = len,
+	};
+
+	memcpy(frame->buf, &hdr, sizeof(hdr));
+	frame->len = sizeof(hdr);
+}
+
+static void frame_set_len(struct log_output_dict_frame *frame)
+{
+	struct log_dict_output_compact_frame_hdr_t hdr = {
+		.type = MSG_COMPACT_FRAME,
+		.len = frame->len - FRAME_HDR_LEN,
+	};
+
+	memcpy(frame->buf, &hdr, sizeof(hdr));
+}
+
+static void package_put(const struct log_output *output, const uint8_t *package, size_t len)
+{
+	const uint32_t *words = (const uint32_t *)package;
+	size_t nwords = package_words(package, len);
+	uint8_t varint[5];
+
+	if (nwords == 0U) {
+		frame_put(output, package, len);
+		return;
+	}
+
+	frame_put(output, package, sizeof(uint32_t));
+
+	for (size_t i = 1; i < nwords; i++) {
+		frame_put(output, varint, varint_put(varint, words[i]));
+	}
+
+	frame_put(output, &package[nwords * sizeof(uint32_t)], len - nwords * sizeof(uint32_t));
+}
+
+static void compact_msg_process(const struct log_output *output, struct log_msg *msg)
+{
+	struct log_output_dict_frame *frame = &output->control_block->frame;
+	log_timestamp_t timestamp = log_msg_get_timestamp(msg);
+	uint8_t hdr[RECORD_HDR_MAX_LEN];
+	size_t hdr_len = 0;
+	size_t package_len;
+	size_t data_len;
+	uint8_t *package = log_msg_get_package(msg, &package_len);
+	uint8_t *data = log_msg_get_data(msg, &data_len);
+	size_t compact_len = package_compact_len(package, package_len);
+	size_t record_len;
+
+	for (int i = 0; i < 2; i++) {
+		hdr_len = 0;
+		hdr[hdr_len++] = (msg->hdr.desc.domain << 4) | msg->hdr.desc.level;
+		hdr_len += varint_put(&hdr[hdr_len], timestamp_delta(frame, timestamp));
+		hdr_len += varint_put(&hdr[hdr_len], msg_source_id(msg));
+		hdr_len += varint_put(&hdr[hdr_len], package_len);
+		hdr_len += varint_put(&hdr[hdr_len], data_len);
+
+		record_len = hdr_len + compact_len + data_len;
+
+		/* Close the current frame if the record does not fit in it */
+		if (frame->len == 0U || frame->len + record_len <= sizeof(frame->buf)) {
+			break;
+		}
+
+		frame_flush(output);
+	}
+
+	if (frame->len == 0U) {
+		frame_start(frame, 0U);
+	}
+
+	if (frame->len + record_len > sizeof(frame->buf)) {
+		/* Too large for a frame buffer, streamed through it in chunks */
+		frame_start(frame, record_len);
+		frame_put(output, hdr, hdr_len);
+		package_put(output, package, package_len);
+		frame_put(output, data, data_len);
+		frame_flush(output);
+		return;
+	}
+
+	frame_put(output, hdr, hdr_len);
+	package_put(output, package, package_len);
+	frame_put(output, data, data_len);
+	frame_set_len(frame);
+	frame->timestamp = timestamp;
+
+	if (!log_data_pending()) {
+		frame_flush(output);
+	}
+}
+#else /* CONFIG_LOG_DICTIONARY_COMPACT */
+static void normal_msg_process(const struct log_output *output, struct log_msg *msg)
+{
+	struct log_dict_output_normal_msg_hdr_t output_hdr;
+
 	/* Keep sync with header in struct log_msg */
 	output_hdr.type = MSG_NORMAL;
 	output_hdr.domain = msg->hdr.desc.domain;
@@ -38,11 +248,7 @@ void log_dict_output_msg_process(const struct log_output *output,
 	output_hdr.data_len = msg->hdr.desc.data_len;
 	output_hdr.timestamp = msg->hdr.timestamp;
 
-	output_hdr.source = (source != NULL) ?
-				(IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?
-					log_dynamic_source_id(source) :
-					log_const_source_id(source)) :
-				0U;
+	output_hdr.source = msg_source_id(msg);
 
 	buffer_write(output->func, (uint8_t *)&output_hdr, sizeof(output_hdr),
 		     (void *)output->control_block->ctx);
@@ -61,11 +267,33 @@ void log_dict_output_msg_process(const struct log_output *output,
 
 	log_output_flush(output);
 }
+#endif /* CONFIG_LOG_DICTIONARY_COMPACT */
+
+void log_dict_output_flush(const struct log_output *output)
+{
+#if defined(CONFIG_LOG_DICTIONARY_COMPACT)
+	frame_flush(output);
+#else
+	ARG_UNUSED(output);
+#endif
+}
+
+void log_dict_output_msg_process(const struct log_output *output,
+				 struct log_msg *msg, uint32_t flags)
+{
+#if defined(CONFIG_LOG_DICTIONARY_COMPACT)
+	compact_msg_process(output, msg);
+#else
+	normal_msg_process(output, msg);
+#endif
+}
 
 void log_dict_output_dropped_process(const struct log_output *output, uint32_t cnt)
 {
 	struct log_dict_output_dropped_msg_t msg;
 
+	log_dict_output_flush(output);
+
 	msg.type = MSG_DROPPED_MSG;
 	msg.num_dropped_messages = MIN(cnt, 9999);
 
@@ -315,6 +315,21 @@ static inline void net_ipv4_set_ecn(uint8_t *tos, uint8_t ecn)
 }
 
 #if defined(CONFIG_NET_IPV4_FRAGMENT)
+/** Payload of a pending IPv4 fragment, other than the first one. */
+struct net_ipv4_frag {
+	/** Fragment data, without the IPv4 header */
+	struct net_buf *buf;
+
+	/** Offset of the data in the reassembled payload */
+	uint16_t offset;
+
+	/** Length of the data */
+	uint16_t len;
+
+	/** Next fragment by offset, index + 1 or 0 */
+	uint16_t next;
+};
+
 /** Store pending IPv4 fragment information that is needed for reassembly. */
 struct net_ipv4_reassembly {
 	/** IPv4 source address of the fragment */
@@ -329,12 +344,33 @@ struct net_ipv4_reassembly {
 	 */
 	struct k_work_delayable timer;
 
-	/** Pointers to pending fragments */
-	struct net_pkt *pkt[CONFIG_NET_IPV4_FRAGMENT_MAX_PKT];
+	/** First fragment, holding the IPv4 header of the packet */
+	struct net_pkt *pkt;
+
+	/** Payload length of the packet, once the last fragment is received */
+	uint32_t total_len;
+
+	/** Payload bytes received so far, the fragments never overlap */
+	uint32_t received;
+
+	/** Uptime of the last received fragment, in milliseconds */
+	uint32_t last_update;
+
+	/** Other pending fragments sorted by offset, index + 1 or 0 */
+	uint16_t frags;
+
+	/** Pending fragment with the highest offset, index + 1 or 0 */
+	uint16_t tail;
+
+	/** Number of pending fragments, including the first one */
+	uint16_t count;
 
 	/** IPv4 fragment identification */
 	uint16_t id;
 	uint8_t protocol;
+
+	/** The last fragment was received and total_len is valid */
+	bool last;
 };
 #else
 struct net_ipv4_reassembly;
@@ -27,17 +27,131 @@ LOG_MODULE_DECLARE(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
 /* Timeout for various buffer allocations in this file. */
 #define NET_BUF_TIMEOUT K_MSEC(100)
 
+#define FRAG_NONE 0U
+#define FRAG_POOL_SIZE (CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT * CONFIG_NET_IPV4_FRAGMENT_MAX_PKT)
+
 static void reassembly_timeout(struct k_work *work);
 
 static struct net_ipv4_reassembly reassembly[CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT];
 
+/* Pending fragments of all the reassemblies, other than the first ones */
+static struct net_ipv4_frag frags[FRAG_POOL_SIZE];
+static uint16_t frags_free;
+static uint16_t frags_used;
+
+/* Payload bytes held by all the reassemblies */
+static uint32_t reassembly_bytes;
+
+/* The reassemblies are updated from the RX path and from the work queue */
+static K_MUTEX_DEFINE(reassembly_lock);
+
+static inline bool reassembly_in_use(struct net_ipv4_reassembly *reass)
+{
+	return k_work_delayable_remaining_get(&reass->timer) != 0;
+}
+
+static inline uint32_t frag_end(uint16_t index)
+{
+	return frags[index].offset + frags[index].len;
+}
+
+static inline uint32_t fragment_payload_len(struct net_pkt *pkt)
+{
+	return net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt);
+}
+
+static void frag_release(uint16_t index)
+{
+	if (frags[index].buf != NULL) {
+		net_buf_unref(frags[index].buf);
+		frags[index].buf = NULL;
+	}
+
+	frags[index].next = frags_free;
+	frags_free = index + 1;
+}
+
+static void reassembly_release(struct net_ipv4_reassembly *reass)
+{
+	k_work_cancel_delayable(&reass->timer);
+
+	while (reass->frags != FRAG_NONE) {
+		uint16_t index = reass->frags - 1;
+
+		reass->frags = frags[index].next;
+		frag_release(index);
+	}
+
+	if (reass->pkt != NULL) {
+		net_pkt_unref(reass->pkt);
+		reass->pkt = NULL;
+	}
+
+	reassembly_bytes -= reass->received;
+
+	reass->tail = FRAG_NONE;
+	reass->count = 0U;
+	reass->received = 0U;
+	reass->total_len = 0U;
+	reass->last = false;
+	reass->id = 0U;
+}
+
+static void reassembly_info(char *str, struct net_ipv4_reassembly *reass)
+{
+	LOG_DBG("%s id 0x%x src %s dst %s remain %d ms", str, reass->id,
+		net_sprint_ipv4_addr(&reass->src),
+		net_sprint_ipv4_addr(&reass->dst),
+		k_ticks_to_ms_ceil32(
+			k_work_delayable_remaining_get(&reass->timer)));
+}
+
+/* Return the reassembly holding fragments that did not receive one for the longest time.
+ * This includes the timed out reassemblies that the work queue did not release yet.
+ */
+static struct net_ipv4_reassembly *reassembly_lru(struct net_ipv4_reassembly *exclude)
+{
+	struct net_ipv4_reassembly *lru = NULL;
+	int i;
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+		struct net_ipv4_reassembly *reass = &reassembly[i];
+
+		if (reass == exclude || reass->count == 0U) {
+			continue;
+		}
+
+		if (lru == NULL || (int32_t)(reass->last_update - lru->last_update) < 0) {
+			lru = reass;
+		}
+	}
+
+	return lru;
+}
+
+/* Drop the least recently used reassembly, other than the given one */
+static int reassembly_evict(struct net_ipv4_reassembly *exclude)
+{
+	struct net_ipv4_reassembly *lru = reassembly_lru(exclude);
+
+	if (lru == NULL) {
+		return -ENOMEM;
+	}
+
+	reassembly_info("Reassembly evicted", lru);
+	reassembly_release(lru);
+
+	return 0;
+}
+
 static struct net_ipv4_reassembly *reassembly_get(uint16_t id, struct in_addr *src,
 						  struct in_addr *dst, uint8_t protocol)
 {
-	int i, avail = -1;
+	struct net_ipv4_reassembly *avail = NULL;
+	int i;
 
 	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
-		if (k_work_delayable_remaining_get(&reassembly[i].timer) &&
+		if (reassembly_in_use(&reassembly[i]) &&
 		    reassembly[i].id == id &&
 		    net_ipv4_addr_cmp(src, &reassembly[i].src) &&
 		    net_ipv4_addr_cmp(dst, &reassembly[i].dst) &&
@@ -45,78 +159,183 @@ static struct net_ipv4_reassembly *reassembly_get(uint16_t id, struct in_addr *s
 			return &reassembly[i];
 		}
 
-		if (k_work_delayable_remaining_get(&reassembly[i].timer)) {
-			continue;
+		if (avail == NULL && !reassembly_in_use(&reassembly[i])) {
+			avail = &reassembly[i];
 		}
+	}
+
+	if (avail == NULL) {
+		avail = reassembly_lru(NULL);
+		reassembly_info("Reassembly evicted", avail);
+	}
 
-		if (avail < 0) {
-			avail = i;
+	/* Also drops what a timed out reassembly might have left */
+	reassembly_release(avail);
+
+	k_work_reschedule(&avail->timer, K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT));
+
+	net_ipaddr_copy(&avail->src, src);
+	net_ipaddr_copy(&avail->dst, dst);
+
+	avail->protocol = protocol;
+	avail->id = id;
+
+	return avail;
+}
+
+static int frag_alloc(struct net_ipv4_reassembly *reass)
+{
+	uint16_t index;
+
+	while (frags_free == FRAG_NONE && frags_used >= FRAG_POOL_SIZE) {
+		if (reassembly_evict(reass) < 0) {
+			return -ENOMEM;
 		}
 	}
 
-	if (avail < 0) {
-		return NULL;
+	if (frags_free != FRAG_NONE) {
+		index = frags_free - 1;
+		frags_free = frags[index].next;
+	} else {
+		index = frags_used++;
 	}
 
-	k_work_reschedule(&reassembly[avail].timer, K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT));
+	return index;
+}
 
-	net_ipaddr_copy(&reassembly[avail].src, src);
-	net_ipaddr_copy(&reassembly[avail].dst, dst);
+/* Make room for len more payload bytes in the memory budget */
+static int reassembly_reserve(struct net_ipv4_reassembly *reass, uint32_t len)
+{
+	if (CONFIG_NET_IPV4_FRAGMENT_MAX_BYTES == 0) {
+		return 0;
+	}
 
-	reassembly[avail].protocol = protocol;
-	reassembly[avail].id = id;
+	while (reassembly_bytes + len > CONFIG_NET_IPV4_FRAGMENT_MAX_BYTES) {
+		if (reassembly_evict(reass) < 0) {
+			return -ENOMEM;
+		}
+	}
 
-	return &reassembly[avail];
+	return 0;
 }
 
-static bool reassembly_cancel(uint32_t id, struct in_addr *src, struct in_addr *dst)
+/* Store a fragment in the reassembly. The fragments are kept sorted by offset and must not
+ * overlap, so the packet is complete once the first and the last fragments are received and
+ * the received bytes add up to the payload length. The packet is consumed on success.
+ */
+static int reassembly_add(struct net_ipv4_reassembly *reass, struct net_pkt *pkt,
+			  uint32_t offset, uint32_t len, bool more)
 {
-	int i, j;
+	uint32_t end = offset + len;
+	uint32_t prev_end;
+	uint16_t *link;
+	int index;
+	int ret;
 
-	LOG_DBG("Cancel 0x%x", id);
+	if (end + net_pkt_ip_hdr_len(pkt) > UINT16_MAX) {
+		return -EMSGSIZE;
+	}
 
-	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
-		int32_t remaining;
+	/* Only the last fragment may end the payload */
+	if (reass->last && (!more || end > reass->total_len)) {
+		return -EBADMSG;
+	}
 
-		if (reassembly[i].id != id ||
-		    !net_ipv4_addr_cmp(src, &reassembly[i].src) ||
-		    !net_ipv4_addr_cmp(dst, &reassembly[i].dst)) {
-			continue;
-		}
+	if (!more && ((reass->tail != FRAG_NONE && frag_end(reass->tail - 1) > end) ||
+		      (reass->pkt != NULL && fragment_payload_len(reass->pkt) > end))) {
+		return -EBADMSG;
+	}
 
-		remaining = k_ticks_to_ms_ceil32(
-			k_work_delayable_remaining_get(&reassembly[i].timer));
-		k_work_cancel_delayable(&reassembly[i].timer);
+	if (offset == 0) {
+		if (reass->pkt != NULL ||
+		    (reass->frags != FRAG_NONE && frags[reass->frags - 1].offset < end)) {
+			return -EBADMSG;
+		}
 
-		LOG_DBG("IPv4 reassembly id 0x%x remaining %d ms", reassembly[i].id, remaining);
+		ret = reassembly_reserve(reass, len);
+		if (ret < 0) {
+			return ret;
+		}
 
-		reassembly[i].id = 0U;
+		/* The first fragment keeps the IPv4 header for the reassembled packet */
+		reass->pkt = pkt;
+		goto done;
+	}
 
-		for (j = 0; j < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; j++) {
-			if (!reassembly[i].pkt[j]) {
-				continue;
-			}
+	if (len == 0) {
+		return -EBADMSG;
+	}
 
-			LOG_DBG("[%d] IPv4 reassembly pkt %p %zd bytes data", j,
-				reassembly[i].pkt[j], net_pkt_get_len(reassembly[i].pkt[j]));
+	if (reass->tail != FRAG_NONE && frags[reass->tail - 1].offset < offset) {
+		/* Fragments received in order are appended directly */
+		prev_end = frag_end(reass->tail - 1);
+		link = &frags[reass->tail - 1].next;
+	} else {
+		prev_end = reass->pkt != NULL ? fragment_payload_len(reass->pkt) : 0;
+		link = &reass->frags;
 
-			net_pkt_unref(reassembly[i].pkt[j]);
-			reassembly[i].pkt[j] = NULL;
+		while (*link != FRAG_NONE && frags[*link - 1].offset < offset) {
+			prev_end = frag_end(*link - 1);
+			link = &frags[*link - 1].next;
 		}
+	}
+
+	if (offset < prev_end || (*link != FRAG_NONE && frags[*link - 1].offset < end)) {
+		/* Overlapping or duplicated, drop it */
+		return -EBADMSG;
+	}
 
-		return true;
+	ret = reassembly_reserve(reass, len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	index = frag_alloc(reass);
+	if (index < 0) {
+		return index;
+	}
+
+	/* Only the payload is kept, the packet itself is released right away */
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_pull(pkt, net_pkt_ip_hdr_len(pkt))) {
+		LOG_ERR("Failed to pull headers");
+		frag_release(index);
+		return -ENOBUFS;
 	}
 
-	return false;
+	frags[index].buf = pkt->buffer;
+	frags[index].offset = offset;
+	frags[index].len = len;
+	frags[index].next = *link;
+
+	*link = index + 1;
+
+	if (frags[index].next == FRAG_NONE) {
+		reass->tail = index + 1;
+	}
+
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+done:
+	if (!more) {
+		reass->last = true;
+		reass->total_len = end;
+	}
+
+	LOG_DBG("Storing %u bytes at offset %u of 0x%x", len, offset, reass->id);
+
+	reass->count++;
+	reass->received += len;
+	reassembly_bytes += len;
+
+	return 0;
 }
 
-static void reassembly_info(char *str, struct net_ipv4_reassembly *reass)
+static inline bool reassembly_complete(struct net_ipv4_reassembly *reass)
 {
-	LOG_DBG("%s id 0x%x src %s dst %s remain %d ms", str, reass->id,
-		net_sprint_ipv4_addr(&reass->src),
-		net_sprint_ipv4_addr(&reass->dst),
-		k_ticks_to_ms_ceil32(
-			k_work_delayable_remaining_get(&reass->timer)));
+	return reass->pkt != NULL && reass->last && reass->received == reass->total_len;
 }
 
 static void reassembly_timeout(struct k_work *work)
@@ -125,74 +344,57 @@ static void reassembly_timeout(struct k_work *work)
 	struct net_ipv4_reassembly *reass =
 		CONTAINER_OF(dwork, struct net_ipv4_reassembly, timer);
 
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
+	/* The slot was released or reused while this work was waiting for the lock */
+	if (reassembly_in_use(reass) || reass->count == 0U) {
+		goto out;
+	}
+
 	reassembly_info("Reassembly cancelled", reass);
 
 	/* Send a ICMPv4 Time Exceeded only if we received the first fragment */
-	if (reass->pkt[0] && net_pkt_ipv4_fragment_offset(reass->pkt[0]) == 0) {
-		net_icmpv4_send_error(reass->pkt[0], NET_ICMPV4_TIME_EXCEEDED,
+	if (reass->pkt != NULL) {
+		net_icmpv4_send_error(reass->pkt, NET_ICMPV4_TIME_EXCEEDED,
 				      NET_ICMPV4_TIME_EXCEEDED_FRAGMENT_REASSEMBLY_TIME);
 	}
 
-	reassembly_cancel(reass->id, &reass->src, &reass->dst);
+	reassembly_release(reass);
+
+out:
+	k_mutex_unlock(&reassembly_lock);
 }
 
-static void reassemble_packet(struct net_ipv4_reassembly *reass)
+/* Link the payload of the other fragments after the first one and release the reassembly */
+static struct net_pkt *reassemble_packet(struct net_ipv4_reassembly *reass)
 {
 	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
 	struct net_ipv4_hdr *ipv4_hdr;
 	struct net_pkt *pkt;
 	struct net_buf *last;
-	int i;
-
-	k_work_cancel_delayable(&reass->timer);
-
-	NET_ASSERT(reass->pkt[0]);
-
-	last = net_buf_frag_last(reass->pkt[0]->buffer);
-
-	/* We start from 2nd packet which is then appended to the first one */
-	for (i = 1; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
-		pkt = reass->pkt[i];
-		if (!pkt) {
-			break;
-		}
-
-		net_pkt_cursor_init(pkt);
+	uint16_t next;
 
-		/* Get rid of IPv4 header which is at the beginning of the fragment. */
-		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
-		if (!ipv4_hdr) {
-			goto error;
-		}
+	pkt = reass->pkt;
+	reass->pkt = NULL;
 
-		LOG_DBG("Removing %d bytes from start of pkt %p", net_pkt_ip_hdr_len(pkt),
-			pkt->buffer);
+	last = net_buf_frag_last(pkt->buffer);
 
-		if (net_pkt_pull(pkt, net_pkt_ip_hdr_len(pkt))) {
-			LOG_ERR("Failed to pull headers");
-			reassembly_cancel(reass->id, &reass->src, &reass->dst);
-			return;
-		}
+	for (next = reass->frags; next != FRAG_NONE; next = frags[next - 1].next) {
+		last->frags = frags[next - 1].buf;
+		last = net_buf_frag_last(last->frags);
 
-		/* Attach the data to the previous packet */
-		last->frags = pkt->buffer;
-		last = net_buf_frag_last(pkt->buffer);
-
-		pkt->buffer = NULL;
-		reass->pkt[i] = NULL;
-
-		net_pkt_unref(pkt);
+		frags[next - 1].buf = NULL;
 	}
 
-	pkt = reass->pkt[0];
-	reass->pkt[0] = NULL;
+	reassembly_release(reass);
 
 	/* Update the header details for the packet */
 	net_pkt_cursor_init(pkt);
 
 	ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
 	if (!ipv4_hdr) {
-		goto error;
+		net_pkt_unref(pkt);
+		return NULL;
 	}
 
 	/* Fix the total length, offset and checksum of the IPv4 packet */
@@ -207,217 +409,95 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 
 	LOG_DBG("New pkt %p IPv4 len is %d bytes", pkt, net_pkt_get_len(pkt));
 
-	/* We need to use the queue when feeding the packet back into the
-	 * IP stack as we might run out of stack if we call processing_data()
-	 * directly. As the packet does not contain link layer header, we
-	 * MUST NOT pass it to L2 so there will be a special check for that
-	 * in process_data() when handling the packet.
-	 */
-	if (net_recv_data(net_pkt_iface(pkt), pkt) >= 0) {
-		return;
-	}
-
-error:
-	net_pkt_unref(pkt);
+	return pkt;
 }
 
 void net_ipv4_frag_foreach(net_ipv4_frag_cb_t cb, void *user_data)
 {
 	int i;
 
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
 	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
-		if (!k_work_delayable_remaining_get(&reassembly[i].timer)) {
+		if (!reassembly_in_use(&reassembly[i])) {
 			continue;
 		}
 
 		cb(&reassembly[i], user_data);
 	}
-}
-
-/* Verify that we have all the fragments received and in correct order.
- * Return:
- * - a negative value if the fragments are erroneous and must be dropped
- * - zero if we are expecting more fragments
- * - a positive value if we can proceed with the reassembly
- */
-static int fragments_are_ready(struct net_ipv4_reassembly *reass)
-{
-	unsigned int expected_offset = 0;
-	bool more = true;
-	int i;
-
-	/* Fragments can arrive in any order, for example in reverse order:
-	 *   1 -> Fragment3(M=0, offset=x2)
-	 *   2 -> Fragment2(M=1, offset=x1)
-	 *   3 -> Fragment1(M=1, offset=0)
-	 * We have to test several requirements before proceeding with the reassembly:
-	 * - We received the first fragment (Fragment Offset is 0)
-	 * - All intermediate fragments are contiguous
-	 * - The More bit of the last fragment is 0
-	 */
-	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
-		struct net_pkt *pkt = reass->pkt[i];
-		unsigned int offset;
-		int payload_len;
-
-		if (!pkt) {
-			break;
-		}
-
-		offset = net_pkt_ipv4_fragment_offset(pkt);
-
-		if (offset < expected_offset) {
-			/* Overlapping or duplicated, drop it */
-			return -EBADMSG;
-		} else if (offset != expected_offset) {
-			/* Not contiguous, let's wait for fragments */
-			return 0;
-		}
-
-		payload_len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt);
-
-		if (payload_len < 0) {
-			return -EBADMSG;
-		}
-
-		expected_offset += payload_len;
-		more = net_pkt_ipv4_fragment_more(pkt);
-	}
 
-	if (more) {
-		return 0;
-	}
-
-	return 1;
-}
-
-static int shift_packets(struct net_ipv4_reassembly *reass, int pos)
-{
-	int i;
-
-	for (i = pos + 1; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
-		if (!reass->pkt[i]) {
-			LOG_DBG("Moving [%d] %p (offset 0x%x) to [%d]", pos, reass->pkt[pos],
-				net_pkt_ipv4_fragment_offset(reass->pkt[pos]), pos + 1);
-
-			/* pkt[i] is free, so shift everything between [pos] and [i - 1] by one
-			 * element
-			 */
-			memmove(&reass->pkt[pos + 1], &reass->pkt[pos],
-				sizeof(void *) * (i - pos));
-
-			/* pkt[pos] is now free */
-			reass->pkt[pos] = NULL;
-
-			return 0;
-		}
-	}
-
-	/* We do not have free space left in the array */
-	return -ENOMEM;
+	k_mutex_unlock(&reassembly_lock);
 }
 
 enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt, struct net_ipv4_hdr *hdr)
 {
-	struct net_ipv4_reassembly *reass = NULL;
+	struct net_ipv4_reassembly *reass;
+	struct net_pkt *reassembled = NULL;
+	uint32_t payload_len;
 	uint16_t flag;
-	bool found;
 	uint8_t more;
 	uint16_t id;
 	int ret;
-	int i;
 
 	flag = ntohs(*((uint16_t *)&hdr->offset));
 	id = ntohs(*((uint16_t *)&hdr->id));
 
-	reass = reassembly_get(id, (struct in_addr *)hdr->src,
-			       (struct in_addr *)hdr->dst, hdr->proto);
-	if (!reass) {
-		LOG_ERR("Cannot get reassembly slot, dropping pkt %p", pkt);
-		goto drop;
-	}
-
 	more = (flag & NET_IPV4_MORE_FRAG_MASK) ? true : false;
 	net_pkt_set_ipv4_fragment_flags(pkt, flag);
 
-	if (more && (net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt)) % 8) {
+	if (net_pkt_get_len(pkt) < net_pkt_ip_hdr_len(pkt)) {
+		return NET_DROP;
+	}
+
+	payload_len = fragment_payload_len(pkt);
+
+	if (more && payload_len % 8) {
 		/* Fragment length is not multiple of 8, discard the packet and send bad IP
 		 * header error.
 		 */
 		net_icmpv4_send_error(pkt, NET_ICMPV4_BAD_IP_HEADER,
 				      NET_ICMPV4_BAD_IP_HEADER_LENGTH);
-		goto drop;
+		return NET_DROP;
 	}
 
-	/* The fragments might come in wrong order so place them in the reassembly chain in the
-	 * correct order.
-	 */
-	for (i = 0, found = false; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
-		if (reass->pkt[i]) {
-			if (net_pkt_ipv4_fragment_offset(reass->pkt[i]) <
-			    net_pkt_ipv4_fragment_offset(pkt)) {
-				continue;
-			}
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
 
-			/* Make room for this fragment. If there is no room then it will discard
-			 * the whole reassembly.
-			 */
-			if (shift_packets(reass, i)) {
-				break;
-			}
-		}
+	reass = reassembly_get(id, (struct in_addr *)hdr->src,
+			       (struct in_addr *)hdr->dst, hdr->proto);
 
-		LOG_DBG("Storing pkt %p to slot %d offset %d", pkt, i,
-			net_pkt_ipv4_fragment_offset(pkt));
-		reass->pkt[i] = pkt;
-		found = true;
+	reass->last_update = k_uptime_get_32();
 
-		break;
-	}
+	ret = reassembly_add(reass, pkt, net_pkt_ipv4_fragment_offset(pkt), payload_len, more);
+	if (ret < 0) {
+		LOG_ERR("Cannot store IPv4 fragment (%d), dropping id 0x%x", ret, reass->id);
+		reassembly_release(reass);
+		k_mutex_unlock(&reassembly_lock);
 
-	if (!found) {
-		/* We could not add this fragment into our saved fragment list. The whole packet
-		 * must be discarded at this point.
-		 */
-		LOG_ERR("No slots available for 0x%x", reass->id);
-		net_pkt_unref(pkt);
-		goto drop;
+		return NET_DROP;
 	}
 
-	ret = fragments_are_ready(reass);
-	if (ret < 0) {
-		LOG_ERR("Reassembled IPv4 verify failed, dropping id %u", reass->id);
-
-		/* Let the caller release the already inserted pkt */
-		if (i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT) {
-			reass->pkt[i] = NULL;
-		}
+	if (reassembly_complete(reass)) {
+		reassembly_info("Reassembly last pkt", reass);
 
-		net_pkt_unref(pkt);
-		goto drop;
-	} else if (ret == 0) {
+		/* The last fragment received, reassemble the packet */
+		reassembled = reassemble_packet(reass);
+	} else {
 		reassembly_info("Reassembly nth pkt", reass);
-
-		LOG_DBG("More fragments to be received");
-		goto accept;
 	}
 
-	reassembly_info("Reassembly last pkt", reass);
-
-	/* The last fragment received, reassemble the packet */
-	reassemble_packet(reass);
+	k_mutex_unlock(&reassembly_lock);
 
-accept:
-	return NET_OK;
-
-drop:
-	if (reass) {
-		if (reassembly_cancel(reass->id, &reass->src, &reass->dst)) {
-			return NET_OK;
-		}
+	/* We need to use the queue when feeding the packet back into the
+	 * IP stack as we might run out of stack if we call processing_data()
+	 * directly. As the packet does not contain link layer header, we
+	 * MUST NOT pass it to L2 so there will be a special check for that
+	 * in process_data() when handling the packet.
+	 */
+	if (reassembled != NULL && net_recv_data(net_pkt_iface(reassembled), reassembled) < 0) {
+		net_pkt_unref(reassembled);
 	}
 
-	return NET_DROP;
+	return NET_OK;
 }
 
 static int send_ipv4_fragment(struct net_pkt *pkt, uint16_t rand_id, uint16_t fit_len,
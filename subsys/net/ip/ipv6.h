@@ -464,6 +464,21 @@ static inline void net_ipv6_nbr_set_reachable_timer(struct net_if *iface,
 #endif
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
+/** Payload of a pending IPv6 fragment, other than the first one. */
+struct net_ipv6_frag {
+	/** Fragment data, without the IPv6 and fragment headers */
+	struct net_buf *buf;
+
+	/** Offset of the data in the reassembled payload */
+	uint16_t offset;
+
+	/** Length of the data */
+	uint16_t len;
+
+	/** Next fragment by offset, index + 1 or 0 */
+	uint16_t next;
+};
+
 /** Store pending IPv6 fragment information that is needed for reassembly. */
 struct net_ipv6_reassembly {
 	/** IPv6 source address of the fragment */
@@ -478,11 +493,32 @@ struct net_ipv6_reassembly {
 	 */
 	struct k_work_delayable timer;
 
-	/** Pointers to pending fragments */
-	struct net_pkt *pkt[CONFIG_NET_IPV6_FRAGMENT_MAX_PKT];
+	/** First fragment, holding the headers of the packet */
+	struct net_pkt *pkt;
+
+	/** Payload length of the packet, once the last fragment is received */
+	uint32_t total_len;
+
+	/** Payload bytes received so far, the fragments never overlap */
+	uint32_t received;
+
+	/** Uptime of the last received fragment, in milliseconds */
+	uint32_t last_update;
 
 	/** IPv6 fragment identification */
 	uint32_t id;
+
+	/** Other pending fragments sorted by offset, index + 1 or 0 */
+	uint16_t frags;
+
+	/** Pending fragment with the highest offset, index + 1 or 0 */
+	uint16_t tail;
+
+	/** Number of pending fragments, including the first one */
+	uint16_t count;
+
+	/** The last fragment was received and total_len is valid */
+	bool last;
 };
 #else
 struct net_ipv6_reassembly;
@@ -0,0 +1,217 @@
+/** @file
+ * @brief Longest prefix match trie
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#include "lpm.h"
+
+static inline uint8_t key_bit(const uint8_t *key, uint8_t pos)
+{
+	return (key[pos / 8] >> (7 - (pos % 8))) & 1;
+}
+
+/* Return how many leading bits, up to max_len, are the same in a and b */
+static uint8_t common_prefix_len(const uint8_t *a, const uint8_t *b,
+				 uint8_t max_len)
+{
+	uint8_t len = 0U;
+	int i;
+
+	for (i = 0; len < max_len; i++, len += 8) {
+		uint8_t diff = a[i] ^ b[i];
+
+		if (diff != 0U) {
+			len += __builtin_clz(diff) - 24;
+			break;
+		}
+	}
+
+	return MIN(len, max_len);
+}
+
+static struct net_lpm_node *node_alloc(struct net_lpm *lpm,
+				       const uint8_t *key,
+				       uint8_t prefix_len)
+{
+	struct net_lpm_node *node = lpm->free;
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	lpm->free = node->child[0];
+
+	node->child[0] = NULL;
+	node->child[1] = NULL;
+	sys_slist_init(&node->entries);
+	memcpy(node->key, key, DIV_ROUND_UP(prefix_len, 8));
+	node->prefix_len = prefix_len;
+
+	return node;
+}
+
+static void node_free(struct net_lpm *lpm, struct net_lpm_node *node)
+{
+	node->child[0] = lpm->free;
+	lpm->free = node;
+}
+
+void net_lpm_init(struct net_lpm *lpm, struct net_lpm_node *nodes,
+		  size_t count, uint8_t key_bits)
+{
+	lpm->root = NULL;
+	lpm->free = NULL;
+	lpm->key_bits = key_bits;
+
+	for (size_t i = 0; i < count; i++) {
+		node_free(lpm, &nodes[i]);
+	}
+}
+
+int net_lpm_insert(struct net_lpm *lpm, const uint8_t *key,
+		   uint8_t prefix_len, sys_snode_t *entry)
+{
+	struct net_lpm_node **link = &lpm->root;
+	struct net_lpm_node *node, *new_node, *branch;
+	uint8_t len;
+
+	while ((node = *link) != NULL) {
+		len = common_prefix_len(key, node->key,
+					MIN(prefix_len, node->prefix_len));
+
+		if (len < node->prefix_len) {
+			break;
+		}
+
+		if (node->prefix_len == prefix_len) {
+			sys_slist_append(&node->entries, entry);
+			return 0;
+		}
+
+		link = &node->child[key_bit(key, node->prefix_len)];
+	}
+
+	new_node = node_alloc(lpm, key, prefix_len);
+	if (new_node == NULL) {
+		return -ENOMEM;
+	}
+
+	sys_slist_append(&new_node->entries, entry);
+
+	if (node == NULL) {
+		*link = new_node;
+		return 0;
+	}
+
+	if (len == prefix_len) {
+		/* The new prefix covers the existing sub trie */
+		new_node->child[key_bit(node->key, prefix_len)] = node;
+		*link = new_node;
+		return 0;
+	}
+
+	/* The prefixes diverge at bit len, join them with a branch node */
+	branch = node_alloc(lpm, key, len);
+	if (branch == NULL) {
+		node_free(lpm, new_node);
+		return -ENOMEM;
+	}
+
+	branch->child[key_bit(key, len)] = new_node;
+	branch->child[key_bit(node->key, len)] = node;
+	*link = branch;
+
+	return 0;
+}
+
+int net_lpm_remove(struct net_lpm *lpm, const uint8_t *key,
+		   uint8_t prefix_len, sys_snode_t *entry)
+{
+	struct net_lpm_node **link = &lpm->root;
+	struct net_lpm_node **parent_link = NULL;
+	struct net_lpm_node *node, *parent, *child;
+
+	while ((node = *link) != NULL) {
+		if (node->prefix_len > prefix_len ||
+		    common_prefix_len(key, node->key,
+				      node->prefix_len) < node->prefix_len) {
+			return -ENOENT;
+		}
+
+		if (node->prefix_len == prefix_len) {
+			break;
+		}
+
+		parent_link = link;
+		link = &node->child[key_bit(key, node->prefix_len)];
+	}
+
+	if (node == NULL || !sys_slist_find_and_remove(&node->entries, entry)) {
+		return -ENOENT;
+	}
+
+	if (!sys_slist_is_empty(&node->entries) ||
+	    (node->child[0] != NULL && node->child[1] != NULL)) {
+		return 0;
+	}
+
+	/* The node has at most one child left, splice it out */
+	child = node->child[0] != NULL ? node->child[0] : node->child[1];
+	*link = child;
+	node_free(lpm, node);
+
+	if (child != NULL || parent_link == NULL) {
+		return 0;
+	}
+
+	/* The parent may now be a branch node with a single child */
+	parent = *parent_link;
+	if (!sys_slist_is_empty(&parent->entries)) {
+		return 0;
+	}
+
+	*parent_link = parent->child[0] != NULL ? parent->child[0] :
+						  parent->child[1];
+	node_free(lpm, parent);
+
+	return 0;
+}
+
+sys_snode_t *net_lpm_lookup(struct net_lpm *lpm, const uint8_t *key,
+			    net_lpm_match_cb_t cb, void *user_data)
+{
+	struct net_lpm_node *node = lpm->root;
+	sys_snode_t *found = NULL;
+	sys_snode_t *entry;
+
+	while (node != NULL) {
+		if (common_prefix_len(key, node->key,
+				      node->prefix_len) < node->prefix_len) {
+			break;
+		}
+
+		SYS_SLIST_FOR_EACH_NODE(&node->entries, entry) {
+			if (cb == NULL || cb(entry, user_data)) {
+				found = entry;
+				break;
+			}
+		}
+
+		if (node->prefix_len >= lpm->key_bits) {
+			break;
+		}
+
+		node = node->child[key_bit(key, node->prefix_len)];
+	}
+
+	return found;
+}
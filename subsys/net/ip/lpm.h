@@ -0,0 +1,138 @@
+/** @file
+ * @brief Longest prefix match trie
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NET_LPM_H
+#define __NET_LPM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <zephyr/sys/slist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Longest key, in bytes, that can be stored in the trie (IPv6 address) */
+#define NET_LPM_KEY_MAX_LEN 16
+
+/**
+ * @brief Trie node.
+ *
+ * The trie is a path compressed binary trie: every node stores the full
+ * prefix it represents so that chains of single child nodes are never
+ * created. A trie holding N prefixes needs at most 2 * N - 1 nodes.
+ */
+struct net_lpm_node {
+	/** Sub tries, indexed by the bit following the prefix */
+	struct net_lpm_node *child[2];
+
+	/** Entries that were inserted with exactly this prefix. An empty
+	 * list means that this is an internal branch node.
+	 */
+	sys_slist_t entries;
+
+	/** Prefix bits, the bits after prefix_len are not significant */
+	uint8_t key[NET_LPM_KEY_MAX_LEN];
+
+	/** Prefix length in bits */
+	uint8_t prefix_len;
+};
+
+/**
+ * @brief Trie root and node allocator.
+ */
+struct net_lpm {
+	/** Root of the trie */
+	struct net_lpm_node *root;
+
+	/** Unused nodes, linked through child[0] */
+	struct net_lpm_node *free;
+
+	/** Length of the keys in bits, 32 for IPv4 and 128 for IPv6 */
+	uint8_t key_bits;
+};
+
+/**
+ * @typedef net_lpm_match_cb_t
+ * @brief Callback used to filter entries during a lookup.
+ *
+ * @param entry Entry stored in the trie.
+ * @param user_data User data given to net_lpm_lookup().
+ *
+ * @return true if the entry is acceptable, false otherwise.
+ */
+typedef bool (*net_lpm_match_cb_t)(sys_snode_t *entry, void *user_data);
+
+/**
+ * @brief Initialize a trie.
+ *
+ * @param lpm Trie to initialize.
+ * @param nodes Node storage, use NET_LPM_NODES() to size it.
+ * @param count Number of nodes in the storage.
+ * @param key_bits Length of the keys in bits.
+ */
+void net_lpm_init(struct net_lpm *lpm, struct net_lpm_node *nodes,
+		  size_t count, uint8_t key_bits);
+
+/** Number of nodes needed to store @p prefixes distinct prefixes */
+#define NET_LPM_NODES(prefixes) (2 * (prefixes))
+
+/**
+ * @brief Insert an entry to the trie.
+ *
+ * @param lpm Trie.
+ * @param key Prefix of the entry.
+ * @param prefix_len Length of the prefix in bits.
+ * @param entry Entry to insert, it must not already be in the trie.
+ *
+ * @return 0 if ok, <0 if there are no free nodes.
+ */
+int net_lpm_insert(struct net_lpm *lpm, const uint8_t *key,
+		   uint8_t prefix_len, sys_snode_t *entry);
+
+/**
+ * @brief Remove an entry from the trie.
+ *
+ * @param lpm Trie.
+ * @param key Prefix given when the entry was inserted.
+ * @param prefix_len Length of the prefix given when the entry was inserted.
+ * @param entry Entry to remove.
+ *
+ * @return 0 if ok, <0 if the entry was not found.
+ */
+int net_lpm_remove(struct net_lpm *lpm, const uint8_t *key,
+		   uint8_t prefix_len, sys_snode_t *entry);
+
+/**
+ * @brief Find the entry with the longest prefix matching a key.
+ *
+ * @details The cost of the lookup depends on the number of branch points
+ * on the path to the key, not on the number of entries in the trie.
+ * If several acceptable entries have the same prefix, the one inserted
+ * first is returned.
+ *
+ * @param lpm Trie.
+ * @param key Key to look up, key_bits long.
+ * @param cb Optional filter callback.
+ * @param user_data User data given to the callback.
+ *
+ * @return Matching entry, or NULL if none was found.
+ */
+sys_snode_t *net_lpm_lookup(struct net_lpm *lpm, const uint8_t *key,
+			    net_lpm_match_cb_t cb, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NET_LPM_H */
@@ -1756,6 +1756,71 @@ static int get_context_timestamping(struct net_context *context,
 #endif
 }
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+static void zc_tx_buf_destroy(struct net_buf *buf);
+
+NET_BUF_POOL_DEFINE(zc_tx_pool, CONFIG_NET_CONTEXT_ZEROCOPY_BUF_COUNT, 0,
+		    sizeof(struct net_zc_tx *), zc_tx_buf_destroy);
+
+static void zc_tx_buf_destroy(struct net_buf *buf)
+{
+	struct net_zc_tx *zc = *(struct net_zc_tx **)net_buf_user_data(buf);
+
+	net_buf_destroy(buf);
+	net_zc_tx_unref(zc);
+}
+
+struct net_buf *net_context_zc_wrap(struct net_zc_tx *zc,
+				    const struct msghdr *msghdr,
+				    size_t len, k_timeout_t timeout)
+{
+	struct net_buf *frags = NULL;
+	struct net_buf *last = NULL;
+
+	for (size_t i = 0; i < msghdr->msg_iovlen && len > 0; i++) {
+		uint8_t *data = msghdr->msg_iov[i].iov_base;
+		size_t iov_len = MIN(msghdr->msg_iov[i].iov_len, len);
+
+		len -= iov_len;
+
+		/* The length of a net_buf is 16 bits, so split large
+		 * iovecs into several external data fragments.
+		 */
+		while (iov_len > 0) {
+			size_t chunk = MIN(iov_len, UINT16_MAX);
+			struct net_buf *buf;
+
+			buf = net_buf_alloc_with_data(&zc_tx_pool, data, chunk,
+						      timeout);
+			if (buf == NULL) {
+				NET_DBG("No zero-copy buffers left");
+
+				if (frags != NULL) {
+					net_buf_unref(frags);
+				}
+
+				return NULL;
+			}
+
+			*(struct net_zc_tx **)net_buf_user_data(buf) = zc;
+			net_zc_tx_ref(zc);
+
+			if (last == NULL) {
+				frags = buf;
+			} else {
+				net_buf_frag_insert(last, buf);
+			}
+
+			last = buf;
+			data += chunk;
+			iov_len -= chunk;
+		}
+	}
+
+	return frags;
+}
+#endif /* CONFIG_NET_CONTEXT_ZEROCOPY */
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
  * to net_pkt from msghdr.
  */
@@ -1794,6 +1859,7 @@ static int context_setup_udp_packet(struct net_context *context,
 				    const void *buf,
 				    size_t len,
 				    const struct msghdr *msg,
+				    struct net_zc_tx *zc,
 				    const struct sockaddr *dst_addr,
 				    socklen_t addrlen)
 {
@@ -1833,9 +1899,23 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
-	if (ret) {
-		return ret;
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	if (zc != NULL) {
+		struct net_buf *frags;
+
+		frags = net_context_zc_wrap(zc, msg, len, PKT_WAIT_TIME);
+		if (frags == NULL) {
+			return -ENOBUFS;
+		}
+
+		net_pkt_append_buffer(pkt, frags);
+	} else
+#endif
+	{
+		ret = context_write_data(pkt, buf, len, msg);
+		if (ret) {
+			return ret;
+		}
 	}
 
 #if defined(CONFIG_NET_CONTEXT_TIMESTAMPING)
@@ -1930,7 +2010,8 @@ static int context_sendto(struct net_context *context,
 			  net_context_send_cb_t cb,
 			  k_timeout_t timeout,
 			  void *user_data,
-			  bool sendto)
+			  bool sendto,
+			  struct net_zc_tx *zc)
 {
 	const struct msghdr *msghdr = NULL;
 	struct net_if *iface;
@@ -2165,6 +2246,12 @@ static int context_sendto(struct net_context *context,
 		return -ENETDOWN;
 	}
 
+	if (zc != NULL && (net_if_is_ip_offloaded(iface) || msghdr == NULL ||
+			   (net_context_get_proto(context) != IPPROTO_UDP &&
+			    net_context_get_proto(context) != IPPROTO_TCP))) {
+		return -EOPNOTSUPP;
+	}
+
 	context->send_cb = cb;
 	context->user_data = user_data;
 
@@ -2174,7 +2261,10 @@ static int context_sendto(struct net_context *context,
 		goto skip_alloc;
 	}
 
-	pkt = context_alloc_pkt(context, family, len, PKT_WAIT_TIME);
+	/* For zero-copy sends only the headers live in the allocated
+	 * buffer, the payload is appended as external data fragments.
+	 */
+	pkt = context_alloc_pkt(context, family, zc ? 0 : len, PKT_WAIT_TIME);
 	if (!pkt) {
 		NET_ERR("Failed to allocate net_pkt");
 		return -ENOBUFS;
@@ -2182,7 +2272,7 @@ static int context_sendto(struct net_context *context,
 
 	tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_proto(context));
-	if (tmp_len < len) {
+	if (zc == NULL && tmp_len < len) {
 		if (net_context_get_type(context) == SOCK_DGRAM) {
 			NET_ERR("Available payload buffer (%zu) is not enough for requested DGRAM (%zu)",
 				tmp_len, len);
@@ -2234,7 +2324,7 @@ skip_alloc:
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_proto(context) == IPPROTO_UDP) {
 		ret = context_setup_udp_packet(context, family, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
+					       zc, dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2245,7 +2335,7 @@ skip_alloc:
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_proto(context) == IPPROTO_TCP) {
 
-		ret = net_tcp_queue(context, buf, len, msghdr);
+		ret = net_tcp_queue(context, buf, len, msghdr, zc);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2347,7 +2437,7 @@ int net_context_send(struct net_context *context,
 	}
 
 	ret = context_sendto(context, buf, len, &context->remote,
-			     addrlen, cb, timeout, user_data, false);
+			     addrlen, cb, timeout, user_data, false, NULL);
 unlock:
 	k_mutex_unlock(&context->lock);
 
@@ -2366,7 +2456,28 @@ int net_context_sendmsg(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, msghdr, 0, NULL, 0,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, NULL);
+
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
+int net_context_sendmsg_zc(struct net_context *context,
+			   const struct msghdr *msghdr,
+			   struct net_zc_tx *zc,
+			   k_timeout_t timeout)
+{
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_CONTEXT_ZEROCOPY)) {
+		return -EOPNOTSUPP;
+	}
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	ret = context_sendto(context, msghdr, 0, NULL, 0,
+			     NULL, timeout, NULL, true, zc);
 
 	k_mutex_unlock(&context->lock);
 
@@ -2387,7 +2498,7 @@ int net_context_sendto(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, buf, len, dst_addr, addrlen,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, NULL);
 
 	k_mutex_unlock(&context->lock);
 
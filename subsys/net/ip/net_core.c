@@ -481,6 +481,13 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	if (NET_TC_RX_COUNT == 0) {
 		net_process_rx_packet(pkt);
 	} else {
+#if defined(CONFIG_NET_RX_STEERING)
+		/* Use the hash from the driver if it has hardware RSS */
+		if (net_pkt_flow_hash(pkt) == 0U) {
+			net_pkt_set_flow_hash(pkt, net_if_flow_hash(iface, pkt));
+		}
+#endif
+
 		net_tc_submit_to_rx_queue(tc, pkt);
 	}
 }
@@ -36,6 +36,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "ipv6.h"
 
 #include "net_stats.h"
+#include "lpm.h"
 
 #define REACHABLE_TIME (MSEC_PER_SEC * 30) /* in ms */
 /*
@@ -1011,6 +1012,231 @@ void net_if_mcast_monitor(struct net_if *iface,
 #define net_if_mcast_monitor(...)
 #endif /* CONFIG_NET_NATIVE_IPV4 || CONFIG_NET_NATIVE_IPV6 */
 
+#if defined(CONFIG_NET_LPM_TRIE) && \
+	(defined(CONFIG_NET_NATIVE_IPV4) || defined(CONFIG_NET_NATIVE_IPV6))
+/* Unicast addresses of all the interfaces are kept in a trie so that the
+ * interface owning an address can be found without scanning every
+ * interface.
+ */
+struct addr_index_entry {
+	sys_snode_t node;
+	struct net_if *iface;
+	struct net_if_addr *ifaddr;
+	/* Copy of the address the entry was inserted with */
+	uint8_t key[sizeof(struct in6_addr)];
+	uint8_t key_bits;
+};
+
+struct addr_index {
+	struct net_lpm lpm;
+	struct addr_index_entry *entries;
+	size_t count;
+};
+
+static struct k_spinlock addr_index_lock;
+
+#if defined(CONFIG_NET_NATIVE_IPV6)
+#define IPV6_ADDR_INDEX_COUNT (CONFIG_NET_IF_MAX_IPV6_COUNT * NET_IF_MAX_IPV6_ADDR)
+
+static struct addr_index_entry ipv6_addr_index_entries[IPV6_ADDR_INDEX_COUNT];
+static struct net_lpm_node ipv6_addr_index_nodes[NET_LPM_NODES(IPV6_ADDR_INDEX_COUNT)];
+static struct addr_index ipv6_addr_index = {
+	.entries = ipv6_addr_index_entries,
+	.count = ARRAY_SIZE(ipv6_addr_index_entries),
+};
+#endif
+
+#if defined(CONFIG_NET_NATIVE_IPV4)
+#define IPV4_ADDR_INDEX_COUNT (CONFIG_NET_IF_MAX_IPV4_COUNT * NET_IF_MAX_IPV4_ADDR)
+
+static struct addr_index_entry ipv4_addr_index_entries[IPV4_ADDR_INDEX_COUNT];
+static struct net_lpm_node ipv4_addr_index_nodes[NET_LPM_NODES(IPV4_ADDR_INDEX_COUNT)];
+static struct addr_index ipv4_addr_index = {
+	.entries = ipv4_addr_index_entries,
+	.count = ARRAY_SIZE(ipv4_addr_index_entries),
+};
+#endif
+
+static struct addr_index *addr_index_get(sa_family_t family)
+{
+#if defined(CONFIG_NET_NATIVE_IPV6)
+	if (family == AF_INET6) {
+		return &ipv6_addr_index;
+	}
+#endif
+#if defined(CONFIG_NET_NATIVE_IPV4)
+	if (family == AF_INET) {
+		return &ipv4_addr_index;
+	}
+#endif
+	return NULL;
+}
+
+static inline uint8_t addr_index_key_bits(sa_family_t family)
+{
+	return family == AF_INET6 ? sizeof(struct in6_addr) * 8 :
+				    sizeof(struct in_addr) * 8;
+}
+
+static void addr_index_entry_del(struct addr_index *index,
+				 struct addr_index_entry *entry)
+{
+	(void)net_lpm_remove(&index->lpm, entry->key, entry->key_bits,
+			     &entry->node);
+	entry->ifaddr = NULL;
+	entry->iface = NULL;
+}
+
+static void addr_index_del(struct net_if_addr *ifaddr)
+{
+	struct addr_index *index = addr_index_get(ifaddr->address.family);
+	k_spinlock_key_t key;
+
+	if (index == NULL) {
+		return;
+	}
+
+	key = k_spin_lock(&addr_index_lock);
+
+	for (size_t i = 0; i < index->count; i++) {
+		if (index->entries[i].ifaddr == ifaddr) {
+			addr_index_entry_del(index, &index->entries[i]);
+			break;
+		}
+	}
+
+	k_spin_unlock(&addr_index_lock, key);
+}
+
+static void addr_index_del_iface(sa_family_t family, struct net_if *iface)
+{
+	struct addr_index *index = addr_index_get(family);
+	k_spinlock_key_t key;
+
+	if (index == NULL) {
+		return;
+	}
+
+	key = k_spin_lock(&addr_index_lock);
+
+	for (size_t i = 0; i < index->count; i++) {
+		if (index->entries[i].iface == iface) {
+			addr_index_entry_del(index, &index->entries[i]);
+		}
+	}
+
+	k_spin_unlock(&addr_index_lock, key);
+}
+
+static void addr_index_add(struct net_if *iface, struct net_if_addr *ifaddr)
+{
+	struct addr_index *index = addr_index_get(ifaddr->address.family);
+	struct addr_index_entry *entry = NULL;
+	k_spinlock_key_t key;
+
+	if (index == NULL) {
+		return;
+	}
+
+	addr_index_del(ifaddr);
+
+	key = k_spin_lock(&addr_index_lock);
+
+	for (size_t i = 0; i < index->count; i++) {
+		if (index->entries[i].ifaddr == NULL) {
+			entry = &index->entries[i];
+			break;
+		}
+	}
+
+	/* There is one entry for every address slot of every interface */
+	NET_ASSERT(entry != NULL);
+
+	entry->iface = iface;
+	entry->ifaddr = ifaddr;
+	entry->key_bits = addr_index_key_bits(ifaddr->address.family);
+	memcpy(entry->key, &ifaddr->address.in6_addr, entry->key_bits / 8);
+
+	if (net_lpm_insert(&index->lpm, entry->key, entry->key_bits,
+			   &entry->node) < 0) {
+		entry->iface = NULL;
+		entry->ifaddr = NULL;
+	}
+
+	k_spin_unlock(&addr_index_lock, key);
+}
+
+static bool addr_index_match(sys_snode_t *node, void *user_data)
+{
+	struct addr_index_entry *entry =
+		CONTAINER_OF(node, struct addr_index_entry, node);
+
+	ARG_UNUSED(user_data);
+
+	return entry->ifaddr->is_used;
+}
+
+static struct net_if_addr *addr_index_lookup(sa_family_t family,
+					     const uint8_t *addr,
+					     struct net_if **ret)
+{
+	struct addr_index *index = addr_index_get(family);
+	struct net_if_addr *ifaddr = NULL;
+	struct addr_index_entry *entry;
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+
+	if (index == NULL) {
+		return NULL;
+	}
+
+	key = k_spin_lock(&addr_index_lock);
+
+	node = net_lpm_lookup(&index->lpm, addr, addr_index_match, NULL);
+	if (node != NULL) {
+		entry = CONTAINER_OF(node, struct addr_index_entry, node);
+		ifaddr = entry->ifaddr;
+
+		if (ret) {
+			*ret = entry->iface;
+		}
+	}
+
+	k_spin_unlock(&addr_index_lock, key);
+
+	return ifaddr;
+}
+
+static void addr_index_init(void)
+{
+#if defined(CONFIG_NET_NATIVE_IPV6)
+	net_lpm_init(&ipv6_addr_index.lpm, ipv6_addr_index_nodes,
+		     ARRAY_SIZE(ipv6_addr_index_nodes),
+		     addr_index_key_bits(AF_INET6));
+#endif
+#if defined(CONFIG_NET_NATIVE_IPV4)
+	net_lpm_init(&ipv4_addr_index.lpm, ipv4_addr_index_nodes,
+		     ARRAY_SIZE(ipv4_addr_index_nodes),
+		     addr_index_key_bits(AF_INET));
+#endif
+}
+#else
+#define addr_index_init(...)
+#define addr_index_add(...)
+#define addr_index_del(...)
+#define addr_index_del_iface(...)
+static inline struct net_if_addr *addr_index_lookup(sa_family_t family,
+						    const uint8_t *addr,
+						    struct net_if **ret)
+{
+	ARG_UNUSED(family);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(ret);
+
+	return NULL;
+}
+#endif /* CONFIG_NET_LPM_TRIE */
+
 #if defined(CONFIG_NET_NATIVE_IPV6)
 int net_if_config_ipv6_get(struct net_if *iface, struct net_if_ipv6 **ipv6)
 {
@@ -1083,6 +1309,8 @@ int net_if_config_ipv6_put(struct net_if *iface)
 			continue;
 		}
 
+		addr_index_del_iface(AF_INET6, iface);
+
 		iface->config.ip.ipv6 = NULL;
 		ipv6_addresses[i].iface = NULL;
 
@@ -1553,6 +1781,10 @@ struct net_if_addr *net_if_ipv6_addr_lookup(const struct in6_addr *addr,
 {
 	struct net_if_addr *ifaddr = NULL;
 
+	if (IS_ENABLED(CONFIG_NET_LPM_TRIE)) {
+		return addr_index_lookup(AF_INET6, addr->s6_addr, ret);
+	}
+
 	STRUCT_SECTION_FOREACH(net_if, iface) {
 		struct net_if_ipv6 *ipv6;
 
@@ -1901,6 +2133,7 @@ struct net_if_addr *net_if_ipv6_addr_add(struct net_if *iface,
 
 		net_if_addr_init(&ipv6->unicast[i], addr, addr_type,
 				 vlifetime);
+		addr_index_add(iface, &ipv6->unicast[i]);
 
 		NET_DBG("[%zu] interface %d (%p) address %s type %s added", i,
 			net_if_get_by_iface(iface), iface,
@@ -3331,6 +3564,8 @@ int net_if_config_ipv4_put(struct net_if *iface)
 			continue;
 		}
 
+		addr_index_del_iface(AF_INET, iface);
+
 		iface->config.ip.ipv4 = NULL;
 		ipv4_addresses[i].iface = NULL;
 
@@ -3743,6 +3978,10 @@ struct net_if_addr *net_if_ipv4_addr_lookup(const struct in_addr *addr,
 {
 	struct net_if_addr *ifaddr = NULL;
 
+	if (IS_ENABLED(CONFIG_NET_LPM_TRIE)) {
+		return addr_index_lookup(AF_INET, addr->s4_addr, ret);
+	}
+
 	STRUCT_SECTION_FOREACH(net_if, iface) {
 		struct net_if_ipv4 *ipv4;
 
@@ -4268,6 +4507,7 @@ struct net_if_addr *net_if_ipv4_addr_add(struct net_if *iface,
 		ifaddr->address.family = AF_INET;
 		ifaddr->address.in_addr.s4_addr32[0] =
 						addr->s4_addr32[0];
+		addr_index_add(iface, ifaddr);
 		ifaddr->addr_type = addr_type;
 		ifaddr->atomic_ref = ATOMIC_INIT(1);
 
@@ -5005,6 +5245,7 @@ int net_if_addr_unref(struct net_if *iface,
 		return ref - 1;
 	}
 
+	addr_index_del(ifaddr);
 	ifaddr->is_used = false;
 
 	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6 && addr != NULL) {
@@ -5034,6 +5275,101 @@ enum net_verdict net_if_recv_data(struct net_if *iface, struct net_pkt *pkt)
 	return net_if_l2(iface)->recv(iface, pkt);
 }
 
+#if defined(CONFIG_NET_RX_STEERING)
+static inline uint32_t flow_hash_mix(uint32_t hash, uint32_t val)
+{
+	hash ^= val;
+	hash *= 0x9e3779b1U;
+
+	return hash ^ (hash >> 16);
+}
+
+/* Compute a hash of the addresses, protocol and ports of a received packet.
+ * Only the headers in the first buffer are looked at, packets that cannot
+ * be parsed there get hash 0 and are all steered to the same queue.
+ * Fragments are hashed without the ports, so that all the fragments of a
+ * datagram end up in the same queue.
+ */
+uint32_t net_if_flow_hash(struct net_if *iface, struct net_pkt *pkt)
+{
+	const uint8_t *data = pkt->buffer->data;
+	size_t len = pkt->buffer->len;
+	uint32_t hash = 0U;
+	bool ports = true;
+	size_t hdr_len;
+	uint8_t proto;
+
+	if (IS_ENABLED(CONFIG_NET_L2_ETHERNET) &&
+	    net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		uint16_t type;
+
+		if (len < sizeof(struct net_eth_hdr)) {
+			return 0U;
+		}
+
+		type = ntohs(((const struct net_eth_hdr *)data)->type);
+		data += sizeof(struct net_eth_hdr);
+		len -= sizeof(struct net_eth_hdr);
+
+		if (type == NET_ETH_PTYPE_VLAN) {
+			if (len < sizeof(uint32_t)) {
+				return 0U;
+			}
+
+			data += sizeof(uint32_t);
+			len -= sizeof(uint32_t);
+		}
+	}
+
+	if (len < NET_IPV4H_LEN) {
+		return 0U;
+	}
+
+	switch (data[0] >> 4) {
+	case 4:
+		hdr_len = (data[0] & NET_IPV4_IHL_MASK) * 4U;
+		proto = data[9];
+
+		if (sys_get_be16(&data[6]) &
+		    ((NET_IPV4_MF << 13) | NET_IPV4_FRAGH_OFFSET_MASK)) {
+			ports = false;
+		}
+
+		hash = flow_hash_mix(hash, UNALIGNED_GET((uint32_t *)&data[12]));
+		hash = flow_hash_mix(hash, UNALIGNED_GET((uint32_t *)&data[16]));
+		break;
+
+	case 6:
+		if (len < NET_IPV6H_LEN) {
+			return 0U;
+		}
+
+		hdr_len = NET_IPV6H_LEN;
+		proto = data[6];
+
+		for (int i = 8; i < NET_IPV6H_LEN; i += sizeof(uint32_t)) {
+			hash = flow_hash_mix(hash,
+					     UNALIGNED_GET((uint32_t *)&data[i]));
+		}
+		break;
+
+	default:
+		return 0U;
+	}
+
+	if (ports && (proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    len >= hdr_len + sizeof(uint32_t)) {
+		hash = flow_hash_mix(hash,
+				     UNALIGNED_GET((uint32_t *)&data[hdr_len]));
+	}
+
+	hash = flow_hash_mix(hash, proto);
+
+	/* 0 means that the hash is not known */
+	return hash != 0U ? hash : 1U;
+}
+#endif /* CONFIG_NET_RX_STEERING */
+
 void net_if_register_link_cb(struct net_if_link_cb *link,
 			     net_if_link_callback_t cb)
 {
@@ -5923,6 +6259,7 @@ void net_if_init(void)
 	NET_ASSERT(count_if == if_count);
 #endif
 
+	addr_index_init();
 	iface_ipv6_init(if_count);
 	iface_ipv4_init(if_count);
 	iface_router_init();
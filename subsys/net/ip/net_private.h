@@ -62,6 +62,10 @@ extern void net_if_stats_reset_all(void);
 extern void net_process_rx_packet(struct net_pkt *pkt);
 extern void net_process_tx_packet(struct net_pkt *pkt);
 
+#if defined(CONFIG_NET_RX_STEERING)
+extern uint32_t net_if_flow_hash(struct net_if *iface, struct net_pkt *pkt);
+#endif
+
 extern int net_icmp_call_ipv4_handlers(struct net_pkt *pkt,
 				       struct net_ipv4_hdr *ipv4_hdr,
 				       struct net_icmp_hdr *icmp_hdr);
@@ -249,6 +253,90 @@ extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/**
+ * @brief Incrementally update a 16-bit field covered by an Internet checksum
+ *
+ * Implements eqn. 3 of RFC 1624, HC' = ~(~HC + ~m + m'). All values are in
+ * host byte order, like the checksums returned by net_calc_chksum(), so field
+ * values read from the packet must be converted with ntohs() first.
+ *
+ * @param chksum	Checksum in host byte order before the change
+ * @param old_val	Old value of the modified 16-bit field in host byte order
+ * @param new_val	New value of the modified 16-bit field in host byte order
+ *
+ * @return Checksum in host byte order after the change
+ */
+static inline uint16_t net_chksum_update16(uint16_t chksum, uint16_t old_val,
+					   uint16_t new_val)
+{
+	uint32_t sum = (uint16_t)~chksum + (uint16_t)~old_val + new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return (uint16_t)~sum;
+}
+
+/**
+ * @brief Incrementally update a 32-bit field covered by an Internet checksum
+ *
+ * Same as net_chksum_update16() but for 32-bit fields such as IPv4 addresses
+ * or TCP sequence numbers. The field must start at an even offset of the
+ * checksummed data. All values are in host byte order, field values read from
+ * the packet must be converted with ntohl() first.
+ *
+ * @param chksum	Checksum in host byte order before the change
+ * @param old_val	Old value of the modified 32-bit field in host byte order
+ * @param new_val	New value of the modified 32-bit field in host byte order
+ *
+ * @return Checksum in host byte order after the change
+ */
+static inline uint16_t net_chksum_update32(uint16_t chksum, uint32_t old_val,
+					   uint32_t new_val)
+{
+	chksum = net_chksum_update16(chksum, (uint16_t)(old_val >> 16),
+				     (uint16_t)(new_val >> 16));
+
+	return net_chksum_update16(chksum, (uint16_t)old_val, (uint16_t)new_val);
+}
+
+/**
+ * @brief Incrementally update an Internet checksum after rewriting a buffer
+ *
+ * Useful when rewriting a larger area of a header, for instance an IPv6
+ * address when doing NAT or forwarding. The rewritten area must start at an
+ * even offset of the checksummed data. The areas are raw packet content, the
+ * checksum is in host byte order like for net_chksum_update16().
+ *
+ * @param chksum	Checksum in host byte order before the change
+ * @param old_data	Old content of the modified area
+ * @param new_data	New content of the modified area
+ * @param len		Length of the modified area
+ *
+ * @return Checksum in host byte order after the change
+ */
+extern uint16_t net_chksum_update(uint16_t chksum, const uint8_t *old_data,
+				  const uint8_t *new_data, size_t len);
+
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+/**
+ * @brief Wrap caller data into external data network buffers
+ *
+ * Each returned fragment references @a zc, which is released once the
+ * fragment is freed.
+ *
+ * @param zc		Zero-copy descriptor
+ * @param msghdr	Data to wrap
+ * @param len		Maximum number of bytes to wrap
+ * @param timeout	Timeout for the buffer allocations
+ *
+ * @return Fragment chain, NULL if out of buffers
+ */
+struct net_buf *net_context_zc_wrap(struct net_zc_tx *zc,
+				    const struct msghdr *msghdr,
+				    size_t len, k_timeout_t timeout);
+#endif
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
@@ -21,15 +21,28 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
  * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * With RX steering each traffic class has several queues, and y is the
+ * queue index.
  */
-#define MAX_NAME_LEN sizeof("xx_q[y]")
+#define MAX_NAME_LEN sizeof("xx_q[yyy]")
+
+/* With RX steering, every RX traffic class is split into several queues
+ * which are selected by the flow hash of the packet.
+ */
+#if defined(CONFIG_NET_RX_STEERING)
+#define NET_RX_QUEUES_PER_TC CONFIG_NET_RX_STEERING_QUEUES
+#else
+#define NET_RX_QUEUES_PER_TC 1
+#endif
+
+#define NET_RX_QUEUE_COUNT (NET_TC_RX_COUNT * NET_RX_QUEUES_PER_TC)
 
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_RX_QUEUE_COUNT,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -37,7 +50,7 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[NET_RX_QUEUE_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
@@ -63,9 +76,19 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 #if NET_TC_RX_COUNT > 0
+	int queue = tc;
+
+#if defined(CONFIG_NET_RX_STEERING)
+	/* Packets of the same flow always use the same queue, which keeps
+	 * them in order.
+	 */
+	queue = tc * NET_RX_QUEUES_PER_TC +
+		net_pkt_flow_hash(pkt) % NET_RX_QUEUES_PER_TC;
+#endif
+
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&rx_classes[tc].fifo, pkt);
+	submit_to_queue(&rx_classes[queue].fifo, pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
@@ -354,12 +377,12 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_RX_QUEUE_COUNT; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		thread_priority = rx_tc2thread(i / NET_RX_QUEUES_PER_TC);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -393,6 +416,12 @@ void net_tc_rx_init(void)
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(CONFIG_NET_RX_STEERING) && defined(CONFIG_SCHED_CPU_MASK)
+		/* Spread the queues of a traffic class over the CPUs */
+		(void)k_thread_cpu_pin(tid, (i % NET_RX_QUEUES_PER_TC) %
+					    arch_num_cpus());
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
@@ -28,11 +28,18 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include "icmpv6.h"
 #include "nbr.h"
 #include "route.h"
+#include "lpm.h"
 
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
  */
-static sys_slist_t routes;
+static sys_dlist_t routes = SYS_DLIST_STATIC_INIT(&routes);
+
+#if defined(CONFIG_NET_LPM_TRIE)
+/* Routes indexed by destination prefix, protected by the nbr lock */
+static struct net_lpm_node route_lpm_nodes[NET_LPM_NODES(CONFIG_NET_MAX_ROUTES)];
+static struct net_lpm route_lpm;
+#endif
 
 /* Track currently active route lifetime timers */
 static sys_slist_t active_route_lifetime_timers;
@@ -97,6 +104,13 @@ static struct net_nbr *get_nexthop_route(void)
 static void net_route_entry_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Route %p removed", nbr);
+
+#if defined(CONFIG_NET_LPM_TRIE)
+	struct net_route_entry *route = (struct net_route_entry *)nbr->data;
+
+	(void)net_lpm_remove(&route_lpm, route->addr.s6_addr,
+			     route->prefix_len, &route->lpm_node);
+#endif
 }
 
 static void net_route_entries_table_clear(struct net_nbr_table *table)
@@ -205,6 +219,16 @@ static struct net_nbr *nbr_new(struct net_if *iface,
 	net_ipaddr_copy(&net_route_data(nbr)->addr, addr);
 	net_route_data(nbr)->prefix_len = prefix_len;
 
+#if defined(CONFIG_NET_LPM_TRIE)
+	if (net_lpm_insert(&route_lpm, addr->s6_addr, prefix_len,
+			   &net_route_data(nbr)->lpm_node) < 0) {
+		/* Cannot happen as the trie is sized for all the routes */
+		NET_ERR("Route trie full");
+		net_nbr_unref(nbr);
+		return NULL;
+	}
+#endif
+
 	NET_DBG("[%d] nbr %p iface %p IPv6 %s/%d",
 		nbr->idx, nbr, iface,
 		net_sprint_ipv6_addr(&net_route_data(nbr)->addr),
@@ -263,19 +287,40 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_remove(&route->node);
+	sys_dlist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+#if defined(CONFIG_NET_LPM_TRIE)
+static bool route_iface_match(sys_snode_t *node, void *user_data)
+{
+	struct net_route_entry *route =
+		CONTAINER_OF(node, struct net_route_entry, lpm_node);
+
+	return user_data == NULL || route->iface == user_data;
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
+{
+	sys_snode_t *node;
+
+	node = net_lpm_lookup(&route_lpm, dst->s6_addr, route_iface_match,
+			      iface);
+	if (node == NULL) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(node, struct net_route_entry, lpm_node);
+}
+#else
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	net_ipv6_nbr_lock();
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -298,6 +343,18 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+#endif /* CONFIG_NET_LPM_TRIE */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	net_ipv6_nbr_lock();
+
+	found = route_find(iface, dst);
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -393,9 +450,9 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
+		sys_dnode_t *last = sys_dlist_peek_tail(&routes);
 
-		sys_slist_find_and_remove(&routes, last);
+		sys_dlist_remove(last);
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -444,7 +501,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 
 	net_route_update_lifetime(route, lifetime);
 
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_prepend(&routes, &route->node);
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -586,7 +643,9 @@ int net_route_del(struct net_route_entry *route)
 		}
 	}
 
-	sys_slist_find_and_remove(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -1117,6 +1176,10 @@ void net_route_init(void)
 
 #if defined(CONFIG_NET_ROUTE_MCAST)
 	memset(route_mcast_entries, 0, sizeof(route_mcast_entries));
+#endif
+#if defined(CONFIG_NET_LPM_TRIE)
+	net_lpm_init(&route_lpm, route_lpm_nodes, ARRAY_SIZE(route_lpm_nodes),
+		     sizeof(struct in6_addr) * 8);
 #endif
 	k_work_init_delayable(&route_lifetime_timer, route_lifetime_timeout);
 }
@@ -1612,9 +1612,25 @@ static int tcp_pkt_pull(struct net_pkt *pkt, size_t len)
 		goto out;
 	}
 
+	/* Advance the data pointer of the acknowledged fragments instead of
+	 * moving the remaining data to the front, so zero-copy fragments that
+	 * reference caller memory are never written to.
+	 */
+	while (len > 0 && pkt->buffer != NULL) {
+		struct net_buf *buf = pkt->buffer;
+		size_t rem = MIN(len, buf->len);
+
+		net_buf_pull(buf, rem);
+		len -= rem;
+
+		if (buf->len == 0) {
+			pkt->buffer = buf->frags;
+			buf->frags = NULL;
+			net_buf_unref(buf);
+		}
+	}
+
 	net_pkt_cursor_init(pkt);
-	net_pkt_set_overwrite(pkt, true);
-	net_pkt_pull(pkt, len);
 	net_pkt_trim_buffer(pkt);
  out:
 	return ret;
@@ -3695,7 +3711,7 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 }
 
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
-		  const struct msghdr *msg)
+		  const struct msghdr *msg, struct net_zc_tx *zc)
 {
 	struct tcp *conn = context->tcp;
 	size_t queued_len = 0;
@@ -3731,6 +3747,23 @@ int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 	 */
 	len = MIN(conn->send_win - conn->send_data_total, len);
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	if (zc != NULL) {
+		struct net_buf *frags;
+
+		/* The fragments stay in send_data until the peer has
+		 * acknowledged them, see tcp_pkt_pull().
+		 */
+		frags = net_context_zc_wrap(zc, msg, len, TCP_PKT_ALLOC_TIMEOUT);
+		if (frags == NULL) {
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		queued_len = net_buf_frags_len(frags);
+		net_pkt_append_buffer(conn->send_data, frags);
+	} else
+#endif
 	if (msg) {
 		for (int i = 0; i < msg->msg_iovlen; i++) {
 			int iovlen = MIN(msg->msg_iov[i].iov_len, len);
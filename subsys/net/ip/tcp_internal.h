@@ -293,20 +293,24 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
  * @param data		Pointer to the data
  * @param len		Number of bytes
  * @param msg		Data for a vector array operation
+ * @param zc		Zero-copy descriptor, if not NULL the data in msg is
+ *			referenced instead of copied until it is acknowledged
  *
  * @return 0 if ok, < 0 if error
  */
 #if defined(CONFIG_NET_NATIVE_TCP)
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
-		  const struct msghdr *msg);
+		  const struct msghdr *msg, struct net_zc_tx *zc);
 #else
 static inline int net_tcp_queue(struct net_context *context, const void *data,
-				size_t len, const struct msghdr *msg)
+				size_t len, const struct msghdr *msg,
+				struct net_zc_tx *zc)
 {
 	ARG_UNUSED(context);
 	ARG_UNUSED(data);
 	ARG_UNUSED(len);
 	ARG_UNUSED(msg);
+	ARG_UNUSED(zc);
 
 	return -EPROTONOSUPPORT;
 }
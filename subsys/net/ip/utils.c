@@ -533,12 +533,97 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 	}
 }
 
+#if defined(CONFIG_NET_IP_CHKSUM_VECTORIZED)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CHKSUM_VECTOR_BLOCK 32
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define CHKSUM_VECTOR_BLOCK 16
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CHKSUM_VECTOR_BLOCK 16
+#endif
+#endif /* CONFIG_NET_IP_CHKSUM_VECTORIZED */
+
+#if defined(CHKSUM_VECTOR_BLOCK)
+/* Sum the 32-bit words of a 4-byte aligned buffer into 64-bit vector lanes.
+ * Each lane sees at most len / 4 additions of 32-bit values, so the lanes
+ * cannot overflow for any buffer the network stack can hand us. The caller
+ * folds the remaining tail and the returned partial sum.
+ */
+static uint64_t chksum_vector(const uint8_t *data, size_t *pending)
+{
+	size_t blocks = *pending / CHKSUM_VECTOR_BLOCK;
+	uint64_t lanes[CHKSUM_VECTOR_BLOCK / sizeof(uint64_t)];
+	uint64_t sum = 0;
+
+	if (blocks == 0) {
+		return 0;
+	}
+
+	*pending -= blocks * CHKSUM_VECTOR_BLOCK;
+
+#if defined(__AVX2__)
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i acc_lo = zero;
+	__m256i acc_hi = zero;
+
+	while (blocks-- > 0) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)data);
+
+		acc_lo = _mm256_add_epi64(acc_lo, _mm256_unpacklo_epi32(v, zero));
+		acc_hi = _mm256_add_epi64(acc_hi, _mm256_unpackhi_epi32(v, zero));
+		data += CHKSUM_VECTOR_BLOCK;
+	}
+
+	_mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi64(acc_lo, acc_hi));
+#elif defined(__SSE2__)
+	const __m128i zero = _mm_setzero_si128();
+	__m128i acc_lo = zero;
+	__m128i acc_hi = zero;
+
+	while (blocks-- > 0) {
+		__m128i v = _mm_loadu_si128((const __m128i *)data);
+
+		acc_lo = _mm_add_epi64(acc_lo, _mm_unpacklo_epi32(v, zero));
+		acc_hi = _mm_add_epi64(acc_hi, _mm_unpackhi_epi32(v, zero));
+		data += CHKSUM_VECTOR_BLOCK;
+	}
+
+	_mm_storeu_si128((__m128i *)lanes, _mm_add_epi64(acc_lo, acc_hi));
+#elif defined(__ARM_NEON)
+	uint64x2_t acc = vdupq_n_u64(0);
+
+	while (blocks-- > 0) {
+		acc = vpadalq_u32(acc, vld1q_u32((const uint32_t *)data));
+		data += CHKSUM_VECTOR_BLOCK;
+	}
+
+	vst1q_u64(lanes, acc);
+#endif
+
+	/* Fold every lane to 32 bits before adding so the scalar accumulator
+	 * of the caller keeps its headroom.
+	 */
+	for (size_t i = 0; i < ARRAY_SIZE(lanes); i++) {
+		sum += (lanes[i] & 0xffffffffULL) + (lanes[i] >> 32);
+	}
+
+	return sum;
+}
+#endif /* CHKSUM_VECTOR_BLOCK */
+
 /* Word based checksum calculation based on:
  * https://blogs.igalia.com/dpino/2018/06/14/fast-checksum-computation/
  * It’s not necessary to add octets as 16-bit words. Due to the associative property of addition,
  * it is possible to do parallel addition using larger word sizes such as 32-bit or 64-bit words.
  * In those cases the variable that stores the accumulative sum has to be bigger too.
  * Once the sum is computed a final step folds the sum to a 16-bit word (adding carry if any).
+ *
+ * When CONFIG_NET_IP_CHKSUM_VECTORIZED is set and the compiler targets SSE2, AVX2 or NEON, the
+ * bulk of the buffer is summed with vector instructions. On other 64-bit targets the loop works
+ * on 64-bit words with an explicit carry accumulator.
  */
 uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 {
@@ -568,6 +653,51 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 		sum = sum + *((uint16_t *)data);
 		data += sizeof(uint16_t);
 	}
+
+#if defined(CHKSUM_VECTOR_BLOCK) || defined(CONFIG_64BIT)
+	/* Reach 8 (or vector) byte alignment with 32-bit words, then let the wide loop
+	 * consume as much of the buffer as it can.
+	 */
+	while ((((uintptr_t)data & (sizeof(uint64_t) - 1)) != 0) &&
+	       (pending >= sizeof(uint32_t))) {
+		pending -= sizeof(uint32_t);
+		sum = sum + *((uint32_t *)data);
+		data += sizeof(uint32_t);
+	}
+#endif
+
+#if defined(CHKSUM_VECTOR_BLOCK)
+	if (((uintptr_t)data & (sizeof(uint64_t) - 1)) == 0) {
+		size_t before = pending;
+
+		sum += chksum_vector(data, &pending);
+		data += before - pending;
+	}
+#elif defined(CONFIG_64BIT)
+	if (((uintptr_t)data & (sizeof(uint64_t) - 1)) == 0) {
+		const uint64_t *q = (const uint64_t *)data;
+		uint64_t wide = 0;
+		uint64_t carry = 0;
+
+		while (pending >= sizeof(uint64_t) * 2) {
+			uint64_t a = q[0];
+			uint64_t b = q[1];
+
+			pending -= sizeof(uint64_t) * 2;
+			wide += a;
+			carry += (wide < a);
+			wide += b;
+			carry += (wide < b);
+			q += 2;
+		}
+
+		data = (const uint8_t *)q;
+
+		/* Fold the 64-bit partial and its carries back into the 32-bit domain */
+		sum += (wide & 0xffffffffULL) + (wide >> 32) + carry;
+	}
+#endif
+
 	p = (uint32_t *)data;
 
 	/* Do loop unrolling for the very large data sets */
@@ -610,6 +740,15 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	}
 }
 
+uint16_t net_chksum_update(uint16_t chksum, const uint8_t *old_data,
+			   const uint8_t *new_data, size_t len)
+{
+	uint16_t old_sum = calc_chksum(0, old_data, len);
+	uint16_t new_sum = calc_chksum(0, new_data, len);
+
+	return net_chksum_update16(chksum, old_sum, new_sum);
+}
+
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
@@ -17,6 +17,7 @@ LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
 #include <zephyr/net/coap_mgmt.h>
 #include <zephyr/net/coap_service.h>
 #include <zephyr/posix/fcntl.h>
+#include <zephyr/sys/hash_function.h>
 
 #if defined(CONFIG_NET_TC_THREAD_COOPERATIVE)
 /* Lowest priority cooperative thread */
@@ -35,6 +36,10 @@ LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
 #define MAX_OBSERVERS  CONFIG_COAP_SERVICE_OBSERVERS
 #define MAX_POLL_FD    CONFIG_NET_SOCKETS_POLL_MAX
 
+/* Number of notifications handed to the socket at once */
+#define NOTIFY_BATCH   8
+#define NOTIFY_HDR_SIZE (4U + COAP_TOKEN_MAX_LEN)
+
 BUILD_ASSERT(CONFIG_NET_SOCKETS_POLL_MAX > 0, "CONFIG_NET_SOCKETS_POLL_MAX can't be 0");
 
 static K_MUTEX_DEFINE(lock);
@@ -81,6 +86,256 @@ static inline void coap_server_free(void *ptr)
 #endif
 }
 
+BUILD_ASSERT(MAX_OBSERVERS < UINT16_MAX && MAX_PENDINGS < UINT16_MAX,
+	     "Too many observers or pending messages per service");
+
+/*
+ * Observers are indexed by token and pending messages by message id, so that
+ * matching an incoming message does not depend on the number of entries. The
+ * bucket chains and free lists hold the index of the entry plus one, zero ends
+ * them. Entries that were never used are taken above the high water mark, the
+ * index of a service is valid without any initialization.
+ */
+
+#define OBSERVER_BUCKETS ARRAY_SIZE(((struct coap_service_data *)0)->observer_buckets)
+#define PENDING_BUCKETS  ARRAY_SIZE(((struct coap_service_data *)0)->pending_buckets)
+
+static uint16_t coap_token_bucket(const uint8_t *token, uint8_t tkl)
+{
+	return sys_hash32_fnv1a(token, tkl) % OBSERVER_BUCKETS;
+}
+
+static struct coap_observer *coap_service_observer_alloc(struct coap_service_data *data)
+{
+	uint16_t idx;
+
+	if (data->observer_free != 0U) {
+		idx = data->observer_free - 1U;
+		data->observer_free = data->observer_next[idx];
+	} else if (data->observer_used < MAX_OBSERVERS) {
+		idx = data->observer_used++;
+	} else {
+		return NULL;
+	}
+
+	return &data->observers[idx];
+}
+
+static void coap_service_observer_link(struct coap_service_data *data,
+				       struct coap_observer *obs)
+{
+	uint16_t idx = obs - data->observers;
+	uint16_t *bucket = &data->observer_buckets[coap_token_bucket(obs->token, obs->tkl)];
+
+	data->observer_next[idx] = *bucket;
+	*bucket = idx + 1U;
+}
+
+/* Unlink an observer from the token index and return it to the free list */
+static void coap_service_observer_free(struct coap_service_data *data,
+				       struct coap_observer *obs)
+{
+	uint16_t idx = obs - data->observers;
+	uint16_t *link = &data->observer_buckets[coap_token_bucket(obs->token, obs->tkl)];
+
+	while (*link != 0U) {
+		if (*link == idx + 1U) {
+			*link = data->observer_next[idx];
+			break;
+		}
+
+		link = &data->observer_next[*link - 1U];
+	}
+
+	memset(obs, 0, sizeof(*obs));
+
+	data->observer_next[idx] = data->observer_free;
+	data->observer_free = idx + 1U;
+}
+
+static struct coap_observer *coap_service_find_observer(struct coap_service_data *data,
+							 const struct sockaddr *addr,
+							 const uint8_t *token, uint8_t tkl)
+{
+	uint16_t idx;
+
+	if (tkl == 0U || tkl > COAP_TOKEN_MAX_LEN) {
+		return NULL;
+	}
+
+	for (idx = data->observer_buckets[coap_token_bucket(token, tkl)]; idx != 0U;
+	     idx = data->observer_next[idx - 1U]) {
+		struct coap_observer *obs = &data->observers[idx - 1U];
+
+		if (obs->tkl != tkl || memcmp(obs->token, token, tkl) != 0) {
+			continue;
+		}
+
+		/* Use the observers array as a one entry list to compare the address */
+		if (addr == NULL || coap_find_observer_by_addr(obs, 1, addr) != NULL) {
+			return obs;
+		}
+	}
+
+	return NULL;
+}
+
+static inline int64_t coap_pending_deadline(const struct coap_pending *pending)
+{
+	return pending->t0 + pending->timeout;
+}
+
+static void coap_pending_heap_set(struct coap_service_data *data, uint16_t pos, uint16_t idx)
+{
+	data->pending_heap[pos] = idx;
+	data->pending_heap_pos[idx] = pos;
+}
+
+static void coap_pending_heap_up(struct coap_service_data *data, uint16_t pos)
+{
+	uint16_t idx = data->pending_heap[pos];
+	int64_t deadline = coap_pending_deadline(&data->pending[idx]);
+
+	while (pos > 0U) {
+		uint16_t parent = (pos - 1U) / 2U;
+
+		if (coap_pending_deadline(&data->pending[data->pending_heap[parent]]) <=
+		    deadline) {
+			break;
+		}
+
+		coap_pending_heap_set(data, pos, data->pending_heap[parent]);
+		pos = parent;
+	}
+
+	coap_pending_heap_set(data, pos, idx);
+}
+
+static void coap_pending_heap_down(struct coap_service_data *data, uint16_t pos)
+{
+	uint16_t idx = data->pending_heap[pos];
+	int64_t deadline = coap_pending_deadline(&data->pending[idx]);
+
+	while (true) {
+		uint16_t child = 2U * pos + 1U;
+
+		if (child >= data->pending_count) {
+			break;
+		}
+
+		if (child + 1U < data->pending_count &&
+		    coap_pending_deadline(&data->pending[data->pending_heap[child + 1U]]) <
+		    coap_pending_deadline(&data->pending[data->pending_heap[child]])) {
+			child++;
+		}
+
+		if (coap_pending_deadline(&data->pending[data->pending_heap[child]]) >=
+		    deadline) {
+			break;
+		}
+
+		coap_pending_heap_set(data, pos, data->pending_heap[child]);
+		pos = child;
+	}
+
+	coap_pending_heap_set(data, pos, idx);
+}
+
+/* Return the pending message with the earliest retransmission deadline */
+static inline struct coap_pending *coap_service_next_to_expire(struct coap_service_data *data)
+{
+	if (data->pending_count == 0U) {
+		return NULL;
+	}
+
+	return &data->pending[data->pending_heap[0]];
+}
+
+static struct coap_pending *coap_service_pending_alloc(struct coap_service_data *data)
+{
+	uint16_t idx;
+
+	if (data->pending_free != 0U) {
+		idx = data->pending_free - 1U;
+		data->pending_free = data->pending_next[idx];
+	} else if (data->pending_used < MAX_PENDINGS) {
+		idx = data->pending_used++;
+	} else {
+		return NULL;
+	}
+
+	return &data->pending[idx];
+}
+
+static void coap_service_pending_release(struct coap_service_data *data,
+					 struct coap_pending *pending)
+{
+	uint16_t idx = pending - data->pending;
+
+	data->pending_next[idx] = data->pending_free;
+	data->pending_free = idx + 1U;
+}
+
+/* Index a pending message once its first transmission has been scheduled */
+static void coap_service_pending_add(struct coap_service_data *data,
+				     struct coap_pending *pending)
+{
+	uint16_t idx = pending - data->pending;
+	uint16_t *bucket = &data->pending_buckets[pending->id % PENDING_BUCKETS];
+
+	data->pending_next[idx] = *bucket;
+	*bucket = idx + 1U;
+
+	coap_pending_heap_set(data, data->pending_count++, idx);
+	coap_pending_heap_up(data, data->pending_count - 1U);
+}
+
+/* Drop a pending message from the indexes, free its data and its entry */
+static void coap_service_pending_remove(struct coap_service_data *data,
+					struct coap_pending *pending)
+{
+	uint16_t idx = pending - data->pending;
+	uint16_t *link = &data->pending_buckets[pending->id % PENDING_BUCKETS];
+	uint16_t pos = data->pending_heap_pos[idx];
+
+	while (*link != 0U) {
+		if (*link == idx + 1U) {
+			*link = data->pending_next[idx];
+			break;
+		}
+
+		link = &data->pending_next[*link - 1U];
+	}
+
+	if (--data->pending_count > pos) {
+		coap_pending_heap_set(data, pos, data->pending_heap[data->pending_count]);
+		coap_pending_heap_up(data, pos);
+		coap_pending_heap_down(data, data->pending_heap_pos[data->pending_heap[pos]]);
+	}
+
+	coap_server_free(pending->data);
+	coap_pending_clear(pending);
+	coap_service_pending_release(data, pending);
+}
+
+static struct coap_pending *coap_service_pending_received(struct coap_service_data *data,
+							   const struct coap_packet *response)
+{
+	uint16_t id = coap_header_get_id(response);
+	uint16_t idx;
+
+	for (idx = data->pending_buckets[id % PENDING_BUCKETS]; idx != 0U;
+	     idx = data->pending_next[idx - 1U]) {
+		struct coap_pending *pending = &data->pending[idx - 1U];
+
+		if (pending->timeout != 0U && pending->id == id) {
+			return pending;
+		}
+	}
+
+	return NULL;
+}
+
 static int coap_service_remove_observer(const struct coap_service *service,
 					struct coap_resource *resource,
 					const struct sockaddr *addr,
@@ -88,13 +343,9 @@ static int coap_service_remove_observer(const struct coap_service *service,
 {
 	struct coap_observer *obs;
 
-	if (tkl > 0 && addr != NULL) {
-		/* Prefer addr+token to find the observer */
-		obs = coap_find_observer(service->data->observers, MAX_OBSERVERS, addr, token, tkl);
-	} else if (tkl > 0) {
-		/* Then try to find the observer by token */
-		obs = coap_find_observer_by_token(service->data->observers, MAX_OBSERVERS, token,
-						  tkl);
+	if (tkl > 0) {
+		/* Prefer addr+token, then token only to find the observer */
+		obs = coap_service_find_observer(service->data, addr, token, tkl);
 	} else if (addr != NULL) {
 		obs = coap_find_observer_by_addr(service->data->observers, MAX_OBSERVERS, addr);
 	} else {
@@ -109,12 +360,12 @@ static int coap_service_remove_observer(const struct coap_service *service,
 	if (resource == NULL) {
 		COAP_SERVICE_FOREACH_RESOURCE(service, it) {
 			if (coap_remove_observer(it, obs)) {
-				memset(obs, 0, sizeof(*obs));
+				coap_service_observer_free(service->data, obs);
 				return 1;
 			}
 		}
 	} else if (coap_remove_observer(resource, obs)) {
-		memset(obs, 0, sizeof(*obs));
+		coap_service_observer_free(service->data, obs);
 		return 1;
 	}
 
@@ -170,7 +421,7 @@ static int coap_server_process(int sock_fd)
 
 	type = coap_header_get_type(&request);
 
-	pending = coap_pending_received(&request, service->data->pending, MAX_PENDINGS);
+	pending = coap_service_pending_received(service->data, &request);
 	if (pending) {
 		uint8_t token[COAP_TOKEN_MAX_LEN];
 		uint8_t tkl;
@@ -181,8 +432,7 @@ static int coap_server_process(int sock_fd)
 			coap_service_remove_observer(service, NULL, &client_addr, token, tkl);
 			__fallthrough;
 		case COAP_TYPE_ACK:
-			coap_server_free(pending->data);
-			coap_pending_clear(pending);
+			coap_service_pending_remove(service->data, pending);
 			break;
 		default:
 			LOG_WRN("Unexpected pending type %d", type);
@@ -256,7 +506,6 @@ unlock:
 static void coap_server_retransmit(void)
 {
 	struct coap_pending *pending;
-	int64_t remaining;
 	int64_t now = k_uptime_get();
 	int ret;
 
@@ -267,19 +516,21 @@ static void coap_server_retransmit(void)
 			continue;
 		}
 
-		pending = coap_pending_next_to_expire(service->data->pending, MAX_PENDINGS);
-		if (pending == NULL) {
-			/* No work to be done */
-			continue;
-		}
+		/* Handle all the expired pending requests, earliest first */
+		while ((pending = coap_service_next_to_expire(service->data)) != NULL &&
+		       coap_pending_deadline(pending) <= now) {
+			if (!coap_pending_cycle(pending)) {
+				LOG_WRN("Packet retransmission failed for %s", service->name);
 
-		/* Check if the pending request has expired */
-		remaining = pending->t0 + pending->timeout - now;
-		if (remaining > 0) {
-			continue;
-		}
+				coap_service_remove_observer(service, NULL, &pending->addr,
+							     NULL, 0U);
+				coap_service_pending_remove(service->data, pending);
+				continue;
+			}
+
+			/* The deadline of the heap root moved later */
+			coap_pending_heap_down(service->data, 0U);
 
-		if (coap_pending_cycle(pending)) {
 			ret = zsock_sendto(service->data->sock_fd, pending->data, pending->len, 0,
 					   &pending->addr, ADDRLEN(&pending->addr));
 			if (ret < 0) {
@@ -287,12 +538,6 @@ static void coap_server_retransmit(void)
 					service->name, ret);
 			}
 			__ASSERT_NO_MSG(ret == pending->len);
-		} else {
-			LOG_WRN("Packet retransmission failed for %s", service->name);
-
-			coap_service_remove_observer(service, NULL, &pending->addr, NULL, 0U);
-			coap_server_free(pending->data);
-			coap_pending_clear(pending);
 		}
 	}
 
@@ -311,12 +556,12 @@ static int coap_server_poll_timeout(void)
 			continue;
 		}
 
-		pending = coap_pending_next_to_expire(svc->data->pending, MAX_PENDINGS);
+		pending = coap_service_next_to_expire(svc->data);
 		if (pending == NULL) {
 			continue;
 		}
 
-		remaining = pending->t0 + pending->timeout - now;
+		remaining = coap_pending_deadline(pending) - now;
 		if (result > remaining) {
 			result = remaining;
 		}
@@ -519,6 +764,48 @@ int coap_service_is_running(const struct coap_service *service)
 	return ret;
 }
 
+/*
+ * Start tracking a confirmable message for retransmission, lock must be held. The message is
+ * @p cpkt followed by @p tail_len bytes from @p tail.
+ */
+static int coap_service_track(const struct coap_service *service, const struct coap_packet *cpkt,
+			      const uint8_t *tail, uint16_t tail_len,
+			      const struct sockaddr *addr,
+			      const struct coap_transmission_parameters *params)
+{
+	struct coap_pending *pending = coap_service_pending_alloc(service->data);
+	int ret;
+
+	if (pending == NULL) {
+		LOG_WRN("No pending message available for %s", service->name);
+		return -ENOMEM;
+	}
+
+	ret = coap_pending_init(pending, cpkt, addr, params);
+	if (ret < 0) {
+		LOG_WRN("Failed to init pending message for %s (%d)", service->name, ret);
+		coap_service_pending_release(service->data, pending);
+		return ret;
+	}
+
+	/* Replace tracked data with our allocated copy */
+	pending->len += tail_len;
+	pending->data = coap_server_alloc(pending->len);
+	if (pending->data == NULL) {
+		LOG_WRN("Failed to allocate pending message data for %s", service->name);
+		coap_pending_clear(pending);
+		coap_service_pending_release(service->data, pending);
+		return -ENOMEM;
+	}
+	memcpy(pending->data, cpkt->data, cpkt->offset);
+	memcpy(pending->data + cpkt->offset, tail, tail_len);
+
+	coap_pending_cycle(pending);
+	coap_service_pending_add(service->data, pending);
+
+	return 0;
+}
+
 int coap_service_send(const struct coap_service *service, const struct coap_packet *cpkt,
 		      const struct sockaddr *addr, socklen_t addr_len,
 		      const struct coap_transmission_parameters *params)
@@ -541,32 +828,8 @@ int coap_service_send(const struct coap_service *service, const struct coap_pack
 	 * Check if we should start with retransmits, if creating a pending message fails we still
 	 * try to send.
 	 */
-	if (coap_header_get_type(cpkt) == COAP_TYPE_CON) {
-		struct coap_pending *pending = coap_pending_next_unused(service->data->pending,
-									MAX_PENDINGS);
-
-		if (pending == NULL) {
-			LOG_WRN("No pending message available for %s", service->name);
-			goto send;
-		}
-
-		ret = coap_pending_init(pending, cpkt, addr, params);
-		if (ret < 0) {
-			LOG_WRN("Failed to init pending message for %s (%d)", service->name, ret);
-			goto send;
-		}
-
-		/* Replace tracked data with our allocated copy */
-		pending->data = coap_server_alloc(pending->len);
-		if (pending->data == NULL) {
-			LOG_WRN("Failed to allocate pending message data for %s", service->name);
-			coap_pending_clear(pending);
-			goto send;
-		}
-		memcpy(pending->data, cpkt->data, pending->len);
-
-		coap_pending_cycle(pending);
-
+	if (coap_header_get_type(cpkt) == COAP_TYPE_CON &&
+	    coap_service_track(service, cpkt, NULL, 0U, addr, params) == 0) {
 		/* Trigger event in receive loop to schedule retransmit */
 		coap_server_update_services();
 	}
@@ -598,6 +861,106 @@ int coap_resource_send(const struct coap_resource *resource, const struct coap_p
 	return -ENOENT;
 }
 
+static int coap_service_send_batch(const struct coap_service *service,
+				   struct zsock_mmsghdr *msgs, int count)
+{
+	int ret;
+
+	ret = zsock_sendmmsg(service->data->sock_fd, msgs, count, 0);
+	if (ret < 0) {
+		LOG_ERR("Failed to send CoAP notifications for %s (%d)", service->name, -errno);
+		return 0;
+	}
+
+	return ret;
+}
+
+int coap_resource_notify_observers(struct coap_resource *resource, const struct coap_packet *cpkt,
+				   const struct coap_transmission_parameters *params)
+{
+	/* Only used with the lock held */
+	static struct zsock_mmsghdr msgs[NOTIFY_BATCH];
+	static struct iovec iov[NOTIFY_BATCH][2];
+	static uint8_t hdrs[NOTIFY_BATCH][NOTIFY_HDR_SIZE];
+
+	const struct coap_service *service = NULL;
+	const uint8_t *tail = cpkt->data + cpkt->hdr_len;
+	uint16_t tail_len = cpkt->offset - cpkt->hdr_len;
+	uint8_t type = coap_header_get_type(cpkt);
+	uint8_t code = coap_header_get_code(cpkt);
+	bool tracked = false;
+	struct coap_observer *obs;
+	int batch = 0;
+	int count = 0;
+	int ret;
+
+	/* Find owning service */
+	COAP_SERVICE_FOREACH(svc) {
+		if (COAP_SERVICE_HAS_RESOURCE(svc, resource)) {
+			service = svc;
+			break;
+		}
+	}
+
+	if (service == NULL) {
+		return -ENOENT;
+	}
+
+	(void)k_mutex_lock(&lock, K_FOREVER);
+
+	if (service->data->sock_fd < 0) {
+		(void)k_mutex_unlock(&lock);
+		return -EBADF;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&resource->observers, obs, list) {
+		struct coap_packet hdr;
+
+		/* Only the header and the token differ between the observers */
+		ret = coap_packet_init(&hdr, hdrs[batch], sizeof(hdrs[batch]), COAP_VERSION_1,
+				       type, obs->tkl, obs->token, code, coap_next_id());
+		if (ret < 0) {
+			LOG_ERR("Failed to init notification header (%d)", ret);
+			continue;
+		}
+
+		if (type == COAP_TYPE_CON &&
+		    coap_service_track(service, &hdr, tail, tail_len, &obs->addr, params) == 0) {
+			tracked = true;
+		}
+
+		iov[batch][0].iov_base = hdrs[batch];
+		iov[batch][0].iov_len = hdr.offset;
+		iov[batch][1].iov_base = (void *)tail;
+		iov[batch][1].iov_len = tail_len;
+
+		msgs[batch].msg_hdr = (struct msghdr) {
+			.msg_name = &obs->addr,
+			.msg_namelen = ADDRLEN(&obs->addr),
+			.msg_iov = iov[batch],
+			.msg_iovlen = ARRAY_SIZE(iov[batch]),
+		};
+
+		if (++batch == NOTIFY_BATCH) {
+			count += coap_service_send_batch(service, msgs, batch);
+			batch = 0;
+		}
+	}
+
+	if (batch > 0) {
+		count += coap_service_send_batch(service, msgs, batch);
+	}
+
+	(void)k_mutex_unlock(&lock);
+
+	if (tracked) {
+		/* Trigger event in receive loop to schedule retransmits */
+		coap_server_update_services();
+	}
+
+	return count;
+}
+
 int coap_resource_parse_observe(struct coap_resource *resource, const struct coap_packet *request,
 				const struct sockaddr *addr)
 {
@@ -638,21 +1001,21 @@ int coap_resource_parse_observe(struct coap_resource *resource, const struct coa
 		struct coap_observer *observer;
 
 		/* RFC7641 section 4.1 - Check if the current observer already exists */
-		observer = coap_find_observer(service->data->observers, MAX_OBSERVERS, addr, token,
-					      tkl);
+		observer = coap_service_find_observer(service->data, addr, token, tkl);
 		if (observer != NULL) {
 			/* Client refresh */
 			goto unlock;
 		}
 
 		/* New client */
-		observer = coap_observer_next_unused(service->data->observers, MAX_OBSERVERS);
+		observer = coap_service_observer_alloc(service->data);
 		if (observer == NULL) {
 			ret = -ENOMEM;
 			goto unlock;
 		}
 
 		coap_observer_init(observer, request, addr);
+		coap_service_observer_link(service->data, observer);
 		coap_register_observer(resource, observer);
 	} else if (ret == 1) {
 		ret = coap_service_remove_observer(service, resource, addr, token, tkl);
@@ -4,12 +4,191 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include <zephyr/net/dns_resolve.h>
+#include <zephyr/sys/hash_function.h>
 #include "dns_cache.h"
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+#define DNS_CACHE_NONE 0U
+
+static void dns_cache_clean(struct dns_cache *cache);
+
+static uint32_t dns_cache_hash(const char *query)
+{
+	return sys_hash32_fnv1a(query, strlen(query));
+}
+
+static inline uint16_t *dns_cache_bucket(struct dns_cache *cache, uint32_t hash)
+{
+	return &cache->buckets[hash % (2 * cache->size)];
+}
+
+static inline bool dns_cache_expires_before(struct dns_cache *cache, uint16_t a, uint16_t b)
+{
+	return sys_timepoint_cmp(cache->entries[a].expiry, cache->entries[b].expiry) < 0;
+}
+
+static void dns_cache_heap_set(struct dns_cache *cache, uint16_t pos, uint16_t index)
+{
+	cache->heap[pos] = index;
+	cache->entries[index].heap_pos = pos;
+}
+
+static void dns_cache_heap_up(struct dns_cache *cache, uint16_t pos)
+{
+	uint16_t index = cache->heap[pos];
+
+	while (pos > 0) {
+		uint16_t parent = (pos - 1) / 2;
+
+		if (!dns_cache_expires_before(cache, index, cache->heap[parent])) {
+			break;
+		}
+
+		dns_cache_heap_set(cache, pos, cache->heap[parent]);
+		pos = parent;
+	}
+
+	dns_cache_heap_set(cache, pos, index);
+}
+
+static void dns_cache_heap_down(struct dns_cache *cache, uint16_t pos)
+{
+	uint16_t index = cache->heap[pos];
+
+	while (true) {
+		uint16_t child = 2 * pos + 1;
+
+		if (child >= cache->count) {
+			break;
+		}
+
+		if (child + 1 < cache->count &&
+		    dns_cache_expires_before(cache, cache->heap[child + 1], cache->heap[child])) {
+			child++;
+		}
+
+		if (!dns_cache_expires_before(cache, cache->heap[child], index)) {
+			break;
+		}
+
+		dns_cache_heap_set(cache, pos, cache->heap[child]);
+		pos = child;
+	}
+
+	dns_cache_heap_set(cache, pos, index);
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_release(struct dns_cache *cache, uint16_t index)
+{
+	struct dns_cache_entry *entry = &cache->entries[index];
+	uint16_t *link = dns_cache_bucket(cache, entry->hash);
+	uint16_t pos = entry->heap_pos;
+
+	while (*link != index + 1) {
+		link = &cache->entries[*link - 1].next;
+	}
+
+	*link = entry->next;
+
+	cache->count--;
+	if (pos < cache->count) {
+		uint16_t last = cache->heap[cache->count];
+
+		dns_cache_heap_set(cache, pos, last);
+		dns_cache_heap_down(cache, pos);
+		dns_cache_heap_up(cache, cache->entries[last].heap_pos);
+	}
+
+	entry->in_use = false;
+	entry->next = cache->free;
+	cache->free = index + 1;
+}
+
+/* Needs to be called when lock is already acquired */
+static uint16_t dns_cache_alloc(struct dns_cache *cache)
+{
+	uint16_t index;
+
+	if (cache->free != DNS_CACHE_NONE) {
+		index = cache->free - 1;
+		cache->free = cache->entries[index].next;
+	} else if (cache->used < cache->size) {
+		index = cache->used++;
+	} else {
+		/* Replace the entry closest to expiry */
+		index = cache->heap[0];
+		NET_DBG("Overwrite \"%s\"", cache->entries[index].query);
+		dns_cache_release(cache, index);
+		cache->free = cache->entries[index].next;
+	}
+
+	return index;
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_insert(struct dns_cache *cache, const char *query, uint32_t hash,
+			     uint16_t type, bool negative, uint32_t ttl,
+			     struct dns_addrinfo const *addrinfo)
+{
+	uint16_t index = dns_cache_alloc(cache);
+	struct dns_cache_entry *entry = &cache->entries[index];
+	uint16_t *bucket = dns_cache_bucket(cache, hash);
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	entry->query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1] = '\0';
+	if (addrinfo != NULL) {
+		entry->data = *addrinfo;
+	}
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+	entry->hash = hash;
+	entry->type = type;
+	entry->negative = negative;
+	entry->in_use = true;
+
+	entry->next = *bucket;
+	*bucket = index + 1;
+
+	dns_cache_heap_set(cache, cache->count, index);
+	cache->count++;
+	dns_cache_heap_up(cache, cache->count - 1);
+}
+
+/*
+ * Remove the entries of a query. Type 0 removes the entries of any type,
+ * negative_only keeps the answers and removes only the negative entries.
+ * Needs to be called when lock is already acquired.
+ */
+static void dns_cache_remove_locked(struct dns_cache *cache, const char *query, uint32_t hash,
+				    uint16_t type, bool negative_only)
+{
+	uint16_t next = *dns_cache_bucket(cache, hash);
+
+	while (next != DNS_CACHE_NONE) {
+		uint16_t index = next - 1;
+		struct dns_cache_entry *entry = &cache->entries[index];
+
+		next = entry->next;
+
+		if (entry->hash != hash || strcmp(entry->query, query) != 0) {
+			continue;
+		}
+
+		if (type != 0 && entry->type != 0 && entry->type != type) {
+			continue;
+		}
+
+		if (negative_only && !entry->negative) {
+			continue;
+		}
+
+		NET_DBG("Remove \"%s\"", entry->query);
+		dns_cache_release(cache, index);
+	}
+}
 
 int dns_cache_flush(struct dns_cache *cache)
 {
@@ -17,6 +196,10 @@ int dns_cache_flush(struct dns_cache *cache)
 	for (size_t i = 0; i < cache->size; i++) {
 		cache->entries[i].in_use = false;
 	}
+	memset(cache->buckets, 0, 2 * cache->size * sizeof(cache->buckets[0]));
+	cache->count = 0U;
+	cache->used = 0U;
+	cache->free = DNS_CACHE_NONE;
 	k_mutex_unlock(cache->lock);
 
 	return 0;
@@ -25,9 +208,8 @@ int dns_cache_flush(struct dns_cache *cache)
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl)
 {
-	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
-	size_t index_to_replace = 0;
-	bool found_empty = false;
+	uint16_t type;
+	uint32_t hash;
 
 	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
 		return -EINVAL;
@@ -40,32 +222,59 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 		return -EINVAL;
 	}
 
+	if (addrinfo->ai_family == AF_INET) {
+		type = DNS_QUERY_TYPE_A;
+	} else if (addrinfo->ai_family == AF_INET6) {
+		type = DNS_QUERY_TYPE_AAAA;
+	} else {
+		type = 0U;
+	}
+
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	NET_DBG("Add \"%s\" with TTL %" PRIu32, query, ttl);
 
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
-		}
+	/* An answer supersedes a negative entry of the same query */
+	dns_cache_remove_locked(cache, query, hash, type, true);
+
+	dns_cache_insert(cache, query, hash, type, false, ttl, addrinfo);
+
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
+
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   uint32_t ttl)
+{
+	uint32_t hash;
+
+	if (cache == NULL || query == NULL || ttl == 0) {
+		return -EINVAL;
 	}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
+		NET_WARN("Query string to big to be processed %u >= "
+			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
+			 strlen(query));
+		return -EINVAL;
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	hash = dns_cache_hash(query);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	NET_DBG("Add negative \"%s\" type %d with TTL %" PRIu32, query, type, ttl);
+
+	dns_cache_clean(cache);
+
+	dns_cache_remove_locked(cache, query, hash, type, false);
+
+	dns_cache_insert(cache, query, hash, type, true, ttl, NULL);
 
 	k_mutex_unlock(cache->lock);
 
@@ -86,21 +295,24 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
-		}
-	}
+	dns_cache_remove_locked(cache, query, dns_cache_hash(query), 0U, false);
 
 	k_mutex_unlock(cache->lock);
 
 	return 0;
 }
 
-int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
-		   size_t addrinfo_array_len)
+/*
+ * Type 0 returns the answers of any type and ignores the negative entries,
+ * like dns_cache_find() always did.
+ */
+static int dns_cache_lookup(struct dns_cache *cache, const char *query, uint16_t type,
+			    struct dns_addrinfo *addrinfo, size_t addrinfo_array_len)
 {
+	bool negative = false;
 	size_t found = 0;
+	uint32_t hash;
+	uint16_t next;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
@@ -113,22 +325,34 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+	next = *dns_cache_bucket(cache, hash);
+
+	while (next != DNS_CACHE_NONE) {
+		struct dns_cache_entry *entry = &cache->entries[next - 1];
+
+		next = entry->next;
+
+		if (entry->hash != hash || strcmp(entry->query, query) != 0) {
+			continue;
+		}
+		if (type != 0 && entry->type != 0 && entry->type != type) {
 			continue;
 		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
+		if (entry->negative) {
+			negative = negative || type != 0;
 			continue;
 		}
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
 		} else {
-			addrinfo[found] = cache->entries[i].data;
+			addrinfo[found] = entry->data;
 			found++;
 			NET_DBG("Found \"%s\"", query);
 		}
@@ -140,23 +364,38 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 		return -ENOSR;
 	}
 
+	if (found == 0 && negative) {
+		NET_DBG("Found negative \"%s\"", query);
+		return DNS_EAI_NODATA;
+	}
+
 	if (found == 0) {
 		NET_DBG("Could not find \"%s\"", query);
 	}
 	return found;
 }
 
-/* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
+int dns_cache_find(struct dns_cache *cache, const char *query, struct dns_addrinfo *addrinfo,
+		   size_t addrinfo_array_len)
 {
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			continue;
-		}
+	return dns_cache_lookup(cache, query, 0U, addrinfo, addrinfo_array_len);
+}
 
-		if (sys_timepoint_expired(cache->entries[i].expiry)) {
-			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
-		}
+int dns_cache_find_type(struct dns_cache *cache, const char *query, enum dns_query_type type,
+			struct dns_addrinfo *addrinfo, size_t addrinfo_array_len)
+{
+	if (type == 0) {
+		return -EINVAL;
+	}
+
+	return dns_cache_lookup(cache, query, type, addrinfo, addrinfo_array_len);
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_clean(struct dns_cache *cache)
+{
+	while (cache->count > 0 && sys_timepoint_expired(cache->entries[cache->heap[0]].expiry)) {
+		NET_DBG("Remove \"%s\"", cache->entries[cache->heap[0]].query);
+		dns_cache_release(cache, cache->heap[0]);
 	}
 }
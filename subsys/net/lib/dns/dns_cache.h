@@ -22,13 +22,28 @@ struct dns_cache_entry {
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
+	uint32_t hash;      /* hash of the query */
+	uint16_t next;      /* next entry of the bucket or free list, index + 1 */
+	uint16_t heap_pos;  /* position in the expiry heap */
+	uint16_t type;      /* enum dns_query_type, 0 if the entry is for any type */
+	bool negative;      /* the query has no answer (RFC 2308) */
 	bool in_use;
 };
 
+/*
+ * Entries are chained in buckets by the hash of their query, and ordered
+ * by expiry in a binary heap so that expired entries and the entry closest
+ * to expiry are found without scanning the whole cache.
+ */
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
+	uint16_t *buckets;  /* 2 * size chains of entries, index + 1 */
+	uint16_t *heap;     /* indexes of the entries in use */
 	struct k_mutex *lock;
+	uint16_t count;     /* number of entries in use */
+	uint16_t used;      /* high-water mark of the entries */
+	uint16_t free;      /* free list of released entries, index + 1 */
 };
 
 /**
@@ -41,10 +56,17 @@ struct dns_cache {
  * @param name Name of the cache.
  */
 #define DNS_CACHE_DEFINE(name, cache_size)                                                         \
+	BUILD_ASSERT((cache_size) > 0 && (cache_size) < UINT16_MAX);                               \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
+	static uint16_t name##_buckets[2 * (cache_size)];                                          \
+	static uint16_t name##_heap[cache_size];                                                   \
 	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+		.entries = name##_entries,                                                         \
+		.size = cache_size,                                                                \
+		.buckets = name##_buckets,                                                         \
+		.heap = name##_heap,                                                               \
+		.lock = &name##_mutex};
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -71,6 +93,23 @@ int dns_cache_flush(struct dns_cache *cache);
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl);
 
+/**
+ * @brief Adds a negative entry to the dns cache, recording that the query
+ * has no answer (RFC 2308). Entries of the query that the negative answer
+ * covers are removed.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query which has no answer.
+ * @param type Query type without any record, or 0 if the name does not exist
+ * at all (NXDOMAIN).
+ * @param ttl Time to live for the entry in seconds. This usually is the
+ * minimum of the TTL and MINIMUM fields of the SOA record of the response.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   uint32_t ttl);
+
 /**
  * @brief Removes all entries with the given query
  *
@@ -94,7 +133,26 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
  * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
  * array will however be filled with valid data.
  */
-int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
+int dns_cache_find(struct dns_cache *cache, const char *query, struct dns_addrinfo *addrinfo,
 		   size_t addrinfo_array_len);
 
+/**
+ * @brief Tries to find the entries of the specified query and type within
+ * the cache.
+ *
+ * @param cache Cache where the entry should be searched.
+ * @param query Query which should be searched for.
+ * @param type Query type which should be searched for.
+ * @param addrinfo dns_addrinfo array which will be written if the query was found.
+ * @param addrinfo_array_len Array size of the dns_addrinfo array
+ * @retval on success the amount of dns_addrinfo written into the addrinfo array will be returned.
+ * A cache miss will therefore return a 0.
+ * @retval DNS_EAI_NODATA if a negative entry of the query and type was found.
+ * @retval On error a negative value is returned.
+ * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
+ * array will however be filled with valid data.
+ */
+int dns_cache_find_type(struct dns_cache *cache, const char *query, enum dns_query_type type,
+			struct dns_addrinfo *addrinfo, size_t addrinfo_array_len);
+
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
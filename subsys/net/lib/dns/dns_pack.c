@@ -177,6 +177,70 @@ int dns_unpack_answer(struct dns_msg_t *dns_msg, int dname_ptr, uint32_t *ttl,
 	return 0;
 }
 
+int dns_unpack_negative_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl)
+{
+	int records = dns_header_ancount(dns_msg->msg) + dns_header_nscount(dns_msg->msg);
+	int answers = dns_header_ancount(dns_msg->msg);
+	int offset = dns_msg->answer_offset;
+	uint8_t *msg = dns_msg->msg;
+
+	for (int i = 0; i < records; i++) {
+		uint16_t rdlength;
+		int dname_len;
+		int rdata;
+
+		dname_len = skip_fqdn(msg + offset, dns_msg->msg_size - offset);
+		if (dname_len < 0) {
+			return dname_len;
+		}
+
+		rdata = offset + dname_len + DNS_COMMON_UINT_SIZE + DNS_COMMON_UINT_SIZE +
+			DNS_TTL_LEN + DNS_RDLENGTH_LEN;
+		if (rdata > dns_msg->msg_size) {
+			return -EINVAL;
+		}
+
+		rdlength = dns_answer_rdlength(dname_len, msg + offset);
+		if (rdata + rdlength > dns_msg->msg_size) {
+			return -EINVAL;
+		}
+
+		/* The SOA record is in the authority section, after the
+		 * CNAME records of the answer section if any.
+		 */
+		if (i >= answers && dns_answer_type(dname_len, msg + offset) == DNS_RR_TYPE_SOA) {
+			uint32_t soa_ttl = dns_answer_ttl(dname_len, msg + offset);
+			int pos = rdata;
+			int len;
+
+			/* MNAME and RNAME, then SERIAL, REFRESH, RETRY,
+			 * EXPIRE and MINIMUM.
+			 */
+			for (int j = 0; j < 2; j++) {
+				len = skip_fqdn(msg + pos, rdata + rdlength - pos);
+				if (len < 0) {
+					return len;
+				}
+
+				pos += len;
+			}
+
+			if (pos + 5 * DNS_TTL_LEN > rdata + rdlength) {
+				return -EINVAL;
+			}
+
+			*ttl = MIN(soa_ttl,
+				   ntohl(UNALIGNED_GET((uint32_t *)(msg + pos + 4 * DNS_TTL_LEN))));
+
+			return 0;
+		}
+
+		offset = rdata + rdlength;
+	}
+
+	return -ENOENT;
+}
+
 int dns_unpack_response_header(struct dns_msg_t *msg, int src_id)
 {
 	uint8_t *dns_header;
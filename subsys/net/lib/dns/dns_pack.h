@@ -89,6 +89,7 @@ enum dns_rr_type {
 	DNS_RR_TYPE_INVALID = 0,
 	DNS_RR_TYPE_A	= 1,		/* IPv4  */
 	DNS_RR_TYPE_CNAME = 5,		/* CNAME */
+	DNS_RR_TYPE_SOA = 6,		/* SOA   */
 	DNS_RR_TYPE_PTR = 12,		/* PTR   */
 	DNS_RR_TYPE_TXT = 16,		/* TXT   */
 	DNS_RR_TYPE_AAAA = 28,		/* IPv6  */
@@ -366,6 +367,23 @@ int dns_unpack_answer(struct dns_msg_t *dns_msg, int dname_ptr, uint32_t *ttl,
  */
 int dns_unpack_response_header(struct dns_msg_t *msg, int src_id);
 
+/**
+ * @brief Unpacks the TTL of a negative response
+ *
+ * @details RFC 2308 chapter 5: the TTL of a negative answer is the minimum
+ *          of the TTL of the SOA record of the authority section and of its
+ *          MINIMUM field. The answer_offset field must have been computed by
+ *          dns_unpack_response_query().
+ *
+ * @param dns_msg Structure containing the response.
+ * @param ttl TTL of the negative answer.
+ * @retval 0 on success
+ * @retval -ENOENT if the authority section has no SOA record, in which case
+ *         the negative answer must not be cached.
+ * @retval -EINVAL if the message is malformed.
+ */
+int dns_unpack_negative_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl);
+
 /**
  * @brief Packs the query message
  *
@@ -98,6 +98,11 @@ static inline void invoke_query_callback(int status,
 					 struct dns_addrinfo *info,
 					 struct dns_pending_query *pending_query);
 static void release_query(struct dns_pending_query *pending_query);
+static void invoke_query_callbacks(struct dns_resolve_context *ctx, int status,
+				   struct dns_addrinfo *info, int query_idx);
+static void release_queries(struct dns_resolve_context *ctx, int query_idx);
+static void update_coalesced_queries(struct dns_resolve_context *ctx, int query_idx,
+				     uint16_t old_hash);
 
 static bool server_is_mdns(sa_family_t family, struct sockaddr *addr)
 {
@@ -238,6 +243,8 @@ static int dispatcher_cb(void *my_ctx, int sock,
 			goto free_buf;
 		}
 
+		query_hash = ctx->queries[i].query_hash;
+
 		for (j = 0; j < SERVER_COUNT; j++) {
 			if (ctx->servers[j].sock < 0) {
 				continue;
@@ -251,6 +258,11 @@ static int dispatcher_cb(void *my_ctx, int sock,
 			}
 		}
 
+		/* The queries coalesced with this one wait for the response
+		 * of the CNAME query now.
+		 */
+		update_coalesced_queries(ctx, i, query_hash);
+
 		if (failure) {
 			NET_DBG("DNS cname query failed %d times", failure);
 
@@ -269,10 +281,10 @@ quit:
 		goto free_buf;
 	}
 
-	invoke_query_callback(ret, NULL, &ctx->queries[i]);
+	invoke_query_callbacks(ctx, ret, NULL, i);
 
 	/* Marks the end of the results */
-	release_query(&ctx->queries[i]);
+	release_queries(ctx, i);
 
 free_buf:
 	if (dns_cname) {
@@ -638,6 +650,166 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 	return -ENOENT;
 }
 
+/* Must be invoked with context lock held */
+static inline bool is_coalesced_with(struct dns_resolve_context *ctx, int idx,
+				     int query_idx, uint16_t query_hash)
+{
+	return idx != query_idx && ctx->queries[idx].coalesced &&
+	       check_query_active(&ctx->queries[idx], false) &&
+	       ctx->queries[idx].leader_id == ctx->queries[query_idx].id &&
+	       ctx->queries[idx].query_hash == query_hash;
+}
+
+/* Invoke the callback of a query slot and of the queries coalesced with it.
+ *
+ * Must be invoked with context lock held.
+ */
+static void invoke_query_callbacks(struct dns_resolve_context *ctx, int status,
+				   struct dns_addrinfo *info, int query_idx)
+{
+	uint16_t query_hash = ctx->queries[query_idx].query_hash;
+
+	invoke_query_callback(status, info, &ctx->queries[query_idx]);
+
+	if (!IS_ENABLED(CONFIG_DNS_RESOLVER_COALESCE_QUERIES) ||
+	    ctx->queries[query_idx].coalesced) {
+		return;
+	}
+
+	for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (is_coalesced_with(ctx, i, query_idx, query_hash)) {
+			invoke_query_callback(status, info, &ctx->queries[i]);
+		}
+	}
+}
+
+/* Release a query slot and the queries coalesced with it.
+ *
+ * Must be invoked with context lock held.
+ */
+static void release_queries(struct dns_resolve_context *ctx, int query_idx)
+{
+	uint16_t query_hash = ctx->queries[query_idx].query_hash;
+
+	if (IS_ENABLED(CONFIG_DNS_RESOLVER_COALESCE_QUERIES) &&
+	    !ctx->queries[query_idx].coalesced) {
+		for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+			if (is_coalesced_with(ctx, i, query_idx, query_hash)) {
+				release_query(&ctx->queries[i]);
+			}
+		}
+	}
+
+	release_query(&ctx->queries[query_idx]);
+}
+
+/* Follow the new hash of a query that was sent again, e.g. for a CNAME.
+ *
+ * Must be invoked with context lock held.
+ */
+static void update_coalesced_queries(struct dns_resolve_context *ctx, int query_idx,
+				     uint16_t old_hash)
+{
+	if (!IS_ENABLED(CONFIG_DNS_RESOLVER_COALESCE_QUERIES)) {
+		return;
+	}
+
+	for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (is_coalesced_with(ctx, i, query_idx, old_hash)) {
+			ctx->queries[i].query_hash = ctx->queries[query_idx].query_hash;
+		}
+	}
+}
+
+/* Find a sent query that a new query of the same name and type can wait for.
+ *
+ * Must be invoked with context lock held.
+ */
+static int get_slot_by_query(struct dns_resolve_context *ctx, const char *query,
+			     enum dns_query_type type)
+{
+	for (int i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (check_query_active(&ctx->queries[i], false) &&
+		    !ctx->queries[i].coalesced &&
+		    ctx->queries[i].query != NULL &&
+		    ctx->queries[i].query_hash != 0 &&
+		    ctx->queries[i].query_type == type &&
+		    strcmp(ctx->queries[i].query, query) == 0) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE_NEGATIVE)
+/* The response tells that the name does not exist, or that it has no record
+ * of the queried type. mDNS responses are not cached. The header is checked
+ * like in dns_unpack_response_header(), which rejects these responses.
+ */
+static bool dns_is_negative_response(struct dns_msg_t *dns_msg, uint16_t dns_id)
+{
+	uint8_t *msg = dns_msg->msg;
+	int rcode;
+
+	if (dns_id == 0 || dns_msg->msg_size < DNS_MSG_HEADER_SIZE ||
+	    dns_header_qr(msg) != DNS_RESPONSE ||
+	    dns_header_opcode(msg) != DNS_QUERY ||
+	    dns_header_z(msg) != 0) {
+		return false;
+	}
+
+	rcode = dns_header_rcode(msg);
+
+	return dns_header_qdcount(msg) == 1 &&
+	       (rcode == DNS_HEADER_NAMEERROR ||
+		(rcode == DNS_HEADER_NOERROR && dns_header_ancount(msg) == 0));
+}
+
+/* Cache a negative response (RFC 2308) and find the query it answers */
+static int dns_validate_negative(struct dns_resolve_context *ctx,
+				 struct dns_msg_t *dns_msg,
+				 uint16_t dns_id,
+				 int *query_idx,
+				 uint16_t *query_hash)
+{
+	struct dns_pending_query *pending_query;
+	const char *query_name;
+	uint32_t ttl;
+
+	/* Without question section the query is found by its id only */
+	if (dns_unpack_response_query(dns_msg) < 0) {
+		return DNS_EAI_NODATA;
+	}
+
+	query_name = dns_msg->msg + dns_msg->query_offset;
+
+	/* Add \0 and query type (A or AAAA) to the hash */
+	*query_hash = crc16_ansi(query_name, strlen(query_name) + 1 + 2);
+
+	*query_idx = get_slot_by_id(ctx, dns_id, *query_hash);
+	if (*query_idx < 0) {
+		return DNS_EAI_SYSTEM;
+	}
+
+	pending_query = &ctx->queries[*query_idx];
+
+	/* An LLMNR responder only answers for its own names, another one may
+	 * still have the name or the record.
+	 */
+	if (pending_query->query != NULL && !pending_query->llmnr &&
+	    dns_unpack_negative_ttl(dns_msg, &ttl) == 0 && ttl > 0) {
+		/* A missing name has no record of any type */
+		dns_cache_add_negative(&dns_cache, pending_query->query,
+				       dns_header_rcode(dns_msg->msg) == DNS_HEADER_NAMEERROR ?
+				       0 : pending_query->query_type,
+				       MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_MAX_TTL));
+	}
+
+	return DNS_EAI_NODATA;
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_NEGATIVE */
+
 /* Unit test needs to be able to call this function */
 #if !defined(CONFIG_NET_TEST)
 static
@@ -687,6 +859,14 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		goto quit;
 	}
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE_NEGATIVE)
+	if (dns_is_negative_response(dns_msg, *dns_id)) {
+		ret = dns_validate_negative(ctx, dns_msg, *dns_id, query_idx,
+					    query_hash);
+		goto quit;
+	}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_NEGATIVE */
+
 	ret = dns_unpack_response_header(dns_msg, *dns_id);
 	if (ret < 0) {
 		ret = DNS_EAI_FAIL;
@@ -811,8 +991,8 @@ query_known:
 			src = dns_msg->msg + dns_msg->response_position;
 			memcpy(addr, src, address_size);
 
-			invoke_query_callback(DNS_EAI_INPROGRESS, &info,
-					      &ctx->queries[*query_idx]);
+			invoke_query_callbacks(ctx, DNS_EAI_INPROGRESS, &info,
+					       *query_idx);
 #ifdef CONFIG_DNS_RESOLVER_CACHE
 			dns_cache_add(&dns_cache,
 				ctx->queries[*query_idx].query, &info, ttl);
@@ -921,10 +1101,10 @@ static int dns_read(struct dns_resolve_context *ctx,
 		goto quit;
 	}
 
-	invoke_query_callback(ret, NULL, &ctx->queries[query_idx]);
+	invoke_query_callbacks(ctx, ret, NULL, query_idx);
 
 	/* Marks the end of the results */
-	release_query(&ctx->queries[query_idx]);
+	release_queries(ctx, query_idx);
 
 	return 0;
 
@@ -1217,6 +1397,7 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	struct net_buf *dns_qname = NULL;
 	struct sockaddr addr;
 	int ret, i = -1, j = 0;
+	int leader = -ENOENT;
 	int failure = 0;
 	bool mdns_query = false;
 	uint8_t hop_limit;
@@ -1285,7 +1466,20 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 
 try_resolve:
 #ifdef CONFIG_DNS_RESOLVER_CACHE
-	ret = dns_cache_find(&dns_cache, query, cached_info, sizeof(cached_info));
+	ret = dns_cache_find_type(&dns_cache, query, type, cached_info,
+				  ARRAY_SIZE(cached_info));
+	if (ret == -ENOSR) {
+		/* The array is filled with as many entries as it can hold */
+		ret = ARRAY_SIZE(cached_info);
+	}
+
+	if (ret == DNS_EAI_NODATA) {
+		/* A negative answer is cached, see RFC 2308 */
+		cb(DNS_EAI_NODATA, NULL, user_data);
+
+		return 0;
+	}
+
 	if (ret > 0) {
 		/* The query was cached, no
 		 * need to continue further.
@@ -1306,6 +1500,10 @@ try_resolve:
 		goto fail;
 	}
 
+	if (IS_ENABLED(CONFIG_DNS_RESOLVER_COALESCE_QUERIES)) {
+		leader = get_slot_by_query(ctx, query, type);
+	}
+
 	i = get_cb_slot(ctx);
 	if (i < 0) {
 		ret = -EAGAIN;
@@ -1319,9 +1517,38 @@ try_resolve:
 	ctx->queries[i].user_data = user_data;
 	ctx->queries[i].ctx = ctx;
 	ctx->queries[i].query_hash = 0;
+	ctx->queries[i].coalesced = false;
 
 	k_work_init_delayable(&ctx->queries[i].timer, query_timeout);
 
+	if (leader >= 0) {
+		/* The same name and type is already being resolved, wait for
+		 * its response instead of sending another query. This query
+		 * has an id of its own so that it can be cancelled alone.
+		 */
+		do {
+			ctx->queries[i].id = sys_rand16_get();
+		} while (ctx->queries[i].id == ctx->queries[leader].id);
+
+		ctx->queries[i].leader_id = ctx->queries[leader].id;
+		ctx->queries[i].query_hash = ctx->queries[leader].query_hash;
+		ctx->queries[i].coalesced = true;
+
+		if (dns_id) {
+			*dns_id = ctx->queries[i].id;
+		}
+
+		NET_DBG("[%u] coalesced with [%u] id %u", i, leader,
+			ctx->queries[leader].id);
+
+		ret = k_work_reschedule(&ctx->queries[i].timer, tout);
+		if (ret >= 0) {
+			ret = 0;
+		}
+
+		goto quit;
+	}
+
 	dns_data = net_buf_alloc(&dns_msg_pool, ctx->buf_timeout);
 	if (!dns_data) {
 		ret = -ENOMEM;
@@ -1392,6 +1619,8 @@ try_resolve:
 			hop_limit = 1U;
 		}
 
+		ctx->queries[i].llmnr = ctx->servers[j].is_llmnr;
+
 		ret = dns_write(ctx, j, i, dns_data->data,
 				net_buf_max_len(dns_data),
 				net_buf_max_len(dns_data),
@@ -39,6 +39,9 @@ int enter_http_done_state(struct http_client_ctx *client);
 /* Others */
 struct http_resource_detail *get_resource_detail(const char *path, int *len, bool is_ws);
 int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len);
+int http_server_send_static(struct http_client_ctx *client, const void *buf, size_t len);
+bool http_server_claim_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				struct http_client_ctx *client);
 void http_client_timer_restart(struct http_client_ctx *client);
 
 /* TODO Could be static, but currently used in tests. */
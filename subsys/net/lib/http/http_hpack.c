@@ -10,6 +10,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/hpack.h>
 #include <zephyr/net/net_core.h>
+#include <zephyr/sys/hash_function.h>
 
 LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
@@ -26,70 +27,76 @@ static inline bool http_hpack_key_is_dynamic(uint32_t key)
 struct hpack_table_entry {
 	const char *name;
 	const char *value;
+	uint8_t name_len;
+	uint8_t value_len;
 };
 
+#define HPACK_NAME(_name) { _name, NULL, sizeof(_name) - 1, 0 }
+#define HPACK_FIELD(_name, _value) \
+	{ _name, _value, sizeof(_name) - 1, sizeof(_value) - 1 }
+
 static const struct hpack_table_entry http_hpack_table_static[] = {
-	[HTTP_SERVER_HPACK_AUTHORITY] = { ":authority", NULL },
-	[HTTP_SERVER_HPACK_METHOD_GET] = { ":method", "GET" },
-	[HTTP_SERVER_HPACK_METHOD_POST] = { ":method", "POST" },
-	[HTTP_SERVER_HPACK_PATH_ROOT] = { ":path", "/" },
-	[HTTP_SERVER_HPACK_PATH_INDEX] = { ":path", "/index.html" },
-	[HTTP_SERVER_HPACK_SCHEME_HTTP] = { ":scheme", "http" },
-	[HTTP_SERVER_HPACK_SCHEME_HTTPS] = { ":scheme", "https" },
-	[HTTP_SERVER_HPACK_STATUS_200] = { ":status", "200" },
-	[HTTP_SERVER_HPACK_STATUS_204] = { ":status", "204" },
-	[HTTP_SERVER_HPACK_STATUS_206] = { ":status", "206" },
-	[HTTP_SERVER_HPACK_STATUS_304] = { ":status", "304" },
-	[HTTP_SERVER_HPACK_STATUS_400] = { ":status", "400" },
-	[HTTP_SERVER_HPACK_STATUS_404] = { ":status", "404" },
-	[HTTP_SERVER_HPACK_STATUS_500] = { ":status", "500" },
-	[HTTP_SERVER_HPACK_ACCEPT_CHARSET] = { "accept-charset", NULL },
-	[HTTP_SERVER_HPACK_ACCEPT_ENCODING] = { "accept-encoding", "gzip, deflate" },
-	[HTTP_SERVER_HPACK_ACCEPT_LANGUAGE] = { "accept-language", NULL },
-	[HTTP_SERVER_HPACK_ACCEPT_RANGES] = { "accept-ranges", NULL },
-	[HTTP_SERVER_HPACK_ACCEPT] = { "accept", NULL },
-	[HTTP_SERVER_HPACK_ACCESS_CONTROL_ALLOW_ORIGIN] = { "access-control-allow-origin", NULL },
-	[HTTP_SERVER_HPACK_AGE] = { "age", NULL },
-	[HTTP_SERVER_HPACK_ALLOW] = { "allow", NULL },
-	[HTTP_SERVER_HPACK_AUTHORIZATION] = { "authorization", NULL },
-	[HTTP_SERVER_HPACK_CACHE_CONTROL] = { "cache-control", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_DISPOSITION] = { "content-disposition", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_ENCODING] = { "content-encoding", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_LANGUAGE] = { "content-language", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_LENGTH] = { "content-length", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_LOCATION] = { "content-location", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_RANGE] = { "content-range", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_TYPE] = { "content-type", NULL },
-	[HTTP_SERVER_HPACK_COOKIE] = { "cookie", NULL },
-	[HTTP_SERVER_HPACK_DATE] = { "date", NULL },
-	[HTTP_SERVER_HPACK_ETAG] = { "etag", NULL },
-	[HTTP_SERVER_HPACK_EXPECT] = { "expect", NULL },
-	[HTTP_SERVER_HPACK_EXPIRES] = { "expires", NULL },
-	[HTTP_SERVER_HPACK_FROM] = { "from", NULL },
-	[HTTP_SERVER_HPACK_HOST] = { "host", NULL },
-	[HTTP_SERVER_HPACK_IF_MATCH] = { "if-match", NULL },
-	[HTTP_SERVER_HPACK_IF_MODIFIED_SINCE] = { "if-modified-since", NULL },
-	[HTTP_SERVER_HPACK_IF_NONE_MATCH] = { "if-none-match", NULL },
-	[HTTP_SERVER_HPACK_IF_RANGE] = { "if-range", NULL },
-	[HTTP_SERVER_HPACK_IF_UNMODIFIED_SINCE] = { "if-unmodified-since", NULL },
-	[HTTP_SERVER_HPACK_LAST_MODIFIED] = { "last-modified", NULL },
-	[HTTP_SERVER_HPACK_LINK] = { "link", NULL },
-	[HTTP_SERVER_HPACK_LOCATION] = { "location", NULL },
-	[HTTP_SERVER_HPACK_MAX_FORWARDS] = { "max-forwards", NULL },
-	[HTTP_SERVER_HPACK_PROXY_AUTHENTICATE] = { "proxy-authenticate", NULL },
-	[HTTP_SERVER_HPACK_PROXY_AUTHORIZATION] = { "proxy-authorization", NULL },
-	[HTTP_SERVER_HPACK_RANGE] = { "range", NULL },
-	[HTTP_SERVER_HPACK_REFERER] = { "referer", NULL },
-	[HTTP_SERVER_HPACK_REFRESH] = { "refresh", NULL },
-	[HTTP_SERVER_HPACK_RETRY_AFTER] = { "retry-after", NULL },
-	[HTTP_SERVER_HPACK_SERVER] = { "server", NULL },
-	[HTTP_SERVER_HPACK_SET_COOKIE] = { "set-cookie", NULL },
-	[HTTP_SERVER_HPACK_STRICT_TRANSPORT_SECURITY] = { "strict-transport-security", NULL },
-	[HTTP_SERVER_HPACK_TRANSFER_ENCODING] = { "transfer-encoding", NULL },
-	[HTTP_SERVER_HPACK_USER_AGENT] = { "user-agent", NULL },
-	[HTTP_SERVER_HPACK_VARY] = { "vary", NULL },
-	[HTTP_SERVER_HPACK_VIA] = { "via", NULL },
-	[HTTP_SERVER_HPACK_WWW_AUTHENTICATE] = { "www-authenticate", NULL },
+	[HTTP_SERVER_HPACK_AUTHORITY] = HPACK_NAME(":authority"),
+	[HTTP_SERVER_HPACK_METHOD_GET] = HPACK_FIELD(":method", "GET"),
+	[HTTP_SERVER_HPACK_METHOD_POST] = HPACK_FIELD(":method", "POST"),
+	[HTTP_SERVER_HPACK_PATH_ROOT] = HPACK_FIELD(":path", "/"),
+	[HTTP_SERVER_HPACK_PATH_INDEX] = HPACK_FIELD(":path", "/index.html"),
+	[HTTP_SERVER_HPACK_SCHEME_HTTP] = HPACK_FIELD(":scheme", "http"),
+	[HTTP_SERVER_HPACK_SCHEME_HTTPS] = HPACK_FIELD(":scheme", "https"),
+	[HTTP_SERVER_HPACK_STATUS_200] = HPACK_FIELD(":status", "200"),
+	[HTTP_SERVER_HPACK_STATUS_204] = HPACK_FIELD(":status", "204"),
+	[HTTP_SERVER_HPACK_STATUS_206] = HPACK_FIELD(":status", "206"),
+	[HTTP_SERVER_HPACK_STATUS_304] = HPACK_FIELD(":status", "304"),
+	[HTTP_SERVER_HPACK_STATUS_400] = HPACK_FIELD(":status", "400"),
+	[HTTP_SERVER_HPACK_STATUS_404] = HPACK_FIELD(":status", "404"),
+	[HTTP_SERVER_HPACK_STATUS_500] = HPACK_FIELD(":status", "500"),
+	[HTTP_SERVER_HPACK_ACCEPT_CHARSET] = HPACK_NAME("accept-charset"),
+	[HTTP_SERVER_HPACK_ACCEPT_ENCODING] = HPACK_FIELD("accept-encoding", "gzip, deflate"),
+	[HTTP_SERVER_HPACK_ACCEPT_LANGUAGE] = HPACK_NAME("accept-language"),
+	[HTTP_SERVER_HPACK_ACCEPT_RANGES] = HPACK_NAME("accept-ranges"),
+	[HTTP_SERVER_HPACK_ACCEPT] = HPACK_NAME("accept"),
+	[HTTP_SERVER_HPACK_ACCESS_CONTROL_ALLOW_ORIGIN] = HPACK_NAME("access-control-allow-origin"),
+	[HTTP_SERVER_HPACK_AGE] = HPACK_NAME("age"),
+	[HTTP_SERVER_HPACK_ALLOW] = HPACK_NAME("allow"),
+	[HTTP_SERVER_HPACK_AUTHORIZATION] = HPACK_NAME("authorization"),
+	[HTTP_SERVER_HPACK_CACHE_CONTROL] = HPACK_NAME("cache-control"),
+	[HTTP_SERVER_HPACK_CONTENT_DISPOSITION] = HPACK_NAME("content-disposition"),
+	[HTTP_SERVER_HPACK_CONTENT_ENCODING] = HPACK_NAME("content-encoding"),
+	[HTTP_SERVER_HPACK_CONTENT_LANGUAGE] = HPACK_NAME("content-language"),
+	[HTTP_SERVER_HPACK_CONTENT_LENGTH] = HPACK_NAME("content-length"),
+	[HTTP_SERVER_HPACK_CONTENT_LOCATION] = HPACK_NAME("content-location"),
+	[HTTP_SERVER_HPACK_CONTENT_RANGE] = HPACK_NAME("content-range"),
+	[HTTP_SERVER_HPACK_CONTENT_TYPE] = HPACK_NAME("content-type"),
+	[HTTP_SERVER_HPACK_COOKIE] = HPACK_NAME("cookie"),
+	[HTTP_SERVER_HPACK_DATE] = HPACK_NAME("date"),
+	[HTTP_SERVER_HPACK_ETAG] = HPACK_NAME("etag"),
+	[HTTP_SERVER_HPACK_EXPECT] = HPACK_NAME("expect"),
+	[HTTP_SERVER_HPACK_EXPIRES] = HPACK_NAME("expires"),
+	[HTTP_SERVER_HPACK_FROM] = HPACK_NAME("from"),
+	[HTTP_SERVER_HPACK_HOST] = HPACK_NAME("host"),
+	[HTTP_SERVER_HPACK_IF_MATCH] = HPACK_NAME("if-match"),
+	[HTTP_SERVER_HPACK_IF_MODIFIED_SINCE] = HPACK_NAME("if-modified-since"),
+	[HTTP_SERVER_HPACK_IF_NONE_MATCH] = HPACK_NAME("if-none-match"),
+	[HTTP_SERVER_HPACK_IF_RANGE] = HPACK_NAME("if-range"),
+	[HTTP_SERVER_HPACK_IF_UNMODIFIED_SINCE] = HPACK_NAME("if-unmodified-since"),
+	[HTTP_SERVER_HPACK_LAST_MODIFIED] = HPACK_NAME("last-modified"),
+	[HTTP_SERVER_HPACK_LINK] = HPACK_NAME("link"),
+	[HTTP_SERVER_HPACK_LOCATION] = HPACK_NAME("location"),
+	[HTTP_SERVER_HPACK_MAX_FORWARDS] = HPACK_NAME("max-forwards"),
+	[HTTP_SERVER_HPACK_PROXY_AUTHENTICATE] = HPACK_NAME("proxy-authenticate"),
+	[HTTP_SERVER_HPACK_PROXY_AUTHORIZATION] = HPACK_NAME("proxy-authorization"),
+	[HTTP_SERVER_HPACK_RANGE] = HPACK_NAME("range"),
+	[HTTP_SERVER_HPACK_REFERER] = HPACK_NAME("referer"),
+	[HTTP_SERVER_HPACK_REFRESH] = HPACK_NAME("refresh"),
+	[HTTP_SERVER_HPACK_RETRY_AFTER] = HPACK_NAME("retry-after"),
+	[HTTP_SERVER_HPACK_SERVER] = HPACK_NAME("server"),
+	[HTTP_SERVER_HPACK_SET_COOKIE] = HPACK_NAME("set-cookie"),
+	[HTTP_SERVER_HPACK_STRICT_TRANSPORT_SECURITY] = HPACK_NAME("strict-transport-security"),
+	[HTTP_SERVER_HPACK_TRANSFER_ENCODING] = HPACK_NAME("transfer-encoding"),
+	[HTTP_SERVER_HPACK_USER_AGENT] = HPACK_NAME("user-agent"),
+	[HTTP_SERVER_HPACK_VARY] = HPACK_NAME("vary"),
+	[HTTP_SERVER_HPACK_VIA] = HPACK_NAME("via"),
+	[HTTP_SERVER_HPACK_WWW_AUTHENTICATE] = HPACK_NAME("www-authenticate"),
 };
 
 const struct hpack_table_entry *http_hpack_table_get(uint32_t key)
@@ -111,11 +118,10 @@ static int http_hpack_find_index(struct http_hpack_header_buf *header,
 	     i <= HTTP_SERVER_HPACK_WWW_AUTHENTICATE; i++) {
 		entry = &http_hpack_table_static[i];
 
-		if (entry->name != NULL &&
-		    strlen(entry->name) == header->name_len &&
+		if (entry->name_len == header->name_len &&
 		    memcmp(entry->name, header->name, header->name_len) == 0) {
 			if (entry->value != NULL &&
-			    strlen(entry->value) == header->value_len &&
+			    entry->value_len == header->value_len &&
 			    memcmp(entry->value, header->value, header->value_len) == 0) {
 				/* Got exact match. */
 				*name_only = false;
@@ -137,6 +143,203 @@ static int http_hpack_find_index(struct http_hpack_header_buf *header,
 	return -ENOENT;
 }
 
+#define HPACK_STATIC_TABLE_LEN HTTP_SERVER_HPACK_WWW_AUTHENTICATE
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+
+/*
+ * The dynamic table is a FIFO of header fields. Each entry gets a sequence
+ * number when inserted, so the entry with HPACK index i is simply
+ * next - 1 - (i - 62), and eviction only moves first forward. The strings
+ * are appended to data and compacted with a single memmove when the end of
+ * the buffer is reached. For the encoder, entries are also chained by hash
+ * so that a header field is found without a walk of the whole table.
+ * Chain links pointing to evicted entries are detected by their sequence
+ * number.
+ */
+
+static uint32_t hpack_field_hash(const char *name, size_t name_len,
+				 const char *value, size_t value_len)
+{
+	uint32_t hash = sys_hash32_fnv1a(name, name_len);
+
+	hash = sys_hash32_fnv1a_update(hash, ":", 1);
+
+	return sys_hash32_fnv1a_update(hash, value, value_len);
+}
+
+static inline uint32_t table_count(const struct http_hpack_table *table)
+{
+	return table->next - table->first;
+}
+
+static inline bool table_seq_valid(const struct http_hpack_table *table,
+				   uint32_t seq)
+{
+	return seq - table->first < table_count(table);
+}
+
+static inline struct http_hpack_dynamic_entry *
+table_entry(struct http_hpack_table *table, uint32_t seq)
+{
+	return &table->entries[seq % HTTP_HPACK_TABLE_MAX_ENTRIES];
+}
+
+static inline const char *table_entry_data(struct http_hpack_table *table,
+					   struct http_hpack_dynamic_entry *entry)
+{
+	return (const char *)&table->data[entry->pos - table->data_start];
+}
+
+static void table_evict(struct http_hpack_table *table, uint32_t size)
+{
+	struct http_hpack_dynamic_entry *entry;
+
+	while (table->size > size) {
+		entry = table_entry(table, table->first);
+		table->size -= entry->name_len + entry->value_len +
+			       HTTP_HPACK_ENTRY_OVERHEAD;
+		table->first++;
+	}
+
+	if (table_count(table) == 0) {
+		table->data_start = table->data_end;
+	}
+}
+
+static void table_add(struct http_hpack_table *table,
+		      const char *name, size_t name_len,
+		      const char *value, size_t value_len)
+{
+	struct http_hpack_dynamic_entry *entry;
+	uint32_t entry_size = name_len + value_len + HTTP_HPACK_ENTRY_OVERHEAD;
+	uint32_t *bucket;
+	uint32_t head;
+
+	if (entry_size > table->max_size) {
+		/* RFC7541 ch 4.4, an entry larger than the table empties it. */
+		table_evict(table, 0);
+		return;
+	}
+
+	table_evict(table, table->max_size - entry_size);
+
+	if (table->data_end - table->data_start + name_len + value_len >
+	    sizeof(table->data)) {
+		/* Move the live strings to the beginning of the buffer. As
+		 * the size of the table includes the entry overhead, they
+		 * always fit with the new strings.
+		 */
+		head = table_count(table) > 0 ?
+		       table_entry(table, table->first)->pos : table->data_end;
+		memmove(table->data, &table->data[head - table->data_start],
+			table->data_end - head);
+		table->data_start = head;
+	}
+
+	entry = table_entry(table, table->next);
+	entry->pos = table->data_end;
+	entry->name_len = name_len;
+	entry->value_len = value_len;
+	entry->hash = hpack_field_hash(name, name_len, value, value_len);
+
+	memcpy(&table->data[table->data_end - table->data_start], name, name_len);
+	memcpy(&table->data[table->data_end - table->data_start + name_len],
+	       value, value_len);
+	table->data_end += name_len + value_len;
+
+	bucket = &table->buckets[entry->hash % HTTP_HPACK_TABLE_BUCKETS];
+	entry->next = *bucket;
+	*bucket = table->next + 1;
+
+	table->next++;
+	table->size += entry_size;
+}
+
+static struct http_hpack_dynamic_entry *
+table_get(struct http_hpack_table *table, uint32_t index)
+{
+	uint32_t offset = index - HPACK_STATIC_TABLE_LEN - 1;
+
+	if (table == NULL || offset >= table_count(table)) {
+		return NULL;
+	}
+
+	return table_entry(table, table->next - 1 - offset);
+}
+
+static int table_find(struct http_hpack_table *table,
+		      struct http_hpack_header_buf *header)
+{
+	struct http_hpack_dynamic_entry *entry;
+	uint32_t hash;
+	uint32_t seq;
+	const char *data;
+
+	if (table_count(table) == 0) {
+		return -ENOENT;
+	}
+
+	hash = hpack_field_hash(header->name, header->name_len,
+				header->value, header->value_len);
+	seq = table->buckets[hash % HTTP_HPACK_TABLE_BUCKETS];
+
+	/* Chains go from the newest to the oldest entry. */
+	while (seq != 0 && table_seq_valid(table, seq - 1)) {
+		entry = table_entry(table, seq - 1);
+		data = table_entry_data(table, entry);
+
+		if (entry->hash == hash &&
+		    entry->name_len == header->name_len &&
+		    entry->value_len == header->value_len &&
+		    memcmp(data, header->name, header->name_len) == 0 &&
+		    memcmp(data + entry->name_len, header->value,
+			   header->value_len) == 0) {
+			return HPACK_STATIC_TABLE_LEN + 1 + table->next - seq;
+		}
+
+		seq = entry->next;
+	}
+
+	return -ENOENT;
+}
+
+void http_hpack_table_init(struct http_hpack_table *table, uint32_t max_size)
+{
+	memset(table->buckets, 0, sizeof(table->buckets));
+	table->data_start = 0;
+	table->data_end = 0;
+	table->first = 0;
+	table->next = 0;
+	table->size = 0;
+	table->max_size = MIN(max_size, sizeof(table->data));
+	table->size_update = false;
+}
+
+void http_hpack_table_set_max_size(struct http_hpack_table *table,
+				   uint32_t max_size)
+{
+	table->max_size = MIN(max_size, sizeof(table->data));
+	table->size_update = true;
+	table_evict(table, table->max_size);
+}
+
+#else /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
+
+static inline struct http_hpack_dynamic_entry *
+table_get(struct http_hpack_table *table, uint32_t index)
+{
+	return NULL;
+}
+
+static inline const char *table_entry_data(struct http_hpack_table *table,
+					   struct http_hpack_dynamic_entry *entry)
+{
+	return NULL;
+}
+
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
+
 #define HPACK_INTEGER_CONTINUATION_FLAG            0x80
 #define HPACK_STRING_HUFFMAN_FLAG                  0x80
 #define HPACK_STRING_PREFIX_LEN                    7
@@ -286,7 +489,8 @@ static int hpack_string_decode(const uint8_t *buf, size_t datalen,
 	return len;
 }
 
-static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
+static int hpack_handle_indexed(struct http_hpack_table *table,
+				const uint8_t *buf, size_t datalen,
 				struct http_hpack_header_buf *header)
 {
 	const struct hpack_table_entry *entry;
@@ -303,6 +507,21 @@ static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 		return -EBADMSG;
 	}
 
+	if (index > HPACK_STATIC_TABLE_LEN) {
+		struct http_hpack_dynamic_entry *dyn = table_get(table, index);
+
+		if (dyn == NULL) {
+			return -EBADMSG;
+		}
+
+		header->name = table_entry_data(table, dyn);
+		header->name_len = dyn->name_len;
+		header->value = header->name + dyn->name_len;
+		header->value_len = dyn->value_len;
+
+		return ret;
+	}
+
 	entry = http_hpack_table_get(index);
 	if (entry == NULL) {
 		return -EBADMSG;
@@ -313,16 +532,17 @@ static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 	}
 
 	header->name = entry->name;
-	header->name_len = strlen(entry->name);
+	header->name_len = entry->name_len;
 	header->value = entry->value;
-	header->value_len = strlen(entry->value);
+	header->value_len = entry->value_len;
 
 	return ret;
 }
 
-static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
+static int hpack_handle_literal(struct http_hpack_table *table,
+				const uint8_t *buf, size_t datalen,
 				struct http_hpack_header_buf *header,
-				uint8_t prefix_len)
+				uint8_t prefix_len, bool indexing)
 {
 	uint32_t index;
 	int ret, len;
@@ -349,6 +569,29 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 		len += ret;
 		buf += ret;
 		datalen -= ret;
+	} else if (index > HPACK_STATIC_TABLE_LEN) {
+		/* Indexed name, from the dynamic table. */
+		struct http_hpack_dynamic_entry *dyn = table_get(table, index);
+
+		if (dyn == NULL) {
+			return -EBADMSG;
+		}
+
+		header->name = table_entry_data(table, dyn);
+		header->name_len = dyn->name_len;
+
+		if (indexing) {
+			/* The entry may be evicted when the new one is added,
+			 * keep a copy of the name.
+			 */
+			if (dyn->name_len > sizeof(header->buf)) {
+				return -ENOBUFS;
+			}
+
+			memcpy(header->buf, header->name, dyn->name_len);
+			header->name = header->buf;
+			header->datalen = dyn->name_len;
+		}
 	} else {
 		/* Indexed name. */
 		const struct hpack_table_entry *entry;
@@ -363,7 +606,7 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 		}
 
 		header->name = entry->name;
-		header->name_len = strlen(entry->name);
+		header->name_len = entry->name_len;
 	}
 
 	ret = hpack_string_decode(buf, datalen, HPACK_HEADER_VALUE, header);
@@ -376,23 +619,39 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 	return len;
 }
 
-static int hpack_handle_literal_index(const uint8_t *buf, size_t datalen,
-			       struct http_hpack_header_buf *header)
+static int hpack_handle_literal_index(struct http_hpack_table *table,
+				      const uint8_t *buf, size_t datalen,
+				      struct http_hpack_header_buf *header)
 {
-	/* TODO Add dynamic table support, if needed. */
+	int ret;
+
+	ret = hpack_handle_literal(table, buf, datalen, header,
+				   HPACK_PREFIX_LEN_LITERAL_INDEXING, true);
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	/* Only add the entry once the whole field was decoded, so that the
+	 * decoding can be retried when more data is available.
+	 */
+	if (ret > 0 && table != NULL) {
+		table_add(table, header->name, header->name_len,
+			  header->value, header->value_len);
+	}
+#endif
 
-	return hpack_handle_literal(buf, datalen, header,
-				    HPACK_PREFIX_LEN_LITERAL_INDEXING);
+	return ret;
 }
 
-static int hpack_handle_literal_no_index(const uint8_t *buf, size_t datalen,
-				  struct http_hpack_header_buf *header)
+static int hpack_handle_literal_no_index(struct http_hpack_table *table,
+					 const uint8_t *buf, size_t datalen,
+					 struct http_hpack_header_buf *header)
 {
-	return hpack_handle_literal(buf, datalen, header,
-				    HPACK_PREFIX_LEN_LITERAL_NO_INDEXING);
+	return hpack_handle_literal(table, buf, datalen, header,
+				    HPACK_PREFIX_LEN_LITERAL_NO_INDEXING, false);
 }
 
-static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
+static int hpack_handle_dynamic_size_update(struct http_hpack_table *table,
+					    const uint8_t *buf, size_t datalen,
+					    struct http_hpack_header_buf *header)
 {
 	uint32_t max_size;
 	int ret;
@@ -403,13 +662,30 @@ static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
 		return ret;
 	}
 
-	/* TODO Add dynamic table support, if needed. */
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	if (table != NULL) {
+		/* The peer may not exceed the size we advertised. */
+		if (max_size > HTTP_SERVER_HPACK_TABLE_SIZE) {
+			return -EBADMSG;
+		}
+
+		table->max_size = max_size;
+		table_evict(table, max_size);
+	}
+#endif
+
+	/* Not a header field. */
+	header->name = "";
+	header->name_len = 0;
+	header->value = "";
+	header->value_len = 0;
 
 	return ret;
 }
 
-int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
-			     struct http_hpack_header_buf *header)
+int http_hpack_table_decode_header(struct http_hpack_table *table,
+				   const uint8_t *buf, size_t datalen,
+				   struct http_hpack_header_buf *header)
 {
 	uint8_t prefix;
 	int ret;
@@ -425,18 +701,19 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 	prefix = *buf;
 
 	if ((prefix & HPACK_PREFIX_INDEXED_MASK) == HPACK_PREFIX_INDEXED) {
-		ret = hpack_handle_indexed(buf, datalen, header);
+		ret = hpack_handle_indexed(table, buf, datalen, header);
 	} else if ((prefix & HPACK_PREFIX_LITERAL_INDEXING_MASK) ==
 		   HPACK_PREFIX_LITERAL_INDEXING) {
-		ret = hpack_handle_literal_index(buf, datalen, header);
+		ret = hpack_handle_literal_index(table, buf, datalen, header);
 	} else if (((prefix & HPACK_PREFIX_LITERAL_NO_INDEXING_MASK) ==
 		    HPACK_PREFIX_LITERAL_NO_INDEXING) ||
 		   ((prefix & HPACK_PREFIX_LITERAL_NEVER_INDEXED_MASK) ==
 		    HPACK_PREFIX_LITERAL_NEVER_INDEXED)) {
-		ret = hpack_handle_literal_no_index(buf, datalen, header);
+		ret = hpack_handle_literal_no_index(table, buf, datalen, header);
 	} else if ((prefix & HPACK_PREFIX_DYNAMIC_TABLE_SIZE_MASK) ==
 		   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE) {
-		ret = hpack_handle_dynamic_size_update(buf, datalen);
+		ret = hpack_handle_dynamic_size_update(table, buf, datalen,
+						       header);
 	} else {
 		ret = -EINVAL;
 	}
@@ -444,6 +721,12 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 	return ret;
 }
 
+int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
+			     struct http_hpack_header_buf *header)
+{
+	return http_hpack_table_decode_header(NULL, buf, datalen, header);
+}
+
 static int hpack_integer_encode(uint8_t *buf, size_t buflen, int value,
 				uint8_t prefix, uint8_t n)
 {
@@ -470,7 +753,7 @@ static int hpack_integer_encode(uint8_t *buf, size_t buflen, int value,
 			return -ENOBUFS;
 		}
 
-		*buf = (uint8_t)((value % 128) + 128);
+		*buf++ = (uint8_t)((value % 128) + 128);
 		len++;
 		value /= 128;
 	}
@@ -534,23 +817,13 @@ static int hpack_string_encode(uint8_t *buf, size_t buflen,
 	return len;
 }
 
-static int hpack_encode_literal(uint8_t *buf, size_t buflen,
+static int hpack_encode_literal(uint8_t *buf, size_t buflen, int index,
+				uint8_t prefix, uint8_t prefix_len,
 				struct http_hpack_header_buf *header)
 {
 	int ret, len = 0;
 
-	ret = hpack_integer_encode(buf, buflen, 0,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
-	if (ret < 0) {
-		return ret;
-	}
-
-	buf += ret;
-	buflen -= ret;
-	len += ret;
-
-	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
+	ret = hpack_integer_encode(buf, buflen, index, prefix, prefix_len);
 	if (ret < 0) {
 		return ret;
 	}
@@ -559,32 +832,18 @@ static int hpack_encode_literal(uint8_t *buf, size_t buflen,
 	buflen -= ret;
 	len += ret;
 
-	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
-	if (ret < 0) {
-		return ret;
-	}
-
-	len += ret;
-
-	return len;
-}
-
-static int hpack_encode_literal_value(uint8_t *buf, size_t buflen, int index,
-				      struct http_hpack_header_buf *header)
-{
-	int ret, len = 0;
+	if (index == 0) {
+		/* Literal name. */
+		ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
+		if (ret < 0) {
+			return ret;
+		}
 
-	ret = hpack_integer_encode(buf, buflen, index,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
-	if (ret < 0) {
-		return ret;
+		buf += ret;
+		buflen -= ret;
+		len += ret;
 	}
 
-	buf += ret;
-	buflen -= ret;
-	len += ret;
-
 	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
 	if (ret < 0) {
 		return ret;
@@ -601,11 +860,13 @@ static int hpack_encode_indexed(uint8_t *buf, size_t buflen, int index)
 				    HPACK_PREFIX_LEN_INDEXED);
 }
 
-int http_hpack_encode_header(uint8_t *buf, size_t buflen,
-			     struct http_hpack_header_buf *header)
+int http_hpack_table_encode_header(struct http_hpack_table *table,
+				   uint8_t *buf, size_t buflen,
+				   struct http_hpack_header_buf *header)
 {
 	int ret, len = 0;
 	bool name_only;
+	int index;
 
 	if (buf == NULL || header == NULL ||
 	    header->name == NULL || header->name_len == 0 ||
@@ -617,17 +878,77 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 		return -ENOBUFS;
 	}
 
-	ret = http_hpack_find_index(header, &name_only);
-	if (ret < 0) {
-		/* All literal */
-		len = hpack_encode_literal(buf, buflen, header);
-	} else if (name_only) {
-		/* Literal value */
-		len = hpack_encode_literal_value(buf, buflen, ret, header);
-	} else {
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	if (table != NULL && table->size_update) {
+		/* RFC7541 ch 4.2, signal the new maximum size first. */
+		ret = hpack_integer_encode(buf, buflen, table->max_size,
+					   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+					   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+		if (ret < 0) {
+			return ret;
+		}
+
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+#endif
+
+	index = http_hpack_find_index(header, &name_only);
+	if (index >= 0 && !name_only) {
 		/* Indexed */
-		len = hpack_encode_indexed(buf, buflen, ret);
+		ret = hpack_encode_indexed(buf, buflen, index);
+		goto out;
 	}
 
-	return len;
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	if (table != NULL) {
+		ret = table_find(table, header);
+		if (ret > 0) {
+			/* Indexed, from the dynamic table */
+			ret = hpack_encode_indexed(buf, buflen, ret);
+			goto out;
+		}
+
+		if (header->name_len + header->value_len +
+		    HTTP_HPACK_ENTRY_OVERHEAD <= table->max_size) {
+			/* Literal with incremental indexing */
+			ret = hpack_encode_literal(buf, buflen, MAX(index, 0),
+						   HPACK_PREFIX_LITERAL_INDEXING,
+						   HPACK_PREFIX_LEN_LITERAL_INDEXING,
+						   header);
+			if (ret > 0) {
+				table_add(table, header->name, header->name_len,
+					  header->value, header->value_len);
+			}
+
+			goto out;
+		}
+	}
+#endif
+
+	/* Literal name or value */
+	ret = hpack_encode_literal(buf, buflen, MAX(index, 0),
+				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED,
+				   header);
+
+out:
+	if (ret < 0) {
+		return ret;
+	}
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	if (table != NULL) {
+		table->size_update = false;
+	}
+#endif
+
+	return len + ret;
+}
+
+int http_hpack_encode_header(uint8_t *buf, size_t buflen,
+			     struct http_hpack_header_buf *header)
+{
+	return http_hpack_table_encode_header(NULL, buf, buflen, header);
 }
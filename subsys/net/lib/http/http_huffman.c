@@ -277,51 +277,172 @@ static const struct decode_elem decode_table[] = {
 	{ 30,  22, { 0b11111111, 0b11111111, 0b11111111, 0b11111000 } },
 };
 
-static const struct decode_elem eos = {
-	30,   0, { 0b11111111, 0b11111111, 0b11111111, 0b11111100 }
-};
-
 #define UINT32_BITLEN 32
 
 #define MSB_MASK(len) (UINT32_MAX << (UINT32_BITLEN - len))
 #define LSB_MASK(len) ((1UL << len) - 1UL)
 
-static bool huffman_bits_compare(uint32_t bits, const struct decode_elem *entry)
-{
-	uint32_t mask = MSB_MASK(entry->bitlen);
-	uint32_t code = sys_get_be32(entry->code);
+/* The HPACK code is canonical: the codes of a given length are consecutive
+ * numbers, and follow the codes of the previous length. The decoder looks
+ * up the codes of up to 8 bits directly from the first byte of the input.
+ * Longer codes are found by comparing the input with the highest code of
+ * each length, and their symbol is at a fixed offset from the first code
+ * of that length in decode_table. The tables below are derived from
+ * decode_table, the EOS symbol following its last entry.
+ */
+struct huffman_fast_elem {
+	uint8_t symbol;
+	uint8_t bitlen; /* 0 if the code is longer than 8 bits */
+};
 
-	if (code == (bits & mask)) {
-		return true;
-	}
+struct huffman_len_elem {
+	uint8_t bitlen;
+	uint32_t limit; /* first code longer than bitlen, left aligned */
+	uint16_t offset; /* decode_table index of the first code */
+	uint32_t first; /* first code of this length */
+};
 
-	return false;
-}
+/* The EOS code, 30 bits set, is decoded as this symbol */
+#define EOS_SYMBOL 256
+
+static const struct huffman_fast_elem decode_fast[256] = {
+	{  48, 5 }, {  48, 5 }, {  48, 5 }, {  48, 5 },
+	{  48, 5 }, {  48, 5 }, {  48, 5 }, {  48, 5 },
+	{  49, 5 }, {  49, 5 }, {  49, 5 }, {  49, 5 },
+	{  49, 5 }, {  49, 5 }, {  49, 5 }, {  49, 5 },
+	{  50, 5 }, {  50, 5 }, {  50, 5 }, {  50, 5 },
+	{  50, 5 }, {  50, 5 }, {  50, 5 }, {  50, 5 },
+	{  97, 5 }, {  97, 5 }, {  97, 5 }, {  97, 5 },
+	{  97, 5 }, {  97, 5 }, {  97, 5 }, {  97, 5 },
+	{  99, 5 }, {  99, 5 }, {  99, 5 }, {  99, 5 },
+	{  99, 5 }, {  99, 5 }, {  99, 5 }, {  99, 5 },
+	{ 101, 5 }, { 101, 5 }, { 101, 5 }, { 101, 5 },
+	{ 101, 5 }, { 101, 5 }, { 101, 5 }, { 101, 5 },
+	{ 105, 5 }, { 105, 5 }, { 105, 5 }, { 105, 5 },
+	{ 105, 5 }, { 105, 5 }, { 105, 5 }, { 105, 5 },
+	{ 111, 5 }, { 111, 5 }, { 111, 5 }, { 111, 5 },
+	{ 111, 5 }, { 111, 5 }, { 111, 5 }, { 111, 5 },
+	{ 115, 5 }, { 115, 5 }, { 115, 5 }, { 115, 5 },
+	{ 115, 5 }, { 115, 5 }, { 115, 5 }, { 115, 5 },
+	{ 116, 5 }, { 116, 5 }, { 116, 5 }, { 116, 5 },
+	{ 116, 5 }, { 116, 5 }, { 116, 5 }, { 116, 5 },
+	{  32, 6 }, {  32, 6 }, {  32, 6 }, {  32, 6 },
+	{  37, 6 }, {  37, 6 }, {  37, 6 }, {  37, 6 },
+	{  45, 6 }, {  45, 6 }, {  45, 6 }, {  45, 6 },
+	{  46, 6 }, {  46, 6 }, {  46, 6 }, {  46, 6 },
+	{  47, 6 }, {  47, 6 }, {  47, 6 }, {  47, 6 },
+	{  51, 6 }, {  51, 6 }, {  51, 6 }, {  51, 6 },
+	{  52, 6 }, {  52, 6 }, {  52, 6 }, {  52, 6 },
+	{  53, 6 }, {  53, 6 }, {  53, 6 }, {  53, 6 },
+	{  54, 6 }, {  54, 6 }, {  54, 6 }, {  54, 6 },
+	{  55, 6 }, {  55, 6 }, {  55, 6 }, {  55, 6 },
+	{  56, 6 }, {  56, 6 }, {  56, 6 }, {  56, 6 },
+	{  57, 6 }, {  57, 6 }, {  57, 6 }, {  57, 6 },
+	{  61, 6 }, {  61, 6 }, {  61, 6 }, {  61, 6 },
+	{  65, 6 }, {  65, 6 }, {  65, 6 }, {  65, 6 },
+	{  95, 6 }, {  95, 6 }, {  95, 6 }, {  95, 6 },
+	{  98, 6 }, {  98, 6 }, {  98, 6 }, {  98, 6 },
+	{ 100, 6 }, { 100, 6 }, { 100, 6 }, { 100, 6 },
+	{ 102, 6 }, { 102, 6 }, { 102, 6 }, { 102, 6 },
+	{ 103, 6 }, { 103, 6 }, { 103, 6 }, { 103, 6 },
+	{ 104, 6 }, { 104, 6 }, { 104, 6 }, { 104, 6 },
+	{ 108, 6 }, { 108, 6 }, { 108, 6 }, { 108, 6 },
+	{ 109, 6 }, { 109, 6 }, { 109, 6 }, { 109, 6 },
+	{ 110, 6 }, { 110, 6 }, { 110, 6 }, { 110, 6 },
+	{ 112, 6 }, { 112, 6 }, { 112, 6 }, { 112, 6 },
+	{ 114, 6 }, { 114, 6 }, { 114, 6 }, { 114, 6 },
+	{ 117, 6 }, { 117, 6 }, { 117, 6 }, { 117, 6 },
+	{  58, 7 }, {  58, 7 }, {  66, 7 }, {  66, 7 },
+	{  67, 7 }, {  67, 7 }, {  68, 7 }, {  68, 7 },
+	{  69, 7 }, {  69, 7 }, {  70, 7 }, {  70, 7 },
+	{  71, 7 }, {  71, 7 }, {  72, 7 }, {  72, 7 },
+	{  73, 7 }, {  73, 7 }, {  74, 7 }, {  74, 7 },
+	{  75, 7 }, {  75, 7 }, {  76, 7 }, {  76, 7 },
+	{  77, 7 }, {  77, 7 }, {  78, 7 }, {  78, 7 },
+	{  79, 7 }, {  79, 7 }, {  80, 7 }, {  80, 7 },
+	{  81, 7 }, {  81, 7 }, {  82, 7 }, {  82, 7 },
+	{  83, 7 }, {  83, 7 }, {  84, 7 }, {  84, 7 },
+	{  85, 7 }, {  85, 7 }, {  86, 7 }, {  86, 7 },
+	{  87, 7 }, {  87, 7 }, {  89, 7 }, {  89, 7 },
+	{ 106, 7 }, { 106, 7 }, { 107, 7 }, { 107, 7 },
+	{ 113, 7 }, { 113, 7 }, { 118, 7 }, { 118, 7 },
+	{ 119, 7 }, { 119, 7 }, { 120, 7 }, { 120, 7 },
+	{ 121, 7 }, { 121, 7 }, { 122, 7 }, { 122, 7 },
+	{  38, 8 }, {  42, 8 }, {  44, 8 }, {  59, 8 },
+	{  88, 8 }, {  90, 8 }, {   0, 0 }, {   0, 0 },
+};
+
+static const struct huffman_len_elem decode_len[] = {
+	{ 10, 0xff400000,  74, 0x000003f8 },
+	{ 11, 0xffa00000,  79, 0x000007fa },
+	{ 12, 0xffc00000,  82, 0x00000ffa },
+	{ 13, 0xfff00000,  84, 0x00001ff8 },
+	{ 14, 0xfff80000,  90, 0x00003ffc },
+	{ 15, 0xfffe0000,  92, 0x00007ffc },
+	{ 19, 0xfffe6000,  95, 0x0007fff0 },
+	{ 20, 0xfffee000,  98, 0x000fffe6 },
+	{ 21, 0xffff4800, 106, 0x001fffdc },
+	{ 22, 0xffffb000, 119, 0x003fffd2 },
+	{ 23, 0xffffea00, 145, 0x007fffd8 },
+	{ 24, 0xfffff600, 174, 0x00ffffea },
+	{ 25, 0xfffff800, 186, 0x01ffffec },
+	{ 26, 0xfffffbc0, 190, 0x03ffffe0 },
+	{ 27, 0xfffffe20, 205, 0x07ffffde },
+	{ 28, 0xfffffff0, 224, 0x0fffffe2 },
+	{ 30, 0xffffffff, 253, 0x3ffffffc },
+};
 
-static const struct decode_elem *huffman_decode_bits(uint32_t bits)
+static const uint8_t encode_index[256] = {
+	 84, 145, 224, 225, 226, 227, 228, 229, 230, 174, 253, 231,
+	232, 254, 233, 234, 235, 236, 237, 238, 239, 240, 255, 241,
+	242, 243, 244, 245, 246, 247, 248, 249,  10,  74,  75,  82,
+	 85,  11,  68,  79,  76,  77,  69,  80,  70,  12,  13,  14,
+	  0,   1,   2,  15,  16,  17,  18,  19,  20,  21,  36,  71,
+	 92,  22,  83,  78,  86,  23,  37,  38,  39,  40,  41,  42,
+	 43,  44,  45,  46,  47,  48,  49,  50,  51,  52,  53,  54,
+	 55,  56,  57,  58,  72,  59,  73,  87,  95,  88,  90,  24,
+	 93,   3,  25,   4,  26,   5,  27,  28,  29,   6,  60,  61,
+	 30,  31,  32,   7,  33,  62,  34,   8,   9,  35,  63,  64,
+	 65,  66,  67,  94,  81,  91,  89, 250,  98, 119,  99, 100,
+	120, 121, 122, 146, 123, 147, 148, 149, 150, 151, 175, 152,
+	176, 177, 124, 153, 178, 154, 155, 156, 157, 106, 125, 158,
+	126, 159, 160, 179, 127, 107, 101, 128, 129, 161, 162, 108,
+	163, 130, 131, 180, 109, 132, 164, 165, 110, 111, 133, 112,
+	166, 134, 167, 168, 102, 135, 136, 137, 169, 138, 139, 170,
+	190, 191, 103,  96, 140, 171, 141, 186, 192, 193, 194, 205,
+	206, 195, 181, 187,  97, 113, 196, 207, 208, 197, 209, 182,
+	114, 115, 198, 199, 251, 210, 211, 212, 104, 183, 105, 116,
+	142, 117, 118, 172, 143, 144, 188, 189, 184, 185, 200, 173,
+	201, 213, 202, 203, 214, 215, 216, 217, 218, 252, 219, 220,
+	221, 222, 223, 204,
+};
+
+/* Decode the symbol at the start of bits, return its code length */
+static uint8_t huffman_decode_bits(uint32_t bits, uint16_t *symbol)
 {
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (huffman_bits_compare(bits, &decode_table[i])) {
-			return &decode_table[i];
-		}
-	}
+	const struct huffman_fast_elem *fast = &decode_fast[bits >> 24];
+	const struct huffman_len_elem *elem;
+	uint32_t index;
 
-	if (huffman_bits_compare(bits, &eos)) {
-		return &eos;
+	if (fast->bitlen > 0) {
+		*symbol = fast->symbol;
+		return fast->bitlen;
 	}
 
-	return NULL;
-}
-
-static const struct decode_elem *huffman_find_entry(uint8_t symbol)
-{
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (decode_table[i].symbol == symbol) {
-			return &decode_table[i];
+	for (elem = decode_len; elem < &decode_len[ARRAY_SIZE(decode_len) - 1]; elem++) {
+		if (bits < elem->limit) {
+			break;
 		}
 	}
 
-	return NULL;
+	index = elem->offset + ((bits >> (UINT32_BITLEN - elem->bitlen)) - elem->first);
+	if (index >= ARRAY_SIZE(decode_table)) {
+		*symbol = EOS_SYMBOL;
+	} else {
+		*symbol = decode_table[index].symbol;
+	}
+
+	return elem->bitlen;
 }
 
 #define MAX_PADDING_LEN 7
@@ -330,59 +451,35 @@ int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			      uint8_t *buf, size_t buflen)
 {
 	size_t encoded_bits_len = encoded_len * 8;
-	uint8_t bits_needed = UINT32_BITLEN;
-	const struct decode_elem *decoded;
-	uint8_t bits_in_byte_left = 8;
 	size_t decoded_len = 0;
-	uint32_t bits = 0;
+	uint64_t bits = 0; /* Input bits not decoded yet, MSB first */
+	uint8_t bits_len = 0;
 
 	if (encoded_buf == NULL || buf == NULL || encoded_len == 0) {
 		return -EINVAL;
 	}
 
 	while (encoded_bits_len > 0) {
-		/* Refill the bits variable */
-		while (bits_needed > 0) {
-			if (encoded_len > 0) {
-				if (bits_in_byte_left <= bits_needed) {
-					/* Consume rest of the byte */
-					bits <<= bits_in_byte_left;
-					bits |= *encoded_buf &
-						    LSB_MASK(bits_in_byte_left);
-					bits_needed -= bits_in_byte_left;
-					bits_in_byte_left = 0;
-				} else {
-					/* Consume part of the byte */
-					bits <<= bits_needed;
-					bits |= (*encoded_buf >>
-						 (bits_in_byte_left - bits_needed)) &
-						LSB_MASK(bits_needed);
-					bits_in_byte_left -= bits_needed;
-					bits_needed = 0;
-				}
-			} else {
-				/* Pad with ones */
-				bits <<= bits_needed;
-				bits |= LSB_MASK(bits_needed);
-				bits_needed = 0;
-			}
+		uint16_t symbol;
+		uint8_t bitlen;
 
-			/* Move to next encoded byte */
-			if (bits_in_byte_left == 0) {
-				encoded_buf++;
+		/* Refill the bits variable a byte at a time, pad with ones */
+		while (bits_len <= 56) {
+			uint8_t byte = 0xff;
+
+			if (encoded_len > 0) {
+				byte = *encoded_buf++;
 				encoded_len--;
-				bits_in_byte_left = 8;
 			}
+
+			bits |= (uint64_t)byte << (56 - bits_len);
+			bits_len += 8;
 		}
 
 		/* Pass to decoder */
-		decoded = huffman_decode_bits(bits);
-		if (decoded == NULL) {
-			LOG_ERR("No symbol found");
-			return -EBADMSG;
-		}
+		bitlen = huffman_decode_bits((uint32_t)(bits >> 32), &symbol);
 
-		if (decoded == &eos) {
+		if (symbol == EOS_SYMBOL) {
 			if (encoded_bits_len > MAX_PADDING_LEN) {
 				LOG_ERR("eos reached prematurely");
 				return -EBADMSG;
@@ -391,14 +488,15 @@ int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			break;
 		}
 
-		if (encoded_bits_len < decoded->bitlen) {
+		if (encoded_bits_len < bitlen) {
 			LOG_ERR("Invalid symbol used for padding");
 			return -EBADMSG;
 		}
 
 		/* Remove consumed bits from bits variable. */
-		bits_needed += decoded->bitlen;
-		encoded_bits_len -= decoded->bitlen;
+		bits <<= bitlen;
+		bits_len -= bitlen;
+		encoded_bits_len -= bitlen;
 
 		/* Store decoded symbol */
 		if (buflen == 0) {
@@ -406,7 +504,7 @@ int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			return -ENOBUFS;
 		}
 
-		*buf = decoded->symbol;
+		*buf = (uint8_t)symbol;
 		buf++;
 		buflen--;
 		decoded_len++;
@@ -431,10 +529,7 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 		uint32_t code;
 		uint8_t bitlen;
 
-		entry = huffman_find_entry(*str);
-		if (entry == NULL) {
-			return -EINVAL;
-		}
+		entry = &decode_table[encode_index[*str]];
 
 		if (entry->bitlen > buflen_bits) {
 			return -ENOBUFS;
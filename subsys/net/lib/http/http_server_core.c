@@ -12,14 +12,18 @@
 #include <string.h>
 #include <strings.h>
 
+#include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/service.h>
+#include <zephyr/net/net_context.h>
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/tls_credentials.h>
+#include <zephyr/posix/fcntl.h>
 #include <zephyr/posix/sys/eventfd.h>
 #include <zephyr/posix/fnmatch.h>
+#include <zephyr/sys/hash_function.h>
 
 LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
@@ -38,25 +42,62 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
 #define HTTP_SERVER_MAX_SERVICES CONFIG_HTTP_SERVER_NUM_SERVICES
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
-#define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
+#define HTTP_SERVER_NUM_WORKERS  CONFIG_HTTP_SERVER_NUM_WORKERS
 
+/* Client slots of each worker thread */
+#define HTTP_SERVER_WORKER_CLIENTS \
+	DIV_ROUND_UP(HTTP_SERVER_MAX_CLIENTS, HTTP_SERVER_NUM_WORKERS)
+#define HTTP_SERVER_SOCK_COUNT \
+	(1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_WORKER_CLIENTS)
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_ZEROCOPY)
+/* Zero-copy descriptor of a client slot, busy until the network stack has
+ * released the data of the last send.
+ */
+struct static_zc_tx {
+	struct net_zc_tx zc;
+	atomic_t busy;
+};
+#endif
+
+/* Context of a worker thread. The first worker runs in the server thread,
+ * it owns the listen sockets and starts the other workers.
+ */
 struct http_server_ctx {
 	int num_clients;
 	int listen_fds; /* max value of 1 + MAX_SERVICES */
 
-	/* First pollfd is eventfd that can be used to stop the server,
-	 * then we have the server listen sockets,
-	 * and then the accepted sockets.
+	/* First pollfd is eventfd that can be used to stop the worker,
+	 * then we have the server listen sockets, shared by all workers,
+	 * and then the sockets accepted by this worker.
 	 */
 	struct zsock_pollfd fds[HTTP_SERVER_SOCK_COUNT];
-	struct http_client_ctx clients[HTTP_SERVER_MAX_CLIENTS];
+	struct http_client_ctx clients[HTTP_SERVER_WORKER_CLIENTS];
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_ZEROCOPY)
+	/* Kept out of the client contexts, which are cleared when the
+	 * connection is closed while the network stack may still reference
+	 * the descriptor.
+	 */
+	struct static_zc_tx static_zc[HTTP_SERVER_WORKER_CLIENTS];
+#endif
 };
 
-static struct http_server_ctx server_ctx;
+static struct http_server_ctx server_ctx[HTTP_SERVER_NUM_WORKERS];
 static K_SEM_DEFINE(server_start, 0, 1);
 static bool server_running;
 
+/* Protects the holder of the dynamic resources, shared by all workers */
+static struct k_spinlock resource_lock;
+
+#if HTTP_SERVER_NUM_WORKERS > 1
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, HTTP_SERVER_NUM_WORKERS - 1,
+				   CONFIG_HTTP_SERVER_STACK_SIZE);
+static struct k_thread worker_threads[HTTP_SERVER_NUM_WORKERS - 1];
+#endif
+
 static void close_client_connection(struct http_client_ctx *client);
+static void stop_workers(void);
 
 int http_server_init(struct http_server_ctx *ctx)
 {
@@ -202,6 +243,17 @@ int http_server_init(struct http_server_ctx *ctx)
 			continue;
 		}
 
+		/* All the workers poll the listen socket, the ones that lose
+		 * the race for a new connection must not block in accept.
+		 */
+		if (HTTP_SERVER_NUM_WORKERS > 1 &&
+		    zsock_fcntl(fd, F_SETFL, O_NONBLOCK) < 0) {
+			LOG_ERR("fcntl: %d", errno);
+			failed++;
+			zsock_close(fd);
+			continue;
+		}
+
 		LOG_DBG("Initialized HTTP Service %s:%u", svc->host, *svc->port);
 
 		ctx->fds[count].fd = fd;
@@ -222,6 +274,64 @@ int http_server_init(struct http_server_ctx *ctx)
 	return 0;
 }
 
+#if HTTP_SERVER_NUM_WORKERS > 1
+/* Set up the context of an additional worker, it polls the listen sockets
+ * of the first worker.
+ */
+static int http_server_worker_init(struct http_server_ctx *ctx)
+{
+	struct http_server_ctx *main_ctx = &server_ctx[0];
+	int fd;
+
+	memset(ctx->fds, 0, sizeof(ctx->fds));
+	memset(ctx->clients, 0, sizeof(ctx->clients));
+
+	for (int i = 0; i < ARRAY_SIZE(ctx->fds); i++) {
+		ctx->fds[i].fd = INVALID_SOCK;
+	}
+
+	fd = eventfd(0, 0);
+	if (fd < 0) {
+		fd = -errno;
+		LOG_ERR("eventfd failed (%d)", fd);
+		return fd;
+	}
+
+	ctx->fds[0].fd = fd;
+	ctx->fds[0].events = ZSOCK_POLLIN;
+
+	for (int i = 1; i < main_ctx->listen_fds; i++) {
+		ctx->fds[i].fd = main_ctx->fds[i].fd;
+		ctx->fds[i].events = ZSOCK_POLLIN;
+	}
+
+	ctx->listen_fds = main_ctx->listen_fds;
+	ctx->num_clients = 0;
+
+	return 0;
+}
+#endif
+
+/* A worker that has no free client slot stops polling the listen sockets,
+ * which leaves the new connections to the other workers.
+ */
+static void update_listen_events(struct http_server_ctx *ctx)
+{
+	short events = ZSOCK_POLLIN;
+
+	if (HTTP_SERVER_NUM_WORKERS == 1) {
+		return;
+	}
+
+	if (ctx->num_clients >= HTTP_SERVER_WORKER_CLIENTS) {
+		events = 0;
+	}
+
+	for (int i = 1; i < ctx->listen_fds; i++) {
+		ctx->fds[i].events = events;
+	}
+}
+
 static int accept_new_client(int server_fd)
 {
 	int new_socket;
@@ -247,8 +357,15 @@ static int accept_new_client(int server_fd)
 
 static void close_all_sockets(struct http_server_ctx *ctx)
 {
-	zsock_close(ctx->fds[0].fd); /* close eventfd */
-	ctx->fds[0].fd = -1;
+	bool main_worker = (ctx == &server_ctx[0]);
+
+	/* The eventfd of the other workers is closed by the first worker
+	 * once they have stopped, as it is used to stop them.
+	 */
+	if (main_worker) {
+		zsock_close(ctx->fds[0].fd); /* close eventfd */
+		ctx->fds[0].fd = -1;
+	}
 
 	for (int i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
 		if (ctx->fds[i].fd < 0) {
@@ -256,10 +373,12 @@ static void close_all_sockets(struct http_server_ctx *ctx)
 		}
 
 		if (i < ctx->listen_fds) {
-			zsock_close(ctx->fds[i].fd);
+			if (main_worker) {
+				zsock_close(ctx->fds[i].fd);
+			}
 		} else {
 			struct http_client_ctx *client =
-				&server_ctx.clients[i - ctx->listen_fds];
+				&ctx->clients[i - ctx->listen_fds];
 
 			close_client_connection(client);
 		}
@@ -303,25 +422,55 @@ static void client_release_resources(struct http_client_ctx *client)
 	}
 }
 
+static struct http_server_ctx *client_worker(struct http_client_ctx *client)
+{
+	ARRAY_FOR_EACH_PTR(server_ctx, ctx) {
+		if (IS_ARRAY_ELEMENT(ctx->clients, client)) {
+			return ctx;
+		}
+	}
+
+	return NULL;
+}
+
+bool http_server_claim_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				struct http_client_ctx *client)
+{
+	k_spinlock_key_t key = k_spin_lock(&resource_lock);
+	bool claimed = false;
+
+	if (dynamic_detail->holder == NULL || dynamic_detail->holder == client) {
+		dynamic_detail->holder = client;
+		claimed = true;
+	}
+
+	k_spin_unlock(&resource_lock, key);
+
+	return claimed;
+}
+
 void http_server_release_client(struct http_client_ctx *client)
 {
-	int i;
+	struct http_server_ctx *ctx = client_worker(client);
 	struct k_work_sync sync;
+	int i;
 
-	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
+	__ASSERT_NO_MSG(ctx != NULL);
 
 	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
 	client_release_resources(client);
 
-	server_ctx.num_clients--;
+	ctx->num_clients--;
 
-	for (i = server_ctx.listen_fds; i < ARRAY_SIZE(server_ctx.fds); i++) {
-		if (server_ctx.fds[i].fd == client->fd) {
-			server_ctx.fds[i].fd = INVALID_SOCK;
+	for (i = ctx->listen_fds; i < ARRAY_SIZE(ctx->fds); i++) {
+		if (ctx->fds[i].fd == client->fd) {
+			ctx->fds[i].fd = INVALID_SOCK;
 			break;
 		}
 	}
 
+	update_listen_events(ctx);
+
 	memset(client, 0, sizeof(struct http_client_ctx));
 	client->fd = INVALID_SOCK;
 }
@@ -351,7 +500,7 @@ static void client_timeout(struct k_work *work)
 
 void http_client_timer_restart(struct http_client_ctx *client)
 {
-	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
+	__ASSERT_NO_MSG(client_worker(client) != NULL);
 
 	k_work_reschedule(&client->inactivity_timer, INACTIVITY_TIMEOUT);
 }
@@ -376,6 +525,14 @@ static void init_client_ctx(struct http_client_ctx *client, int new_socket)
 	}
 
 	client->current_stream = NULL;
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	http_hpack_table_init(&client->hpack_decoder, HTTP_SERVER_HPACK_TABLE_SIZE);
+	/* The peer assumes the default size of 4096 until told otherwise. */
+	http_hpack_table_init(&client->hpack_encoder, HTTP_SERVER_HPACK_TABLE_SIZE);
+	http_hpack_table_set_max_size(&client->hpack_encoder,
+				      HTTP_SERVER_HPACK_TABLE_SIZE);
+#endif
 }
 
 static int handle_http_preface(struct http_client_ctx *client)
@@ -569,6 +726,7 @@ static int http_server_run(struct http_server_ctx *ctx)
 					ctx->fds[j].revents = 0;
 
 					ctx->num_clients++;
+					update_listen_events(ctx);
 
 					LOG_DBG("Init client #%d", j - ctx->listen_fds);
 
@@ -630,6 +788,11 @@ static int http_server_run(struct http_server_ctx *ctx)
 	return 0;
 
 closing:
+	if (ctx == &server_ctx[0]) {
+		/* The other workers poll the listen sockets too */
+		stop_workers();
+	}
+
 	/* Close all client connections and the server socket */
 	close_all_sockets(ctx);
 	return ret;
@@ -670,10 +833,172 @@ static bool skip_this(struct http_resource_desc *resource, bool is_websocket)
 	return false;
 }
 
+#if defined(CONFIG_HTTP_SERVER_RESOURCE_HASH)
+/*
+ * The resources whose path has no wildcard are indexed by the hash of the
+ * path. The rest are kept in a list and matched one by one. Every resource
+ * has a rank, its position in the services, so that when both a hashed and
+ * a wildcard resource match, the one that comes first wins like it would
+ * with a linear scan.
+ */
+#define RESOURCE_HASH_MAX_ENTRIES CONFIG_HTTP_SERVER_RESOURCE_HASH_MAX_ENTRIES
+#define RESOURCE_HASH_BUCKETS (2 * RESOURCE_HASH_MAX_ENTRIES)
+#define RESOURCE_HASH_NONE UINT16_MAX
+
+struct resource_hash_entry {
+	struct http_resource_desc *resource;
+	uint32_t hash;
+	uint16_t next;  /* next entry in the bucket, in rank order */
+	uint16_t rank;
+};
+
+static struct {
+	struct resource_hash_entry entries[RESOURCE_HASH_MAX_ENTRIES];
+	uint16_t buckets[RESOURCE_HASH_BUCKETS];
+	uint16_t wildcards[RESOURCE_HASH_MAX_ENTRIES];
+	uint16_t nb_entries;
+	uint16_t nb_wildcards;
+	bool valid;
+} resource_hash;
+
+/* Hash a path up to its terminator, "\0" or "?" */
+static uint32_t path_hash(const char *path)
+{
+	return sys_hash32_fnv1a(path, strcspn(path, "?"));
+}
+
+static bool has_wildcard(const char *path)
+{
+	return IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD) &&
+	       strpbrk(path, "*?[") != NULL;
+}
+
+/* The services and their resources are defined at build time, so the
+ * table only needs to be built once.
+ */
+static int resource_hash_init(void)
+{
+	uint16_t count = 0U;
+
+	HTTP_SERVICE_FOREACH(service) {
+		HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
+			if (count == RESOURCE_HASH_MAX_ENTRIES) {
+				LOG_WRN("Too many resources to hash, "
+					"increase CONFIG_HTTP_SERVER_RESOURCE_HASH_MAX_ENTRIES");
+				return 0;
+			}
+
+			resource_hash.entries[count].resource = resource;
+			resource_hash.entries[count].rank = count;
+			count++;
+		}
+	}
+
+	for (int i = 0; i < RESOURCE_HASH_BUCKETS; i++) {
+		resource_hash.buckets[i] = RESOURCE_HASH_NONE;
+	}
+
+	resource_hash.nb_wildcards = 0U;
+
+	/* Walk backwards and prepend so that the buckets are in rank order */
+	for (int i = count - 1; i >= 0; i--) {
+		struct resource_hash_entry *entry = &resource_hash.entries[i];
+		uint16_t *bucket;
+
+		if (has_wildcard(entry->resource->resource)) {
+			continue;
+		}
+
+		entry->hash = path_hash(entry->resource->resource);
+		bucket = &resource_hash.buckets[entry->hash % RESOURCE_HASH_BUCKETS];
+		entry->next = *bucket;
+		*bucket = i;
+	}
+
+	for (int i = 0; i < count; i++) {
+		if (has_wildcard(resource_hash.entries[i].resource->resource)) {
+			resource_hash.wildcards[resource_hash.nb_wildcards++] = i;
+		}
+	}
+
+	resource_hash.nb_entries = count;
+	resource_hash.valid = true;
+
+	LOG_DBG("%u resources hashed, %u with wildcards", count,
+		resource_hash.nb_wildcards);
+
+	return 0;
+}
+
+SYS_INIT(resource_hash_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+static struct http_resource_detail *resource_hash_lookup(const char *path,
+							 int *path_len,
+							 bool is_websocket)
+{
+	struct http_resource_desc *found = NULL;
+	uint16_t rank = RESOURCE_HASH_NONE;
+	uint32_t hash = path_hash(path);
+	uint16_t idx;
+
+	idx = resource_hash.buckets[hash % RESOURCE_HASH_BUCKETS];
+
+	for (; idx != RESOURCE_HASH_NONE; idx = resource_hash.entries[idx].next) {
+		struct resource_hash_entry *entry = &resource_hash.entries[idx];
+
+		if (entry->hash != hash || skip_this(entry->resource, is_websocket) ||
+		    compare_strings(path, entry->resource->resource) != 0) {
+			continue;
+		}
+
+		found = entry->resource;
+		rank = entry->rank;
+		break;
+	}
+
+	for (int i = 0; i < resource_hash.nb_wildcards; i++) {
+		struct resource_hash_entry *entry =
+			&resource_hash.entries[resource_hash.wildcards[i]];
+
+		if (entry->rank > rank) {
+			break;
+		}
+
+		if (skip_this(entry->resource, is_websocket)) {
+			continue;
+		}
+
+		if ((IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD) &&
+		     fnmatch(entry->resource->resource, path, FNM_PATHNAME) == 0) ||
+		    compare_strings(path, entry->resource->resource) == 0) {
+			found = entry->resource;
+			break;
+		}
+	}
+
+	if (found == NULL) {
+		NET_DBG("No match for %s", path);
+		return NULL;
+	}
+
+	NET_DBG("Got match for %s", found->resource);
+
+	*path_len = strlen(found->resource);
+
+	return found->detail;
+}
+#endif /* CONFIG_HTTP_SERVER_RESOURCE_HASH */
+
 struct http_resource_detail *get_resource_detail(const char *path,
 						 int *path_len,
 						 bool is_websocket)
 {
+#if defined(CONFIG_HTTP_SERVER_RESOURCE_HASH)
+	if (resource_hash.valid) {
+		return resource_hash_lookup(path, path_len, is_websocket);
+	}
+#endif
+
 	HTTP_SERVICE_FOREACH(service) {
 		HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
 			if (skip_this(resource, is_websocket)) {
@@ -722,6 +1047,64 @@ int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t
 	return 0;
 }
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_ZEROCOPY)
+static void static_zc_done(struct net_zc_tx *zc)
+{
+	struct static_zc_tx *tx = CONTAINER_OF(zc, struct static_zc_tx, zc);
+
+	/* Static resources are never freed, the descriptor can be reused. */
+	atomic_clear(&tx->busy);
+}
+#endif
+
+int http_server_send_static(struct http_client_ctx *client, const void *buf, size_t len)
+{
+#if defined(CONFIG_HTTP_SERVER_STATIC_ZEROCOPY)
+	struct http_server_ctx *ctx = client_worker(client);
+	struct static_zc_tx *tx;
+
+	__ASSERT_NO_MSG(ctx != NULL);
+
+	tx = &ctx->static_zc[ARRAY_INDEX(ctx->clients, client)];
+
+	while (len) {
+		struct iovec iov = {
+			.iov_base = (void *)buf,
+			.iov_len = len,
+		};
+		struct msghdr msg = {
+			.msg_iov = &iov,
+			.msg_iovlen = 1,
+		};
+		ssize_t out_len;
+
+		if (!atomic_cas(&tx->busy, 0, 1)) {
+			/* The previous send is not complete yet, copy the rest
+			 * rather than waiting for the peer to acknowledge it.
+			 */
+			break;
+		}
+
+		out_len = zsock_sendmsg_zc(client->fd, &msg, 0, &tx->zc, static_zc_done);
+		if (out_len < 0) {
+			if (errno == EOPNOTSUPP) {
+				/* TLS or offloaded socket, copy the rest */
+				break;
+			}
+
+			return -errno;
+		}
+
+		buf = (const char *)buf + out_len;
+		len -= out_len;
+
+		http_client_timer_restart(client);
+	}
+#endif
+
+	return http_server_sendall(client, buf, len);
+}
+
 int http_server_start(void)
 {
 	if (server_running) {
@@ -746,13 +1129,65 @@ int http_server_stop(void)
 
 	server_running = false;
 	k_sem_reset(&server_start);
-	eventfd_write(server_ctx.fds[0].fd, 1);
+	eventfd_write(server_ctx[0].fds[0].fd, 1);
 
 	LOG_DBG("Stopping HTTP server");
 
 	return 0;
 }
 
+#if HTTP_SERVER_NUM_WORKERS > 1
+static void http_server_worker_thread(void *p1, void *p2, void *p3)
+{
+	struct http_server_ctx *ctx = p1;
+	int ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	ret = http_server_run(ctx);
+	if (ret < 0) {
+		/* Have the first worker restart the server */
+		eventfd_write(server_ctx[0].fds[0].fd, 1);
+	}
+}
+
+static void start_workers(void)
+{
+	for (int i = 1; i < HTTP_SERVER_NUM_WORKERS; i++) {
+		if (http_server_worker_init(&server_ctx[i]) < 0) {
+			LOG_ERR("Failed to initialize HTTP server worker %d", i);
+			continue;
+		}
+
+		k_thread_create(&worker_threads[i - 1], worker_stacks[i - 1],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i - 1]),
+				http_server_worker_thread, &server_ctx[i], NULL, NULL,
+				THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&worker_threads[i - 1], "http_server_worker");
+	}
+}
+
+/* Called by the first worker before it closes the listen sockets */
+static void stop_workers(void)
+{
+	for (int i = 1; i < HTTP_SERVER_NUM_WORKERS; i++) {
+		if (server_ctx[i].fds[0].fd < 0) {
+			continue;
+		}
+
+		eventfd_write(server_ctx[i].fds[0].fd, 1);
+		k_thread_join(&worker_threads[i - 1], K_FOREVER);
+
+		zsock_close(server_ctx[i].fds[0].fd);
+		server_ctx[i].fds[0].fd = INVALID_SOCK;
+	}
+}
+#else
+static void start_workers(void) { }
+static void stop_workers(void) { }
+#endif
+
 static void http_server_thread(void *p1, void *p2, void *p3)
 {
 	int ret;
@@ -765,13 +1200,15 @@ static void http_server_thread(void *p1, void *p2, void *p3)
 		k_sem_take(&server_start, K_FOREVER);
 
 		while (server_running) {
-			ret = http_server_init(&server_ctx);
+			ret = http_server_init(&server_ctx[0]);
 			if (ret < 0) {
 				LOG_ERR("Failed to initialize HTTP2 server");
 				goto again;
 			}
 
-			ret = http_server_run(&server_ctx);
+			start_workers();
+
+			ret = http_server_run(&server_ctx[0]);
 			if (!server_running) {
 				continue;
 			}
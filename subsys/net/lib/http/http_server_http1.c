@@ -74,7 +74,7 @@ static int handle_http1_static_resource(
 			return ret;
 		}
 
-		ret = http_server_sendall(client, data, len);
+		ret = http_server_send_static(client, data, len);
 		if (ret < 0) {
 			return ret;
 		}
@@ -273,7 +273,7 @@ static int handle_http1_dynamic_resource(
 		return -ENOPROTOOPT;
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_claim_resource(dynamic_detail, client)) {
 		static const char conflict_response[] =
 				"HTTP/1.1 409 Conflict\r\n\r\n";
 
@@ -287,8 +287,6 @@ static int handle_http1_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_HEAD:
 		if (user_method & BIT(HTTP_HEAD)) {
@@ -113,7 +113,12 @@ static int add_header_field(struct http_client_ctx *client, uint8_t **buf,
 	client->header_field.value = value;
 	client->header_field.value_len = strlen(value);
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	ret = http_hpack_table_encode_header(&client->hpack_encoder, *buf, *buflen,
+					     &client->header_field);
+#else
 	ret = http_hpack_encode_header(*buf, *buflen, &client->header_field);
+#endif
 	if (ret < 0) {
 		return ret;
 	}
@@ -236,7 +241,8 @@ int send_settings_frame(struct http_client_ctx *client, bool ack)
 			(settings_frame + HTTP2_FRAME_HEADER_SIZE);
 		UNALIGNED_PUT(htons(HTTP2_SETTINGS_HEADER_TABLE_SIZE),
 			      &setting->id);
-		UNALIGNED_PUT(0, &setting->value);
+		UNALIGNED_PUT(htonl(HTTP_SERVER_HPACK_TABLE_SIZE),
+			      &setting->value);
 
 		setting++;
 		UNALIGNED_PUT(htons(HTTP2_SETTINGS_MAX_CONCURRENT_STREAMS),
@@ -357,7 +363,10 @@ static int handle_http2_static_resource(
 
 	client->current_stream->headers_sent = true;
 
-	ret = send_data_frame(client, content_200, content_len,
+	/* Only the frame header is sent here, the content is sent without
+	 * being copied if possible.
+	 */
+	ret = send_data_frame(client, NULL, content_len,
 			      frame->stream_identifier,
 			      HTTP2_FLAG_END_STREAM);
 	if (ret < 0) {
@@ -365,6 +374,12 @@ static int handle_http2_static_resource(
 		goto out;
 	}
 
+	ret = http_server_send_static(client, content_200, content_len);
+	if (ret < 0) {
+		LOG_DBG("Cannot write to socket (%d)", ret);
+		goto out;
+	}
+
 	client->current_stream->end_stream_sent = true;
 
 out:
@@ -573,7 +588,7 @@ static int handle_http2_dynamic_resource(
 		return -ENOPROTOOPT;
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_claim_resource(dynamic_detail, client)) {
 		ret = send_http2_409(client, frame);
 		if (ret < 0) {
 			return ret;
@@ -582,8 +597,6 @@ static int handle_http2_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_GET:
 		if (user_method & BIT(HTTP_GET)) {
@@ -1244,7 +1257,13 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 		struct http_hpack_header_buf *header = &client->header_field;
 		size_t datalen = MIN(client->data_len, frame->length);
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+		ret = http_hpack_table_decode_header(&client->hpack_decoder,
+						     client->cursor, datalen,
+						     header);
+#else
 		ret = http_hpack_decode_header(client->cursor, datalen, header);
+#endif
 		if (ret <= 0) {
 			if (ret == -EAGAIN) {
 				ret = handle_incomplete_http_header(client);
@@ -1264,6 +1283,11 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 		client->cursor += ret;
 		client->data_len -= ret;
 
+		if (header->name_len == 0) {
+			/* Dynamic table size update */
+			continue;
+		}
+
 		LOG_DBG("Parsed header: %.*s %.*s", (int)header->name_len,
 			header->name, (int)header->value_len, header->value);
 
@@ -1399,6 +1423,29 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 	}
 
 	bytes_consumed = client->current_frame.length;
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	if (!is_header_flag_set(frame->flags, HTTP2_FLAG_SETTINGS_ACK)) {
+		struct http2_settings_field *setting;
+
+		for (size_t i = 0; i + sizeof(*setting) <= bytes_consumed;
+		     i += sizeof(*setting)) {
+			setting = (struct http2_settings_field *)(client->cursor + i);
+
+			if (ntohs(UNALIGNED_GET(&setting->id)) !=
+			    HTTP2_SETTINGS_HEADER_TABLE_SIZE) {
+				continue;
+			}
+
+			/* Size of the peer decoder table, used by our encoder. */
+			http_hpack_table_set_max_size(
+				&client->hpack_encoder,
+				MIN(ntohl(UNALIGNED_GET(&setting->value)),
+				    HTTP_SERVER_HPACK_TABLE_SIZE));
+		}
+	}
+#endif
+
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
 
@@ -2678,6 +2678,25 @@ static void handle_ongoing_block2_tx(struct lwm2m_message *msg, struct coap_pack
 #endif
 }
 
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_BLOCK2)
+/* Only the SenML CBOR writer encodes the requested block of a response, other
+ * writers always encode the response from its start.
+ */
+static bool is_senml_cbor_request(struct coap_packet *cpkt)
+{
+	struct coap_option option;
+	uint16_t accept;
+
+	if (coap_find_options(cpkt, COAP_OPTION_ACCEPT, &option, 1) > 0) {
+		accept = coap_option_value_to_int(&option);
+	} else if (lwm2m_engine_default_content_format(&accept) < 0) {
+		return false;
+	}
+
+	return accept == LWM2M_FORMAT_APP_SENML_CBOR;
+}
+#endif
+
 void lwm2m_udp_receive(struct lwm2m_ctx *client_ctx, uint8_t *buf, uint16_t buf_len,
 		       struct sockaddr *from_addr)
 {
@@ -2814,7 +2833,18 @@ void lwm2m_udp_receive(struct lwm2m_ctx *client_ctx, uint8_t *buf, uint16_t buf_
 			if (msg) {
 				return handle_ongoing_block2_tx(msg, &response);
 			}
+
+			/* SenML CBOR responses are encoded again for each block,
+			 * blocks of other formats cannot be built without the
+			 * ongoing transfer and the request is ignored.
+			 */
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_BLOCK2)
+			if (!is_senml_cbor_request(&response)) {
+				return;
+			}
+#else
 			return;
+#endif
 		}
 
 		/* Clear out existing Block2 transfers when new requests come */
@@ -3182,7 +3212,9 @@ int lwm2m_perform_composite_read_op(struct lwm2m_message *msg, uint16_t content_
 	}
 
 	/* Add object start mark */
-	engine_put_begin(&msg->out, &msg->path);
+	if (engine_put_begin(&msg->out, &msg->path) < 0) {
+		return -ENOMEM;
+	}
 
 	/* Read resource from path */
 	SYS_SLIST_FOR_EACH_CONTAINER(lwm2m_path_list, entry, node) {
@@ -18,43 +18,96 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <inttypes.h>
 #include <ctype.h>
 #include <time.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/hash_function.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/kernel.h>
 
 #include <zcbor_common.h>
 #include <zcbor_decode.h>
-#include <zcbor_encode.h>
 
 #include "lwm2m_engine.h"
 #include "lwm2m_object.h"
 #include "lwm2m_rw_senml_cbor.h"
 #include "lwm2m_senml_cbor_decode.h"
-#include "lwm2m_senml_cbor_encode.h"
 #include "lwm2m_senml_cbor_types.h"
 #include "lwm2m_util.h"
 
 #define SENML_MAX_NAME_SIZE sizeof("/65535/65535/")
 
-struct cbor_out_fmt_data {
-	/* Data */
-	struct lwm2m_senml input;
+/* SenML CBOR labels, RFC 8428 */
+#define SENML_LABEL_BN -2
+#define SENML_LABEL_BT -3
+#define SENML_LABEL_N 0
+#define SENML_LABEL_V 2
+#define SENML_LABEL_VS 3
+#define SENML_LABEL_VB 4
+#define SENML_LABEL_T 6
+#define SENML_LABEL_VD 8
+
+/* CBOR major types */
+#define CBOR_MAJOR_UINT 0
+#define CBOR_MAJOR_NINT 1
+#define CBOR_MAJOR_BSTR 2
+#define CBOR_MAJOR_TSTR 3
+#define CBOR_MAJOR_ARRAY 4
+#define CBOR_MAJOR_MAP 5
+
+#define CBOR_FALSE 0xf4
+#define CBOR_TRUE 0xf5
+#define CBOR_FLOAT64 0xfb
+
+/* The record count is only known at the end, the array head leaves room for 65535 records */
+#define SENML_ARRAY_HEAD_SIZE 3
+/* Map head, bn, bt, n and t of a record */
+#define SENML_RECORD_HEAD_SIZE (1 + 2 * (2 + SENML_MAX_NAME_SIZE) + 2 * (1 + 9))
+/* Label and value, or label and head of a string value */
+#define SENML_VALUE_HEAD_SIZE (sizeof("vlo") + 9)
 
-	/* Storage for basenames and names ~ sizeof("/65535/65535/") */
+/*
+ * Records are encoded as soon as their value is known, so the memory used
+ * does not depend on the number of records. Only the bytes at
+ * [win_start, win_end) of the payload are written into the packet, the
+ * rest is just counted. This is how a single block of a large payload is
+ * produced.
+ */
+struct cbor_out_fmt_data {
+	/* Record being formed */
 	struct {
-		char names[CONFIG_LWM2M_RW_SENML_CBOR_RECORDS][SENML_MAX_NAME_SIZE];
-		size_t name_sz; /* Name buff size */
-		uint8_t name_cnt;
-	};
+		char bn[SENML_MAX_NAME_SIZE];
+		char n[SENML_MAX_NAME_SIZE];
+		uint8_t bn_len;
+		uint8_t n_len;
+		bool bn_present;
+		bool bt_present;
+		bool n_present;
+		bool t_present;
+		int64_t bt;
+		int64_t t;
+	} rec;
+
+	/* Number of records written */
+	uint16_t count;
+
+	/* Packet offset of the array head */
+	uint16_t start;
 
 	/* Basetime for Cached data timestamp */
 	time_t basetime;
 
-	/* Storage for object links */
-	struct {
-		char objlnk[CONFIG_LWM2M_RW_SENML_CBOR_RECORDS][sizeof("65535:65535")];
-		size_t objlnk_sz; /* Object link buff size */
-		uint8_t objlnk_cnt;
-	};
+	/* Payload position and the part of the payload that goes into the packet */
+	uint32_t pos;
+	uint32_t win_start;
+	uint32_t win_end;
+
+	/* Block-wise response */
+	bool block;
+	bool block_requested;
+	uint8_t block_szx;
+	uint32_t block_num;
+
+	/* FNV-1a of the payload, used as ETag of block-wise responses */
+	uint32_t hash;
 };
 
 struct cbor_in_fmt_data {
@@ -78,15 +131,8 @@ static int path_to_string(char *buf, size_t buf_size, const struct lwm2m_obj_pat
  */
 K_MUTEX_DEFINE(fd_mtx);
 
-#define GET_CBOR_FD_NAME(fd) ((fd)->names[(fd)->name_cnt])
-/* Get the current record */
-#define GET_CBOR_FD_REC(fd) \
-	&((fd)->input.lwm2m_senml_record_m[(fd)->input.lwm2m_senml_record_m_count])
 /* Get a record */
 #define GET_IN_FD_REC_I(fd, i) &((fd)->dcd.lwm2m_senml_record_m[i])
-/* Consume the current record */
-#define CONSUME_CBOR_FD_REC(fd) \
-	&((fd)->input.lwm2m_senml_record_m[(fd)->input.lwm2m_senml_record_m_count++])
 /* Get CBOR output formatter data */
 #define LWM2M_OFD_CBOR(octx) ((struct cbor_out_fmt_data *)engine_get_out_user_data(octx))
 
@@ -98,9 +144,9 @@ static void setup_out_fmt_data(struct lwm2m_message *msg)
 
 	(void)memset(fd, 0, sizeof(*fd));
 	engine_set_out_user_data(&msg->out, fd);
-	fd->name_sz = SENML_MAX_NAME_SIZE;
 	fd->basetime = 0;
-	fd->objlnk_sz = sizeof("65535:65535");
+	fd->win_end = UINT32_MAX;
+	fd->hash = SYS_HASH32_FNV1A_INIT;
 }
 
 static void clear_out_fmt_data(struct lwm2m_message *msg)
@@ -127,87 +173,146 @@ static void clear_in_fmt_data(struct lwm2m_message *msg)
 	k_mutex_unlock(&fd_mtx);
 }
 
-static int fmt_range_check(struct cbor_out_fmt_data *fd)
+/* Write the head of a data item in its shortest form */
+static size_t cbor_head(uint8_t *buf, uint8_t major, uint64_t value)
 {
-	if (fd->name_cnt >= CONFIG_LWM2M_RW_SENML_CBOR_RECORDS ||
-	    fd->objlnk_cnt >= CONFIG_LWM2M_RW_SENML_CBOR_RECORDS ||
-	    fd->input.lwm2m_senml_record_m_count >= CONFIG_LWM2M_RW_SENML_CBOR_RECORDS) {
-		LOG_ERR("CONFIG_LWM2M_RW_SENML_CBOR_RECORDS too small");
-		return -ENOMEM;
+	major <<= 5;
+
+	if (value < 24) {
+		buf[0] = major | value;
+		return 1;
 	}
 
-	return 0;
+	if (value <= UINT8_MAX) {
+		buf[0] = major | 24;
+		buf[1] = value;
+		return 2;
+	}
+
+	if (value <= UINT16_MAX) {
+		buf[0] = major | 25;
+		sys_put_be16(value, &buf[1]);
+		return 3;
+	}
+
+	if (value <= UINT32_MAX) {
+		buf[0] = major | 26;
+		sys_put_be32(value, &buf[1]);
+		return 5;
+	}
+
+	buf[0] = major | 27;
+	sys_put_be64(value, &buf[1]);
+	return 9;
 }
 
-static int put_basename(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
+static size_t cbor_int(uint8_t *buf, int64_t value)
 {
-	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
-	int len;
-	int ret;
-
-	ret = fmt_range_check(fd);
-	if (ret < 0) {
-		return ret;
+	if (value < 0) {
+		return cbor_head(buf, CBOR_MAJOR_NINT, -1 - value);
 	}
 
-	char *basename = GET_CBOR_FD_NAME(fd);
+	return cbor_head(buf, CBOR_MAJOR_UINT, value);
+}
 
-	len = path_to_string(basename, fd->name_sz, path, LWM2M_PATH_LEVEL_OBJECT_INST);
+static size_t cbor_tstr(uint8_t *buf, const char *str, size_t len)
+{
+	size_t head = cbor_head(buf, CBOR_MAJOR_TSTR, len);
 
-	if (len < 0) {
-		return len;
-	}
+	memcpy(&buf[head], str, len);
 
-	/* Tell CBOR encoder where to find the name */
-	struct record *record = GET_CBOR_FD_REC(fd);
+	return head + len;
+}
 
-	record->record_bn.record_bn.value = basename;
-	record->record_bn.record_bn.len = len;
-	record->record_bn_present = 1;
+static int put_bytes(struct lwm2m_output_context *out, const uint8_t *data, size_t len)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	uint32_t from = MAX(fd->pos, fd->win_start);
+	uint32_t to = MIN(fd->pos + len, fd->win_end);
+	int ret;
 
-	if ((len < sizeof("/0/0") - 1) || (len >= SENML_MAX_NAME_SIZE)) {
-		__ASSERT_NO_MSG(false);
-		return -EINVAL;
+	if (from < to) {
+		ret = buf_append(CPKT_BUF_WRITE(out->out_cpkt), data + (from - fd->pos),
+				 to - from);
+		if (ret < 0) {
+			return ret;
+		}
 	}
 
-	fd->name_cnt++;
+	if (fd->block) {
+		fd->hash = sys_hash32_fnv1a_update(fd->hash, data, len);
+	}
+
+	fd->pos += len;
 
 	return 0;
 }
 
-static int put_empty_array(struct lwm2m_output_context *out)
+static int put_begin(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
 {
-	int len = 1;
+	static const uint8_t head[SENML_ARRAY_HEAD_SIZE] = { (CBOR_MAJOR_ARRAY << 5) | 25 };
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
 
-	memset(CPKT_BUF_W_PTR(out->out_cpkt), 0x80, len); /* 80 # array(0) */
-	out->out_cpkt->offset += len;
+	fd->start = out->out_cpkt->offset;
 
-	return len;
+	return put_bytes(out, head, sizeof(head));
 }
 
 static int put_end(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
 {
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	struct coap_packet *cpkt = out->out_cpkt;
+	uint8_t *head = &cpkt->data[fd->start];
 	size_t len;
-	struct lwm2m_senml *input = &(LWM2M_OFD_CBOR(out)->input);
 
-	if (!input->lwm2m_senml_record_m_count) {
-		len = put_empty_array(out);
+	fd->hash = sys_hash32_fnv1a_update(fd->hash, &fd->count, sizeof(fd->count));
 
-		return len;
+	if (fd->win_start > 0) {
+		/* The array head is not part of this block */
+		return 0;
+	}
+
+	if (fd->pos < SENML_ARRAY_HEAD_SIZE) {
+		return -ENOMEM;
+	}
+
+	if (fd->pos > fd->win_end) {
+		/* Only the first block is in the packet, keep the size of the head for
+		 * the offsets of all the blocks to agree
+		 */
+		sys_put_be16(fd->count, &head[1]);
+		return 0;
 	}
 
-	uint_fast8_t ret =
-		cbor_encode_lwm2m_senml(CPKT_BUF_W_REGION(out->out_cpkt), input, &len);
+	/* The whole payload is in the packet, shrink the head to its preferred size */
+	len = cbor_head(head, CBOR_MAJOR_ARRAY, fd->count);
+	memmove(&head[len], &head[SENML_ARRAY_HEAD_SIZE],
+		cpkt->offset - fd->start - SENML_ARRAY_HEAD_SIZE);
+	cpkt->offset -= SENML_ARRAY_HEAD_SIZE - len;
+
+	return 0;
+}
+
+static int put_basename(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	int len;
+
+	len = path_to_string(fd->rec.bn, sizeof(fd->rec.bn), path, LWM2M_PATH_LEVEL_OBJECT_INST);
 
-	if (ret != ZCBOR_SUCCESS) {
-		LOG_ERR("unable to encode senml cbor msg");
+	if (len < 0) {
+		return len;
+	}
 
-		return -E2BIG;
+	if ((len < sizeof("/0/0") - 1) || (len >= SENML_MAX_NAME_SIZE)) {
+		__ASSERT_NO_MSG(false);
+		return -EINVAL;
 	}
 
-	out->out_cpkt->offset += len;
+	fd->rec.bn_len = len;
+	fd->rec.bn_present = true;
 
-	return len;
+	return 0;
 }
 
 static int put_begin_oi(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
@@ -228,71 +333,32 @@ static int put_begin_r(struct lwm2m_output_context *out, struct lwm2m_obj_path *
 {
 	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
 	int len;
-	int ret;
-
-	ret = fmt_range_check(fd);
-	if (ret < 0) {
-		return ret;
-	}
-
-	char *name = GET_CBOR_FD_NAME(fd);
 
 	/* Write resource name */
-	len = snprintk(name, sizeof("65535"), "%" PRIu16 "", path->res_id);
+	len = snprintk(fd->rec.n, sizeof(fd->rec.n), "%" PRIu16 "", path->res_id);
 
 	if (len < sizeof("0") - 1) {
 		__ASSERT_NO_MSG(false);
 		return -EINVAL;
 	}
 
-	/* Check if we could use an already existing name
-	 * -> latest name slot is used as a scratchpad
-	 */
-	for (int idx = 0; idx < fd->name_cnt; idx++) {
-		if (strncmp(name, fd->names[idx], len) == 0) {
-			name = fd->names[idx];
-			break;
-		}
-	}
-
-	/* Tell CBOR encoder where to find the name */
-	struct record *record = GET_CBOR_FD_REC(fd);
-
-	record->record_n.record_n.value = name;
-	record->record_n.record_n.len = len;
-	record->record_n_present = 1;
-
-	/* Makes possible to use same slot for storing r/ri name combination.
-	 * No need to increase the name count if an existing name has been used
-	 */
-	if (path->level < LWM2M_PATH_LEVEL_RESOURCE_INST && name == GET_CBOR_FD_NAME(fd)) {
-		fd->name_cnt++;
-	}
+	fd->rec.n_len = len;
+	fd->rec.n_present = true;
 
 	return 0;
 }
 
 static int put_data_timestamp(struct lwm2m_output_context *out, time_t value)
 {
-	struct record *out_record;
 	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
-	int ret;
-
-	ret = fmt_range_check(fd);
-	if (ret < 0) {
-		return ret;
-	}
-
-	/* Tell CBOR encoder where to find the name */
-	out_record = GET_CBOR_FD_REC(fd);
 
 	if (fd->basetime) {
-		out_record->record_t.record_t = value - fd->basetime;
-		out_record->record_t_present = 1;
+		fd->rec.t = value - fd->basetime;
+		fd->rec.t_present = true;
 	} else {
 		fd->basetime = value;
-		out_record->record_bt.record_bt = value;
-		out_record->record_bt_present = 1;
+		fd->rec.bt = value;
+		fd->rec.bt_present = true;
 	}
 
 	return 0;
@@ -302,17 +368,9 @@ static int put_data_timestamp(struct lwm2m_output_context *out, time_t value)
 static int put_begin_ri(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
 {
 	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
-	char *name = GET_CBOR_FD_NAME(fd);
-	struct record *record = GET_CBOR_FD_REC(fd);
-	int ret;
-
-	ret = fmt_range_check(fd);
-	if (ret < 0) {
-		return ret;
-	}
 
 	/* Forms name from resource id and resource instance id */
-	int len = snprintk(name, SENML_MAX_NAME_SIZE,
+	int len = snprintk(fd->rec.n, sizeof(fd->rec.n),
 			   "%" PRIu16 "/%" PRIu16 "",
 			   path->res_id, path->res_inst_id);
 
@@ -321,25 +379,8 @@ static int put_begin_ri(struct lwm2m_output_context *out, struct lwm2m_obj_path
 		return -EINVAL;
 	}
 
-	/* Check if we could use an already existing name
-	 * -> latest name slot is used as a scratchpad
-	 */
-	for (int idx = 0; idx < fd->name_cnt; idx++) {
-		if (strncmp(name, fd->names[idx], len) == 0) {
-			name = fd->names[idx];
-			break;
-		}
-	}
-
-	/* Tell CBOR encoder where to find the name */
-	record->record_n.record_n.value = name;
-	record->record_n.record_n.len = len;
-	record->record_n_present = 1;
-
-	/* No need to increase the name count if an existing name has been used */
-	if (name == GET_CBOR_FD_NAME(fd)) {
-		fd->name_cnt++;
-	}
+	fd->rec.n_len = len;
+	fd->rec.n_present = true;
 
 	return 0;
 }
@@ -348,12 +389,11 @@ static int put_name_nth_ri(struct lwm2m_output_context *out, struct lwm2m_obj_pa
 {
 	int ret = 0;
 	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
-	struct record *record = GET_CBOR_FD_REC(fd);
 
 	/* With the first ri the resource name (and ri name) are already in place*/
 	if (path->res_inst_id > 0) {
 		ret = put_begin_ri(out, path);
-	} else if (record && record->record_t_present) {
+	} else if (fd->rec.t_present) {
 		/* Name need to be add for each time serialized record */
 		ret = put_begin_r(out, path);
 	}
@@ -361,24 +401,92 @@ static int put_name_nth_ri(struct lwm2m_output_context *out, struct lwm2m_obj_pa
 	return ret;
 }
 
-static int put_value(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, int64_t value)
+/*
+ * Write out the current record. The value is given as its encoded label and
+ * value, followed by the data of string values.
+ */
+static int put_record(struct lwm2m_output_context *out, struct lwm2m_obj_path *path,
+		      const uint8_t *value, size_t value_len, const void *data, size_t data_len)
 {
-	int ret = put_name_nth_ri(out, path);
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	uint8_t head[SENML_RECORD_HEAD_SIZE];
+	size_t len;
+	int pairs;
+	int ret;
+
+	ret = put_name_nth_ri(out, path);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (fd->count == UINT16_MAX) {
+		LOG_ERR("Too many SenML records");
+		return -ENOMEM;
+	}
+
+	pairs = fd->rec.bn_present + fd->rec.bt_present + fd->rec.n_present +
+		fd->rec.t_present + 1;
+	len = cbor_head(head, CBOR_MAJOR_MAP, pairs);
+
+	if (fd->rec.bn_present) {
+		len += cbor_int(&head[len], SENML_LABEL_BN);
+		len += cbor_tstr(&head[len], fd->rec.bn, fd->rec.bn_len);
+	}
+
+	if (fd->rec.bt_present) {
+		len += cbor_int(&head[len], SENML_LABEL_BT);
+		len += cbor_int(&head[len], fd->rec.bt);
+	}
+
+	if (fd->rec.n_present) {
+		len += cbor_int(&head[len], SENML_LABEL_N);
+		len += cbor_tstr(&head[len], fd->rec.n, fd->rec.n_len);
+	}
+
+	if (fd->rec.t_present) {
+		len += cbor_int(&head[len], SENML_LABEL_T);
+		len += cbor_int(&head[len], fd->rec.t);
+	}
+
+	/* The next record starts without any fields */
+	fd->rec.bn_present = false;
+	fd->rec.bt_present = false;
+	fd->rec.n_present = false;
+	fd->rec.t_present = false;
+
+	ret = put_bytes(out, head, len);
+	if (ret < 0) {
+		return ret;
+	}
 
+	ret = put_bytes(out, value, value_len);
 	if (ret < 0) {
 		return ret;
 	}
 
-	struct record *record = CONSUME_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
+	if (data_len > 0) {
+		ret = put_bytes(out, data, data_len);
+		if (ret < 0) {
+			return ret;
+		}
+	}
 
-	/* Write the value */
-	record->record_union.record_union_choice = union_vi_c;
-	record->record_union.union_vi = value;
-	record->record_union_present = 1;
+	fd->count++;
 
 	return 0;
 }
 
+static int put_value(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, int64_t value)
+{
+	uint8_t buf[SENML_VALUE_HEAD_SIZE];
+	size_t len;
+
+	len = cbor_int(buf, SENML_LABEL_V);
+	len += cbor_int(&buf[len], value);
+
+	return put_record(out, path, buf, len, NULL, 0);
+}
+
 static int put_s8(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, int8_t value)
 {
 	return put_value(out, path, value);
@@ -401,136 +509,187 @@ static int put_s64(struct lwm2m_output_context *out, struct lwm2m_obj_path *path
 
 static int put_time(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, time_t value)
 {
-	int ret = put_name_nth_ri(out, path);
+	return put_value(out, path, (int64_t)value);
+}
 
-	if (ret < 0) {
-		return ret;
-	}
+static int put_float(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, double *value)
+{
+	uint8_t buf[SENML_VALUE_HEAD_SIZE];
+	uint64_t bits;
+	size_t len;
 
-	struct record *record = CONSUME_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
+	memcpy(&bits, value, sizeof(bits));
 
-	/* Write the value */
-	record->record_union.record_union_choice = union_vi_c;
-	record->record_union.union_vi = (int64_t)value;
-	record->record_union_present = 1;
+	len = cbor_int(buf, SENML_LABEL_V);
+	buf[len++] = CBOR_FLOAT64;
+	sys_put_be64(bits, &buf[len]);
+	len += sizeof(bits);
 
-	return 0;
+	return put_record(out, path, buf, len, NULL, 0);
 }
 
-static int put_float(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, double *value)
+static int put_string(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
+		      size_t buflen)
 {
-	int ret = put_name_nth_ri(out, path);
+	uint8_t head[SENML_VALUE_HEAD_SIZE];
+	size_t len;
 
-	if (ret < 0) {
-		return ret;
-	}
+	len = cbor_int(head, SENML_LABEL_VS);
+	len += cbor_head(&head[len], CBOR_MAJOR_TSTR, buflen);
 
-	struct record *record = CONSUME_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
+	return put_record(out, path, head, len, buf, buflen);
+}
 
-	/* Write the value */
-	record->record_union.record_union_choice = union_vf_c;
-	record->record_union.union_vf = *value;
-	record->record_union_present = 1;
+static int put_bool(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, bool value)
+{
+	uint8_t buf[SENML_VALUE_HEAD_SIZE];
+	size_t len;
 
-	return 0;
+	len = cbor_int(buf, SENML_LABEL_VB);
+	buf[len++] = value ? CBOR_TRUE : CBOR_FALSE;
+
+	return put_record(out, path, buf, len, NULL, 0);
 }
 
-static int put_string(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
+static int put_opaque(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
 		      size_t buflen)
 {
-	int ret = put_name_nth_ri(out, path);
-
-	if (ret < 0) {
-		return ret;
-	}
-
-	struct record *record = CONSUME_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
+	uint8_t head[SENML_VALUE_HEAD_SIZE];
+	size_t len;
 
-	/* Write the value */
-	record->record_union.record_union_choice = union_vs_c;
-	record->record_union.union_vs.value = buf;
-	record->record_union.union_vs.len = buflen;
-	record->record_union_present = 1;
+	len = cbor_int(head, SENML_LABEL_VD);
+	len += cbor_head(&head[len], CBOR_MAJOR_BSTR, buflen);
 
-	return 0;
+	return put_record(out, path, head, len, buf, buflen);
 }
 
-static int put_bool(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, bool value)
+static int put_objlnk(struct lwm2m_output_context *out, struct lwm2m_obj_path *path,
+		      struct lwm2m_objlnk *value)
 {
-	int ret = put_name_nth_ri(out, path);
+	uint8_t buf[SENML_VALUE_HEAD_SIZE + sizeof("65535:65535")];
+	char objlnk[sizeof("65535:65535")];
+	size_t len;
 
-	if (ret < 0) {
-		return ret;
+	/* Format object link */
+	int objlnk_len =
+		snprintk(objlnk, sizeof(objlnk), "%u:%u", value->obj_id, value->obj_inst);
+	if (objlnk_len < 0) {
+		return -EINVAL;
 	}
 
-	struct record *record = CONSUME_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
-
-	/* Write the value */
-	record->record_union.record_union_choice = union_vb_c;
-	record->record_union.union_vb = value;
-	record->record_union_present = 1;
+	/* Object link values have a text label */
+	len = cbor_tstr(buf, "vlo", sizeof("vlo") - 1);
+	len += cbor_tstr(&buf[len], objlnk, objlnk_len);
 
-	return 0;
+	return put_record(out, path, buf, len, NULL, 0);
 }
 
-static int put_opaque(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
-		      size_t buflen)
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_BLOCK2)
+/*
+ * A response only carries the block asked for with a Block2 option, or the
+ * first block if the whole payload does not fit into a single message. The
+ * payload is encoded again for every block, so nothing has to be kept in
+ * between the requests (RFC 7959, 2.4).
+ */
+static int block2_setup(struct lwm2m_message *msg)
 {
-	int ret = put_name_nth_ri(out, path);
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(&msg->out);
+	struct coap_packet *request = msg->in.in_cpkt;
+	uint16_t size = CONFIG_LWM2M_COAP_BLOCK_SIZE;
+	uint16_t requested;
+	int opt;
+
+	/* Notifications and Send messages are not responses */
+	if (request == NULL || !coap_packet_is_request(request) ||
+	    coap_header_get_code(request) == COAP_CODE_EMPTY) {
+		return 0;
+	}
 
-	if (ret < 0) {
-		return ret;
+	fd->block = true;
+	fd->block_szx = lwm2m_default_block_size();
+
+	opt = coap_get_option_int(request, COAP_OPTION_BLOCK2);
+	if (opt < 0) {
+		fd->win_end = CONFIG_LWM2M_COAP_MAX_MSG_SIZE;
+		return 0;
 	}
 
-	struct record *record = CONSUME_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
+	fd->block_requested = true;
+	fd->block_num = GET_BLOCK_NUM(opt);
+
+	requested = coap_block_size_to_bytes(GET_BLOCK_SIZE(opt));
+	if (requested < size) {
+		fd->block_szx = GET_BLOCK_SIZE(opt);
+		size = requested;
+	} else {
+		/* Answer with a smaller block size, the block number follows */
+		fd->block_num *= requested / size;
+	}
 
-	/* Write the value */
-	record->record_union.record_union_choice = union_vd_c;
-	record->record_union.union_vd.value = buf;
-	record->record_union.union_vd.len = buflen;
-	record->record_union_present = 1;
+	fd->win_start = fd->block_num * size;
+	fd->win_end = fd->win_start + size;
 
 	return 0;
 }
 
-static int put_objlnk(struct lwm2m_output_context *out, struct lwm2m_obj_path *path,
-		      struct lwm2m_objlnk *value)
+static int block2_finish(struct lwm2m_message *msg)
 {
-	int ret = 0;
-	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(&msg->out);
+	struct coap_packet *cpkt = msg->out.out_cpkt;
+	uint16_t size = coap_block_size_to_bytes(fd->block_szx);
+	bool more;
+	int ret;
 
-	ret = fmt_range_check(fd);
-	if (ret < 0) {
-		return ret;
+	if (!fd->block) {
+		return 0;
 	}
 
-	/* Format object link */
-	int objlnk_idx = fd->objlnk_cnt;
-	char *objlink_buf = fd->objlnk[objlnk_idx];
-	int objlnk_len =
-		snprintk(objlink_buf, fd->objlnk_sz, "%u:%u", value->obj_id, value->obj_inst);
-	if (objlnk_len < 0) {
+	if (fd->win_start > 0 && fd->pos <= fd->win_start) {
+		LOG_DBG("Block %u is past the end of the payload", fd->block_num);
 		return -EINVAL;
 	}
 
-	ret = put_name_nth_ri(out, path);
+	if (!fd->block_requested) {
+		if (fd->pos <= fd->win_end) {
+			return 0;
+		}
+
+		/* Cut the payload down to the first block */
+		cpkt->offset = fd->start + size;
+		fd->win_end = size;
+	}
 
+	more = fd->pos > fd->win_end;
+
+	ret = coap_append_option_int(cpkt, COAP_OPTION_BLOCK2,
+				     (fd->block_num << 4) | (more << 3) | fd->block_szx);
 	if (ret < 0) {
 		return ret;
 	}
 
-	struct record *record = CONSUME_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
+	if (!more && fd->block_num == 0) {
+		return 0;
+	}
 
-	/* Write the value */
-	record->record_union.record_union_choice = union_vlo_c;
-	record->record_union.union_vlo.value = objlink_buf;
-	record->record_union.union_vlo.len = objlnk_len;
-	record->record_union_present = 1;
+	ret = coap_append_option_int(cpkt, COAP_OPTION_SIZE2, fd->pos);
+	if (ret < 0) {
+		return ret;
+	}
 
-	fd->objlnk_cnt++;
+	return coap_packet_append_option(cpkt, COAP_OPTION_ETAG, (const uint8_t *)&fd->hash,
+					 sizeof(fd->hash));
+}
+#else
+static int block2_setup(struct lwm2m_message *msg)
+{
+	return 0;
+}
 
+static int block2_finish(struct lwm2m_message *msg)
+{
 	return 0;
 }
+#endif /* CONFIG_LWM2M_RW_SENML_CBOR_BLOCK2 */
 
 static int get_opaque(struct lwm2m_input_context *in,
 			 uint8_t *value, size_t buflen,
@@ -778,6 +937,7 @@ static int do_write_op_item(struct lwm2m_message *msg, struct record *rec)
 }
 
 const struct lwm2m_writer senml_cbor_writer = {
+	.put_begin = put_begin,
 	.put_end = put_end,
 	.put_begin_oi = put_begin_oi,
 	.put_begin_r = put_begin_r,
@@ -812,7 +972,14 @@ int do_read_op_senml_cbor(struct lwm2m_message *msg)
 
 	setup_out_fmt_data(msg);
 
-	ret = lwm2m_perform_read_op(msg, LWM2M_FORMAT_APP_SENML_CBOR);
+	ret = block2_setup(msg);
+	if (ret == 0) {
+		ret = lwm2m_perform_read_op(msg, LWM2M_FORMAT_APP_SENML_CBOR);
+	}
+
+	if (ret >= 0) {
+		ret = block2_finish(msg);
+	}
 
 	clear_out_fmt_data(msg);
 
@@ -911,7 +1078,15 @@ int do_composite_read_op_for_parsed_path_senml_cbor(struct lwm2m_message *msg,
 
 	setup_out_fmt_data(msg);
 
-	ret = lwm2m_perform_composite_read_op(msg, LWM2M_FORMAT_APP_SENML_CBOR, lwm_path_list);
+	ret = block2_setup(msg);
+	if (ret == 0) {
+		ret = lwm2m_perform_composite_read_op(msg, LWM2M_FORMAT_APP_SENML_CBOR,
+						      lwm_path_list);
+	}
+
+	if (ret >= 0) {
+		ret = block2_finish(msg);
+	}
 
 	clear_out_fmt_data(msg);
 
@@ -25,16 +25,149 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+
+	mqtt_inflight_reset(client);
 }
 
-/** @brief Initialize tx buffer. */
+/** @brief Initialize tx buffer.
+ *
+ * The buffer is not cleared, the encoders write every byte they send.
+ */
 static void tx_buf_init(struct mqtt_client *client, struct buf_ctx *buf)
 {
-	memset(client->tx_buf, 0, client->tx_buf_size);
 	buf->cur = client->tx_buf;
 	buf->end = client->tx_buf + client->tx_buf_size;
 }
 
+#if CONFIG_MQTT_PUBLISH_WINDOW > 0
+#define MQTT_INFLIGHT_NONE 0U
+
+static inline uint16_t *inflight_bucket(struct mqtt_inflight *inflight,
+					uint16_t message_id)
+{
+	return &inflight->buckets[message_id % ARRAY_SIZE(inflight->buckets)];
+}
+
+/* Returns the link to the entry of message_id in its bucket chain or to the
+ * end of the chain.
+ */
+static uint16_t *inflight_find(struct mqtt_inflight *inflight,
+			       uint16_t message_id)
+{
+	uint16_t *link = inflight_bucket(inflight, message_id);
+
+	while (*link != MQTT_INFLIGHT_NONE &&
+	       inflight->entries[*link - 1].message_id != message_id) {
+		link = &inflight->entries[*link - 1].next;
+	}
+
+	return link;
+}
+
+void mqtt_inflight_reset(struct mqtt_client *client)
+{
+	struct mqtt_inflight *inflight = &client->internal.inflight;
+
+	memset(inflight->buckets, 0, sizeof(inflight->buckets));
+	inflight->count = 0U;
+	inflight->used = 0U;
+	inflight->free = MQTT_INFLIGHT_NONE;
+}
+
+int mqtt_inflight_check(struct mqtt_client *client,
+			const struct mqtt_publish_param *param)
+{
+	struct mqtt_inflight *inflight = &client->internal.inflight;
+
+	if (param->message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE) {
+		return 0;
+	}
+
+	if (*inflight_find(inflight, param->message_id) != MQTT_INFLIGHT_NONE) {
+		/* Only a retransmission may reuse the id of a message in flight */
+		return param->dup_flag ? 0 : -EEXIST;
+	}
+
+	if (inflight->count >= CONFIG_MQTT_PUBLISH_WINDOW) {
+		return -EAGAIN;
+	}
+
+	return 0;
+}
+
+void mqtt_inflight_add(struct mqtt_client *client,
+		       const struct mqtt_publish_param *param)
+{
+	struct mqtt_inflight *inflight = &client->internal.inflight;
+	struct mqtt_inflight_entry *entry;
+	uint16_t *bucket;
+	uint16_t index;
+
+	if (param->message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE ||
+	    *inflight_find(inflight, param->message_id) != MQTT_INFLIGHT_NONE) {
+		return;
+	}
+
+	if (inflight->free != MQTT_INFLIGHT_NONE) {
+		index = inflight->free - 1;
+		inflight->free = inflight->entries[index].next;
+	} else {
+		index = inflight->used++;
+	}
+
+	bucket = inflight_bucket(inflight, param->message_id);
+
+	entry = &inflight->entries[index];
+	entry->message_id = param->message_id;
+	entry->qos = param->message.topic.qos;
+	entry->received = false;
+	entry->next = *bucket;
+
+	*bucket = index + 1;
+	inflight->count++;
+}
+
+int mqtt_inflight_ack(struct mqtt_client *client, uint8_t type,
+		      uint16_t message_id)
+{
+	struct mqtt_inflight *inflight = &client->internal.inflight;
+	struct mqtt_inflight_entry *entry;
+	uint16_t *link;
+	uint16_t index;
+
+	link = inflight_find(inflight, message_id);
+	if (*link == MQTT_INFLIGHT_NONE) {
+		NET_DBG("[CID %p]: Message id 0x%04x not in flight", client,
+			message_id);
+		return -ENOENT;
+	}
+
+	index = *link - 1;
+	entry = &inflight->entries[index];
+
+	if (type == MQTT_PKT_TYPE_PUBREC) {
+		if (entry->qos != MQTT_QOS_2_EXACTLY_ONCE) {
+			return -ENOENT;
+		}
+
+		entry->received = true;
+		return 0;
+	}
+
+	if ((type == MQTT_PKT_TYPE_PUBACK) !=
+	    (entry->qos == MQTT_QOS_1_AT_LEAST_ONCE)) {
+		return -ENOENT;
+	}
+
+	*link = entry->next;
+	entry->next = inflight->free;
+	inflight->free = index + 1;
+	inflight->count--;
+
+	return 0;
+}
+#endif /* CONFIG_MQTT_PUBLISH_WINDOW > 0 */
+
 void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt)
 {
 	if (client->evt_cb != NULL) {
@@ -261,6 +394,11 @@ int mqtt_publish(struct mqtt_client *client,
 		goto error;
 	}
 
+	err_code = mqtt_inflight_check(client, param);
+	if (err_code < 0) {
+		goto error;
+	}
+
 	err_code = publish_encode(param, &packet);
 	if (err_code < 0) {
 		goto error;
@@ -277,6 +415,9 @@ int mqtt_publish(struct mqtt_client *client,
 	msg.msg_iovlen = ARRAY_SIZE(io_vector);
 
 	err_code = client_write_msg(client, &msg);
+	if (err_code == 0) {
+		mqtt_inflight_add(client, param);
+	}
 
 error:
 	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
@@ -287,6 +428,25 @@ error:
 	return err_code;
 }
 
+int mqtt_publish_inflight_count(struct mqtt_client *client)
+{
+#if CONFIG_MQTT_PUBLISH_WINDOW > 0
+	int count;
+
+	NULL_PARAM_CHECK(client);
+
+	mqtt_mutex_lock(client);
+	count = client->internal.inflight.count;
+	mqtt_mutex_unlock(client);
+
+	return count;
+#else
+	ARG_UNUSED(client);
+
+	return -ENOTSUP;
+#endif
+}
+
 int mqtt_publish_qos1_ack(struct mqtt_client *client,
 			  const struct mqtt_puback_param *param)
 {
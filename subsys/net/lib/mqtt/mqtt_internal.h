@@ -154,6 +154,76 @@ enum mqtt_state {
  */
 void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt);
 
+#if CONFIG_MQTT_PUBLISH_WINDOW > 0
+/**@brief Forget all the publications in flight.
+ *
+ * @param[in] client Client instance.
+ */
+void mqtt_inflight_reset(struct mqtt_client *client);
+
+/**@brief Check that a publication can be put in flight.
+ *
+ * @param[in] client Client instance.
+ * @param[in] param Publication to be sent.
+ *
+ * @return 0 if the publication can be sent, -EAGAIN if the window is full,
+ *         -EEXIST if the message id is in flight and the DUP flag is not set.
+ */
+int mqtt_inflight_check(struct mqtt_client *client,
+			const struct mqtt_publish_param *param);
+
+/**@brief Put a publication in flight, after mqtt_inflight_check() passed.
+ *
+ * @param[in] client Client instance.
+ * @param[in] param Publication being sent.
+ */
+void mqtt_inflight_add(struct mqtt_client *client,
+		       const struct mqtt_publish_param *param);
+
+/**@brief Handle the acknowledgment of a publication in flight.
+ *
+ * @param[in] client Client instance.
+ * @param[in] type Type of the acknowledgment, MQTT_PKT_TYPE_PUBACK,
+ *                 MQTT_PKT_TYPE_PUBREC or MQTT_PKT_TYPE_PUBCOMP.
+ * @param[in] message_id Message id of the acknowledged publication.
+ *
+ * @return 0 if the publication was in flight, -ENOENT otherwise.
+ */
+int mqtt_inflight_ack(struct mqtt_client *client, uint8_t type,
+		      uint16_t message_id);
+#else
+static inline void mqtt_inflight_reset(struct mqtt_client *client)
+{
+	ARG_UNUSED(client);
+}
+
+static inline int mqtt_inflight_check(struct mqtt_client *client,
+				      const struct mqtt_publish_param *param)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(param);
+
+	return 0;
+}
+
+static inline void mqtt_inflight_add(struct mqtt_client *client,
+				     const struct mqtt_publish_param *param)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(param);
+}
+
+static inline int mqtt_inflight_ack(struct mqtt_client *client, uint8_t type,
+				    uint16_t message_id)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(type);
+	ARG_UNUSED(message_id);
+
+	return 0;
+}
+#endif /* CONFIG_MQTT_PUBLISH_WINDOW > 0 */
+
 /**@brief Handles MQTT messages received from the peer.
  *
  * @param[in] client Identifies the client for which the data was received.
@@ -18,7 +18,6 @@ void ipv6_frag_cb(struct net_ipv6_reassembly *reass, void *user_data)
 	const struct shell *sh = data->sh;
 	int *count = data->user_data;
 	char src[ADDR_LEN];
-	int i;
 
 	if (!*count) {
 		PR("\nIPv6 reassembly Id         Remain "
@@ -31,23 +30,23 @@ void ipv6_frag_cb(struct net_ipv6_reassembly *reass, void *user_data)
 	   k_ticks_to_ms_ceil32(k_work_delayable_remaining_get(&reass->timer)),
 	   src, net_sprint_ipv6_addr(&reass->dst));
 
-	for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_PKT; i++) {
-		if (reass->pkt[i]) {
-			struct net_buf *frag = reass->pkt[i]->frags;
+	PR("%d fragments, %u bytes received\n", reass->count, reass->received);
 
-			PR("[%d] pkt %p->", i, reass->pkt[i]);
+	if (reass->pkt) {
+		struct net_buf *frag = reass->pkt->frags;
 
-			while (frag) {
-				PR("%p", frag);
+		PR("First pkt %p->", reass->pkt);
 
-				frag = frag->frags;
-				if (frag) {
-					PR("->");
-				}
-			}
+		while (frag) {
+			PR("%p", frag);
 
-			PR("\n");
+			frag = frag->frags;
+			if (frag) {
+				PR("->");
+			}
 		}
+
+		PR("\n");
 	}
 
 	(*count)++;
@@ -46,20 +46,33 @@ LOG_MODULE_REGISTER(net_sock_addr, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 struct getaddrinfo_state {
 	const struct zsock_addrinfo *hints;
-	struct k_sem sem;
-	int status;
+	struct k_spinlock lock;
 	uint16_t idx;
 	uint16_t port;
-	uint16_t dns_id;
 	struct zsock_addrinfo *ai_arr;
 };
 
+/* One A or AAAA query, the results of all queries are collected in the
+ * shared getaddrinfo_state.
+ */
+struct getaddrinfo_query {
+	struct getaddrinfo_state *state;
+	struct k_sem sem;
+	int status;
+	uint16_t dns_id;
+	enum dns_query_type qtype;
+	bool sent;
+	bool done;
+};
+
 static void dns_resolve_cb(enum dns_resolve_status status,
 			   struct dns_addrinfo *info, void *user_data)
 {
-	struct getaddrinfo_state *state = user_data;
+	struct getaddrinfo_query *query = user_data;
+	struct getaddrinfo_state *state = query->state;
 	struct zsock_addrinfo *ai;
 	int socktype = SOCK_STREAM;
+	k_spinlock_key_t key;
 
 	NET_DBG("dns status: %d", status);
 
@@ -67,12 +80,16 @@ static void dns_resolve_cb(enum dns_resolve_status status,
 		if (status == DNS_EAI_ALLDONE) {
 			status = 0;
 		}
-		state->status = status;
-		k_sem_give(&state->sem);
+		query->status = status;
+		k_sem_give(&query->sem);
 		return;
 	}
 
+	/* The A and AAAA queries can complete concurrently */
+	key = k_spin_lock(&state->lock);
+
 	if (state->idx >= AI_ARR_MAX) {
+		k_spin_unlock(&state->lock, key);
 		NET_DBG("getaddrinfo entries overflow");
 		return;
 	}
@@ -101,6 +118,8 @@ static void dns_resolve_cb(enum dns_resolve_status status,
 	ai->ai_protocol = (socktype == SOCK_DGRAM) ? IPPROTO_UDP : IPPROTO_TCP;
 
 	state->idx++;
+
+	k_spin_unlock(&state->lock, key);
 }
 
 static k_timeout_t recalc_timeout(k_timepoint_t end, k_timeout_t timeout)
@@ -118,65 +137,145 @@ static k_timeout_t recalc_timeout(k_timepoint_t end, k_timeout_t timeout)
 	return timeout;
 }
 
-static int exec_query(const char *host, int family,
-		      struct getaddrinfo_state *ai_state)
+static void query_init(struct getaddrinfo_query *query, int family,
+		       struct getaddrinfo_state *ai_state)
+{
+	query->state = ai_state;
+	query->status = DNS_EAI_ADDRFAMILY;
+	query->dns_id = 0;
+	query->qtype = (family == AF_INET6) ? DNS_QUERY_TYPE_AAAA : DNS_QUERY_TYPE_A;
+	query->done = false;
+	k_sem_init(&query->sem, 0, K_SEM_MAX_LIMIT);
+}
+
+/* Run the queries in parallel, the status of each query is set when it
+ * returns. The queries that time out are retried with backoff.
+ */
+static void exec_queries(const char *host, struct getaddrinfo_query *queries,
+			 int count)
 {
-	enum dns_query_type qtype = DNS_QUERY_TYPE_A;
 	k_timepoint_t end = sys_timepoint_calc(K_MSEC(CONFIG_NET_SOCKETS_DNS_TIMEOUT));
 	k_timeout_t timeout = K_MSEC(MIN(CONFIG_NET_SOCKETS_DNS_TIMEOUT,
 					 CONFIG_NET_SOCKETS_DNS_BACKOFF_INTERVAL));
+	k_timepoint_t wait_end;
+	bool retry, deferred;
 	int timeout_ms;
-	int st, ret;
-
-	if (family == AF_INET6) {
-		qtype = DNS_QUERY_TYPE_AAAA;
-	}
+	int i, ret, sent;
 
 again:
 	timeout_ms = k_ticks_to_ms_ceil32(timeout.ticks);
 
 	NET_DBG("Timeout %d", timeout_ms);
 
-	ret = dns_get_addr_info(host, qtype, &ai_state->dns_id,
-				dns_resolve_cb, ai_state, timeout_ms);
-	if (ret == 0) {
-		/* If the DNS query for reason fails so that the
-		 * dns_resolve_cb() would not be called, then we want the
-		 * semaphore to timeout so that we will not hang forever.
-		 * So make the sem timeout longer than the DNS timeout so that
-		 * we do not need to start to cancel any pending DNS queries.
-		 */
-		ret = k_sem_take(&ai_state->sem, K_MSEC(timeout_ms + 100));
+send:
+	/* If the DNS query for reason fails so that the dns_resolve_cb()
+	 * would not be called, then we want the semaphore to timeout so that
+	 * we will not hang forever. So make the sem timeout longer than the
+	 * DNS timeout so that we do not need to start to cancel any pending
+	 * DNS queries.
+	 */
+	wait_end = sys_timepoint_calc(K_MSEC(timeout_ms + 100));
+	deferred = false;
+	sent = 0;
+
+	for (i = 0; i < count; i++) {
+		struct getaddrinfo_query *query = &queries[i];
+
+		query->sent = false;
+
+		if (query->done) {
+			continue;
+		}
+
+		ret = dns_get_addr_info(host, query->qtype, &query->dns_id,
+					dns_resolve_cb, query, timeout_ms);
+		if (ret == 0) {
+			query->sent = true;
+			sent++;
+		} else if (ret == -EAGAIN && sent > 0) {
+			/* No free query slot, send it once the others are done */
+			deferred = true;
+		} else if (ret == -EPFNOSUPPORT) {
+			/* If we are returned -EPFNOSUPPORT then that will
+			 * indicate wrong address family type queried. Check
+			 * that and return DNS_EAI_ADDRFAMILY.
+			 */
+			query->status = DNS_EAI_ADDRFAMILY;
+			query->done = true;
+		} else if (ret < 0) {
+			errno = -ret;
+			query->status = DNS_EAI_SYSTEM;
+			query->done = true;
+		}
+	}
+
+	retry = false;
+
+	for (i = 0; i < count; i++) {
+		struct getaddrinfo_query *query = &queries[i];
+
+		if (!query->sent) {
+			continue;
+		}
+
+		ret = k_sem_take(&query->sem, sys_timepoint_timeout(wait_end));
 		if (ret == -EAGAIN) {
 			if (!sys_timepoint_expired(end)) {
-				timeout = recalc_timeout(end, timeout);
-				goto again;
+				retry = true;
+				continue;
 			}
 
-			(void)dns_cancel_addr_info(ai_state->dns_id);
-			st = DNS_EAI_AGAIN;
-		} else {
-			if (ai_state->status == DNS_EAI_CANCELED) {
-				if (!sys_timepoint_expired(end)) {
-					timeout = recalc_timeout(end, timeout);
-					goto again;
-				}
-			}
+			(void)dns_cancel_addr_info(query->dns_id);
+			query->status = DNS_EAI_AGAIN;
+		} else if (query->status == DNS_EAI_CANCELED &&
+			   !sys_timepoint_expired(end)) {
+			retry = true;
+			continue;
+		}
+
+		query->done = true;
+	}
+
+	if (deferred && !retry) {
+		goto send;
+	}
+
+	if (retry) {
+		timeout = recalc_timeout(end, timeout);
+		goto again;
+	}
+}
 
-			st = ai_state->status;
+/* Results of parallel queries arrive in any order, keep the IPv4 addresses
+ * first like when the queries are done one after the other.
+ */
+static void sort_results(struct getaddrinfo_state *ai_state)
+{
+	struct zsock_addrinfo tmp;
+	uint16_t first = 0;
+
+	for (uint16_t idx = 0; idx < ai_state->idx; idx++) {
+		if (ai_state->ai_arr[idx].ai_family != AF_INET) {
+			continue;
 		}
-	} else if (ret == -EPFNOSUPPORT) {
-		/* If we are returned -EPFNOSUPPORT then that will indicate
-		 * wrong address family type queried. Check that and return
-		 * DNS_EAI_ADDRFAMILY.
-		 */
-		st = DNS_EAI_ADDRFAMILY;
-	} else {
-		errno = -ret;
-		st = DNS_EAI_SYSTEM;
+
+		if (idx > first) {
+			tmp = ai_state->ai_arr[idx];
+			memmove(&ai_state->ai_arr[first + 1], &ai_state->ai_arr[first],
+				(idx - first) * sizeof(tmp));
+			ai_state->ai_arr[first] = tmp;
+		}
+
+		first++;
 	}
 
-	return st;
+	for (uint16_t idx = 0; idx < ai_state->idx; idx++) {
+		struct zsock_addrinfo *ai = &ai_state->ai_arr[idx];
+
+		ai->ai_addr = &ai->_ai_addr;
+		ai->ai_canonname = ai->_ai_canonname;
+		ai->ai_next = (idx + 1 < ai_state->idx) ? ai + 1 : NULL;
+	}
 }
 
 static int getaddrinfo_null_host(int port, const struct zsock_addrinfo *hints,
@@ -224,7 +323,8 @@ int z_impl_z_zsock_getaddrinfo_internal(const char *host, const char *service,
 	long int port = 0;
 	int st1 = DNS_EAI_ADDRFAMILY, st2 = DNS_EAI_ADDRFAMILY;
 	struct sockaddr *ai_addr;
-	struct getaddrinfo_state ai_state;
+	struct getaddrinfo_state ai_state = { 0 };
+	struct getaddrinfo_query queries[2];
 
 	if (hints) {
 		family = hints->ai_family;
@@ -263,14 +363,38 @@ int z_impl_z_zsock_getaddrinfo_internal(const char *host, const char *service,
 	ai_state.idx = 0U;
 	ai_state.port = htons(port);
 	ai_state.ai_arr = res;
-	ai_state.dns_id = 0;
-	k_sem_init(&ai_state.sem, 0, K_SEM_MAX_LIMIT);
+
+	query_init(&queries[0], AF_INET, &ai_state);
+	query_init(&queries[1], AF_INET6, &ai_state);
+
+	/* If both address families are wanted and the resolver can have more
+	 * than one query in flight, send the A and AAAA queries together.
+	 */
+	if ((family == AF_UNSPEC) && IS_ENABLED(CONFIG_NET_IPV4) &&
+	    IS_ENABLED(CONFIG_NET_IPV6) && (CONFIG_DNS_NUM_CONCUR_QUERIES > 1)) {
+		exec_queries(host, queries, ARRAY_SIZE(queries));
+
+		st1 = queries[0].status;
+		st2 = queries[1].status;
+		if (st1 == DNS_EAI_AGAIN) {
+			return st1;
+		}
+
+		if (st2 == DNS_EAI_AGAIN) {
+			return st2;
+		}
+
+		sort_results(&ai_state);
+
+		goto done;
+	}
 
 	/* If family is AF_UNSPEC, then we query IPv4 address first
 	 * if IPv4 is enabled in the config.
 	 */
 	if ((family != AF_INET6) && IS_ENABLED(CONFIG_NET_IPV4)) {
-		st1 = exec_query(host, AF_INET, &ai_state);
+		exec_queries(host, &queries[0], 1);
+		st1 = queries[0].status;
 		if (st1 == DNS_EAI_AGAIN) {
 			return st1;
 		}
@@ -280,12 +404,14 @@ int z_impl_z_zsock_getaddrinfo_internal(const char *host, const char *service,
 	 * so we can do IPv6 query next if IPv6 is enabled in the config.
 	 */
 	if ((family != AF_INET) && IS_ENABLED(CONFIG_NET_IPV6)) {
-		st2 = exec_query(host, AF_INET6, &ai_state);
+		exec_queries(host, &queries[1], 1);
+		st2 = queries[1].status;
 		if (st2 == DNS_EAI_AGAIN) {
 			return st2;
 		}
 	}
 
+done:
 	for (uint16_t idx = 0; idx < ai_state.idx; idx++) {
 		ai_addr = &ai_state.ai_arr[idx]._ai_addr;
 		net_sin(ai_addr)->sin_port = htons(port);
@@ -275,6 +275,8 @@ int zsock_close_ctx(struct net_context *ctx)
 	ctx->user_data = INT_TO_POINTER(EINTR);
 	sock_set_error(ctx);
 
+	zsock_epoll_ctx_close(ctx);
+
 	zsock_flush_queue(ctx);
 
 	SET_ERRNO(net_context_put(ctx));
@@ -392,6 +394,8 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		net_context_ref(new_ctx);
 
 		(void)k_condvar_signal(&parent->cond.recv);
+
+		zsock_epoll_notify(parent, ZSOCK_EPOLLIN);
 	}
 
 }
@@ -403,6 +407,8 @@ static void zsock_received_cb(struct net_context *ctx,
 			      int status,
 			      void *user_data)
 {
+	uint32_t epoll_events = ZSOCK_EPOLLIN;
+
 	if (ctx->cond.lock) {
 		(void)k_mutex_lock(ctx->cond.lock, K_FOREVER);
 	}
@@ -413,10 +419,13 @@ static void zsock_received_cb(struct net_context *ctx,
 	if (status < 0) {
 		ctx->user_data = INT_TO_POINTER(-status);
 		sock_set_error(ctx);
+		epoll_events |= ZSOCK_EPOLLERR;
 	}
 
 	/* if pkt is NULL, EOF */
 	if (!pkt) {
+		epoll_events |= ZSOCK_EPOLLHUP;
+
 		struct net_pkt *last_pkt = k_fifo_peek_tail(&ctx->recv_q);
 
 		if (!last_pkt) {
@@ -446,6 +455,8 @@ unlock:
 	/* Wake reader if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
 
+	zsock_epoll_notify(ctx, epoll_events);
+
 	if (ctx->cond.lock) {
 		(void)k_mutex_unlock(ctx->cond.lock);
 	}
@@ -463,6 +474,8 @@ int zsock_shutdown_ctx(struct net_context *ctx, int how)
 		sock_set_eof(ctx);
 
 		zsock_flush_queue(ctx);
+
+		zsock_epoll_notify(ctx, ZSOCK_EPOLLIN | ZSOCK_EPOLLHUP);
 	} else if (how == ZSOCK_SHUT_WR || how == ZSOCK_SHUT_RDWR) {
 		SET_ERRNO(-ENOTSUP);
 	} else {
@@ -1086,6 +1099,88 @@ fail:
 #include <zephyr/syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t total = 0;
+	unsigned int count = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (unsigned int i = 0; i < vlen; i++) {
+		ssize_t len;
+
+		len = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = len;
+		total += len;
+		count++;
+	}
+
+	k_mutex_unlock(lock);
+
+	if (count == 0 && vlen > 0) {
+		/* errno was set by the failing sendmsg */
+		return -1;
+	}
+
+	sock_obj_core_update_send_stats(sock, total);
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int count = 0;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	/* Every message header needs to be copied and verified on its own,
+	 * so from user mode the messages are sent one by one.
+	 */
+	for (unsigned int i = 0; i < vlen; i++) {
+		unsigned int msg_len;
+		ssize_t len;
+
+		len = z_vrfy_zsock_sendmsg(sock, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			break;
+		}
+
+		msg_len = len;
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len, &msg_len,
+					  sizeof(msg_len)));
+		count++;
+	}
+
+	if (count == 0 && vlen > 0) {
+		return -1;
+	}
+
+	return count;
+}
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -2122,6 +2217,386 @@ fail:
 #include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t total = 0;
+	unsigned int count = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	/* All messages are received under one socket lock, so a burst of
+	 * queued datagrams is drained without waking up the caller for
+	 * each of them.
+	 */
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (unsigned int i = 0; i < vlen; i++) {
+		int msg_flags = flags & ~ZSOCK_MSG_WAITFORONE;
+		ssize_t len;
+
+		/* Only the first message may block with MSG_WAITFORONE */
+		if (count > 0 && (flags & ZSOCK_MSG_WAITFORONE)) {
+			msg_flags |= ZSOCK_MSG_DONTWAIT;
+		}
+
+		len = vtable->recvmsg(obj, &msgvec[i].msg_hdr, msg_flags);
+		if (len < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = len;
+		total += len;
+		count++;
+	}
+
+	k_mutex_unlock(lock);
+
+	if (count == 0 && vlen > 0) {
+		/* errno was set by the failing recvmsg */
+		return -1;
+	}
+
+	sock_obj_core_update_recv_stats(sock, total);
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int count = 0;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	/* Every message header needs to be copied and verified on its own,
+	 * so from user mode the messages are received one by one.
+	 */
+	for (unsigned int i = 0; i < vlen; i++) {
+		int msg_flags = flags & ~ZSOCK_MSG_WAITFORONE;
+		unsigned int msg_len;
+		ssize_t len;
+
+		if (count > 0 && (flags & ZSOCK_MSG_WAITFORONE)) {
+			msg_flags |= ZSOCK_MSG_DONTWAIT;
+		}
+
+		len = z_vrfy_zsock_recvmsg(sock, &msgvec[i].msg_hdr, msg_flags);
+		if (len < 0) {
+			break;
+		}
+
+		msg_len = len;
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len, &msg_len,
+					  sizeof(msg_len)));
+		count++;
+	}
+
+	if (count == 0 && vlen > 0) {
+		return -1;
+	}
+
+	return count;
+}
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+/* Zero-copy needs direct access to the network buffers of the socket,
+ * which only native sockets have.
+ */
+static struct net_context *zsock_zc_get_ctx(int sock, struct k_mutex **lock)
+{
+	const struct socket_op_vtable *vtable;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return NULL;
+	}
+
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return NULL;
+	}
+
+	return obj;
+}
+
+static ssize_t zsock_sendmsg_zc_ctx(struct net_context *ctx,
+				    const struct msghdr *msg, int flags,
+				    struct net_zc_tx *zc)
+{
+	k_timeout_t timeout = K_FOREVER;
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	k_timepoint_t buf_timeout, end;
+	int status;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+		buf_timeout = sys_timepoint_calc(K_NO_WAIT);
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+		buf_timeout = sys_timepoint_calc(MAX_WAIT_BUFS);
+	}
+	end = sys_timepoint_calc(timeout);
+
+	while (1) {
+		status = net_context_sendmsg_zc(ctx, msg, zc, timeout);
+		if (status < 0) {
+			status = send_check_and_wait(ctx, status,
+						     buf_timeout,
+						     timeout, &retry_timeout);
+			if (status < 0) {
+				return status;
+			}
+
+			/* Update the timeout value in case loop is repeated. */
+			timeout = sys_timepoint_timeout(end);
+
+			continue;
+		}
+
+		break;
+	}
+
+	return status;
+}
+
+ssize_t zsock_sendmsg_zc(int sock, const struct msghdr *msg, int flags,
+			 struct net_zc_tx *zc, void (*done)(struct net_zc_tx *zc))
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t bytes_sent;
+
+	if (msg == NULL || zc == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* The reference of the sender keeps the completion callback from
+	 * running while the data is still being queued.
+	 */
+	net_zc_tx_init(zc, done);
+
+	ctx = zsock_zc_get_ctx(sock, &lock);
+	if (ctx == NULL) {
+		bytes_sent = -1;
+		goto out;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	bytes_sent = zsock_sendmsg_zc_ctx(ctx, msg, flags, zc);
+	k_mutex_unlock(lock);
+
+	sock_obj_core_update_send_stats(sock, bytes_sent);
+
+out:
+	net_zc_tx_unref(zc);
+
+	return bytes_sent;
+}
+
+/* Detach the unread part of the packet as a plain fragment chain. The
+ * fragments that were already consumed (protocol headers, data read with
+ * an earlier call) stay with the packet, and the first lent fragment is
+ * pulled up to the read cursor.
+ */
+static struct net_buf *zsock_pkt_detach_data(struct net_pkt *pkt)
+{
+	struct net_buf *frags = pkt->cursor.buf;
+	struct net_buf *prev;
+
+	if (frags == NULL) {
+		return NULL;
+	}
+
+	if (pkt->buffer == frags) {
+		pkt->buffer = NULL;
+	} else {
+		for (prev = pkt->buffer; prev->frags != frags; prev = prev->frags) {
+		}
+
+		prev->frags = NULL;
+	}
+
+	net_buf_pull(frags, pkt->cursor.pos - frags->data);
+
+	pkt->cursor.buf = NULL;
+	pkt->cursor.pos = NULL;
+
+	return frags;
+}
+
+static ssize_t zsock_recv_zc_ctx(struct net_context *ctx,
+				 struct net_buf **frags, int flags,
+				 struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	ssize_t recv_len;
+	int ret;
+
+	*frags = NULL;
+
+	/* Lent buffers leave the receive queue, so they cannot be peeked */
+	if (flags & ZSOCK_MSG_PEEK) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+			errno = ENOTCONN;
+			return -1;
+		}
+
+		if (sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		}
+
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+	} else if (sock_type != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+
+		if (sock_type == SOCK_STREAM && sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		}
+	}
+
+	pkt = k_fifo_get(&ctx->recv_q, timeout);
+	if (pkt == NULL) {
+		if (sock_type == SOCK_STREAM && sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		errno = EAGAIN;
+		return -1;
+	}
+
+	if (sock_type == SOCK_STREAM && net_pkt_eof(pkt)) {
+		sock_set_eof(ctx);
+	}
+
+	if (sock_type == SOCK_DGRAM && src_addr != NULL && addrlen != NULL) {
+		ret = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
+					    src_addr, *addrlen);
+		if (ret < 0) {
+			NET_DBG("sock_get_pkt_src_addr %d", ret);
+			net_pkt_unref(pkt);
+			errno = -ret;
+			return -1;
+		}
+
+		if (src_addr->sa_family == AF_INET) {
+			*addrlen = sizeof(struct sockaddr_in);
+		} else {
+			*addrlen = sizeof(struct sockaddr_in6);
+		}
+	}
+
+	recv_len = net_pkt_remaining_data(pkt);
+	*frags = zsock_pkt_detach_data(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	net_pkt_unref(pkt);
+
+	return recv_len;
+}
+
+ssize_t zsock_recv_zc(int sock, struct net_buf **frags, int flags,
+		      struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t bytes_received;
+
+	if (frags == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = zsock_zc_get_ctx(sock, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	bytes_received = zsock_recv_zc_ctx(ctx, frags, flags, src_addr, addrlen);
+	k_mutex_unlock(lock);
+
+	sock_obj_core_update_recv_stats(sock, bytes_received);
+
+	return bytes_received;
+}
+
+int zsock_recv_zc_release(int sock, struct net_buf *frags)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	size_t len;
+
+	if (frags == NULL) {
+		return 0;
+	}
+
+	len = net_buf_frags_len(frags);
+	net_buf_unref(frags);
+
+	ctx = zsock_zc_get_ctx(sock, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	/* For stream sockets the receive window is only opened once the
+	 * application has given the data back.
+	 */
+	if (net_context_get_type(ctx) == SOCK_STREAM) {
+		(void)k_mutex_lock(lock, K_FOREVER);
+		net_context_update_recv_wnd(ctx, len);
+		k_mutex_unlock(lock);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_CONTEXT_ZEROCOPY */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -0,0 +1,702 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/slist.h>
+
+#include "sockets_internal.h"
+#include "../../ip/tcp_internal.h"
+
+/* Readiness events that are reported even if not requested */
+#define EPOLL_ALWAYS_EVENTS (ZSOCK_EPOLLERR | ZSOCK_EPOLLHUP)
+
+#define EPOLL_EVENT_MASK (ZSOCK_EPOLLIN | ZSOCK_EPOLLOUT | \
+			  EPOLL_ALWAYS_EVENTS)
+
+/* How often writability of TCP sockets is re-checked if there are more of
+ * them waiting for EPOLLOUT than can be waited on with one k_poll().
+ */
+#define EPOLL_OUT_RECHECK K_MSEC(10)
+
+struct zsock_epoll;
+
+struct zsock_epoll_item {
+	/** Node in the ready list of the epoll instance */
+	sys_dnode_t ready_node;
+	/** Node in the list of TCP sockets waiting for EPOLLOUT */
+	sys_dnode_t out_node;
+	/** Node in the interest list of the epoll instance */
+	sys_dnode_t ep_node;
+	/** Node in the epoll list of the socket, or in the free list */
+	sys_snode_t ctx_node;
+
+	struct zsock_epoll *ep;
+	struct net_context *ctx;
+	zsock_epoll_data_t data;
+
+	/** Requested events and flags */
+	uint32_t events;
+	/** Events raised since the item was last reported */
+	uint32_t pending;
+	/** Last seen TCP writability, used for edge triggering */
+	bool out_ready;
+};
+
+struct zsock_epoll {
+	sys_dlist_t items;
+	sys_dlist_t ready;
+	sys_dlist_t out_items;
+	struct k_poll_signal signal;
+	bool in_use;
+};
+
+extern const struct socket_op_vtable sock_fd_op_vtable;
+static const struct fd_op_vtable epoll_fd_op_vtable;
+
+static struct zsock_epoll epoll_instances[CONFIG_NET_SOCKETS_EPOLL_MAX];
+static struct zsock_epoll_item epoll_items[CONFIG_NET_SOCKETS_EPOLL_ITEMS];
+static sys_slist_t epoll_free_items;
+static bool epoll_items_init;
+
+/* Protects all the epoll instances and interest lists. The socket
+ * callbacks only append to a ready list, so the lock is held shortly.
+ */
+static struct k_spinlock epoll_lock;
+
+static bool epoll_is_tcp(struct net_context *ctx)
+{
+	return IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
+	       net_context_get_type(ctx) == SOCK_STREAM &&
+	       !net_if_is_ip_offloaded(net_context_get_iface(ctx));
+}
+
+static bool epoll_tcp_out_ready(struct net_context *ctx)
+{
+	return net_context_get_state(ctx) == NET_CONTEXT_CONNECTED &&
+	       !sock_is_eof(ctx) &&
+	       k_sem_count_get(net_tcp_tx_sem_get(ctx)) > 0;
+}
+
+static uint32_t epoll_item_poll(struct zsock_epoll_item *item)
+{
+	struct net_context *ctx = item->ctx;
+	uint32_t events = 0;
+
+	if (!k_fifo_is_empty(&ctx->recv_q) || sock_is_eof(ctx)) {
+		events |= ZSOCK_EPOLLIN;
+	}
+
+	if (!epoll_is_tcp(ctx) || epoll_tcp_out_ready(ctx)) {
+		events |= ZSOCK_EPOLLOUT;
+	}
+
+	if (sock_is_error(ctx)) {
+		events |= ZSOCK_EPOLLERR;
+	}
+
+	if (sock_is_eof(ctx)) {
+		events |= ZSOCK_EPOLLHUP;
+	}
+
+	return events & (item->events | EPOLL_ALWAYS_EVENTS);
+}
+
+static void epoll_item_set_ready(struct zsock_epoll_item *item,
+				 uint32_t events)
+{
+	item->pending |= events;
+
+	if (!sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_append(&item->ep->ready, &item->ready_node);
+		k_poll_signal_raise(&item->ep->signal, 0);
+	}
+}
+
+static void epoll_item_free(struct zsock_epoll_item *item)
+{
+	if (sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_remove(&item->ready_node);
+	}
+
+	if (sys_dnode_is_linked(&item->out_node)) {
+		sys_dlist_remove(&item->out_node);
+	}
+
+	sys_dlist_remove(&item->ep_node);
+	(void)sys_slist_find_and_remove(&item->ctx->epoll_items,
+					&item->ctx_node);
+
+	item->ep = NULL;
+	item->ctx = NULL;
+	sys_slist_prepend(&epoll_free_items, &item->ctx_node);
+}
+
+/* Called by the socket layer with the socket lock held */
+void zsock_epoll_notify(struct net_context *ctx, uint32_t events)
+{
+	struct zsock_epoll_item *item;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&epoll_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->epoll_items, item, ctx_node) {
+		uint32_t ready = events & (item->events | EPOLL_ALWAYS_EVENTS);
+
+		if (ready != 0 && (item->events & EPOLL_EVENT_MASK) != 0) {
+			epoll_item_set_ready(item, ready);
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+}
+
+void zsock_epoll_ctx_close(struct net_context *ctx)
+{
+	struct zsock_epoll_item *item, *next;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&epoll_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&ctx->epoll_items, item, next,
+					  ctx_node) {
+		epoll_item_free(item);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+}
+
+int z_impl_zsock_epoll_create(int size)
+{
+	struct zsock_epoll *ep = NULL;
+	k_spinlock_key_t key;
+	int fd;
+
+	if (size <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	key = k_spin_lock(&epoll_lock);
+
+	if (!epoll_items_init) {
+		for (int i = 0; i < ARRAY_SIZE(epoll_items); i++) {
+			sys_slist_prepend(&epoll_free_items,
+					  &epoll_items[i].ctx_node);
+		}
+
+		epoll_items_init = true;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(epoll_instances); i++) {
+		if (!epoll_instances[i].in_use) {
+			ep = &epoll_instances[i];
+			ep->in_use = true;
+			break;
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	if (ep == NULL) {
+		zvfs_free_fd(fd);
+		errno = ENFILE;
+		return -1;
+	}
+
+	sys_dlist_init(&ep->items);
+	sys_dlist_init(&ep->ready);
+	sys_dlist_init(&ep->out_items);
+	k_poll_signal_init(&ep->signal);
+
+	zvfs_finalize_fd(fd, ep, &epoll_fd_op_vtable);
+
+	return fd;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_create(int size)
+{
+	return z_impl_zsock_epoll_create(size);
+}
+#include <zephyr/syscalls/zsock_epoll_create_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static struct zsock_epoll_item *epoll_item_find(struct zsock_epoll *ep,
+						struct net_context *ctx)
+{
+	struct zsock_epoll_item *item;
+
+	/* A socket is rarely watched by more than one epoll instance, so
+	 * this is effectively a constant time lookup.
+	 */
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->epoll_items, item, ctx_node) {
+		if (item->ep == ep) {
+			return item;
+		}
+	}
+
+	return NULL;
+}
+
+static void epoll_item_arm(struct zsock_epoll_item *item,
+			   const struct zsock_epoll_event *event)
+{
+	uint32_t ready;
+
+	item->events = event->events;
+	item->data = event->data;
+	item->pending = 0U;
+	item->out_ready = false;
+
+	if (sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_remove(&item->ready_node);
+	}
+
+	if (sys_dnode_is_linked(&item->out_node)) {
+		sys_dlist_remove(&item->out_node);
+	}
+
+	/* TCP writability is not signalled by a callback, so these sockets
+	 * are checked, and waited on, separately by zsock_epoll_wait().
+	 */
+	if ((item->events & ZSOCK_EPOLLOUT) && epoll_is_tcp(item->ctx)) {
+		sys_dlist_append(&item->ep->out_items, &item->out_node);
+	}
+
+	/* Report the current state, so that no event is lost between the
+	 * socket creation and adding it to the interest list.
+	 */
+	ready = epoll_item_poll(item);
+	if (ready != 0) {
+		item->out_ready = (ready & ZSOCK_EPOLLOUT) != 0;
+		epoll_item_set_ready(item, ready);
+	}
+}
+
+int z_impl_zsock_epoll_ctl(int epfd, int op, int fd,
+			   struct zsock_epoll_event *event)
+{
+	const struct fd_op_vtable *vtable;
+	struct zsock_epoll_item *item;
+	struct net_context *ctx;
+	struct zsock_epoll *ep;
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	ep = zvfs_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	ctx = zvfs_get_fd_obj_and_vtable(fd, &vtable, NULL);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	/* Only native sockets feed the ready list */
+	if (vtable != (const struct fd_op_vtable *)&sock_fd_op_vtable) {
+		errno = EPERM;
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL && event == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	key = k_spin_lock(&epoll_lock);
+
+	item = epoll_item_find(ep, ctx);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		if (item != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		item = SYS_SLIST_PEEK_HEAD_CONTAINER(&epoll_free_items, item,
+						     ctx_node);
+		if (item == NULL) {
+			ret = -ENOSPC;
+			break;
+		}
+
+		(void)sys_slist_get_not_empty(&epoll_free_items);
+
+		sys_dnode_init(&item->ready_node);
+		sys_dnode_init(&item->out_node);
+		item->ep = ep;
+		item->ctx = ctx;
+		sys_dlist_append(&ep->items, &item->ep_node);
+		sys_slist_append(&ctx->epoll_items, &item->ctx_node);
+
+		epoll_item_arm(item, event);
+		break;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_item_arm(item, event);
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_item_free(item);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_ctl(int epfd, int op, int fd,
+					 struct zsock_epoll_event *event)
+{
+	struct zsock_epoll_event event_copy;
+
+	/* Checks the caller has access to the socket object */
+	if (z_impl_zsock_get_context_object(fd) == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (op == ZSOCK_EPOLL_CTL_DEL || event == NULL) {
+		return z_impl_zsock_epoll_ctl(epfd, op, fd, event);
+	}
+
+	K_OOPS(k_usermode_from_copy(&event_copy, event, sizeof(event_copy)));
+
+	return z_impl_zsock_epoll_ctl(epfd, op, fd, &event_copy);
+}
+#include <zephyr/syscalls/zsock_epoll_ctl_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+/* Move TCP sockets which became writable to the ready list */
+static void epoll_check_out_items(struct zsock_epoll *ep)
+{
+	struct zsock_epoll_item *item;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&ep->out_items, item, out_node) {
+		bool ready = epoll_tcp_out_ready(item->ctx);
+
+		if (ready && (!(item->events & ZSOCK_EPOLLET) ||
+			      !item->out_ready)) {
+			epoll_item_set_ready(item, ZSOCK_EPOLLOUT);
+		}
+
+		item->out_ready = ready;
+	}
+}
+
+static int epoll_collect(struct zsock_epoll *ep,
+			 struct zsock_epoll_event *events, int maxevents)
+{
+	struct zsock_epoll_item *item;
+	sys_dlist_t still_ready;
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+	int count = 0;
+
+	sys_dlist_init(&still_ready);
+
+	key = k_spin_lock(&epoll_lock);
+
+	k_poll_signal_reset(&ep->signal);
+
+	epoll_check_out_items(ep);
+
+	while (count < maxevents &&
+	       (node = sys_dlist_get(&ep->ready)) != NULL) {
+		uint32_t ready;
+
+		item = CONTAINER_OF(node, struct zsock_epoll_item, ready_node);
+
+		if (item->events & ZSOCK_EPOLLET) {
+			ready = item->pending;
+		} else {
+			/* Level triggered items are reported as long as the
+			 * condition holds, so query the socket state.
+			 */
+			ready = epoll_item_poll(item);
+		}
+
+		item->pending = 0U;
+
+		if (ready == 0) {
+			continue;
+		}
+
+		events[count].events = ready;
+		events[count].data = item->data;
+		count++;
+
+		if (item->events & ZSOCK_EPOLLONESHOT) {
+			/* Disabled until re-armed with ZSOCK_EPOLL_CTL_MOD */
+			item->events &= ~EPOLL_EVENT_MASK;
+			if (sys_dnode_is_linked(&item->out_node)) {
+				sys_dlist_remove(&item->out_node);
+			}
+		} else if (!(item->events & ZSOCK_EPOLLET)) {
+			sys_dlist_append(&still_ready, node);
+		}
+	}
+
+	/* Level triggered items are queued behind the rest, so that a busy
+	 * socket cannot starve the others.
+	 */
+	while ((node = sys_dlist_get(&still_ready)) != NULL) {
+		sys_dlist_append(&ep->ready, node);
+	}
+
+	if (!sys_dlist_is_empty(&ep->ready)) {
+		k_poll_signal_raise(&ep->signal, 0);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	return count;
+}
+
+int z_impl_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			    int maxevents, int timeout)
+{
+	struct k_poll_event poll_events[1 + CONFIG_NET_SOCKETS_POLL_MAX];
+	struct zsock_epoll_item *item;
+	struct zsock_epoll *ep;
+	k_timeout_t wait;
+	k_timepoint_t end;
+	int count;
+	int ret;
+
+	ep = zvfs_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	while (true) {
+		k_spinlock_key_t key;
+		int n = 1;
+
+		count = epoll_collect(ep, events, maxevents);
+		if (count > 0) {
+			return count;
+		}
+
+		wait = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(wait, K_NO_WAIT)) {
+			return 0;
+		}
+
+		k_poll_event_init(&poll_events[0], K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &ep->signal);
+
+		key = k_spin_lock(&epoll_lock);
+
+		SYS_DLIST_FOR_EACH_CONTAINER(&ep->out_items, item, out_node) {
+			struct net_context *ctx = item->ctx;
+			struct k_sem *sem;
+
+			if (n == ARRAY_SIZE(poll_events)) {
+				/* Too many to wait on, fall back to polling */
+				if (K_TIMEOUT_EQ(wait, K_FOREVER) ||
+				    k_timeout_ticks(wait) >
+				    k_timeout_ticks(EPOLL_OUT_RECHECK)) {
+					wait = EPOLL_OUT_RECHECK;
+				}
+				break;
+			}
+
+			if (net_context_get_state(ctx) == NET_CONTEXT_CONNECTING) {
+				sem = net_tcp_conn_sem_get(ctx);
+			} else {
+				sem = net_tcp_tx_sem_get(ctx);
+			}
+
+			k_poll_event_init(&poll_events[n++],
+					  K_POLL_TYPE_SEM_AVAILABLE,
+					  K_POLL_MODE_NOTIFY_ONLY, sem);
+		}
+
+		k_spin_unlock(&epoll_lock, key);
+
+		ret = k_poll(poll_events, n, wait);
+		if (ret != 0 && ret != -EAGAIN && ret != -EINTR) {
+			errno = -ret;
+			return -1;
+		}
+	}
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_wait(int epfd,
+					  struct zsock_epoll_event *events,
+					  int maxevents, int timeout)
+{
+	struct zsock_epoll_event *events_copy;
+	size_t events_size;
+	int ret;
+
+	if (maxevents <= 0 ||
+	    size_mul_overflow(maxevents, sizeof(*events), &events_size)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(events, events_size));
+
+	events_copy = k_usermode_alloc_from_copy(events, events_size);
+	if (events_copy == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	ret = z_impl_zsock_epoll_wait(epfd, events_copy, maxevents, timeout);
+	if (ret > 0) {
+		K_OOPS(k_usermode_to_copy(events, events_copy,
+					  ret * sizeof(*events)));
+	}
+
+	k_free(events_copy);
+
+	return ret;
+}
+#include <zephyr/syscalls/zsock_epoll_wait_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static int epoll_close_vmeth(void *obj)
+{
+	struct zsock_epoll *ep = obj;
+	struct zsock_epoll_item *item;
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+
+	key = k_spin_lock(&epoll_lock);
+
+	while ((node = sys_dlist_peek_head(&ep->items)) != NULL) {
+		item = CONTAINER_OF(node, struct zsock_epoll_item, ep_node);
+		epoll_item_free(item);
+	}
+
+	ep->in_use = false;
+
+	k_spin_unlock(&epoll_lock, key);
+
+	return 0;
+}
+
+static int epoll_ioctl_vmeth(void *obj, unsigned int request, va_list args)
+{
+	struct zsock_epoll *ep = obj;
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	/* An epoll instance can itself be polled for readiness */
+	switch (request) {
+	case ZFD_IOCTL_POLL_PREPARE: {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+		struct k_poll_event *pev_end;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+		pev_end = va_arg(args, struct k_poll_event *);
+
+		if (!(pfd->events & ZSOCK_POLLIN)) {
+			return 0;
+		}
+
+		if (*pev == pev_end) {
+			return -ENOMEM;
+		}
+
+		key = k_spin_lock(&epoll_lock);
+
+		if (sys_dlist_is_empty(&ep->ready)) {
+			k_poll_signal_reset(&ep->signal);
+		} else {
+			ret = -EALREADY;
+		}
+
+		k_spin_unlock(&epoll_lock, key);
+
+		k_poll_event_init(*pev, K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &ep->signal);
+		(*pev)++;
+
+		return ret;
+	}
+
+	case ZFD_IOCTL_POLL_UPDATE: {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+
+		if (!(pfd->events & ZSOCK_POLLIN)) {
+			return 0;
+		}
+
+		key = k_spin_lock(&epoll_lock);
+
+		if (!sys_dlist_is_empty(&ep->ready)) {
+			pfd->revents |= ZSOCK_POLLIN;
+		}
+
+		k_spin_unlock(&epoll_lock, key);
+
+		(*pev)++;
+
+		return 0;
+	}
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static const struct fd_op_vtable epoll_fd_op_vtable = {
+	.close = epoll_close_vmeth,
+	.ioctl = epoll_ioctl_vmeth,
+};
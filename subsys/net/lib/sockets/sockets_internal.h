@@ -47,6 +47,22 @@ static inline bool net_socket_is_tls(void *obj)
 }
 #endif
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+void zsock_epoll_notify(struct net_context *ctx, uint32_t events);
+void zsock_epoll_ctx_close(struct net_context *ctx);
+#else
+static inline void zsock_epoll_notify(struct net_context *ctx, uint32_t events)
+{
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(events);
+}
+
+static inline void zsock_epoll_ctx_close(struct net_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+#endif
+
 #define sock_is_eof(ctx) sock_get_flag(ctx, SOCK_EOF)
 #define sock_set_eof(ctx) sock_set_flag(ctx, SOCK_EOF, SOCK_EOF)
 #define sock_is_nonblock(ctx) sock_get_flag(ctx, SOCK_NONBLOCK)
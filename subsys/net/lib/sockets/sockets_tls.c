@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/random/random.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/hash_function.h>
 
 /* TODO: Remove all direct access to private fields.
  * According with Mbed TLS migration guide:
@@ -47,8 +48,15 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/error.h>
 #include <mbedtls/platform.h>
 #include <mbedtls/ssl_cache.h>
+#include <mbedtls/ssl_ticket.h>
 #endif /* CONFIG_MBEDTLS */
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SETTINGS)
+#include <stdlib.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/settings/settings.h>
+#endif
+
 #include "sockets_internal.h"
 #include "tls_internal.h"
 
@@ -101,12 +109,24 @@ struct dtls_timing_context {
 
 /** TLS peer address/session ID mapping. */
 struct tls_session_cache {
+	/** LRU list node, the most recently used entry is at the head. */
+	sys_dnode_t node;
+
 	/** Creation time. */
 	int64_t timestamp;
 
 	/** Peer address. */
 	struct sockaddr peer_addr;
 
+	/** Hash of the server name (SNI) of the session, 0 if not set. */
+	uint32_t hostname_hash;
+
+	/** Hash of the peer address and server name. */
+	uint32_t hash;
+
+	/** Index + 1 of the next entry in the hash bucket, 0 if none. */
+	uint16_t next;
+
 	/** Session buffer. */
 	uint8_t *session;
 
@@ -114,6 +134,11 @@ struct tls_session_cache {
 	size_t session_len;
 };
 
+#define TLS_SESSION_CACHE_BUCKETS \
+	(2 * CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_SESSION_COUNT)
+#define TLS_SESSION_LIFETIME_MS \
+	(CONFIG_NET_SOCKETS_TLS_SESSION_LIFETIME * MSEC_PER_SEC)
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 struct tls_dtls_cid {
 	bool enabled;
@@ -143,6 +168,9 @@ __net_socket struct tls_context {
 	/** Session ended at the TLS/DTLS level. */
 	bool session_closed : 1;
 
+	/** The current handshake is a full one, not a session resumption. */
+	bool full_handshake : 1;
+
 	/** Socket type. */
 	enum net_sock_type type;
 
@@ -173,6 +201,9 @@ __net_socket struct tls_context {
 		/** Information if hostname was explicitly set on a socket. */
 		bool is_hostname_set;
 
+		/** Hash of the hostname, used as a session cache key. */
+		uint32_t hostname_hash;
+
 		/** Peer verification level. */
 		int8_t verify_level;
 
@@ -250,10 +281,27 @@ static struct tls_context tls_contexts[CONFIG_NET_SOCKETS_TLS_MAX_CONTEXTS];
 
 static struct tls_session_cache client_cache[CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_SESSION_COUNT];
 
+/* Client session cache index, hash buckets and LRU order. Free entries
+ * are kept at the tail of the LRU list so that they are used first.
+ */
+static uint16_t client_cache_buckets[TLS_SESSION_CACHE_BUCKETS];
+static sys_dlist_t client_cache_lru;
+
+/* Handshake and session cache statistics. */
+static struct tls_session_stats session_stats;
+
+/* A mutex for protecting the client session cache and statistics. */
+static struct k_mutex session_lock;
+
 #if defined(MBEDTLS_SSL_CACHE_C)
 static mbedtls_ssl_cache_context server_cache;
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+static mbedtls_ssl_ticket_context server_ticket;
+static bool server_ticket_ready;
+#endif
+
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
@@ -271,6 +319,13 @@ static void tls_session_cache_reset(void)
 	}
 
 	(void)memset(client_cache, 0, sizeof(client_cache));
+	(void)memset(client_cache_buckets, 0, sizeof(client_cache_buckets));
+
+	sys_dlist_init(&client_cache_lru);
+
+	for (int i = 0; i < ARRAY_SIZE(client_cache); i++) {
+		sys_dlist_append(&client_cache_lru, &client_cache[i].node);
+	}
 }
 
 bool net_socket_is_tls(void *obj)
@@ -365,14 +420,19 @@ static int tls_init(void)
 #endif
 
 	(void)memset(tls_contexts, 0, sizeof(tls_contexts));
-	(void)memset(client_cache, 0, sizeof(client_cache));
+	tls_session_cache_reset();
 
 	k_mutex_init(&context_lock);
+	k_mutex_init(&session_lock);
 
 #if defined(MBEDTLS_SSL_CACHE_C)
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_init(&server_ticket);
+#endif
+
 	return 0;
 }
 
@@ -571,95 +631,324 @@ static bool peer_addr_cmp(const struct sockaddr *addr,
 	return false;
 }
 
-static int tls_session_save(const struct sockaddr *peer_addr,
-			    mbedtls_ssl_session *session)
+static uint32_t tls_session_hash(const struct sockaddr *peer_addr,
+				 uint32_t hostname_hash)
 {
-	struct tls_session_cache *entry = NULL;
-	size_t session_len;
-	int ret;
+	uint32_t hash = sys_hash32_fnv1a(&hostname_hash, sizeof(hostname_hash));
 
-	for (int i = 0; i < ARRAY_SIZE(client_cache); i++) {
-		if (client_cache[i].session == NULL) {
-			/* New entry. */
-			if (entry == NULL || entry->session != NULL) {
-				entry = &client_cache[i];
-			}
-		} else {
-			if (peer_addr_cmp(&client_cache[i].peer_addr, peer_addr)) {
-				/* Reuse old entry for given address. */
-				entry = &client_cache[i];
-				break;
-			}
+	if (IS_ENABLED(CONFIG_NET_IPV6) && peer_addr->sa_family == AF_INET6) {
+		const struct sockaddr_in6 *addr = net_sin6(peer_addr);
 
-			/* Remember the oldest entry and reuse if needed. */
-			if (entry == NULL ||
-			    (entry->session != NULL &&
-			     entry->timestamp < client_cache[i].timestamp)) {
-				entry = &client_cache[i];
-			}
+		hash = sys_hash32_fnv1a_update(hash, &addr->sin6_port, sizeof(addr->sin6_port));
+		hash = sys_hash32_fnv1a_update(hash, &addr->sin6_addr, sizeof(addr->sin6_addr));
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) && peer_addr->sa_family == AF_INET) {
+		const struct sockaddr_in *addr = net_sin(peer_addr);
+
+		hash = sys_hash32_fnv1a_update(hash, &addr->sin_port, sizeof(addr->sin_port));
+		hash = sys_hash32_fnv1a_update(hash, &addr->sin_addr, sizeof(addr->sin_addr));
+	}
+
+	return hash;
+}
+
+static inline uint16_t tls_session_index(struct tls_session_cache *entry)
+{
+	return entry - client_cache;
+}
+
+static struct tls_session_cache *tls_session_find(const struct sockaddr *peer_addr,
+						  uint32_t hostname_hash,
+						  uint32_t hash)
+{
+	uint16_t idx = client_cache_buckets[hash % TLS_SESSION_CACHE_BUCKETS];
+
+	while (idx != 0) {
+		struct tls_session_cache *entry = &client_cache[idx - 1];
+
+		if (entry->hash == hash && entry->hostname_hash == hostname_hash &&
+		    peer_addr_cmp(&entry->peer_addr, peer_addr)) {
+			return entry;
+		}
+
+		idx = entry->next;
+	}
+
+	return NULL;
+}
+
+static void tls_session_link(struct tls_session_cache *entry)
+{
+	uint16_t *bucket = &client_cache_buckets[entry->hash % TLS_SESSION_CACHE_BUCKETS];
+
+	entry->next = *bucket;
+	*bucket = tls_session_index(entry) + 1;
+}
+
+static void tls_session_unlink(struct tls_session_cache *entry)
+{
+	uint16_t *link = &client_cache_buckets[entry->hash % TLS_SESSION_CACHE_BUCKETS];
+
+	while (*link != 0) {
+		if (*link == tls_session_index(entry) + 1) {
+			*link = entry->next;
+			break;
 		}
+
+		link = &client_cache[*link - 1].next;
+	}
+}
+
+static void tls_session_touch(struct tls_session_cache *entry)
+{
+	sys_dlist_remove(&entry->node);
+	sys_dlist_prepend(&client_cache_lru, &entry->node);
+}
+
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SETTINGS)
+#define TLS_SESSION_SETTINGS_ROOT "tls_sess"
+
+/* Persistent form of a cache entry, followed by the session data. */
+struct tls_session_record {
+	struct sockaddr peer_addr;
+	uint32_t hostname_hash;
+};
+
+static void tls_session_settings_name(struct tls_session_cache *entry,
+				      char *name, size_t len)
+{
+	snprintk(name, len, TLS_SESSION_SETTINGS_ROOT "/%u",
+		 tls_session_index(entry));
+}
+
+static void tls_session_settings_save(struct tls_session_cache *entry)
+{
+	struct tls_session_record *record;
+	char name[sizeof(TLS_SESSION_SETTINGS_ROOT) + 6];
+	int ret;
+
+	record = mbedtls_calloc(1, sizeof(*record) + entry->session_len);
+	if (record == NULL) {
+		NET_ERR("Failed to allocate session record.");
+		return;
+	}
+
+	memcpy(&record->peer_addr, &entry->peer_addr, sizeof(record->peer_addr));
+	record->hostname_hash = entry->hostname_hash;
+	memcpy(record + 1, entry->session, entry->session_len);
+
+	tls_session_settings_name(entry, name, sizeof(name));
+
+	ret = settings_save_one(name, record, sizeof(*record) + entry->session_len);
+	if (ret < 0) {
+		NET_ERR("Failed to store TLS session %d", ret);
+	}
+
+	mbedtls_free(record);
+}
+
+static void tls_session_settings_delete(struct tls_session_cache *entry)
+{
+	char name[sizeof(TLS_SESSION_SETTINGS_ROOT) + 6];
+
+	tls_session_settings_name(entry, name, sizeof(name));
+	(void)settings_delete(name);
+}
+
+static int tls_session_settings_set(const char *name, size_t len,
+				    settings_read_cb read_cb, void *cb_arg)
+{
+	struct tls_session_cache *entry;
+	struct tls_session_record record;
+	unsigned long idx;
+	char *endptr;
+	ssize_t ret;
+
+	idx = strtoul(name, &endptr, 10);
+	if (endptr == name || *endptr != '\0' || idx >= ARRAY_SIZE(client_cache) ||
+	    len <= sizeof(record)) {
+		return -EINVAL;
 	}
 
-	/* Allocate session and save */
+	ret = read_cb(cb_arg, &record, sizeof(record));
+	if (ret != sizeof(record)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&session_lock, K_FOREVER);
 
+	entry = &client_cache[idx];
 	if (entry->session != NULL) {
+		tls_session_unlink(entry);
+		mbedtls_free(entry->session);
+	}
+
+	entry->session_len = len - sizeof(record);
+	entry->session = mbedtls_calloc(1, entry->session_len);
+	if (entry->session == NULL) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	ret = read_cb(cb_arg, entry->session, entry->session_len);
+	if (ret != entry->session_len) {
 		mbedtls_free(entry->session);
 		entry->session = NULL;
+		ret = -EINVAL;
+		goto out;
 	}
 
+	memcpy(&entry->peer_addr, &record.peer_addr, sizeof(entry->peer_addr));
+	entry->hostname_hash = record.hostname_hash;
+	entry->hash = tls_session_hash(&entry->peer_addr, entry->hostname_hash);
+	/* Uptime does not survive a reboot, the lifetime restarts now. */
+	entry->timestamp = k_uptime_get();
+
+	tls_session_link(entry);
+	tls_session_touch(entry);
+	ret = 0;
+
+out:
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(tls_session, TLS_SESSION_SETTINGS_ROOT, NULL,
+			       tls_session_settings_set, NULL, NULL);
+#else
+static inline void tls_session_settings_save(struct tls_session_cache *entry)
+{
+}
+
+static inline void tls_session_settings_delete(struct tls_session_cache *entry)
+{
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SETTINGS */
+
+static void tls_session_drop(struct tls_session_cache *entry)
+{
+	tls_session_unlink(entry);
+	tls_session_settings_delete(entry);
+
+	mbedtls_free(entry->session);
+	entry->session = NULL;
+	entry->session_len = 0;
+
+	sys_dlist_remove(&entry->node);
+	sys_dlist_append(&client_cache_lru, &entry->node);
+}
+
+static int tls_session_save(const struct sockaddr *peer_addr,
+			    uint32_t hostname_hash,
+			    mbedtls_ssl_session *session)
+{
+	struct tls_session_cache *entry;
+	uint32_t hash = tls_session_hash(peer_addr, hostname_hash);
+	uint8_t *buf;
+	size_t session_len;
+	int ret;
+
 	(void)mbedtls_ssl_session_save(session, NULL, 0, &session_len);
 
-	entry->session = mbedtls_calloc(1, session_len);
-	if (entry->session == NULL) {
+	buf = mbedtls_calloc(1, session_len);
+	if (buf == NULL) {
 		NET_ERR("Failed to allocate session buffer.");
 		return -ENOMEM;
 	}
 
-	ret = mbedtls_ssl_session_save(session, entry->session, session_len,
+	ret = mbedtls_ssl_session_save(session, buf, session_len,
 				       &session_len);
 	if (ret < 0) {
 		NET_ERR("Failed to serialize session, err: -0x%x.", -ret);
-		mbedtls_free(entry->session);
-		entry->session = NULL;
+		mbedtls_free(buf);
 		return -ENOMEM;
 	}
 
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	entry = tls_session_find(peer_addr, hostname_hash, hash);
+	if (entry != NULL) {
+		if (entry->session_len == session_len &&
+		    memcmp(entry->session, buf, session_len) == 0) {
+			/* The session was resumed as is, nothing to store. */
+			mbedtls_free(buf);
+			tls_session_touch(entry);
+			goto out;
+		}
+
+		/* Reuse old entry for given address. */
+		tls_session_unlink(entry);
+		mbedtls_free(entry->session);
+	} else {
+		/* Reuse the least recently used entry. */
+		entry = CONTAINER_OF(sys_dlist_peek_tail(&client_cache_lru),
+				     struct tls_session_cache, node);
+		if (entry->session != NULL) {
+			session_stats.cache_evictions++;
+			tls_session_unlink(entry);
+			mbedtls_free(entry->session);
+		}
+	}
+
+	entry->session = buf;
 	entry->session_len = session_len;
 	entry->timestamp = k_uptime_get();
+	entry->hostname_hash = hostname_hash;
+	entry->hash = hash;
 	memcpy(&entry->peer_addr, peer_addr, sizeof(*peer_addr));
 
+	tls_session_link(entry);
+	tls_session_touch(entry);
+	tls_session_settings_save(entry);
+
+out:
+	k_mutex_unlock(&session_lock);
+
 	return 0;
 }
 
 static int tls_session_get(const struct sockaddr *peer_addr,
+			   uint32_t hostname_hash,
 			   mbedtls_ssl_session *session)
 {
-	struct tls_session_cache *entry = NULL;
+	struct tls_session_cache *entry;
 	int ret;
 
-	for (int i = 0; i < ARRAY_SIZE(client_cache); i++) {
-		if (client_cache[i].session != NULL &&
-		    peer_addr_cmp(&client_cache[i].peer_addr, peer_addr)) {
-			entry = &client_cache[i];
-			break;
-		}
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	entry = tls_session_find(peer_addr, hostname_hash,
+				 tls_session_hash(peer_addr, hostname_hash));
+	if (entry != NULL &&
+	    k_uptime_get() - entry->timestamp > TLS_SESSION_LIFETIME_MS) {
+		/* Expired, the server would refuse it anyway. */
+		tls_session_drop(entry);
+		entry = NULL;
 	}
 
 	if (entry == NULL) {
-		return -ENOENT;
+		session_stats.cache_misses++;
+		ret = -ENOENT;
+		goto out;
 	}
 
 	ret = mbedtls_ssl_session_load(session, entry->session,
 				       entry->session_len);
 	if (ret < 0) {
 		/* Discard corrupted session data. */
-		mbedtls_free(entry->session);
-		entry->session = NULL;
+		tls_session_drop(entry);
+		session_stats.cache_misses++;
 		NET_ERR("Failed to load TLS session %d", ret);
-		return -EIO;
+		ret = -EIO;
+		goto out;
 	}
 
-	return 0;
+	session_stats.cache_hits++;
+	tls_session_touch(entry);
+
+out:
+	k_mutex_unlock(&session_lock);
+
+	return ret;
 }
 
 static void tls_session_store(struct tls_context *context,
@@ -683,7 +972,8 @@ static void tls_session_store(struct tls_context *context,
 		goto exit;
 	}
 
-	ret = tls_session_save(&peer_addr, &session);
+	ret = tls_session_save(&peer_addr, context->options.hostname_hash,
+			       &session);
 	if (ret < 0) {
 		NET_ERR("Failed to save session for %p", context);
 	}
@@ -707,7 +997,8 @@ static void tls_session_restore(struct tls_context *context,
 	memcpy(&peer_addr, addr, addrlen);
 	mbedtls_ssl_session_init(&session);
 
-	ret = tls_session_get(&peer_addr, &session);
+	ret = tls_session_get(&peer_addr, context->options.hostname_hash,
+			      &session);
 	if (ret < 0) {
 		NET_DBG("Session not found for %p", context);
 		goto exit;
@@ -724,8 +1015,18 @@ exit:
 
 static void tls_session_purge(void)
 {
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(client_cache); i++) {
+		if (client_cache[i].session != NULL) {
+			tls_session_settings_delete(&client_cache[i]);
+		}
+	}
+
 	tls_session_cache_reset();
 
+	k_mutex_unlock(&session_lock);
+
 #if defined(MBEDTLS_SSL_CACHE_C)
 	mbedtls_ssl_cache_free(&server_cache);
 	mbedtls_ssl_cache_init(&server_cache);
@@ -1169,6 +1470,7 @@ static int tls_mbedtls_reset(struct tls_context *context)
 	}
 
 	k_sem_reset(&context->tls_established);
+	context->full_handshake = false;
 
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	/* Server role: reset the address so that a new
@@ -1186,6 +1488,41 @@ static int tls_mbedtls_reset(struct tls_context *context)
 	return 0;
 }
 
+/* Same as mbedtls_ssl_handshake(), but notes whether the server
+ * certificate stage is reached. It is skipped when a session is resumed.
+ */
+static int tls_mbedtls_handshake_steps(struct tls_context *context)
+{
+	int ret = 0;
+
+	while (!mbedtls_ssl_is_handshake_over(&context->ssl)) {
+		if (context->ssl.state == MBEDTLS_SSL_SERVER_CERTIFICATE) {
+			context->full_handshake = true;
+		}
+
+		ret = mbedtls_ssl_handshake_step(&context->ssl);
+		if (ret != 0) {
+			break;
+		}
+	}
+
+	return ret;
+}
+
+static void tls_handshake_stats_update(struct tls_context *context)
+{
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	session_stats.handshakes++;
+	if (!context->full_handshake) {
+		session_stats.resumed++;
+	}
+
+	k_mutex_unlock(&session_lock);
+
+	context->full_handshake = false;
+}
+
 static int tls_mbedtls_handshake(struct tls_context *context,
 				 k_timeout_t timeout)
 {
@@ -1196,7 +1533,7 @@ static int tls_mbedtls_handshake(struct tls_context *context,
 
 	end = sys_timepoint_calc(timeout);
 
-	while ((ret = mbedtls_ssl_handshake(&context->ssl)) != 0) {
+	while ((ret = tls_mbedtls_handshake_steps(context)) != 0) {
 		if (ret == MBEDTLS_ERR_SSL_WANT_READ ||
 		    ret == MBEDTLS_ERR_SSL_WANT_WRITE ||
 		    ret == MBEDTLS_ERR_SSL_ASYNC_IN_PROGRESS ||
@@ -1277,6 +1614,7 @@ static int tls_mbedtls_handshake(struct tls_context *context,
 	}
 
 	if (ret == 0) {
+		tls_handshake_stats_update(context);
 		k_sem_give(&context->tls_established);
 	}
 
@@ -1285,6 +1623,32 @@ static int tls_mbedtls_handshake(struct tls_context *context,
 	return ret;
 }
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+/* Generate the ticket key on first use, once entropy is available. */
+static int tls_server_ticket_setup(void)
+{
+	int ret = 0;
+
+	k_mutex_lock(&context_lock, K_FOREVER);
+
+	if (!server_ticket_ready) {
+		ret = mbedtls_ssl_ticket_setup(&server_ticket, tls_ctr_drbg_random,
+					       NULL, MBEDTLS_CIPHER_AES_256_GCM,
+					       CONFIG_NET_SOCKETS_TLS_SESSION_LIFETIME);
+		if (ret != 0) {
+			NET_ERR("Failed to set up session tickets, err: -0x%x",
+				-ret);
+		} else {
+			server_ticket_ready = true;
+		}
+	}
+
+	k_mutex_unlock(&context_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
 static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 {
 	int role, type, ret;
@@ -1421,6 +1785,25 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 	}
 #endif
 
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+	if (!is_server) {
+		mbedtls_ssl_conf_session_tickets(&context->config,
+						 context->options.cache_enabled ?
+						 MBEDTLS_SSL_SESSION_TICKETS_ENABLED :
+						 MBEDTLS_SSL_SESSION_TICKETS_DISABLED);
+	}
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	if (is_server && context->options.cache_enabled &&
+	    tls_server_ticket_setup() == 0) {
+		mbedtls_ssl_conf_session_tickets_cb(&context->config,
+						    mbedtls_ssl_ticket_write,
+						    mbedtls_ssl_ticket_parse,
+						    &server_ticket);
+	}
+#endif
+
 	ret = mbedtls_ssl_setup(&context->ssl,
 				&context->config);
 	if (ret != 0) {
@@ -1519,6 +1902,8 @@ static int tls_opt_hostname_set(struct tls_context *context,
 #endif
 
 	context->options.is_hostname_set = true;
+	context->options.hostname_hash =
+		optval != NULL ? sys_hash32_fnv1a(optval, strlen(optval)) : 0;
 
 	return 0;
 }
@@ -1941,6 +2326,22 @@ static int tls_opt_session_cache_get(struct tls_context *context,
 	return 0;
 }
 
+static int tls_opt_session_stats_get(struct tls_context *context,
+				     void *optval, socklen_t *optlen)
+{
+	ARG_UNUSED(context);
+
+	if (*optlen != sizeof(struct tls_session_stats)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+	memcpy(optval, &session_stats, sizeof(session_stats));
+	k_mutex_unlock(&session_lock);
+
+	return 0;
+}
+
 static int tls_opt_session_cache_purge_set(struct tls_context *context,
 					   const void *optval, socklen_t optlen)
 {
@@ -3471,6 +3872,10 @@ int ztls_getsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		err = tls_opt_session_cache_get(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_STATS:
+		err = tls_opt_session_stats_get(ctx, optval, optlen);
+		break;
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	case TLS_DTLS_HANDSHAKE_TIMEOUT_MIN:
 		err = tls_opt_dtls_handshake_timeout_get(ctx, optval,
@@ -324,14 +324,19 @@ static void udp_session_cb(enum zperf_status status,
 
 	case ZPERF_SESSION_FINISHED: {
 		uint32_t rate_in_kbps;
+		uint32_t rate_in_pps;
 
 		/* Compute baud rate */
 		if (result->time_in_us != 0U) {
 			rate_in_kbps = (uint32_t)
 				((result->total_len * 8ULL * USEC_PER_SEC) /
 				 (result->time_in_us * 1000ULL));
+			rate_in_pps = (uint32_t)
+				((result->nb_packets_rcvd * (uint64_t)USEC_PER_SEC) /
+				 result->time_in_us);
 		} else {
 			rate_in_kbps = 0U;
+			rate_in_pps = 0U;
 		}
 
 		shell_fprintf(sh, SHELL_NORMAL, "End of session!\n");
@@ -355,6 +360,9 @@ static void udp_session_cb(enum zperf_status status,
 		print_number(sh, rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, "\n");
 
+		shell_fprintf(sh, SHELL_NORMAL, " packet rate:\t\t%u pps\n",
+			      rate_in_pps);
+
 		break;
 	}
 
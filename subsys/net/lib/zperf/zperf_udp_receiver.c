@@ -307,14 +307,55 @@ static void udp_receiver_cleanup(void)
 	zperf_session_reset(SESSION_UDP);
 }
 
+#if CONFIG_NET_ZPERF_UDP_RECV_BATCH > 1
+static int udp_recv_batch(int sock)
+{
+	static uint8_t bufs[CONFIG_NET_ZPERF_UDP_RECV_BATCH][UDP_RECEIVER_BUF_SIZE];
+	static struct sockaddr addrs[CONFIG_NET_ZPERF_UDP_RECV_BATCH];
+	static struct iovec iovs[CONFIG_NET_ZPERF_UDP_RECV_BATCH];
+	static struct zsock_mmsghdr msgs[CONFIG_NET_ZPERF_UDP_RECV_BATCH];
+	int total = 0;
+	int count;
+
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		iovs[i].iov_base = bufs[i];
+		iovs[i].iov_len = sizeof(bufs[i]);
+
+		memset(&msgs[i], 0, sizeof(msgs[i]));
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* The socket is readable, so only the first message is waited for
+	 * and the rest of the batch is whatever is already queued.
+	 */
+	count = zsock_recvmmsg(sock, msgs, ARRAY_SIZE(msgs),
+			       ZSOCK_MSG_WAITFORONE);
+	if (count < 0) {
+		return -errno;
+	}
+
+	for (int i = 0; i < count; i++) {
+		udp_received(sock, &addrs[i], bufs[i], msgs[i].msg_len);
+		total += msgs[i].msg_len;
+	}
+
+	return total;
+}
+#endif /* CONFIG_NET_ZPERF_UDP_RECV_BATCH > 1 */
+
 static int udp_recv_data(struct net_socket_service_event *pev)
 {
+#if CONFIG_NET_ZPERF_UDP_RECV_BATCH == 1
 	static uint8_t buf[UDP_RECEIVER_BUF_SIZE];
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+#endif
 	int ret = 0;
 	int family, sock_error;
-	struct sockaddr addr;
 	socklen_t optlen = sizeof(int);
-	socklen_t addrlen = sizeof(addr);
 
 	if (!udp_server_running) {
 		return -ENOENT;
@@ -336,10 +377,18 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 		return 0;
 	}
 
+#if CONFIG_NET_ZPERF_UDP_RECV_BATCH > 1
+	ret = udp_recv_batch(pev->event.fd);
+#else
 	ret = zsock_recvfrom(pev->event.fd, buf, sizeof(buf), 0,
 			     &addr, &addrlen);
-	if (ret < 0) {
+	if (ret >= 0) {
+		udp_received(pev->event.fd, &addr, buf, ret);
+	} else {
 		ret = -errno;
+	}
+#endif
+	if (ret < 0) {
 		(void)zsock_getsockopt(pev->event.fd, SOL_SOCKET,
 				       SO_DOMAIN, &family, &optlen);
 		NET_ERR("recv failed on IPv%d socket (%d)",
@@ -347,8 +396,6 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 		goto error;
 	}
 
-	udp_received(pev->event.fd, &addr, buf, ret);
-
 	return ret;
 
 error:
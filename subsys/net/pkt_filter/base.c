@@ -11,38 +11,58 @@ LOG_MODULE_REGISTER(npf_base, CONFIG_NET_PKT_FILTER_LOG_LEVEL);
 #include <zephyr/net/net_pkt_filter.h>
 #include <zephyr/spinlock.h>
 
+#include "classifier.h"
+
+#ifdef CONFIG_NET_PKT_FILTER_COMPILED
+#define NPF_CLASSIFIER_DEFINE(_name) static struct npf_classifier _name
+#define NPF_CLASSIFIER_INIT(_name) .classifier = &(_name),
+#else
+#define NPF_CLASSIFIER_DEFINE(_name)
+#define NPF_CLASSIFIER_INIT(_name)
+#endif
+
 /*
  * Our actual rule lists for supported test points
  */
 
+NPF_CLASSIFIER_DEFINE(send_classifier);
 struct npf_rule_list npf_send_rules = {
 	.rule_head = SYS_SLIST_STATIC_INIT(&send_rules.rule_head),
 	.lock = { },
+	NPF_CLASSIFIER_INIT(send_classifier)
 };
 
+NPF_CLASSIFIER_DEFINE(recv_classifier);
 struct npf_rule_list npf_recv_rules = {
 	.rule_head = SYS_SLIST_STATIC_INIT(&recv_rules.rule_head),
 	.lock = { },
+	NPF_CLASSIFIER_INIT(recv_classifier)
 };
 
 #ifdef CONFIG_NET_PKT_FILTER_LOCAL_IN_HOOK
+NPF_CLASSIFIER_DEFINE(local_in_recv_classifier);
 struct npf_rule_list npf_local_in_recv_rules = {
 	.rule_head = SYS_SLIST_STATIC_INIT(&local_in_recv_rules.rule_head),
 	.lock = { },
+	NPF_CLASSIFIER_INIT(local_in_recv_classifier)
 };
 #endif /* CONFIG_NET_PKT_FILTER_LOCAL_IN_HOOK */
 
 #ifdef CONFIG_NET_PKT_FILTER_IPV4_HOOK
+NPF_CLASSIFIER_DEFINE(ipv4_recv_classifier);
 struct npf_rule_list npf_ipv4_recv_rules = {
 	.rule_head = SYS_SLIST_STATIC_INIT(&ipv4_recv_rules.rule_head),
 	.lock = { },
+	NPF_CLASSIFIER_INIT(ipv4_recv_classifier)
 };
 #endif /* CONFIG_NET_PKT_FILTER_IPV4_HOOK */
 
 #ifdef CONFIG_NET_PKT_FILTER_IPV6_HOOK
+NPF_CLASSIFIER_DEFINE(ipv6_recv_classifier);
 struct npf_rule_list npf_ipv6_recv_rules = {
 	.rule_head = SYS_SLIST_STATIC_INIT(&ipv6_recv_rules.rule_head),
 	.lock = { },
+	NPF_CLASSIFIER_INIT(ipv6_recv_classifier)
 };
 #endif /* CONFIG_NET_PKT_FILTER_IPV6_HOOK */
 
@@ -77,7 +97,7 @@ static struct npf_rule_list *get_ip_rules(uint8_t pf)
  * All tests must be true to return true.
  * If no tests then it is true.
  */
-static bool apply_tests(struct npf_rule *rule, struct net_pkt *pkt)
+bool npf_apply_tests(struct npf_rule *rule, struct net_pkt *pkt)
 {
 	struct npf_test *test;
 	unsigned int i;
@@ -110,7 +130,7 @@ static enum net_verdict evaluate(sys_slist_t *rule_head, struct net_pkt *pkt)
 	}
 
 	SYS_SLIST_FOR_EACH_CONTAINER(rule_head, rule, node) {
-		if (apply_tests(rule, pkt) == true) {
+		if (npf_apply_tests(rule, pkt) == true) {
 			return rule->result;
 		}
 	}
@@ -122,12 +142,31 @@ static enum net_verdict evaluate(sys_slist_t *rule_head, struct net_pkt *pkt)
 static enum net_verdict lock_evaluate(struct npf_rule_list *rules, struct net_pkt *pkt)
 {
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
-	enum net_verdict result = evaluate(&rules->rule_head, pkt);
+	enum net_verdict result;
+
+#ifdef CONFIG_NET_PKT_FILTER_COMPILED
+	if (npf_classifier_evaluate(rules->classifier, pkt, &result)) {
+		k_spin_unlock(&rules->lock, key);
+		return result;
+	}
+#endif
+
+	result = evaluate(&rules->rule_head, pkt);
 
 	k_spin_unlock(&rules->lock, key);
 	return result;
 }
 
+/* Must be called with the rule list lock held after every list change */
+static inline void rules_changed(struct npf_rule_list *rules)
+{
+#ifdef CONFIG_NET_PKT_FILTER_COMPILED
+	npf_classifier_build(rules->classifier, &rules->rule_head);
+#else
+	ARG_UNUSED(rules);
+#endif
+}
+
 bool net_pkt_filter_send_ok(struct net_pkt *pkt)
 {
 	enum net_verdict result = lock_evaluate(&npf_send_rules, pkt);
@@ -177,6 +216,7 @@ void npf_insert_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 
 	NET_DBG("inserting rule %p into %p", rule, rules);
 	sys_slist_prepend(&rules->rule_head, &rule->node);
+	rules_changed(rules);
 
 	k_spin_unlock(&rules->lock, key);
 }
@@ -190,6 +230,7 @@ void npf_append_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 
 	NET_DBG("appending rule %p into %p", rule, rules);
 	sys_slist_append(&rules->rule_head, &rule->node);
+	rules_changed(rules);
 
 	k_spin_unlock(&rules->lock, key);
 }
@@ -199,6 +240,10 @@ bool npf_remove_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
 	bool result = sys_slist_find_and_remove(&rules->rule_head, &rule->node);
 
+	if (result) {
+		rules_changed(rules);
+	}
+
 	k_spin_unlock(&rules->lock, key);
 	NET_DBG("removing rule %p from %p: %d", rule, rules, result);
 	return result;
@@ -211,6 +256,7 @@ bool npf_remove_all_rules(struct npf_rule_list *rules)
 
 	if (result) {
 		sys_slist_init(&rules->rule_head);
+		rules_changed(rules);
 		NET_DBG("removing all rules from %p", rules);
 	}
 
@@ -0,0 +1,231 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(npf_classifier, CONFIG_NET_PKT_FILTER_LOG_LEVEL);
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_pkt_filter.h>
+#include <zephyr/sys/hash_function.h>
+#include <string.h>
+
+#include "classifier.h"
+
+/*
+ * Instead of running the tests of every rule in turn, only the rules that
+ * can possibly match a packet are evaluated. Each rule is indexed on the
+ * value of at most one packet field. For a given packet the candidates
+ * are the rules indexed on one of its field values plus the rules that
+ * are not indexed at all. Those candidate lists are kept in rule order and
+ * merged, so the first matching candidate is also the first matching rule
+ * of the list.
+ */
+
+static const uint8_t full_mask[sizeof(struct net_eth_addr)] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+static uint32_t field_hash(uint8_t field, const uint8_t *value, size_t len)
+{
+	/* The field identifier is hashed as the first byte of the key. Hash
+	 * values only live in the index built at run time.
+	 */
+	return sys_hash32_fnv1a_update(sys_hash32_fnv1a(&field, sizeof(field)), value, len);
+}
+
+static bool rule_index_field(struct npf_rule *rule, uint8_t *field,
+			     uint32_t *hash)
+{
+	for (uint32_t i = 0; i < rule->nb_tests; i++) {
+		struct npf_test *test = rule->tests[i];
+
+		if (test->fn == npf_eth_src_addr_match ||
+		    test->fn == npf_eth_dst_addr_match) {
+			struct npf_test_eth_addr *eth =
+				CONTAINER_OF(test, struct npf_test_eth_addr, test);
+
+			if (eth->nb_addresses != 1 ||
+			    memcmp(eth->mask.addr, full_mask, sizeof(full_mask)) != 0) {
+				continue;
+			}
+
+			*field = test->fn == npf_eth_src_addr_match ?
+				 NPF_FIELD_ETH_SRC : NPF_FIELD_ETH_DST;
+			*hash = field_hash(*field, eth->addresses[0].addr,
+					   sizeof(struct net_eth_addr));
+			return true;
+		}
+
+		if (test->fn == npf_eth_type_match) {
+			struct npf_test_eth_type *type =
+				CONTAINER_OF(test, struct npf_test_eth_type, test);
+
+			*field = NPF_FIELD_ETH_TYPE;
+			*hash = field_hash(*field, (const uint8_t *)&type->type,
+					   sizeof(type->type));
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void npf_classifier_build(struct npf_classifier *cls, sys_slist_t *rule_head)
+{
+	struct npf_rule *rule;
+	uint16_t count = 0U;
+
+	cls->valid = false;
+	cls->fields = 0U;
+	cls->nb_wildcards = 0U;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(rule_head, rule, node) {
+		if (count == NPF_CLASSIFIER_MAX_RULES) {
+			NET_DBG("too many rules for classifier %p", cls);
+			cls->nb_rules = 0U;
+			return;
+		}
+
+		cls->rules[count++] = rule;
+	}
+
+	cls->nb_rules = count;
+
+	if (count == 0U) {
+		return;
+	}
+
+	for (int i = 0; i < NPF_CLASSIFIER_BUCKETS; i++) {
+		cls->buckets[i] = NPF_CLASSIFIER_NONE;
+	}
+
+	/* Walk backwards and prepend so that the buckets are in rule order */
+	for (int i = count - 1; i >= 0; i--) {
+		struct npf_classifier_entry *entry = &cls->entries[i];
+		uint16_t *bucket;
+
+		if (!rule_index_field(cls->rules[i], &entry->field, &entry->hash)) {
+			entry->field = NPF_FIELD_COUNT;
+			continue;
+		}
+
+		bucket = &cls->buckets[entry->hash % NPF_CLASSIFIER_BUCKETS];
+		entry->next = *bucket;
+		*bucket = i;
+		cls->fields |= BIT(entry->field);
+	}
+
+	for (int i = 0; i < count; i++) {
+		if (cls->entries[i].field == NPF_FIELD_COUNT) {
+			cls->wildcards[cls->nb_wildcards++] = i;
+		}
+	}
+
+	cls->valid = true;
+
+	NET_DBG("classifier %p: %u rules, %u not indexed", cls, count,
+		cls->nb_wildcards);
+}
+
+/* Return the first rule at or after idx in the bucket chain for the key */
+static uint16_t chain_next(struct npf_classifier *cls, uint16_t idx,
+			   uint8_t field, uint32_t hash)
+{
+	while (idx != NPF_CLASSIFIER_NONE) {
+		if (cls->entries[idx].hash == hash &&
+		    cls->entries[idx].field == field) {
+			break;
+		}
+
+		idx = cls->entries[idx].next;
+	}
+
+	return idx;
+}
+
+bool npf_classifier_evaluate(struct npf_classifier *cls, struct net_pkt *pkt,
+			     enum net_verdict *result)
+{
+	uint16_t cursor[NPF_FIELD_COUNT];
+	uint32_t hash[NPF_FIELD_COUNT];
+	uint16_t wildcard = 0U;
+
+	if (!cls->valid) {
+		return false;
+	}
+
+	for (int f = 0; f < NPF_FIELD_COUNT; f++) {
+		cursor[f] = NPF_CLASSIFIER_NONE;
+	}
+
+	if (cls->fields != 0U) {
+		struct net_eth_hdr *hdr;
+
+		if (pkt->buffer == NULL ||
+		    pkt->buffer->len < sizeof(struct net_eth_hdr)) {
+			return false;
+		}
+
+		hdr = NET_ETH_HDR(pkt);
+
+		hash[NPF_FIELD_ETH_SRC] = field_hash(NPF_FIELD_ETH_SRC, hdr->src.addr,
+						     sizeof(hdr->src));
+		hash[NPF_FIELD_ETH_DST] = field_hash(NPF_FIELD_ETH_DST, hdr->dst.addr,
+						     sizeof(hdr->dst));
+		hash[NPF_FIELD_ETH_TYPE] = field_hash(NPF_FIELD_ETH_TYPE,
+						      (const uint8_t *)&hdr->type,
+						      sizeof(hdr->type));
+
+		for (int f = 0; f < NPF_FIELD_COUNT; f++) {
+			if (!(cls->fields & BIT(f))) {
+				continue;
+			}
+
+			cursor[f] = chain_next(cls,
+					       cls->buckets[hash[f] % NPF_CLASSIFIER_BUCKETS],
+					       f, hash[f]);
+		}
+	}
+
+	while (true) {
+		uint16_t best = NPF_CLASSIFIER_NONE;
+		int best_f = NPF_FIELD_COUNT;
+
+		if (wildcard < cls->nb_wildcards) {
+			best = cls->wildcards[wildcard];
+		}
+
+		for (int f = 0; f < NPF_FIELD_COUNT; f++) {
+			if (cursor[f] < best) {
+				best = cursor[f];
+				best_f = f;
+			}
+		}
+
+		if (best == NPF_CLASSIFIER_NONE) {
+			break;
+		}
+
+		if (npf_apply_tests(cls->rules[best], pkt)) {
+			*result = cls->rules[best]->result;
+			return true;
+		}
+
+		if (best_f == NPF_FIELD_COUNT) {
+			wildcard++;
+		} else {
+			cursor[best_f] = chain_next(cls, cls->entries[best].next,
+						    best_f, hash[best_f]);
+		}
+	}
+
+	NET_DBG("no matching rules in classifier %p", cls);
+	*result = NET_DROP;
+
+	return true;
+}
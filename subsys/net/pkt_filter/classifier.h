@@ -0,0 +1,71 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NPF_CLASSIFIER_H
+#define __NPF_CLASSIFIER_H
+
+#include <zephyr/net/net_pkt_filter.h>
+
+/* Evaluate the tests of a single rule, defined in base.c */
+bool npf_apply_tests(struct npf_rule *rule, struct net_pkt *pkt);
+
+#ifdef CONFIG_NET_PKT_FILTER_COMPILED
+
+/*
+ * Packet fields that rules can be indexed on. A rule is indexed on at
+ * most one field: the first test of the rule that requires an exact
+ * value for one of them.
+ */
+enum npf_field {
+	NPF_FIELD_ETH_SRC,
+	NPF_FIELD_ETH_DST,
+	NPF_FIELD_ETH_TYPE,
+	NPF_FIELD_COUNT,
+};
+
+#define NPF_CLASSIFIER_MAX_RULES CONFIG_NET_PKT_FILTER_COMPILED_MAX_RULES
+#define NPF_CLASSIFIER_BUCKETS (2 * NPF_CLASSIFIER_MAX_RULES)
+#define NPF_CLASSIFIER_NONE UINT16_MAX
+
+struct npf_classifier_entry {
+	uint32_t hash;      /* hash of the field value */
+	uint16_t next;      /* next entry in the bucket, in rule order */
+	uint8_t field;      /* enum npf_field */
+};
+
+/*
+ * Compiled form of a rule list. Entry i of entries[] describes the
+ * indexed field of rules[i]. Rules that cannot be indexed are listed,
+ * in order, in wildcards[].
+ */
+struct npf_classifier {
+	struct npf_rule *rules[NPF_CLASSIFIER_MAX_RULES];
+	struct npf_classifier_entry entries[NPF_CLASSIFIER_MAX_RULES];
+	uint16_t buckets[NPF_CLASSIFIER_BUCKETS];
+	uint16_t wildcards[NPF_CLASSIFIER_MAX_RULES];
+	uint16_t nb_rules;
+	uint16_t nb_wildcards;
+	uint8_t fields;     /* bitmask of the indexed fields */
+	bool valid;
+};
+
+/*
+ * Rebuild the classifier from a rule list. Must be called with the lock
+ * of the rule list held, after every change of the list.
+ */
+void npf_classifier_build(struct npf_classifier *cls, sys_slist_t *rule_head);
+
+/*
+ * Return the verdict of the first matching rule, like a walk of the rule
+ * list would. Returns false if the classifier cannot be used for this
+ * rule list or packet, in which case the list has to be walked.
+ */
+bool npf_classifier_evaluate(struct npf_classifier *cls, struct net_pkt *pkt,
+			     enum net_verdict *result);
+
+#endif /* CONFIG_NET_PKT_FILTER_COMPILED */
+
+#endif /* __NPF_CLASSIFIER_H */
@@ -13,6 +13,7 @@
 #include <zephyr/init.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/buf.h>
+#include <string.h>
 
 #define LOG_MODULE_NAME shell_uart
 LOG_MODULE_REGISTER(shell_uart);
@@ -23,18 +24,73 @@ LOG_MODULE_REGISTER(shell_uart);
 #define RX_POLL_PERIOD K_NO_WAIT
 #endif
 
+#define ASYNC_TX_BUF_SIZE CONFIG_SHELL_BACKEND_SERIAL_ASYNC_TX_BUFFER_SIZE
+/* Time given to a transfer in progress to complete when switching to blocking
+ * mode, before it is aborted. Interrupts may be locked at that point.
+ */
+#define ASYNC_TX_FLUSH_TIMEOUT_US 100000
+
 #ifdef CONFIG_MCUMGR_TRANSPORT_SHELL
 NET_BUF_POOL_DEFINE(smp_shell_rx_pool, CONFIG_MCUMGR_TRANSPORT_SHELL_RX_BUF_COUNT,
 		    SMP_SHELL_RX_BUF_SIZE, 0, NULL);
 #endif /* CONFIG_MCUMGR_TRANSPORT_SHELL */
 
+/* Start transfer of the buffer which is being filled. Called with tx_lock held. */
+static void async_tx_start(struct shell_uart_async *sh_uart)
+{
+	int err;
+
+	err = uart_tx(sh_uart->common.dev, sh_uart->tx_data[sh_uart->tx_idx],
+		      sh_uart->tx_len, SYS_FOREVER_US);
+	if (err < 0) {
+		/* Output is lost but the shell is not blocked. */
+		sh_uart->tx_len = 0;
+		return;
+	}
+
+	sh_uart->tx_busy = true;
+	sh_uart->tx_xfer_len = sh_uart->tx_len;
+	sh_uart->tx_xfer_sent = 0;
+	sh_uart->tx_idx ^= 1;
+	sh_uart->tx_len = 0;
+}
+
+static void async_tx_done(struct shell_uart_async *sh_uart, size_t sent)
+{
+	k_spinlock_key_t key = k_spin_lock(&sh_uart->tx_lock);
+
+	if (!sh_uart->tx_busy) {
+		/* Late event of a transfer given up by async_tx_flush(). */
+		k_spin_unlock(&sh_uart->tx_lock, key);
+		return;
+	}
+
+	/* Data written during the transfer is sent in a single transfer, unless
+	 * the shell has switched to blocking mode in the meantime.
+	 */
+	sh_uart->tx_busy = false;
+	sh_uart->tx_xfer_sent = sent;
+	if ((sh_uart->tx_len > 0) && !sh_uart->common.blocking_tx) {
+		async_tx_start(sh_uart);
+	}
+
+	k_spin_unlock(&sh_uart->tx_lock, key);
+
+	sh_uart->common.handler(SHELL_TRANSPORT_EVT_TX_RDY, sh_uart->common.context);
+}
+
 static void async_callback(const struct device *dev, struct uart_event *evt, void *user_data)
 {
 	struct shell_uart_async *sh_uart = (struct shell_uart_async *)user_data;
 
 	switch (evt->type) {
 	case  UART_TX_DONE:
-		k_sem_give(&sh_uart->tx_sem);
+	case  UART_TX_ABORTED:
+		if (ASYNC_TX_BUF_SIZE > 0) {
+			async_tx_done(sh_uart, evt->data.tx.len);
+		} else {
+			k_sem_give(&sh_uart->tx_sem);
+		}
 		break;
 	case  UART_RX_RDY:
 		uart_async_rx_on_rdy(&sh_uart->async_rx, evt->data.rx.buf, evt->data.rx.len);
@@ -342,6 +398,65 @@ static int uninit(const struct shell_transport *transport)
 	return 0;
 }
 
+static bool async_tx_wait(struct shell_uart_async *sh_uart)
+{
+	k_spinlock_key_t key;
+	bool busy;
+
+	for (uint32_t waited = 0; ; waited += 10) {
+		key = k_spin_lock(&sh_uart->tx_lock);
+		busy = sh_uart->tx_busy;
+		k_spin_unlock(&sh_uart->tx_lock, key);
+
+		if (!busy || (waited >= ASYNC_TX_FLUSH_TIMEOUT_US)) {
+			return !busy;
+		}
+
+		k_busy_wait(10);
+	}
+}
+
+/* Output data pending in the TX buffers before switching to blocking mode.
+ * No transfer is started once blocking mode is set, the one in progress is
+ * completed or aborted, then the rest is output in order using polling.
+ */
+static void async_tx_flush(struct shell_uart_async *sh_uart)
+{
+	const struct device *dev = sh_uart->common.dev;
+	k_spinlock_key_t key;
+	const uint8_t *data;
+
+	if (!async_tx_wait(sh_uart)) {
+		(void)uart_tx_abort(dev);
+
+		if (!async_tx_wait(sh_uart)) {
+			/* What was sent is unknown, the whole transfer is repeated. */
+			key = k_spin_lock(&sh_uart->tx_lock);
+			sh_uart->tx_busy = false;
+			sh_uart->tx_xfer_sent = 0;
+			k_spin_unlock(&sh_uart->tx_lock, key);
+		}
+	}
+
+	key = k_spin_lock(&sh_uart->tx_lock);
+
+	data = sh_uart->tx_data[sh_uart->tx_idx ^ 1];
+	for (size_t i = sh_uart->tx_xfer_sent; i < sh_uart->tx_xfer_len; i++) {
+		uart_poll_out(dev, data[i]);
+	}
+
+	sh_uart->tx_xfer_sent = sh_uart->tx_xfer_len;
+
+	data = sh_uart->tx_data[sh_uart->tx_idx];
+	for (size_t i = 0; i < sh_uart->tx_len; i++) {
+		uart_poll_out(dev, data[i]);
+	}
+
+	sh_uart->tx_len = 0;
+
+	k_spin_unlock(&sh_uart->tx_lock, key);
+}
+
 static int enable(const struct shell_transport *transport, bool blocking_tx)
 {
 	struct shell_uart_common *sh_uart = (struct shell_uart_common *)transport->ctx;
@@ -352,6 +467,11 @@ static int enable(const struct shell_transport *transport, bool blocking_tx)
 		uart_irq_tx_disable(sh_uart->dev);
 	}
 
+	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_API_ASYNC) && (ASYNC_TX_BUF_SIZE > 0) &&
+	    blocking_tx) {
+		async_tx_flush((struct shell_uart_async *)transport->ctx);
+	}
+
 	return 0;
 }
 
@@ -383,11 +503,36 @@ static int irq_write(struct shell_uart_int_driven *sh_uart,
 	return 0;
 }
 
+static int async_buffered_write(struct shell_uart_async *sh_uart,
+				const void *data, size_t length, size_t *cnt)
+{
+	k_spinlock_key_t key = k_spin_lock(&sh_uart->tx_lock);
+
+	/* When both buffers are in use, nothing is written and the shell waits
+	 * for the TX ready event which is reported when the transfer is done.
+	 */
+	*cnt = MIN(length, ASYNC_TX_BUF_SIZE - sh_uart->tx_len);
+	memcpy(&sh_uart->tx_data[sh_uart->tx_idx][sh_uart->tx_len], data, *cnt);
+	sh_uart->tx_len += *cnt;
+
+	if (!sh_uart->tx_busy && (sh_uart->tx_len > 0)) {
+		async_tx_start(sh_uart);
+	}
+
+	k_spin_unlock(&sh_uart->tx_lock, key);
+
+	return 0;
+}
+
 static int async_write(struct shell_uart_async *sh_uart,
 		       const void *data, size_t length, size_t *cnt)
 {
 	int err;
 
+	if (ASYNC_TX_BUF_SIZE > 0) {
+		return async_buffered_write(sh_uart, data, length, cnt);
+	}
+
 	err = uart_tx(sh_uart->common.dev, data, length, SYS_FOREVER_US);
 	if (err < 0) {
 		*cnt = 0;
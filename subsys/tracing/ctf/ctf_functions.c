@@ -0,0 +1,50 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <ctf_top.h>
+
+/* Set while an event is emitted, functions called by the tracing subsystem
+ * may be instrumented too.
+ */
+static bool func_tracing[CONFIG_MP_MAX_NUM_CPUS];
+
+__attribute__((no_instrument_function))
+static inline void func_event(bool enter, void *func)
+{
+	unsigned int key = arch_irq_lock();
+	bool *busy = &func_tracing[arch_curr_cpu()->id];
+
+	if (!*busy) {
+		*busy = true;
+
+		if (enter) {
+			ctf_top_func_enter((uint32_t)(uintptr_t)func);
+		} else {
+			ctf_top_func_exit((uint32_t)(uintptr_t)func);
+		}
+
+		*busy = false;
+	}
+
+	arch_irq_unlock(key);
+}
+
+__attribute__((no_instrument_function))
+void __cyg_profile_func_enter(void *func, void *call_site)
+{
+	ARG_UNUSED(call_site);
+
+	func_event(true, func);
+}
+
+__attribute__((no_instrument_function))
+void __cyg_profile_func_exit(void *func, void *call_site)
+{
+	ARG_UNUSED(call_site);
+
+	func_event(false, func);
+}
@@ -11,6 +11,47 @@
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/socket_poll.h>
 
+#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+struct ctf_clock {
+	uint32_t last;
+	uint32_t wraps;
+	bool synced;
+};
+
+static struct ctf_clock ctf_clocks[CONFIG_MP_MAX_NUM_CPUS];
+
+uint32_t ctf_timestamp_get(void)
+{
+	unsigned int cpu = arch_curr_cpu()->id;
+	struct ctf_clock *clock = &ctf_clocks[cpu];
+	uint32_t tstamp;
+
+#ifdef CONFIG_TRACING_CTF_TIMESTAMP_CYCLES
+	tstamp = k_cycle_get_32();
+#else
+	tstamp = k_cyc_to_ns_floor64(k_cycle_get_32());
+#endif
+
+	if (!clock->synced || tstamp < clock->last) {
+		uint32_t freq = IS_ENABLED(CONFIG_TRACING_CTF_TIMESTAMP_CYCLES) ?
+				sys_clock_hw_cycles_per_sec() : NSEC_PER_SEC;
+
+		if (clock->synced) {
+			clock->wraps++;
+		}
+
+		clock->synced = true;
+
+		CTF_GATHER_FIELDS(tstamp, CTF_LITERAL(uint8_t, CTF_EVENT_CLOCK_SYNC),
+				  CTF_LITERAL(uint8_t, cpu), freq, clock->wraps);
+	}
+
+	clock->last = tstamp;
+
+	return tstamp;
+}
+#endif
+
 static void _get_thread_name(struct k_thread *thread,
 			     ctf_bounded_string_t *name)
 {
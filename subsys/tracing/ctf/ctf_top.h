@@ -50,11 +50,17 @@
 	}
 
 #ifdef CONFIG_TRACING_CTF_TIMESTAMP
+/*
+ * The timestamp is taken with the interrupts of the CPU masked, so that the
+ * events of a CPU are ordered by timestamp.
+ */
 #define CTF_EVENT(...)                                                         \
 	{                                                                      \
-		const uint32_t tstamp = k_cyc_to_ns_floor64(k_cycle_get_32()); \
+		const unsigned int ctf_key = arch_irq_lock();                  \
+		const uint32_t tstamp = ctf_timestamp_get();                   \
 									       \
 		CTF_GATHER_FIELDS(tstamp, __VA_ARGS__)                         \
+		arch_irq_unlock(ctf_key);                                      \
 	}
 #else
 #define CTF_EVENT(...)                                                         \
@@ -151,6 +157,9 @@ typedef enum {
 	CTF_EVENT_SOCKET_GETSOCKNAME_EXIT = 0x59,
 	CTF_EVENT_SOCKET_SOCKETPAIR_ENTER = 0x5A,
 	CTF_EVENT_SOCKET_SOCKETPAIR_EXIT = 0x5B,
+	CTF_EVENT_CLOCK_SYNC = 0x5C,
+	CTF_EVENT_FUNC_ENTER = 0x5D,
+	CTF_EVENT_FUNC_EXIT = 0x5E,
 
 } ctf_event_t;
 
@@ -158,6 +167,14 @@ typedef struct {
 	char buf[CTF_MAX_STRING_LEN];
 } ctf_bounded_string_t;
 
+/*
+ * Get the timestamp of an event, needs to be called with interrupts locked.
+ *
+ * A clock_sync event is emitted first by the first event of each CPU and
+ * whenever its timestamps wrap around.
+ */
+uint32_t ctf_timestamp_get(void);
+
 static inline void ctf_top_thread_switched_out(uint32_t thread_id,
 					       ctf_bounded_string_t name)
 {
@@ -609,4 +626,14 @@ static inline void ctf_top_socket_socketpair_exit(int32_t sock_A, int32_t sock_B
 	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_SOCKET_SOCKETPAIR_EXIT), sock_A, sock_B, ret);
 }
 
+static inline void ctf_top_func_enter(uint32_t func)
+{
+	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_FUNC_ENTER), func);
+}
+
+static inline void ctf_top_func_exit(uint32_t func)
+{
+	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_FUNC_EXIT), func);
+}
+
 #endif /* SUBSYS_DEBUG_TRACING_CTF_TOP_H */
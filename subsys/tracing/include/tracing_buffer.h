@@ -14,6 +14,13 @@
 extern "C" {
 #endif
 
+/** Number of tracing buffers, one per CPU with CONFIG_TRACING_PER_CPU_BUFFERS */
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS)
+#define TRACING_BUFFER_COUNT CONFIG_MP_MAX_NUM_CPUS
+#else
+#define TRACING_BUFFER_COUNT 1
+#endif
+
 /**
  * @brief Initialize tracing buffer.
  */
@@ -104,6 +111,47 @@ int tracing_buffer_get_finish(uint32_t size);
  */
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
 
+/**
+ * @brief Lock the tracing buffer of the current CPU for writing.
+ *
+ * Only the interrupts of the current CPU are masked, the buffers of other
+ * CPUs can be written at the same time. Only available with
+ * CONFIG_TRACING_PER_CPU_BUFFERS.
+ *
+ * @return Key to pass to tracing_buffer_unlock().
+ */
+unsigned int tracing_buffer_lock(void);
+
+/**
+ * @brief Unlock the tracing buffer of the current CPU.
+ *
+ * @param key Key returned by tracing_buffer_lock().
+ */
+void tracing_buffer_unlock(unsigned int key);
+
+/**
+ * @brief Get the CPU whose buffer the data was last claimed from.
+ *
+ * Only available with CONFIG_TRACING_PER_CPU_BUFFERS.
+ *
+ * @return CPU index.
+ */
+unsigned int tracing_buffer_get_cpu(void);
+
+/**
+ * @brief Read the oldest packet from a flight recorder buffer.
+ *
+ * Packets larger than @a size are discarded. Only available with
+ * CONFIG_TRACING_FLIGHT_RECORDER.
+ *
+ * @param cpu  Index of the buffer, 0 without CONFIG_TRACING_PER_CPU_BUFFERS.
+ * @param data Address of the output buffer.
+ * @param size Size of the output buffer (in bytes).
+ *
+ * @return Size of the packet (in bytes), 0 if the buffer is empty.
+ */
+uint32_t tracing_buffer_record_get(unsigned int cpu, uint8_t *data, uint32_t size);
+
 /**
  * @brief Get buffer from tracing command buffer.
  *
@@ -14,9 +14,15 @@
 extern "C" {
 #endif
 
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS)
+#define TRACING_LOCK()		{ unsigned int key; key = tracing_buffer_lock()
+
+#define TRACING_UNLOCK()	{ tracing_buffer_unlock(key); } }
+#else
 #define TRACING_LOCK()		{ int key; key = irq_lock()
 
 #define TRACING_UNLOCK()	{ irq_unlock(key); } }
+#endif
 
 /**
  * @brief Check tracing enabled or not.
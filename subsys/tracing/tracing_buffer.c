@@ -4,12 +4,193 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/irq.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/sys/ring_buffer.h>
+#include <tracing_buffer.h>
 
-static struct ring_buf tracing_ring_buf;
-static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
+/*
+ * With CONFIG_TRACING_PER_CPU_BUFFERS, each CPU only writes to its own ring
+ * buffer with its interrupts masked, and the tracing thread is the only
+ * reader. A ring buffer has a single producer and a single consumer, so no
+ * lock is shared between CPUs.
+ *
+ * With CONFIG_TRACING_FLIGHT_RECORDER, each packet is stored after its
+ * length, so that the oldest packets can be discarded to make room for a new
+ * one. Packets are then only read out by tracing_buffer_record_get(), with
+ * the buffer locked.
+ */
+#define TRACING_BUFFER_CPU_SIZE (CONFIG_TRACING_BUFFER_SIZE / TRACING_BUFFER_COUNT)
+#define RECORD_LEN_SIZE 2
+
+struct tracing_cpu_buffer {
+	struct ring_buf ring;
+#if defined(CONFIG_TRACING_FLIGHT_RECORDER)
+	/* Location of the length of the packet being written */
+	uint8_t *record_len[RECORD_LEN_SIZE];
+	uint8_t record_len_claimed;
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS)
+	/* Only contended by flight recorder dumps */
+	struct k_spinlock lock;
+	k_spinlock_key_t lock_key;
+#endif
+#endif
+	uint8_t data[TRACING_BUFFER_CPU_SIZE + 1];
+};
+
+static struct tracing_cpu_buffer tracing_buffers[TRACING_BUFFER_COUNT];
 static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
 
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS)
+/* Buffer being read by the tracing thread and how much of its data is left */
+static unsigned int get_cpu;
+static uint32_t get_pending;
+#endif
+
+/* Needs to be called with interrupts locked */
+static inline struct tracing_cpu_buffer *put_buffer(void)
+{
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS)
+	return &tracing_buffers[arch_curr_cpu()->id];
+#else
+	return &tracing_buffers[0];
+#endif
+}
+
+static inline struct tracing_cpu_buffer *get_buffer(void)
+{
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS)
+	return &tracing_buffers[get_cpu];
+#else
+	return &tracing_buffers[0];
+#endif
+}
+
+#if defined(CONFIG_TRACING_FLIGHT_RECORDER)
+/* Needs to be called when the buffer is locked */
+static bool record_drop_oldest(struct tracing_cpu_buffer *buf)
+{
+	uint8_t len[RECORD_LEN_SIZE];
+
+	if (ring_buf_get(&buf->ring, len, sizeof(len)) != sizeof(len)) {
+		return false;
+	}
+
+	(void)ring_buf_get(&buf->ring, NULL, len[0] | (len[1] << 8));
+
+	return true;
+}
+
+/* Claim space for a packet, discarding the oldest ones if the buffer is full */
+static uint32_t record_put_claim(struct tracing_cpu_buffer *buf, uint8_t **data, uint32_t size)
+{
+	uint32_t claimed;
+
+	while (buf->record_len_claimed < RECORD_LEN_SIZE) {
+		if (ring_buf_put_claim(&buf->ring, &buf->record_len[buf->record_len_claimed],
+				       1) == 1) {
+			buf->record_len_claimed++;
+		} else if (!record_drop_oldest(buf)) {
+			return 0;
+		}
+	}
+
+	while ((claimed = ring_buf_put_claim(&buf->ring, data, size)) == 0 && size > 0) {
+		if (!record_drop_oldest(buf)) {
+			break;
+		}
+	}
+
+	return claimed;
+}
+
+static int record_put_finish(struct tracing_cpu_buffer *buf, uint32_t size)
+{
+	int ret;
+
+	if (size == 0U || size > UINT16_MAX) {
+		/* Nothing written, the length is released too */
+		size = 0U;
+	} else {
+		*buf->record_len[0] = (uint8_t)size;
+		*buf->record_len[1] = (uint8_t)(size >> 8);
+		size += RECORD_LEN_SIZE;
+	}
+
+	ret = ring_buf_put_finish(&buf->ring, size);
+	buf->record_len_claimed = 0U;
+
+	return ret;
+}
+
+uint32_t tracing_buffer_record_get(unsigned int cpu, uint8_t *data, uint32_t size)
+{
+	struct tracing_cpu_buffer *buf = &tracing_buffers[cpu];
+	uint8_t len[RECORD_LEN_SIZE];
+	uint32_t record_len = 0U;
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS)
+	k_spinlock_key_t key = k_spin_lock(&buf->lock);
+#else
+	unsigned int key = irq_lock();
+#endif
+
+	/* Packets which do not fit in the output buffer are skipped */
+	while (ring_buf_get(&buf->ring, len, sizeof(len)) == sizeof(len)) {
+		record_len = len[0] | (len[1] << 8);
+
+		if (record_len <= size) {
+			(void)ring_buf_get(&buf->ring, data, record_len);
+			break;
+		}
+
+		(void)ring_buf_get(&buf->ring, NULL, record_len);
+		record_len = 0U;
+	}
+
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS)
+	k_spin_unlock(&buf->lock, key);
+#else
+	irq_unlock(key);
+#endif
+
+	return record_len;
+}
+#endif /* CONFIG_TRACING_FLIGHT_RECORDER */
+
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS)
+unsigned int tracing_buffer_lock(void)
+{
+	unsigned int key = arch_irq_lock();
+
+#if defined(CONFIG_TRACING_FLIGHT_RECORDER)
+	struct tracing_cpu_buffer *buf = put_buffer();
+
+	buf->lock_key = k_spin_lock(&buf->lock);
+#endif
+
+	return key;
+}
+
+void tracing_buffer_unlock(unsigned int key)
+{
+#if defined(CONFIG_TRACING_FLIGHT_RECORDER)
+	struct tracing_cpu_buffer *buf = put_buffer();
+
+	k_spin_unlock(&buf->lock, buf->lock_key);
+#endif
+
+	arch_irq_unlock(key);
+}
+
+unsigned int tracing_buffer_get_cpu(void)
+{
+	return get_cpu;
+}
+#endif /* CONFIG_TRACING_PER_CPU_BUFFERS */
+
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 {
 	*data = &tracing_cmd_buffer[0];
@@ -19,51 +200,128 @@ uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 
 uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_put_claim(&tracing_ring_buf, data, size);
+#if defined(CONFIG_TRACING_FLIGHT_RECORDER)
+	return record_put_claim(put_buffer(), data, size);
+#else
+	return ring_buf_put_claim(&put_buffer()->ring, data, size);
+#endif
 }
 
 int tracing_buffer_put_finish(uint32_t size)
 {
-	return ring_buf_put_finish(&tracing_ring_buf, size);
+	if (IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS)) {
+		/* The data is read by another CPU once the packet is committed */
+		barrier_dmem_fence_full();
+	}
+
+#if defined(CONFIG_TRACING_FLIGHT_RECORDER)
+	return record_put_finish(put_buffer(), size);
+#else
+	return ring_buf_put_finish(&put_buffer()->ring, size);
+#endif
 }
 
 uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
 {
-	return ring_buf_put(&tracing_ring_buf, data, size);
+	uint32_t total_size = 0U;
+	uint32_t claimed_size;
+	uint8_t *buf;
+
+	do {
+		claimed_size = tracing_buffer_put_claim(&buf, size - total_size);
+		memcpy(buf, data + total_size, claimed_size);
+		total_size += claimed_size;
+	} while (total_size < size && claimed_size > 0U);
+
+	(void)tracing_buffer_put_finish(total_size);
+
+	return total_size;
 }
 
 uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_get_claim(&tracing_ring_buf, data, size);
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS)
+	/*
+	 * Packets are committed whole, so the data available when a buffer
+	 * is picked ends on a packet boundary. It is read completely before
+	 * moving to the next buffer, so that packets are not interleaved.
+	 */
+	if (get_pending == 0U) {
+		for (unsigned int i = 1; i <= TRACING_BUFFER_COUNT; i++) {
+			unsigned int cpu = (get_cpu + i) % TRACING_BUFFER_COUNT;
+
+			get_pending = ring_buf_size_get(&tracing_buffers[cpu].ring);
+			if (get_pending > 0U) {
+				get_cpu = cpu;
+				break;
+			}
+		}
+
+		barrier_dmem_fence_full();
+	}
+
+	size = MIN(size, get_pending);
+#endif
+
+	return ring_buf_get_claim(&get_buffer()->ring, data, size);
 }
 
 int tracing_buffer_get_finish(uint32_t size)
 {
-	return ring_buf_get_finish(&tracing_ring_buf, size);
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS)
+	get_pending -= MIN(size, get_pending);
+#endif
+
+	return ring_buf_get_finish(&get_buffer()->ring, size);
 }
 
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
 {
-	return ring_buf_get(&tracing_ring_buf, data, size);
+	uint32_t total_size = 0U;
+	uint32_t claimed_size;
+	uint8_t *buf;
+
+	do {
+		claimed_size = tracing_buffer_get_claim(&buf, size - total_size);
+		memcpy(data + total_size, buf, claimed_size);
+		total_size += claimed_size;
+	} while (total_size < size && claimed_size > 0U);
+
+	(void)tracing_buffer_get_finish(total_size);
+
+	return total_size;
 }
 
 void tracing_buffer_init(void)
 {
-	ring_buf_init(&tracing_ring_buf,
-		      sizeof(tracing_buffer), tracing_buffer);
+	for (int i = 0; i < TRACING_BUFFER_COUNT; i++) {
+		ring_buf_init(&tracing_buffers[i].ring,
+			      sizeof(tracing_buffers[i].data), tracing_buffers[i].data);
+	}
 }
 
 bool tracing_buffer_is_empty(void)
 {
-	return ring_buf_is_empty(&tracing_ring_buf);
+	for (int i = 0; i < TRACING_BUFFER_COUNT; i++) {
+		if (!ring_buf_is_empty(&tracing_buffers[i].ring)) {
+			return false;
+		}
+	}
+
+	return true;
 }
 
 uint32_t tracing_buffer_capacity_get(void)
 {
-	return ring_buf_capacity_get(&tracing_ring_buf);
+	return ring_buf_capacity_get(&tracing_buffers[0].ring);
 }
 
 uint32_t tracing_buffer_space_get(void)
 {
-	return ring_buf_space_get(&tracing_ring_buf);
+	if (IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER)) {
+		/* The oldest packets are discarded to make room */
+		return ring_buf_capacity_get(&put_buffer()->ring) - RECORD_LEN_SIZE;
+	}
+
+	return ring_buf_space_get(&put_buffer()->ring);
 }
@@ -20,6 +20,10 @@
 
 #define TRACING_CMD_ENABLE  "enable"
 #define TRACING_CMD_DISABLE "disable"
+#define TRACING_CMD_DUMP    "dump"
+
+/* Start of a chunk of the data of one CPU, followed by its CPU and length */
+#define TRACING_CPU_CHUNK_MAGIC 0xC5
 
 #ifdef CONFIG_TRACING_BACKEND_UART
 #define TRACING_BACKEND_NAME "tracing_backend_uart"
@@ -54,10 +58,50 @@ static K_SEM_DEFINE(tracing_thread_sem, 0, 1);
 static K_THREAD_STACK_DEFINE(tracing_thread_stack,
 			CONFIG_TRACING_THREAD_STACK_SIZE);
 
+static void tracing_cpu_chunk_handle(unsigned int cpu, uint8_t *data, uint32_t length)
+{
+	if (IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS)) {
+		uint8_t hdr[] = { TRACING_CPU_CHUNK_MAGIC, cpu, length, length >> 8 };
+
+		tracing_buffer_handle(hdr, sizeof(hdr));
+	}
+
+	tracing_buffer_handle(data, length);
+}
+
+#ifdef CONFIG_TRACING_FLIGHT_RECORDER
+static atomic_t tracing_dump_requested;
+
+static void tracing_flight_recorder_dump(void)
+{
+	static uint8_t packet[CONFIG_TRACING_PACKET_MAX_SIZE];
+	uint32_t length;
+
+	for (unsigned int cpu = 0; cpu < TRACING_BUFFER_COUNT; cpu++) {
+		while ((length = tracing_buffer_record_get(cpu, packet, sizeof(packet))) > 0) {
+			tracing_cpu_chunk_handle(cpu, packet, length);
+		}
+	}
+}
+
+static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
+{
+	tracing_thread_tid = k_current_get();
+
+	while (true) {
+		k_sem_take(&tracing_thread_sem, K_FOREVER);
+
+		if (atomic_clear(&tracing_dump_requested)) {
+			tracing_flight_recorder_dump();
+		}
+	}
+}
+#else
 static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 {
 	uint8_t *transferring_buf;
 	uint32_t transferring_length, tracing_buffer_max_length;
+	unsigned int cpu = 0;
 
 	tracing_thread_tid = k_current_get();
 
@@ -71,12 +115,16 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 				tracing_buffer_get_claim(
 						&transferring_buf,
 						tracing_buffer_max_length);
-			tracing_buffer_handle(transferring_buf,
-					      transferring_length);
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+			cpu = tracing_buffer_get_cpu();
+#endif
+			tracing_cpu_chunk_handle(cpu, transferring_buf,
+						 transferring_length);
 			tracing_buffer_get_finish(transferring_length);
 		}
 	}
 }
+#endif
 
 static void tracing_thread_timer_expiry_fn(struct k_timer *timer)
 {
@@ -124,7 +172,8 @@ SYS_INIT(tracing_init, APPLICATION, 0);
 #ifdef CONFIG_TRACING_ASYNC
 void tracing_trigger_output(bool before_put_is_empty)
 {
-	if (before_put_is_empty) {
+	/* A flight recorder is only output when requested */
+	if (before_put_is_empty && !IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER)) {
 		k_timer_start(&tracing_thread_timer,
 			      K_MSEC(CONFIG_TRACING_THREAD_WAIT_THRESHOLD),
 			      K_NO_WAIT);
@@ -148,6 +197,14 @@ void tracing_cmd_handle(uint8_t *buf, uint32_t length)
 		tracing_set_state(TRACING_ENABLE);
 	} else if (strncmp(buf, TRACING_CMD_DISABLE, length) == 0) {
 		tracing_set_state(TRACING_DISABLE);
+#ifdef CONFIG_TRACING_FLIGHT_RECORDER
+		/* Stopping a flight recorder outputs what it recorded */
+		atomic_set(&tracing_dump_requested, 1);
+		k_sem_give(&tracing_thread_sem);
+	} else if (strncmp(buf, TRACING_CMD_DUMP, length) == 0) {
+		atomic_set(&tracing_dump_requested, 1);
+		k_sem_give(&tracing_thread_sem);
+#endif
 	}
 }
 
@@ -0,0 +1,90 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+
+LOG_MODULE_REGISTER(log_call_site_bench, LOG_LEVEL_DBG);
+
+/* Disabled log call site benchmark. Each call site is placed in its own
+ * function which is called N_CALLS times, the average number of cycles of
+ * a call to an empty function is subtracted from the result.
+ */
+
+#define N_CALLS 10000
+
+#define FILTER IF_ENABLED(CONFIG_LOG_CALL_SITE_FILTERING, ("call_site")) \
+	       IF_DISABLED(CONFIG_LOG_CALL_SITE_FILTERING, ("source"))
+
+static __noinline void empty_call(int i)
+{
+	ARG_UNUSED(i);
+	compiler_barrier();
+}
+
+static __noinline void dbg_call(int i)
+{
+	ARG_UNUSED(i);
+	LOG_DBG("disabled");
+}
+
+static __noinline void dbg_args_call(int i)
+{
+	LOG_DBG("disabled %d %d %d", i, i + 1, i + 2);
+}
+
+static uint64_t cycles_per_call(void (*call)(int i))
+{
+	timing_t start, end;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < N_CALLS; i++) {
+		call(i);
+	}
+
+	end = timing_counter_get();
+
+	return timing_cycles_get(&start, &end) / N_CALLS;
+}
+
+static void bench_call(void (*call)(int i), int args, uint64_t overhead)
+{
+	uint64_t cycles = cycles_per_call(call);
+
+	cycles = cycles > overhead ? cycles - overhead : 0U;
+
+	printk("log_call_site filter %s args %d cycles/call %u\n", FILTER, args,
+	       (uint32_t)cycles);
+}
+
+int main(void)
+{
+	uint64_t overhead;
+
+	log_filter_set(NULL, Z_LOG_LOCAL_DOMAIN_ID,
+		       log_source_id_get(STRINGIFY(log_call_site_bench)), LOG_LEVEL_INF);
+
+	timing_init();
+	timing_start();
+
+	/* Warm up the call sites, which register on their first call */
+	dbg_call(0);
+	dbg_args_call(0);
+
+	overhead = cycles_per_call(empty_call);
+	bench_call(dbg_call, 0, overhead);
+	bench_call(dbg_args_call, 3, overhead);
+
+	timing_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
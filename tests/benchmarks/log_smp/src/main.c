@@ -0,0 +1,130 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+
+LOG_MODULE_REGISTER(log_smp_bench, LOG_LEVEL_INF);
+
+/* Deferred logging SMP benchmark. For each number of cores, one thread pinned
+ * to each core logs N_MSGS messages, and the average number of cycles spent
+ * in LOG_INF is reported.
+ */
+
+#define N_MSGS 256
+#define STACK_SIZE 1024
+#define WORKER_PRIORITY 5
+
+K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread workers[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t worker_cycles[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t ready;
+static atomic_t dropped;
+
+static void null_process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+}
+
+static void null_dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	atomic_add(&dropped, cnt);
+}
+
+static void null_panic(const struct log_backend *const backend)
+{
+}
+
+static const struct log_backend_api null_backend_api = {
+	.process = null_process,
+	.dropped = null_dropped,
+	.panic = null_panic,
+};
+
+LOG_BACKEND_DEFINE(null_backend, null_backend_api, true);
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	int cores = POINTER_TO_INT(p2);
+	timing_t start, end;
+
+	ARG_UNUSED(p3);
+
+	/* Start logging on all the cores at the same time */
+	atomic_inc(&ready);
+	while (atomic_get(&ready) < cores) {
+	}
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < N_MSGS; i++) {
+		LOG_INF("core %d message %d", id, i);
+	}
+
+	end = timing_counter_get();
+
+	worker_cycles[id] = timing_cycles_get(&start, &end);
+}
+
+static void wait_processed(void)
+{
+	while (log_buffered_cnt() > 0) {
+		k_sleep(K_MSEC(10));
+	}
+}
+
+static void bench_cores(int cores)
+{
+	uint64_t cycles = 0U;
+
+	wait_processed();
+
+	atomic_set(&ready, 0);
+	atomic_set(&dropped, 0);
+
+	for (int i = 0; i < cores; i++) {
+		k_thread_create(&workers[i], worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i]), worker,
+				INT_TO_POINTER(i), INT_TO_POINTER(cores), NULL,
+				WORKER_PRIORITY, 0, K_FOREVER);
+		k_thread_cpu_pin(&workers[i], i);
+	}
+
+	for (int i = 0; i < cores; i++) {
+		k_thread_start(&workers[i]);
+	}
+
+	for (int i = 0; i < cores; i++) {
+		k_thread_join(&workers[i], K_FOREVER);
+		cycles += worker_cycles[i];
+	}
+
+	wait_processed();
+
+	printk("log_smp buffers %s cores %d cycles/msg %u dropped %u\n",
+	       IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS) ? "per_cpu" : "shared", cores,
+	       (uint32_t)(cycles / (cores * N_MSGS)), (uint32_t)atomic_get(&dropped));
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	for (int cores = 1; cores <= arch_num_cpus(); cores++) {
+		bench_cores(cores);
+	}
+
+	timing_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/lwm2m.h>
+
+#include "lwm2m_engine.h"
+#include "lwm2m_observation.h"
+#include "lwm2m_rw_senml_cbor.h"
+
+/* SenML CBOR encoder microbenchmark. A read of each object set is encoded
+ * N_RUNS times, once into a buffer that holds the whole payload and once as
+ * the last block of a block-wise response. The average number of cycles per
+ * read and the resulting number of payload bytes encoded per second are
+ * reported.
+ */
+
+#define N_RUNS 100
+#define PAYLOAD_SIZE 8192
+#define N_INSTANCES 16
+
+#define TEMP_OBJ_ID 3303
+#define HUMIDITY_OBJ_ID 3304
+
+struct object_set {
+	const char *name;
+	struct lwm2m_obj_path paths[2];
+	int path_count;
+};
+
+#define OBJ_PATH(id) { .obj_id = (id), .level = LWM2M_PATH_LEVEL_OBJECT }
+#define OBJ_INST_PATH(id, inst) \
+	{ .obj_id = (id), .obj_inst_id = (inst), .level = LWM2M_PATH_LEVEL_OBJECT_INST }
+
+static const struct object_set object_sets[] = {
+	{ "temp-1", { OBJ_INST_PATH(TEMP_OBJ_ID, 0) }, 1 },
+	{ "temp-16", { OBJ_PATH(TEMP_OBJ_ID) }, 1 },
+	{ "temp+hum-32", { OBJ_PATH(TEMP_OBJ_ID), OBJ_PATH(HUMIDITY_OBJ_ID) }, 2 },
+};
+
+static struct lwm2m_message msg;
+static uint8_t payload[PAYLOAD_SIZE];
+static uint8_t request_data[32];
+static struct coap_packet request;
+
+static int create_objects(void)
+{
+	int ret;
+
+	for (int i = 0; i < N_INSTANCES; i++) {
+		ret = lwm2m_create_object_inst(&LWM2M_OBJ(TEMP_OBJ_ID, i));
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = lwm2m_create_object_inst(&LWM2M_OBJ(HUMIDITY_OBJ_ID, i));
+		if (ret < 0) {
+			return ret;
+		}
+
+		(void)lwm2m_set_f64(&LWM2M_OBJ(TEMP_OBJ_ID, i, 5700), 20.5 + i);
+		(void)lwm2m_set_f64(&LWM2M_OBJ(HUMIDITY_OBJ_ID, i, 5700), 40.25 + i);
+	}
+
+	return 0;
+}
+
+/* Prepare a GET request, for the given block if block is not negative */
+static void request_init(int block)
+{
+	coap_packet_init(&request, request_data, sizeof(request_data), COAP_VERSION_1,
+			 COAP_TYPE_CON, 0, NULL, COAP_METHOD_GET, 1);
+
+	if (block >= 0) {
+		coap_append_option_int(&request, COAP_OPTION_BLOCK2,
+				       (block << 4) | lwm2m_default_block_size());
+	}
+}
+
+static int read_set(const struct object_set *set, bool is_request)
+{
+	struct lwm2m_obj_path_list path_buf[ARRAY_SIZE(set->paths)];
+	sys_slist_t path_list;
+	sys_slist_t free_list;
+
+	memset(&msg, 0, sizeof(msg));
+
+	msg.out.writer = &senml_cbor_writer;
+	msg.out.out_cpkt = &msg.cpkt;
+	msg.in.in_cpkt = is_request ? &request : NULL;
+
+	coap_packet_init(&msg.cpkt, payload, sizeof(payload), COAP_VERSION_1, COAP_TYPE_ACK, 0,
+			 NULL, COAP_RESPONSE_CODE_CONTENT, 1);
+
+	if (set->path_count == 1) {
+		msg.path = set->paths[0];
+		return do_read_op_senml_cbor(&msg);
+	}
+
+	lwm2m_engine_path_list_init(&path_list, &free_list, path_buf, ARRAY_SIZE(path_buf));
+
+	for (int i = 0; i < set->path_count; i++) {
+		lwm2m_engine_add_path_to_list(&path_list, &free_list, &set->paths[i]);
+	}
+
+	return do_composite_read_op_for_parsed_path_senml_cbor(&msg, &path_list);
+}
+
+static void bench_set(const struct object_set *set, const char *block, bool is_request)
+{
+	timing_t start, end;
+	uint64_t cycles, ns;
+	uint16_t len = 0U;
+	int ret = 0;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < N_RUNS; i++) {
+		ret = read_set(set, is_request);
+	}
+
+	end = timing_counter_get();
+
+	if (ret < 0) {
+		printk("Read of %s failed (%d)\n", set->name, ret);
+		return;
+	}
+
+	(void)coap_packet_get_payload(&msg.cpkt, &len);
+
+	cycles = timing_cycles_get(&start, &end) / N_RUNS;
+	ns = timing_cycles_to_ns(cycles);
+
+	printk("senml_cbor set %-12s block %-4s bytes %5u cycles %u bytes/s %u\n", set->name,
+	       block, len, (uint32_t)cycles,
+	       ns == 0 ? 0U : (uint32_t)(len * NSEC_PER_SEC / ns));
+}
+
+int main(void)
+{
+	uint16_t block_size = coap_block_size_to_bytes(lwm2m_default_block_size());
+	int size;
+
+	if (create_objects() < 0) {
+		printk("Cannot create objects\n");
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < ARRAY_SIZE(object_sets); i++) {
+		const struct object_set *set = &object_sets[i];
+
+		bench_set(set, "none", false);
+
+		/* The first block of a response tells the size of the block-wise payload */
+		request_init(-1);
+		if (read_set(set, true) < 0) {
+			printk("Read of %s failed\n", set->name);
+			continue;
+		}
+
+		size = coap_get_option_int(&msg.cpkt, COAP_OPTION_SIZE2);
+
+		/* The last block needs the whole payload to be encoded */
+		request_init(size > 0 ? (size - 1) / block_size : 0);
+		bench_set(set, "last", true);
+	}
+
+	timing_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,371 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/mqtt.h>
+
+/* MQTT publish throughput benchmark. N_MSGS messages are published for each
+ * QoS level, window and payload size to a broker stand-in listening on the
+ * loopback interface, and the number of messages and payload bytes
+ * acknowledged per second are reported.
+ */
+
+#define N_MSGS 500
+#define MAX_PAYLOAD 1024
+#define BROKER_PORT 1883
+#define POLL_TIMEOUT_MS 3000
+#define BROKER_STACK_SIZE 2048
+#define TOPIC "bench"
+
+/* MQTT control packet types, as seen by the broker stand-in */
+#define PKT_CONNECT    0x10
+#define PKT_CONNACK    0x20
+#define PKT_PUBLISH    0x30
+#define PKT_PUBACK     0x40
+#define PKT_PUBREC     0x50
+#define PKT_PUBREL     0x60
+#define PKT_PUBCOMP    0x70
+#define PKT_DISCONNECT 0xE0
+
+static const size_t payload_sizes[] = { 16, 256, MAX_PAYLOAD };
+static const int windows[] = { 1, 4, CONFIG_MQTT_PUBLISH_WINDOW };
+
+K_THREAD_STACK_DEFINE(broker_stack, BROKER_STACK_SIZE);
+static struct k_thread broker_thread_data;
+static int listen_sock;
+static uint8_t broker_buf[2 * MAX_PAYLOAD];
+
+static struct mqtt_client client;
+static struct sockaddr_in broker;
+static uint8_t rx_buffer[256];
+static uint8_t tx_buffer[256];
+static uint8_t payload[MAX_PAYLOAD];
+static bool connected;
+static uint32_t completed;
+
+static int broker_send_ack(int sock, uint8_t type, const uint8_t *message_id)
+{
+	uint8_t ack[] = { type, 2, message_id[0], message_id[1] };
+
+	if (zsock_send(sock, ack, sizeof(ack), 0) != sizeof(ack)) {
+		return -errno;
+	}
+
+	return 0;
+}
+
+/* Returns the length of the packet at the start of buf, 0 if incomplete */
+static size_t broker_packet_len(const uint8_t *buf, size_t len, size_t *header_len)
+{
+	uint32_t remaining = 0U;
+
+	for (size_t i = 1; i < len && i <= 4; i++) {
+		remaining |= (uint32_t)(buf[i] & 0x7F) << (7 * (i - 1));
+
+		if ((buf[i] & 0x80) == 0) {
+			*header_len = i + 1;
+
+			return *header_len + remaining <= len ? *header_len + remaining : 0;
+		}
+	}
+
+	return 0;
+}
+
+static int broker_handle(int sock, const uint8_t *pkt, size_t header_len)
+{
+	static const uint8_t connack[] = { PKT_CONNACK, 2, 0, 0 };
+	const uint8_t *var = pkt + header_len;
+	uint8_t qos = (pkt[0] >> 1) & 0x03;
+	uint16_t topic_len;
+
+	switch (pkt[0] & 0xF0) {
+	case PKT_CONNECT:
+		if (zsock_send(sock, connack, sizeof(connack), 0) != sizeof(connack)) {
+			return -errno;
+		}
+
+		return 0;
+
+	case PKT_PUBLISH:
+		if (qos == 0) {
+			return 0;
+		}
+
+		topic_len = (var[0] << 8) | var[1];
+
+		return broker_send_ack(sock, qos == 1 ? PKT_PUBACK : PKT_PUBREC,
+				       var + sizeof(topic_len) + topic_len);
+
+	case PKT_PUBREL:
+		return broker_send_ack(sock, PKT_PUBCOMP, var);
+
+	case PKT_DISCONNECT:
+		return -ECONNRESET;
+
+	default:
+		return 0;
+	}
+}
+
+static void broker_serve(int sock)
+{
+	size_t header_len;
+	size_t pkt_len;
+	size_t len = 0;
+	size_t offset;
+	ssize_t ret;
+
+	while (true) {
+		ret = zsock_recv(sock, broker_buf + len, sizeof(broker_buf) - len, 0);
+		if (ret <= 0) {
+			return;
+		}
+
+		len += ret;
+		offset = 0;
+
+		while ((pkt_len = broker_packet_len(broker_buf + offset, len - offset,
+						    &header_len)) > 0) {
+			if (broker_handle(sock, broker_buf + offset, header_len) < 0) {
+				return;
+			}
+
+			offset += pkt_len;
+		}
+
+		memmove(broker_buf, broker_buf + offset, len - offset);
+		len -= offset;
+	}
+}
+
+static void broker_thread(void *p1, void *p2, void *p3)
+{
+	int sock;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		sock = zsock_accept(listen_sock, NULL, NULL);
+		if (sock < 0) {
+			continue;
+		}
+
+		broker_serve(sock);
+		zsock_close(sock);
+	}
+}
+
+static int broker_start(void)
+{
+	int ret;
+
+	broker.sin_family = AF_INET;
+	broker.sin_port = htons(BROKER_PORT);
+	zsock_inet_pton(AF_INET, "127.0.0.1", &broker.sin_addr);
+
+	listen_sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (listen_sock < 0) {
+		return -errno;
+	}
+
+	ret = zsock_bind(listen_sock, (struct sockaddr *)&broker, sizeof(broker));
+	if (ret < 0) {
+		return -errno;
+	}
+
+	ret = zsock_listen(listen_sock, 1);
+	if (ret < 0) {
+		return -errno;
+	}
+
+	k_thread_create(&broker_thread_data, broker_stack, K_THREAD_STACK_SIZEOF(broker_stack),
+			broker_thread, NULL, NULL, NULL, CONFIG_MAIN_THREAD_PRIORITY, 0,
+			K_NO_WAIT);
+
+	return 0;
+}
+
+static void mqtt_evt_handler(struct mqtt_client *c, const struct mqtt_evt *evt)
+{
+	struct mqtt_pubrel_param pubrel;
+
+	switch (evt->type) {
+	case MQTT_EVT_CONNACK:
+		connected = evt->result == 0;
+		break;
+
+	case MQTT_EVT_PUBACK:
+	case MQTT_EVT_PUBCOMP:
+		completed++;
+		break;
+
+	case MQTT_EVT_PUBREC:
+		pubrel.message_id = evt->param.pubrec.message_id;
+		(void)mqtt_publish_qos2_release(c, &pubrel);
+		break;
+
+	default:
+		break;
+	}
+}
+
+static int client_input(void)
+{
+	struct zsock_pollfd fds = {
+		.fd = client.transport.tcp.sock,
+		.events = ZSOCK_POLLIN,
+	};
+	int ret;
+
+	ret = zsock_poll(&fds, 1, POLL_TIMEOUT_MS);
+	if (ret < 0) {
+		return -errno;
+	}
+
+	if (ret == 0) {
+		return -ETIMEDOUT;
+	}
+
+	return mqtt_input(&client);
+}
+
+static int client_connect(void)
+{
+	int ret;
+
+	mqtt_client_init(&client);
+
+	client.broker = &broker;
+	client.evt_cb = mqtt_evt_handler;
+	client.client_id.utf8 = (uint8_t *)"zephyr_bench";
+	client.client_id.size = strlen("zephyr_bench");
+	client.protocol_version = MQTT_VERSION_3_1_1;
+	client.transport.type = MQTT_TRANSPORT_NON_SECURE;
+	client.rx_buf = rx_buffer;
+	client.rx_buf_size = sizeof(rx_buffer);
+	client.tx_buf = tx_buffer;
+	client.tx_buf_size = sizeof(tx_buffer);
+
+	ret = mqtt_connect(&client);
+	if (ret < 0) {
+		return ret;
+	}
+
+	while (!connected) {
+		ret = client_input();
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/* Publish N_MSGS messages, with at most window of them not acknowledged */
+static int publish_all(enum mqtt_qos qos, int window, size_t len)
+{
+	struct mqtt_publish_param param = {
+		.message.topic.topic = MQTT_UTF8_LITERAL(TOPIC),
+		.message.topic.qos = qos,
+		.message.payload.data = payload,
+		.message.payload.len = len,
+	};
+	uint32_t sent = 0U;
+	int ret;
+
+	completed = 0U;
+
+	while (completed < N_MSGS) {
+		if (sent < N_MSGS && (int)(sent - completed) < window) {
+			param.message_id = sent + 1;
+
+			ret = mqtt_publish(&client, &param);
+			if (ret == 0) {
+				sent++;
+				continue;
+			}
+
+			if (ret != -EAGAIN) {
+				return ret;
+			}
+		}
+
+		ret = client_input();
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void bench_publish(enum mqtt_qos qos, int window, size_t len)
+{
+	timing_t start, end;
+	uint64_t ns;
+	int ret;
+
+	start = timing_counter_get();
+	ret = publish_all(qos, window, len);
+	end = timing_counter_get();
+
+	if (ret < 0) {
+		printk("Publishing failed (%d)\n", ret);
+		return;
+	}
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+	printk("mqtt_publish qos %d window %2d payload %4u msgs/s %u bytes/s %u\n", qos, window,
+	       (uint32_t)len, ns == 0 ? 0U : (uint32_t)(N_MSGS * NSEC_PER_SEC / ns),
+	       ns == 0 ? 0U : (uint32_t)(N_MSGS * len * NSEC_PER_SEC / ns));
+}
+
+int main(void)
+{
+	int ret;
+
+	memset(payload, 0xa5, sizeof(payload));
+
+	ret = broker_start();
+	if (ret < 0) {
+		printk("Cannot start broker stand-in (%d)\n", ret);
+		return 0;
+	}
+
+	ret = client_connect();
+	if (ret < 0) {
+		printk("Cannot connect (%d)\n", ret);
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	for (int qos = MQTT_QOS_1_AT_LEAST_ONCE; qos <= MQTT_QOS_2_EXACTLY_ONCE; qos++) {
+		for (int i = 0; i < ARRAY_SIZE(payload_sizes); i++) {
+			for (int j = 0; j < ARRAY_SIZE(windows); j++) {
+				bench_publish(qos, windows[j], payload_sizes[i]);
+			}
+		}
+	}
+
+	timing_stop();
+
+	(void)mqtt_disconnect(&client);
+
+	printk("fin\n");
+
+	return 0;
+}
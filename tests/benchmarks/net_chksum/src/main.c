@@ -0,0 +1,102 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+#include "net_private.h"
+
+/* Internet checksum microbenchmark. For each buffer size and start
+ * alignment calc_chksum() is called N_RUNS times and the average
+ * number of cycles per call is reported. The result is also used so
+ * that the compiler cannot drop the calls.
+ */
+
+#define N_RUNS 1000
+#define MAX_LEN 9000
+
+static const uint16_t lengths[] = { 20, 40, 64, 128, 576, 1280, 1500, MAX_LEN };
+
+static uint8_t data[MAX_LEN + 8] __aligned(16);
+static volatile uint16_t sink;
+
+static uint64_t cycles_per_call(const uint8_t *buf, size_t len)
+{
+	timing_t start, end;
+	uint16_t sum = 0U;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < N_RUNS; i++) {
+		sum = calc_chksum(sum, buf, len);
+	}
+
+	end = timing_counter_get();
+	sink = sum;
+
+	return timing_cycles_get(&start, &end) / N_RUNS;
+}
+
+static void bench_chksum(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(lengths); i++) {
+		for (int align = 0; align < 2; align++) {
+			uint64_t cycles = cycles_per_call(data + align, lengths[i]);
+			uint64_t ns = timing_cycles_to_ns(cycles);
+
+			printk("chksum len %4u align %d cycles %u MB/s %u\n",
+			       lengths[i], align, (uint32_t)cycles,
+			       ns == 0 ? 0U : (uint32_t)((uint64_t)lengths[i] * 1000U / ns));
+		}
+	}
+}
+
+static void bench_incremental(void)
+{
+	uint8_t new_addr[16];
+	uint8_t *old_addr = data + 8;
+	timing_t start, end;
+	uint64_t incr, full;
+	uint16_t sum = 0U;
+
+	for (int i = 0; i < sizeof(new_addr); i++) {
+		new_addr[i] = (uint8_t)(0xfd + i);
+	}
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < N_RUNS; i++) {
+		sum = net_chksum_update(sum, old_addr, new_addr, sizeof(new_addr));
+	}
+
+	end = timing_counter_get();
+	incr = timing_cycles_get(&start, &end) / N_RUNS;
+	sink = sum;
+
+	full = cycles_per_call(data, 1280);
+
+	printk("incremental cycles %u full cycles %u\n", (uint32_t)incr, (uint32_t)full);
+}
+
+int main(void)
+{
+	for (int i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)((i + 13) * 17);
+	}
+
+	timing_init();
+	timing_start();
+
+	bench_chksum();
+	bench_incremental();
+
+	timing_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_pkt_filter.h>
+
+/* Packet filter microbenchmark. A receive rule list of each size in
+ * rule_counts is installed and net_pkt_filter_recv_ok() is called N_RUNS
+ * times for a packet that no rule matches and for a packet that matches
+ * the last address rule. The average number of cycles per call is
+ * reported.
+ */
+
+#define N_RUNS 1000
+#define MAX_RULES 1000
+#define PKT_SIZE 100
+
+static const int rule_counts[] = { 10, 100, MAX_RULES };
+
+/* A rule with room for one test pointer */
+#define RULE_SIZE ROUND_UP(sizeof(struct npf_rule) + sizeof(struct npf_test *), \
+			   sizeof(void *))
+
+static uint8_t rule_storage[MAX_RULES][RULE_SIZE] __aligned(sizeof(void *));
+static struct net_eth_addr src_addrs[MAX_RULES];
+static struct npf_test_eth_addr src_tests[MAX_RULES];
+
+static NPF_SIZE_MIN(huge_pkt, NET_ETH_MTU * 2);
+
+static volatile bool sink;
+
+static void make_addr(struct net_eth_addr *addr, int idx)
+{
+	addr->addr[0] = 0x02;
+	addr->addr[1] = 0x00;
+	addr->addr[2] = 0x5e;
+	addr->addr[3] = 0x00;
+	addr->addr[4] = (uint8_t)(idx >> 8);
+	addr->addr[5] = (uint8_t)idx;
+}
+
+static void install_rules(int count)
+{
+	for (int i = 0; i < count; i++) {
+		struct npf_rule *rule = (struct npf_rule *)rule_storage[i];
+
+		make_addr(&src_addrs[i], i);
+
+		src_tests[i].test.fn = npf_eth_src_addr_match;
+		src_tests[i].addresses = &src_addrs[i];
+		src_tests[i].nb_addresses = 1;
+		memset(src_tests[i].mask.addr, 0xff, sizeof(src_tests[i].mask.addr));
+
+		rule->result = NET_DROP;
+		rule->nb_tests = 1;
+
+		/* Every tenth rule does not match on an address */
+		if (i % 10 == 5) {
+			rule->tests[0] = &huge_pkt.test;
+		} else {
+			rule->tests[0] = &src_tests[i].test;
+		}
+
+		npf_append_recv_rule(rule);
+	}
+
+	npf_append_recv_rule(&npf_default_ok);
+}
+
+static struct net_pkt *build_pkt(int src_idx)
+{
+	static const uint8_t payload[PKT_SIZE - sizeof(struct net_eth_hdr)];
+	struct net_eth_hdr hdr = {
+		.dst = { { 0x02, 0x00, 0x5e, 0x10, 0x00, 0x01 } },
+		.type = htons(NET_ETH_PTYPE_IP),
+	};
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(NULL, PKT_SIZE, AF_UNSPEC, 0, K_NO_WAIT);
+	if (pkt == NULL) {
+		return NULL;
+	}
+
+	make_addr(&hdr.src, src_idx);
+
+	if (net_pkt_write(pkt, &hdr, sizeof(hdr)) < 0 ||
+	    net_pkt_write(pkt, payload, sizeof(payload)) < 0) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	return pkt;
+}
+
+static void bench_pkt(int count, const char *match, struct net_pkt *pkt)
+{
+	timing_t start, end;
+	uint64_t cycles, ns;
+	bool ok = false;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < N_RUNS; i++) {
+		ok = net_pkt_filter_recv_ok(pkt);
+	}
+
+	end = timing_counter_get();
+	sink = ok;
+
+	cycles = timing_cycles_get(&start, &end) / N_RUNS;
+	ns = timing_cycles_to_ns(cycles);
+
+	printk("npf rules %4d match %s cycles %u pps %u\n", count, match,
+	       (uint32_t)cycles, ns == 0 ? 0U : (uint32_t)(NSEC_PER_SEC / ns));
+}
+
+static void bench_rules(int count)
+{
+	struct net_pkt *none, *last;
+
+	install_rules(count);
+
+	none = build_pkt(0xffff);
+	last = build_pkt(count - 1);
+	if (none == NULL || last == NULL) {
+		printk("Cannot allocate packets\n");
+		goto out;
+	}
+
+	if (!net_pkt_filter_recv_ok(none) || net_pkt_filter_recv_ok(last)) {
+		printk("Unexpected filter result\n");
+		goto out;
+	}
+
+	bench_pkt(count, "none", none);
+	bench_pkt(count, "last", last);
+
+out:
+	if (none != NULL) {
+		net_pkt_unref(none);
+	}
+
+	if (last != NULL) {
+		net_pkt_unref(last);
+	}
+
+	npf_remove_all_recv_rules();
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < ARRAY_SIZE(rule_counts); i++) {
+		bench_rules(rule_counts[i]);
+	}
+
+	timing_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/drivers/serial/uart_emul.h>
+#include <zephyr/shell/shell.h>
+
+/* Shell UART output benchmark. A command which prints N_LINES lines is
+ * executed and the time spent in the command handler and the time until the
+ * last byte is transmitted are reported. The emulated UART consumes the data
+ * at the rate of a 115200 baud line.
+ */
+
+#define N_LINES 32
+#define BYTE_TIME_US 87
+#define IDLE_TIME_US 50000
+
+#if defined(CONFIG_SHELL_BACKEND_SERIAL_API_ASYNC)
+#define MODE_NAME (CONFIG_SHELL_BACKEND_SERIAL_ASYNC_TX_BUFFER_SIZE > 0 ? \
+		   "async_buffered" : "async")
+#elif defined(CONFIG_SHELL_BACKEND_SERIAL_API_INTERRUPT_DRIVEN)
+#define MODE_NAME "interrupt_driven"
+#else
+#define MODE_NAME "polling"
+#endif
+
+static const struct device *const uart_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_shell_uart));
+static K_SEM_DEFINE(cmd_done, 0, 1);
+static uint64_t cmd_start_us;
+static uint64_t cmd_end_us;
+static volatile uint64_t line_end_us;
+static volatile uint32_t tx_bytes;
+
+static void tx_data_ready(const struct device *dev, size_t size, void *user_data)
+{
+	uint8_t buf[64];
+	uint32_t len;
+	uint64_t now_us;
+
+	ARG_UNUSED(user_data);
+
+	while ((len = uart_emul_get_tx_data(dev, buf, sizeof(buf))) > 0) {
+		now_us = k_ticks_to_us_ceil64(k_uptime_ticks());
+		line_end_us = MAX(line_end_us, now_us) + (uint64_t)len * BYTE_TIME_US;
+		tx_bytes += len;
+
+		/* Data is consumed at the line rate. */
+		k_sleep(K_TIMEOUT_ABS_US(line_end_us));
+	}
+}
+
+static int cmd_bench_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	cmd_start_us = k_ticks_to_us_floor64(k_uptime_ticks());
+	tx_bytes = 0;
+
+	for (int i = 0; i < N_LINES; i++) {
+		shell_print(sh, "line %02d: 0123456789abcdefghijklmnopqrstuvwxyz", i);
+	}
+
+	cmd_end_us = k_ticks_to_us_floor64(k_uptime_ticks());
+	k_sem_give(&cmd_done);
+
+	return 0;
+}
+
+SHELL_CMD_REGISTER(bench_dump, NULL, "Print lines for the benchmark", cmd_bench_dump);
+
+int main(void)
+{
+	static const uint8_t cmd[] = "bench_dump\n";
+	uint64_t now_us;
+
+	uart_emul_callback_tx_data_ready_set(uart_dev, tx_data_ready, NULL);
+
+	/* Let the shell print the initial prompt. */
+	k_msleep(100);
+
+	uart_emul_put_rx_data(uart_dev, cmd, sizeof(cmd) - 1);
+	k_sem_take(&cmd_done, K_FOREVER);
+
+	/* Wait until the output is transmitted and the line is idle. */
+	do {
+		k_usleep(IDLE_TIME_US);
+		now_us = k_ticks_to_us_floor64(k_uptime_ticks());
+	} while ((now_us - line_end_us) < IDLE_TIME_US);
+
+	/* Stop consuming data so that the result line is not counted. */
+	uart_emul_callback_tx_data_ready_set(uart_dev, NULL, NULL);
+
+	printk("shell_uart mode %s bytes %u command_us %llu transmit_us %llu\n", MODE_NAME,
+	       tx_bytes, cmd_end_us - cmd_start_us, line_end_us - cmd_start_us);
+	printk("fin\n");
+
+	return 0;
+}
@@ -57,6 +57,38 @@ static void unpack(const char *desc, struct out_buffer *buf,
 		      compare_buf, buf->buf);
 }
 
+static int layout_package(void *packaged, size_t len, uint32_t flags, uint32_t layout,
+			  const char *fmt, ...)
+{
+	va_list ap;
+	int rv;
+
+	va_start(ap, fmt);
+	rv = cbvprintf_package_layout(packaged, len, flags, layout, fmt, ap);
+	va_end(ap);
+
+	return rv;
+}
+
+/* Package created using precomputed layout must be the same as the runtime one. */
+#define TEST_LAYOUT_PACKAGING(rt_pkg, len, fmt, ...) do { \
+	_Pragma("GCC diagnostic push") \
+	_Pragma("GCC diagnostic ignored \"-Wpointer-arith\"") \
+	uint32_t layout = CBPRINTF_PACKAGE_LAYOUT(fmt, __VA_ARGS__); \
+	_Pragma("GCC diagnostic pop") \
+	if (layout == CBPRINTF_PACKAGE_LAYOUT_NONE) { \
+		break; \
+	} \
+	int lt_len = layout_package(NULL, ALIGN_OFFSET, 0, layout, fmt, __VA_ARGS__); \
+	zassert_equal(lt_len, len, "layout length %d, expected %d", lt_len, len); \
+	uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) \
+			lt_package[len + ALIGN_OFFSET]; \
+	memset(lt_package, 0, len + ALIGN_OFFSET); \
+	lt_len = layout_package(&lt_package[ALIGN_OFFSET], len, 0, layout, fmt, __VA_ARGS__); \
+	zassert_equal(lt_len, len, "layout length %d, expected %d", lt_len, len); \
+	zassert_mem_equal(&lt_package[ALIGN_OFFSET], rt_pkg, len); \
+} while (0)
+
 #define TEST_PACKAGING(flags, fmt, ...) do { \
 	int must_runtime = CBPRINTF_MUST_RUNTIME_PACKAGE(flags, fmt, __VA_ARGS__); \
 	zassert_equal(must_runtime, !Z_C_GENERIC); \
@@ -80,6 +112,7 @@ static void unpack(const char *desc, struct out_buffer *buf,
 		      rc, len); \
 	dump("runtime", pkg, len); \
 	unpack("runtime", &rt_buf, pkg, len); \
+	TEST_LAYOUT_PACKAGING(pkg, len, fmt, __VA_ARGS__); \
 	struct out_buffer st_buf = { \
 		.buf = static_buf, .idx = 0, .size = sizeof(static_buf) \
 	}; \
@@ -138,4 +138,15 @@ ZTEST(hash_function, test_sys_hash32)
 	zassert_ok(kolmogorov_smirnov_test(buckets, ARRAY_SIZE(buckets)));
 }
 
+ZTEST(hash_function, test_sys_hash32_fnv1a)
+{
+	/* Test vectors of the FNV reference implementation */
+	zassert_equal(sys_hash32_fnv1a("", 0), 0x811c9dc5);
+	zassert_equal(sys_hash32_fnv1a("a", 1), 0xe40c292c);
+	zassert_equal(sys_hash32_fnv1a("foobar", 6), 0xbf9cf968);
+
+	zassert_equal(sys_hash32_fnv1a_update(sys_hash32_fnv1a("foo", 3), "bar", 3),
+		      sys_hash32_fnv1a("foobar", 6));
+}
+
 ZTEST_SUITE(hash_function, NULL, NULL, NULL, NULL, NULL);
@@ -553,6 +553,46 @@ ZTEST(log_buffer, test_item_alloc_commit)
 	item_alloc_commit(false);
 }
 
+void item_alloc_discard(bool overwrite)
+{
+	struct mpsc_pbuf_buffer buffer;
+	struct test_data_var *packet;
+	uint32_t len = 5;
+
+	init(&buffer, 16, overwrite);
+
+	for (int i = 0; i < 64; i++) {
+		/* Discarded packet is not claimed and its space is reclaimed. */
+		packet = (struct test_data_var *)mpsc_pbuf_alloc(&buffer, len,
+								 K_NO_WAIT);
+		zassert_true(packet != NULL);
+		packet->hdr.len = len;
+		mpsc_pbuf_discard(&buffer, (union mpsc_pbuf_generic *)packet);
+
+		packet = (struct test_data_var *)mpsc_pbuf_alloc(&buffer, len,
+								 K_NO_WAIT);
+		zassert_true(packet != NULL);
+		packet->hdr.len = len;
+		packet->hdr.data = i;
+		mpsc_pbuf_commit(&buffer, (union mpsc_pbuf_generic *)packet);
+
+		packet = (struct test_data_var *)mpsc_pbuf_claim(&buffer);
+		zassert_true(packet != NULL);
+		zassert_equal(packet->hdr.data, i);
+		mpsc_pbuf_free(&buffer, (union mpsc_pbuf_generic *)packet);
+
+		zassert_is_null(mpsc_pbuf_claim(&buffer));
+	}
+
+	zassert_equal(drop_cnt, 0);
+}
+
+ZTEST(log_buffer, test_item_alloc_discard)
+{
+	item_alloc_discard(true);
+	item_alloc_discard(false);
+}
+
 void item_max_alloc(bool overwrite)
 {
 	struct mpsc_pbuf_buffer buffer;
@@ -34,6 +34,10 @@ LOG_MODULE_REGISTER(net_ipv4_test, CONFIG_NET_IPV4_LOG_LEVEL);
 #define WAIT_TIME K_SECONDS(2)
 #define ALLOC_TIMEOUT K_MSEC(500)
 
+/* Fragment length and protocol of the packets fed directly to the reassembly */
+#define FRAG_TEST_LEN 64
+#define FRAG_TEST_PROTO 0xfd
+
 /* Dummy network addresses, 192.168.8.1 and 192.168.8.2 */
 static struct in_addr my_addr1 = { { { 0xc0, 0xa8, 0x08, 0x01 } } };
 static struct in_addr my_addr2 = { { { 0xc0, 0xa8, 0x08, 0x02 } } };
@@ -197,6 +201,59 @@ static void reassembly_foreach_cb(struct net_ipv4_reassembly *reassembly, void *
 	++*packets;
 }
 
+/* Callback function for saving the last pending reassembly */
+static void reassembly_save_cb(struct net_ipv4_reassembly *reassembly, void *data)
+{
+	struct net_ipv4_reassembly *saved = (struct net_ipv4_reassembly *)data;
+
+	saved->id = reassembly->id;
+	saved->count = reassembly->count;
+	saved->received = reassembly->received;
+}
+
+/* Feed a fragment of test_tmp_buf data directly to the reassembly */
+static enum net_verdict recv_fragment(uint16_t id, uint16_t offset, uint16_t len, bool more)
+{
+	struct net_ipv4_hdr hdr = {
+		.vhl = 0x45,
+		.ttl = 0x80,
+		.proto = FRAG_TEST_PROTO,
+	};
+	uint16_t flags = (offset / 8) | (more ? NET_IPV4_MORE_FRAG_MASK : 0);
+	enum net_verdict verdict;
+	struct net_pkt *pkt;
+	int ret;
+
+	hdr.len = htons(sizeof(hdr) + len);
+	*(uint16_t *)&hdr.id = htons(id);
+	*(uint16_t *)&hdr.offset = htons(flags);
+	net_ipv4_addr_copy_raw(hdr.src, (uint8_t *)&my_addr2);
+	net_ipv4_addr_copy_raw(hdr.dst, (uint8_t *)&my_addr1);
+
+	pkt = net_pkt_alloc_with_buffer(iface1, sizeof(hdr) + len, AF_INET, 0, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Packet creation failure");
+
+	net_pkt_set_ip_hdr_len(pkt, sizeof(hdr));
+
+	ret = net_pkt_write(pkt, &hdr, sizeof(hdr));
+	zassert_equal(ret, 0, "IPv4 header append failed");
+
+	ret = net_pkt_write(pkt, test_tmp_buf, len);
+	zassert_equal(ret, 0, "IPv4 data append failed");
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	NET_IPV4_HDR(pkt)->chksum = net_calc_chksum_ipv4(pkt);
+	net_pkt_set_overwrite(pkt, false);
+
+	verdict = net_ipv4_handle_fragment_hdr(pkt, NET_IPV4_HDR(pkt));
+	if (verdict == NET_DROP) {
+		net_pkt_unref(pkt);
+	}
+
+	return verdict;
+}
+
 /* Checks all IPv4 headers against expected values */
 static void check_ipv4_fragment_header(struct net_pkt *pkt, const uint8_t *orig_hdr, uint16_t id,
 				       uint16_t current_length, bool final)
@@ -802,6 +859,80 @@ ZTEST(net_ipv4_fragment, test_fragment_timeout)
 		      "Packet size mismatch");
 }
 
+/* Test that fragments received in reverse order are reassembled */
+ZTEST(net_ipv4_fragment, test_reassembly_out_of_order)
+{
+	struct net_ipv4_reassembly saved = { 0 };
+	uint8_t packets;
+	int i;
+
+	for (i = 5; i > 0; i--) {
+		zassert_equal(recv_fragment(0x5678, i * FRAG_TEST_LEN, FRAG_TEST_LEN, i != 5),
+			      NET_OK, "Fragment %d not accepted", i);
+	}
+
+	packets = 0;
+	net_ipv4_frag_foreach(reassembly_foreach_cb, &packets);
+	zassert_equal(packets, 1, "Expected fragments to be pending reassembly");
+
+	net_ipv4_frag_foreach(reassembly_save_cb, &saved);
+	zassert_equal(saved.count, 5, "Expected 5 pending fragments");
+	zassert_equal(saved.received, 5 * FRAG_TEST_LEN, "Pending bytes mismatch");
+
+	zassert_equal(recv_fragment(0x5678, 0, FRAG_TEST_LEN, true), NET_OK,
+		      "First fragment not accepted");
+
+	packets = 0;
+	net_ipv4_frag_foreach(reassembly_foreach_cb, &packets);
+	zassert_equal(packets, 0, "Expected packet to be reassembled");
+}
+
+/* Test that an overlapping fragment drops the whole packet */
+ZTEST(net_ipv4_fragment, test_reassembly_overlap)
+{
+	uint8_t packets;
+
+	zassert_equal(recv_fragment(0x6789, 0, FRAG_TEST_LEN, true), NET_OK,
+		      "First fragment not accepted");
+	zassert_equal(recv_fragment(0x6789, FRAG_TEST_LEN / 2, FRAG_TEST_LEN, true), NET_DROP,
+		      "Overlapping fragment accepted");
+
+	packets = 0;
+	net_ipv4_frag_foreach(reassembly_foreach_cb, &packets);
+	zassert_equal(packets, 0, "Expected reassembly to be dropped");
+}
+
+/* Test that a new packet replaces the least recently used reassembly when all slots are used */
+ZTEST(net_ipv4_fragment, test_reassembly_lru)
+{
+	struct net_ipv4_reassembly saved = { 0 };
+	uint8_t packets;
+	int i;
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT + 1; i++) {
+		zassert_equal(recv_fragment(0x7000 + i, FRAG_TEST_LEN, FRAG_TEST_LEN, true),
+			      NET_OK, "Fragment of packet %d not accepted", i);
+	}
+
+	packets = 0;
+	net_ipv4_frag_foreach(reassembly_foreach_cb, &packets);
+	zassert_equal(packets, CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT,
+		      "Expected all the slots to be used");
+
+	net_ipv4_frag_foreach(reassembly_save_cb, &saved);
+	zassert_not_equal(saved.id, 0x7000, "Expected oldest packet to be dropped");
+
+	/* Duplicated fragments drop the pending packets */
+	for (i = 1; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT + 1; i++) {
+		zassert_equal(recv_fragment(0x7000 + i, FRAG_TEST_LEN, FRAG_TEST_LEN, true),
+			      NET_DROP, "Duplicated fragment of packet %d accepted", i);
+	}
+
+	packets = 0;
+	net_ipv4_frag_foreach(reassembly_foreach_cb, &packets);
+	zassert_equal(packets, 0, "Expected reassemblies to be dropped");
+}
+
 /* Test inserting large packet with do not fragment bit set */
 ZTEST(net_ipv4_fragment, test_do_not_fragment)
 {
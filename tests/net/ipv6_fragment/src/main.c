@@ -2192,6 +2192,104 @@ ZTEST(net_ipv6_fragment, test_send_ipv6_fragment_udp_loopback)
 	}
 }
 
+/* Fragment lengths of the packets fed directly to the reassembly */
+#define FRAG_TEST_LEN 64
+#define FRAG_BUDGET_LEN 512
+
+static uint8_t frag_test_buf[FRAG_BUDGET_LEN];
+
+/* Callback function for counting the pending reassemblies */
+static void reassembly_foreach_cb(struct net_ipv6_reassembly *reassembly, void *data)
+{
+	uint8_t *packets = (uint8_t *)data;
+	++*packets;
+}
+
+/* Callback function for saving the pending reassembly with the given id */
+static void reassembly_save_cb(struct net_ipv6_reassembly *reassembly, void *data)
+{
+	struct net_ipv6_reassembly *saved = (struct net_ipv6_reassembly *)data;
+
+	if (reassembly->id == saved->id) {
+		saved->count = reassembly->count;
+		saved->received = reassembly->received;
+	}
+}
+
+static uint8_t reassembly_pending(void)
+{
+	uint8_t packets = 0;
+
+	net_ipv6_frag_foreach(reassembly_foreach_cb, &packets);
+
+	return packets;
+}
+
+static bool reassembly_pending_id(uint32_t id)
+{
+	struct net_ipv6_reassembly saved = { .id = id };
+
+	net_ipv6_frag_foreach(reassembly_save_cb, &saved);
+
+	return saved.count > 0;
+}
+
+/* Feed a fragment of frag_test_buf data directly to the reassembly. Nothing
+ * follows the fragment header so a reassembled packet is silently dropped.
+ */
+static enum net_verdict recv_fragment(uint32_t id, uint16_t offset, uint16_t len, bool more)
+{
+	struct net_ipv6_hdr hdr = {
+		.vtc = 0x60,
+		.nexthdr = NET_IPV6_NEXTHDR_FRAG,
+		.hop_limit = 0x40,
+	};
+	struct net_ipv6_frag_hdr frag_hdr = {
+		.nexthdr = NET_IPV6_NEXTHDR_NONE,
+	};
+	enum net_verdict verdict;
+	struct net_pkt *pkt;
+	int ret;
+
+	hdr.len = htons(sizeof(frag_hdr) + len);
+	net_ipv6_addr_copy_raw(hdr.src, (uint8_t *)&my_addr2);
+	net_ipv6_addr_copy_raw(hdr.dst, (uint8_t *)&my_addr1);
+	frag_hdr.offset = htons(offset | (more ? 1 : 0));
+	frag_hdr.id = htonl(id);
+
+	pkt = net_pkt_alloc_with_buffer(iface1, sizeof(hdr) + sizeof(frag_hdr) + len,
+					AF_UNSPEC, 0, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Packet creation failure");
+
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_ip_hdr_len(pkt, sizeof(hdr));
+	net_pkt_set_ipv6_hdr_prev(pkt, offsetof(struct net_ipv6_hdr, nexthdr));
+	net_pkt_set_ipv6_fragment_start(pkt, sizeof(hdr));
+
+	ret = net_pkt_write(pkt, &hdr, sizeof(hdr));
+	zassert_equal(ret, 0, "IPv6 header append failed");
+
+	ret = net_pkt_write(pkt, &frag_hdr, sizeof(frag_hdr));
+	zassert_equal(ret, 0, "IPv6 fragment header append failed");
+
+	ret = net_pkt_write(pkt, frag_test_buf, len);
+	zassert_equal(ret, 0, "IPv6 data append failed");
+
+	/* The next header field of the fragment header is already read */
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	ret = net_pkt_skip(pkt, sizeof(hdr) + 1);
+	zassert_equal(ret, 0, "IPv6 fragment header skip failed");
+
+	verdict = net_ipv6_handle_fragment_hdr(pkt, &hdr, NET_IPV6_NEXTHDR_FRAG);
+	if (verdict == NET_DROP) {
+		net_pkt_unref(pkt);
+	}
+
+	return verdict;
+}
+
 static uint8_t ipv6_reass_frag1[] = {
 0x60, 0x00, 0x00, 0x00, 0x04, 0xd8, 0x2c, 0x40,
 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
@@ -2394,4 +2492,101 @@ ZTEST(net_ipv6_fragment, test_recv_ipv6_fragment)
 	net_icmp_cleanup_ctx(&ctx);
 }
 
+/* Test that fragments received in reverse order are reassembled */
+ZTEST(net_ipv6_fragment, test_reassembly_out_of_order)
+{
+	struct net_ipv6_reassembly saved = { .id = 0x5678 };
+	int i;
+
+	for (i = 5; i > 0; i--) {
+		zassert_equal(recv_fragment(0x5678, i * FRAG_TEST_LEN, FRAG_TEST_LEN, i != 5),
+			      NET_OK, "Fragment %d not accepted", i);
+	}
+
+	zassert_equal(reassembly_pending(), 1, "Expected fragments to be pending reassembly");
+
+	net_ipv6_frag_foreach(reassembly_save_cb, &saved);
+	zassert_equal(saved.count, 5, "Expected 5 pending fragments");
+	zassert_equal(saved.received, 5 * FRAG_TEST_LEN, "Pending bytes mismatch");
+
+	zassert_equal(recv_fragment(0x5678, 0, FRAG_TEST_LEN, true), NET_OK,
+		      "First fragment not accepted");
+
+	zassert_equal(reassembly_pending(), 0, "Expected packet to be reassembled");
+}
+
+/* Test that overlapping and duplicated fragments drop the whole packet */
+ZTEST(net_ipv6_fragment, test_reassembly_overlap)
+{
+	zassert_equal(recv_fragment(0x6789, 0, FRAG_TEST_LEN, true), NET_OK,
+		      "First fragment not accepted");
+	zassert_equal(recv_fragment(0x6789, FRAG_TEST_LEN / 2, FRAG_TEST_LEN, true), NET_DROP,
+		      "Overlapping fragment accepted");
+
+	zassert_equal(reassembly_pending(), 0, "Expected reassembly to be dropped");
+
+	zassert_equal(recv_fragment(0x678a, 2 * FRAG_TEST_LEN, FRAG_TEST_LEN, false), NET_OK,
+		      "Last fragment not accepted");
+	zassert_equal(recv_fragment(0x678a, FRAG_TEST_LEN, FRAG_TEST_LEN, true), NET_OK,
+		      "Middle fragment not accepted");
+	zassert_equal(recv_fragment(0x678a, FRAG_TEST_LEN, FRAG_TEST_LEN, true), NET_DROP,
+		      "Duplicated fragment accepted");
+
+	zassert_equal(reassembly_pending(), 0, "Expected reassembly to be dropped");
+}
+
+/* Test that a new packet replaces the least recently used reassembly when all slots are used */
+ZTEST(net_ipv6_fragment, test_reassembly_lru)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT + 1; i++) {
+		zassert_equal(recv_fragment(0x7000 + i, FRAG_TEST_LEN, FRAG_TEST_LEN, true),
+			      NET_OK, "Fragment of packet %d not accepted", i);
+	}
+
+	zassert_equal(reassembly_pending(), CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT,
+		      "Expected all the slots to be used");
+	zassert_false(reassembly_pending_id(0x7000), "Expected oldest packet to be dropped");
+	zassert_true(reassembly_pending_id(0x7000 + CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT),
+		     "Expected newest packet to be pending");
+
+	/* Duplicated fragments drop the pending packets */
+	for (i = 1; i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT + 1; i++) {
+		zassert_equal(recv_fragment(0x7000 + i, FRAG_TEST_LEN, FRAG_TEST_LEN, true),
+			      NET_DROP, "Duplicated fragment of packet %d accepted", i);
+	}
+
+	zassert_equal(reassembly_pending(), 0, "Expected reassemblies to be dropped");
+}
+
+/* Test that the least recently used reassembly is dropped to stay under the byte budget */
+ZTEST(net_ipv6_fragment, test_reassembly_budget)
+{
+	int fit = CONFIG_NET_IPV6_FRAGMENT_MAX_BYTES / FRAG_BUDGET_LEN;
+	int i;
+
+	/* The budget must be reached before all the slots are used */
+	if (fit == 0 || fit >= CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT) {
+		ztest_test_skip();
+	}
+
+	for (i = 0; i < fit + 1; i++) {
+		zassert_equal(recv_fragment(0x8000 + i, FRAG_BUDGET_LEN, FRAG_BUDGET_LEN, true),
+			      NET_OK, "Fragment of packet %d not accepted", i);
+	}
+
+	zassert_equal(reassembly_pending(), fit, "Expected reassemblies within the budget");
+	zassert_false(reassembly_pending_id(0x8000), "Expected oldest packet to be dropped");
+	zassert_true(reassembly_pending_id(0x8000 + fit), "Expected newest packet to be pending");
+
+	/* Duplicated fragments drop the pending packets */
+	for (i = 1; i < fit + 1; i++) {
+		zassert_equal(recv_fragment(0x8000 + i, FRAG_BUDGET_LEN, FRAG_BUDGET_LEN, true),
+			      NET_DROP, "Duplicated fragment of packet %d accepted", i);
+	}
+
+	zassert_equal(reassembly_pending(), 0, "Expected reassemblies to be dropped");
+}
+
 ZTEST_SUITE(net_ipv6_fragment, NULL, test_setup, NULL, NULL, NULL);
@@ -0,0 +1,229 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap_service.h>
+
+#define SERVICE_PORT 5683
+#define RECV_TIMEOUT_MS 3000
+
+static const uint8_t payload[] = "update";
+
+static int obs_get(struct coap_resource *resource, struct coap_packet *request,
+		   struct sockaddr *addr, socklen_t addr_len)
+{
+	ARG_UNUSED(addr_len);
+
+	if (coap_resource_parse_observe(resource, request, addr) != 0) {
+		return COAP_RESPONSE_CODE_BAD_REQUEST;
+	}
+
+	return COAP_RESPONSE_CODE_CONTENT;
+}
+
+static const uint16_t service_port = SERVICE_PORT;
+COAP_SERVICE_DEFINE(observe_service, "127.0.0.1", &service_port, 0);
+
+static const char * const obs_path[] = { "obs", NULL };
+COAP_RESOURCE_DEFINE(obs, observe_service, {
+	.path = obs_path,
+	.get = obs_get,
+});
+
+static int client_open(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVICE_PORT),
+	};
+	struct timeval timeout = {
+		.tv_sec = RECV_TIMEOUT_MS / 1000,
+	};
+	int sock;
+
+	zassert_equal(zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr), 1);
+
+	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(sock >= 0, "Failed to create socket (%d)", errno);
+
+	zassert_ok(zsock_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)));
+	zassert_ok(zsock_connect(sock, (struct sockaddr *)&addr, sizeof(addr)));
+
+	return sock;
+}
+
+static int client_recv(int sock, struct coap_packet *cpkt, uint8_t *buf, size_t len)
+{
+	ssize_t received;
+
+	received = zsock_recv(sock, buf, len, 0);
+	if (received < 0) {
+		return -errno;
+	}
+
+	return coap_packet_parse(cpkt, buf, received, NULL, 0);
+}
+
+static void client_send_empty(int sock, uint8_t type, uint16_t id)
+{
+	uint8_t buf[4];
+	struct coap_packet cpkt;
+
+	zassert_ok(coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1, type, 0, NULL,
+				    COAP_CODE_EMPTY, id));
+	zassert_equal(zsock_send(sock, cpkt.data, cpkt.offset, 0), cpkt.offset);
+}
+
+static void client_observe(int sock, const uint8_t *token, uint8_t tkl)
+{
+	uint8_t buf[64];
+	struct coap_packet cpkt;
+
+	zassert_ok(coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_CON, tkl,
+				    token, COAP_METHOD_GET, coap_next_id()));
+	zassert_ok(coap_append_option_int(&cpkt, COAP_OPTION_OBSERVE, 0));
+	zassert_ok(coap_packet_set_path(&cpkt, "obs"));
+	zassert_equal(zsock_send(sock, cpkt.data, cpkt.offset, 0), cpkt.offset);
+
+	zassert_ok(client_recv(sock, &cpkt, buf, sizeof(buf)));
+	zassert_equal(coap_header_get_type(&cpkt), COAP_TYPE_ACK);
+	zassert_equal(coap_header_get_code(&cpkt), COAP_RESPONSE_CODE_CONTENT);
+}
+
+static void check_notification(struct coap_packet *cpkt, uint8_t type,
+			       const uint8_t *token, uint8_t tkl, int age)
+{
+	uint8_t rx_token[COAP_TOKEN_MAX_LEN];
+	const uint8_t *rx_payload;
+	uint16_t rx_payload_len;
+
+	zassert_equal(coap_header_get_type(cpkt), type);
+	zassert_equal(coap_header_get_code(cpkt), COAP_RESPONSE_CODE_CONTENT);
+	zassert_equal(coap_header_get_token(cpkt, rx_token), tkl);
+	zassert_mem_equal(rx_token, token, tkl);
+	zassert_equal(coap_get_option_int(cpkt, COAP_OPTION_OBSERVE), age);
+
+	rx_payload = coap_packet_get_payload(cpkt, &rx_payload_len);
+	zassert_equal(rx_payload_len, sizeof(payload));
+	zassert_mem_equal(rx_payload, payload, sizeof(payload));
+}
+
+static int notify(uint8_t type, int *age)
+{
+	static uint8_t buf[64];
+	struct coap_packet cpkt;
+
+	*age = coap_resource_next_age(&obs);
+
+	/* The token and message id of the template are replaced for every observer */
+	zassert_ok(coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1, type, 0, NULL,
+				    COAP_RESPONSE_CODE_CONTENT, 0));
+	zassert_ok(coap_append_option_int(&cpkt, COAP_OPTION_OBSERVE, *age));
+	zassert_ok(coap_packet_append_payload_marker(&cpkt));
+	zassert_ok(coap_packet_append_payload(&cpkt, payload, sizeof(payload)));
+
+	return coap_resource_notify_observers(&obs, &cpkt, NULL);
+}
+
+static const uint8_t token_a[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+static const uint8_t token_b[] = { 0xb0, 0x0b };
+
+ZTEST(coap_service_observe, test_notify_non_confirmable)
+{
+	struct coap_packet cpkt;
+	uint8_t buf[64];
+	int sock_a, sock_b;
+	int age;
+
+	sock_a = client_open();
+	sock_b = client_open();
+
+	client_observe(sock_a, token_a, sizeof(token_a));
+	client_observe(sock_b, token_b, sizeof(token_b));
+
+	zassert_equal(notify(COAP_TYPE_NON_CON, &age), 2);
+
+	zassert_ok(client_recv(sock_a, &cpkt, buf, sizeof(buf)));
+	check_notification(&cpkt, COAP_TYPE_NON_CON, token_a, sizeof(token_a), age);
+
+	zassert_ok(client_recv(sock_b, &cpkt, buf, sizeof(buf)));
+	check_notification(&cpkt, COAP_TYPE_NON_CON, token_b, sizeof(token_b), age);
+
+	zsock_close(sock_a);
+	zsock_close(sock_b);
+}
+
+ZTEST(coap_service_observe, test_notify_confirmable)
+{
+	struct coap_packet cpkt;
+	uint8_t buf[64];
+	uint16_t id_b;
+	int sock_a, sock_b;
+	int age;
+
+	sock_a = client_open();
+	sock_b = client_open();
+
+	client_observe(sock_a, token_a, sizeof(token_a));
+	client_observe(sock_b, token_b, sizeof(token_b));
+
+	zassert_equal(notify(COAP_TYPE_CON, &age), 2);
+
+	/* Client A acknowledges the notification, client B does not */
+	zassert_ok(client_recv(sock_a, &cpkt, buf, sizeof(buf)));
+	check_notification(&cpkt, COAP_TYPE_CON, token_a, sizeof(token_a), age);
+	client_send_empty(sock_a, COAP_TYPE_ACK, coap_header_get_id(&cpkt));
+
+	zassert_ok(client_recv(sock_b, &cpkt, buf, sizeof(buf)));
+	check_notification(&cpkt, COAP_TYPE_CON, token_b, sizeof(token_b), age);
+	id_b = coap_header_get_id(&cpkt);
+
+	/* Only the unacknowledged notification is retransmitted */
+	zassert_ok(client_recv(sock_b, &cpkt, buf, sizeof(buf)));
+	check_notification(&cpkt, COAP_TYPE_CON, token_b, sizeof(token_b), age);
+	zassert_equal(coap_header_get_id(&cpkt), id_b);
+
+	zassert_equal(client_recv(sock_a, &cpkt, buf, sizeof(buf)), -EAGAIN);
+
+	/* A reset cancels the observation */
+	client_send_empty(sock_b, COAP_TYPE_RESET, id_b);
+	k_msleep(100);
+
+	zassert_equal(notify(COAP_TYPE_NON_CON, &age), 1);
+
+	zassert_ok(client_recv(sock_a, &cpkt, buf, sizeof(buf)));
+	check_notification(&cpkt, COAP_TYPE_NON_CON, token_a, sizeof(token_a), age);
+
+	zsock_close(sock_a);
+	zsock_close(sock_b);
+}
+
+static void *coap_service_observe_setup(void)
+{
+	int ret;
+
+	ret = coap_service_start(&observe_service);
+	zassert_true(ret == 0 || ret == -EALREADY, "Failed to start service (%d)", ret);
+
+	return NULL;
+}
+
+static void coap_service_observe_after(void *fixture)
+{
+	struct coap_observer *o, *next;
+
+	ARG_UNUSED(fixture);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&obs.observers, o, next, list) {
+		coap_resource_remove_observer_by_token(&obs, o->token, o->tkl);
+	}
+}
+
+ZTEST_SUITE(coap_service_observe, NULL, coap_service_observe_setup, NULL,
+	    coap_service_observe_after, NULL);
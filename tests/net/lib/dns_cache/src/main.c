@@ -133,3 +133,88 @@ ZTEST(net_dns_cache_test, test_expired_entries_removed)
 	zassert_equal(1, dns_cache_find(&test_dns_cache, query, info_read, 3));
 	zassert_equal(AF_INET, info_read[0].ai_family);
 }
+
+ZTEST(net_dns_cache_test, test_find_by_type)
+{
+	struct dns_addrinfo info_write4 = {.ai_family = AF_INET};
+	struct dns_addrinfo info_write6 = {.ai_family = AF_INET6};
+	struct dns_addrinfo info_read[2] = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write4, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write6, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(2, dns_cache_find(&test_dns_cache, query, info_read, 2));
+	zassert_equal(1, dns_cache_find_type(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					     info_read, 2));
+	zassert_equal(AF_INET6, info_read[0].ai_family);
+	zassert_equal(1, dns_cache_find_type(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					     info_read, 2));
+	zassert_equal(AF_INET, info_read[0].ai_family);
+}
+
+ZTEST(net_dns_cache_test, test_negative_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET6};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					  TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(DNS_EAI_NODATA, dns_cache_find_type(&test_dns_cache, query,
+							  DNS_QUERY_TYPE_AAAA, &info_read, 1));
+	zassert_equal(0, dns_cache_find_type(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					     &info_read, 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+
+	/* An answer replaces the negative entry */
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(1, dns_cache_find_type(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					     &info_read, 1));
+	zassert_equal(AF_INET6, info_read.ai_family);
+}
+
+ZTEST(net_dns_cache_test, test_negative_entry_any_type)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL));
+
+	/* A name that does not exist has no record of any type */
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, 0, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(DNS_EAI_NODATA, dns_cache_find_type(&test_dns_cache, query,
+							  DNS_QUERY_TYPE_A, &info_read, 1));
+	zassert_equal(DNS_EAI_NODATA, dns_cache_find_type(&test_dns_cache, query,
+							  DNS_QUERY_TYPE_AAAA, &info_read, 1));
+	zassert_equal(0, dns_cache_find_type(&test_dns_cache, "example2.com", DNS_QUERY_TYPE_A,
+					     &info_read, 1));
+
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_find_type(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					     &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_many_queries)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	char query[sizeof("example00.com")];
+
+	for (int i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "example%02d.com", i);
+		info_write.ai_addrlen = i;
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL + i));
+	}
+
+	for (int i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "example%02d.com", i);
+		zassert_equal(1, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+		zassert_equal(i, info_read.ai_addrlen);
+	}
+
+	zassert_ok(dns_cache_remove(&test_dns_cache, "example05.com"));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "example05.com", &info_read, 1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example06.com", &info_read, 1));
+}
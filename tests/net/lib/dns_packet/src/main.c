@@ -1206,6 +1206,104 @@ ZTEST(dns_packet, test_dns_malformed_and_valid_responses)
 	test_dns_valid_responses();
 }
 
+static uint8_t resp_negative_nxdomain[] = {
+	/* DNS msg header (12 bytes), name error */
+	0xb0, 0x42, 0x81, 0x83, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00,
+
+	/* Query string (www.zephyrproject.org) */
+	0x03, 0x77, 0x77, 0x77, 0x0d, 0x7a, 0x65, 0x70,
+	0x68, 0x79, 0x72, 0x70, 0x72, 0x6f, 0x6a, 0x65,
+	0x63, 0x74, 0x03, 0x6f, 0x72, 0x67, 0x00,
+
+	/* Query type */
+	0x00, 0x01,
+
+	/* Query class */
+	0x00, 0x01,
+};
+
+static uint8_t resp_negative_nxdomain_z[] = {
+	/* DNS msg header (12 bytes), name error with the reserved Z bit */
+	0xb0, 0x43, 0x81, 0xc3, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00,
+
+	/* Query string (www.zephyrproject.org) */
+	0x03, 0x77, 0x77, 0x77, 0x0d, 0x7a, 0x65, 0x70,
+	0x68, 0x79, 0x72, 0x70, 0x72, 0x6f, 0x6a, 0x65,
+	0x63, 0x74, 0x03, 0x6f, 0x72, 0x67, 0x00,
+
+	/* Query type */
+	0x00, 0x01,
+
+	/* Query class */
+	0x00, 0x01,
+};
+
+static uint8_t resp_negative_nxdomain_opcode[] = {
+	/* DNS msg header (12 bytes), name error of a status request */
+	0xb0, 0x44, 0x91, 0x83, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00,
+
+	/* Query string (www.zephyrproject.org) */
+	0x03, 0x77, 0x77, 0x77, 0x0d, 0x7a, 0x65, 0x70,
+	0x68, 0x79, 0x72, 0x70, 0x72, 0x6f, 0x6a, 0x65,
+	0x63, 0x74, 0x03, 0x6f, 0x72, 0x67, 0x00,
+
+	/* Query type */
+	0x00, 0x01,
+
+	/* Query class */
+	0x00, 0x01,
+};
+
+static void run_dns_negative_response(const char *test_case,
+				      uint8_t *buf, size_t len,
+				      int expected_ret)
+{
+	static const uint8_t query[] = {
+		/* Labels */
+		0x03, 0x77, 0x77, 0x77, 0x0d, 0x7a, 0x65, 0x70,
+		0x68, 0x79, 0x72, 0x70, 0x72, 0x6f, 0x6a, 0x65,
+		0x63, 0x74, 0x03, 0x6f, 0x72, 0x67, 0x00,
+		/* Query type */
+		0x00, 0x01
+	};
+	struct dns_msg_t dns_msg = { 0 };
+	uint16_t dns_id = 0;
+	int query_idx = -1;
+	uint16_t query_hash = 0;
+	int ret;
+
+	dns_msg.msg = buf;
+	dns_msg.msg_size = len;
+
+	dns_id = dns_unpack_header_id(dns_msg.msg);
+
+	setup_dns_context(&dns_ctx, 0, dns_id, query, sizeof(query),
+			  DNS_QUERY_TYPE_A);
+
+	ret = dns_validate_msg(&dns_ctx, &dns_msg, &dns_id, &query_idx,
+			       NULL, &query_hash);
+	zassert_equal(ret, expected_ret, "[%s] DNS message failed (%d)",
+		      test_case, ret);
+}
+
+#define RUN_NEGATIVE_TEST(test_name, expected_ret)			\
+	run_dns_negative_response(#test_name, test_name,		\
+				  sizeof(test_name), expected_ret)
+
+ZTEST(dns_packet, test_dns_negative_responses)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_DNS_RESOLVER_CACHE_NEGATIVE);
+
+	RUN_NEGATIVE_TEST(resp_negative_nxdomain, DNS_EAI_NODATA);
+
+	/* Responses with invalid header are not taken as negative answers */
+	RUN_NEGATIVE_TEST(resp_negative_nxdomain_z, DNS_EAI_FAIL);
+	RUN_NEGATIVE_TEST(resp_negative_nxdomain_opcode, DNS_EAI_FAIL);
+}
+
 ZTEST(dns_packet, test_dns_id_len)
 {
 	struct dns_msg_t dns_msg = { 0 };
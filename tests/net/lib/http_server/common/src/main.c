@@ -329,4 +329,34 @@ ZTEST(http_service, test_HTTP_RESOURCE_WILDCARD)
 	zassert_equal(res, RES(3), "Resource mismatch");
 }
 
+ZTEST(http_service, test_HTTP_RESOURCE_LOOKUP)
+{
+	struct http_resource_detail *res;
+	int len;
+
+	/* The query string is not part of the path */
+	res = CHECK_PATH("/index.html?foo=bar", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(len, strlen("/index.html"), "Wrong length");
+	zassert_equal(res, RES(1), "Resource mismatch");
+
+	res = CHECK_PATH("/bar/baz.php?", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(len, strlen("/bar/baz.php"), "Wrong length");
+	zassert_equal(res, RES(3), "Resource mismatch");
+
+	res = CHECK_PATH("/index.htm", &len);
+	zassert_is_null(res, "Resource found");
+
+	/* "/foo.htm" is a websocket resource, so the next match is "/fo*" */
+	res = CHECK_PATH("/foo.htm", &len);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(res, RES(1), "Resource mismatch");
+
+	len = 0;
+	res = get_resource_detail("/foo.htm", &len, true);
+	zassert_not_null(res, "Cannot find resource");
+	zassert_equal(res, RES(2), "Resource mismatch");
+}
+
 ZTEST_SUITE(http_service, NULL, NULL, NULL, NULL, NULL);
@@ -494,4 +494,215 @@ ZTEST(http2_hpack, test_http2_hpack_literal_not_indexed_decode)
 				 ARRAY_SIZE(test_enc_literal_not_indexed_headers));
 }
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+
+/* Requests from RFC7541 C.3, decoded in sequence with the same table */
+static const struct example_headers test_dec_dynamic_requests[] = {
+	{ ":method", "GET",
+	  { 0x82 },
+	  1 },
+	{ ":scheme", "http",
+	  { 0x86 },
+	  1 },
+	{ ":path", "/",
+	  { 0x84 },
+	  1 },
+	{ ":authority", "www.example.com",
+	  { 0x41, 0x0f, 0x77, 0x77, 0x77, 0x2e, 0x65, 0x78,
+	    0x61, 0x6d, 0x70, 0x6c, 0x65, 0x2e, 0x63, 0x6f,
+	    0x6d },
+	  17 },
+	{ ":method", "GET",
+	  { 0x82 },
+	  1 },
+	{ ":scheme", "http",
+	  { 0x86 },
+	  1 },
+	{ ":path", "/",
+	  { 0x84 },
+	  1 },
+	{ ":authority", "www.example.com",
+	  { 0xbe },
+	  1 },
+	{ "cache-control", "no-cache",
+	  { 0x58, 0x08, 0x6e, 0x6f, 0x2d, 0x63, 0x61, 0x63,
+	    0x68, 0x65 },
+	  10 },
+	{ ":method", "GET",
+	  { 0x82 },
+	  1 },
+	{ ":scheme", "https",
+	  { 0x87 },
+	  1 },
+	{ ":path", "/index.html",
+	  { 0x85 },
+	  1 },
+	{ ":authority", "www.example.com",
+	  { 0xbf },
+	  1 },
+	{ "custom-key", "custom-value",
+	  { 0x40, 0x0a, 0x63, 0x75, 0x73, 0x74, 0x6f, 0x6d,
+	    0x2d, 0x6b, 0x65, 0x79, 0x0c, 0x63, 0x75, 0x73,
+	    0x74, 0x6f, 0x6d, 0x2d, 0x76, 0x61, 0x6c, 0x75,
+	    0x65 },
+	  25 },
+};
+
+/* Responses from RFC7541 C.5, with a 256 bytes table and evictions */
+static const struct example_headers test_dec_dynamic_responses[] = {
+	{ ":status", "302",
+	  { 0x48, 0x03, 0x33, 0x30, 0x32 },
+	  5 },
+	{ "cache-control", "private",
+	  { 0x58, 0x07, 0x70, 0x72, 0x69, 0x76, 0x61, 0x74,
+	    0x65 },
+	  9 },
+	{ "date", "Mon, 21 Oct 2013 20:13:21 GMT",
+	  { 0x61, 0x1d, 0x4d, 0x6f, 0x6e, 0x2c, 0x20, 0x32,
+	    0x31, 0x20, 0x4f, 0x63, 0x74, 0x20, 0x32, 0x30,
+	    0x31, 0x33, 0x20, 0x32, 0x30, 0x3a, 0x31, 0x33,
+	    0x3a, 0x32, 0x31, 0x20, 0x47, 0x4d, 0x54 },
+	  31 },
+	{ "location", "https://www.example.com",
+	  { 0x6e, 0x17, 0x68, 0x74, 0x74, 0x70, 0x73, 0x3a,
+	    0x2f, 0x2f, 0x77, 0x77, 0x77, 0x2e, 0x65, 0x78,
+	    0x61, 0x6d, 0x70, 0x6c, 0x65, 0x2e, 0x63, 0x6f,
+	    0x6d },
+	  25 },
+	{ ":status", "307",
+	  { 0x48, 0x03, 0x33, 0x30, 0x37 },
+	  5 },
+	{ "cache-control", "private",
+	  { 0xc1 },
+	  1 },
+	{ "date", "Mon, 21 Oct 2013 20:13:21 GMT",
+	  { 0xc0 },
+	  1 },
+	{ "location", "https://www.example.com",
+	  { 0xbf },
+	  1 },
+	{ ":status", "200",
+	  { 0x88 },
+	  1 },
+	{ "cache-control", "private",
+	  { 0xc1 },
+	  1 },
+	{ "date", "Mon, 21 Oct 2013 20:13:22 GMT",
+	  { 0x61, 0x1d, 0x4d, 0x6f, 0x6e, 0x2c, 0x20, 0x32,
+	    0x31, 0x20, 0x4f, 0x63, 0x74, 0x20, 0x32, 0x30,
+	    0x31, 0x33, 0x20, 0x32, 0x30, 0x3a, 0x31, 0x33,
+	    0x3a, 0x32, 0x32, 0x20, 0x47, 0x4d, 0x54 },
+	  31 },
+	{ "location", "https://www.example.com",
+	  { 0xc0 },
+	  1 },
+	{ "content-encoding", "gzip",
+	  { 0x5a, 0x04, 0x67, 0x7a, 0x69, 0x70 },
+	  6 },
+	{ "set-cookie", "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1",
+	  { 0x77, 0x38, 0x66, 0x6f, 0x6f, 0x3d, 0x41, 0x53,
+	    0x44, 0x4a, 0x4b, 0x48, 0x51, 0x4b, 0x42, 0x5a,
+	    0x58, 0x4f, 0x51, 0x57, 0x45, 0x4f, 0x50, 0x49,
+	    0x55, 0x41, 0x58, 0x51, 0x57, 0x45, 0x4f, 0x49,
+	    0x55, 0x3b, 0x20, 0x6d, 0x61, 0x78, 0x2d, 0x61,
+	    0x67, 0x65, 0x3d, 0x33, 0x36, 0x30, 0x30, 0x3b,
+	    0x20, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e,
+	    0x3d, 0x31 },
+	  58 },
+};
+
+/* A repeated header field is indexed once and then sent by index. */
+static const struct example_headers test_enc_dynamic_headers[] = {
+	{ "custom-key", "custom-value",
+	  { 0x40, 0x88, 0x25, 0xa8, 0x49, 0xe9, 0x5b, 0xa9,
+	    0x7d, 0x7f, 0x89, 0x25, 0xa8, 0x49, 0xe9, 0x5b,
+	    0xb8, 0xe8, 0xb4, 0xbf },
+	  20 },
+	{ "custom-key", "custom-value",
+	  { 0xbe },
+	  1 },
+	{ ":method", "GET",
+	  { 0x82 },
+	  1 },
+	{ "custom-key", "custom-value",
+	  { 0xbe },
+	  1 },
+};
+
+static struct http_hpack_table test_table;
+
+static void test_hpack_verify_table_decode(const struct example_headers *example,
+					   size_t num_examples,
+					   uint32_t max_size, uint32_t size)
+{
+	http_hpack_table_init(&test_table, max_size);
+
+	for (int i = 0; i < num_examples; i++) {
+		struct http_hpack_header_buf hdr;
+		int ret;
+
+		ret = http_hpack_table_decode_header(&test_table, example[i].encoded,
+						     example[i].encoded_len, &hdr);
+		zassert_equal(ret, example[i].encoded_len, "Wrong decoding length");
+		zassert_equal(hdr.name_len, strlen(example[i].name),
+			      "Wrong decoded header name length");
+		zassert_equal(hdr.value_len, strlen(example[i].value),
+			      "Wrong decoded header value length");
+		zassert_mem_equal(hdr.name, example[i].name, hdr.name_len,
+				  "Header name wrongly decoded");
+		zassert_mem_equal(hdr.value, example[i].value, hdr.value_len,
+				  "Header value wrongly decoded");
+	}
+
+	zassert_equal(test_table.size, size, "Wrong dynamic table size");
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_decode)
+{
+	test_hpack_verify_table_decode(test_dec_dynamic_requests,
+				       ARRAY_SIZE(test_dec_dynamic_requests),
+				       4096, 164);
+	test_hpack_verify_table_decode(test_dec_dynamic_responses,
+				       ARRAY_SIZE(test_dec_dynamic_responses),
+				       256, 215);
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_encode)
+{
+	const struct example_headers *example = test_enc_dynamic_headers;
+	struct http_hpack_header_buf hdr;
+	int ret;
+
+	http_hpack_table_init(&test_table, 256);
+
+	for (int i = 0; i < ARRAY_SIZE(test_enc_dynamic_headers); i++) {
+		hdr.name = example[i].name;
+		hdr.value = example[i].value;
+		hdr.name_len = strlen(example[i].name);
+		hdr.value_len = strlen(example[i].value);
+
+		ret = http_hpack_table_encode_header(&test_table, test_buf,
+						     sizeof(test_buf), &hdr);
+		zassert_equal(ret, example[i].encoded_len, "Wrong encoding length");
+		zassert_mem_equal(test_buf, example[i].encoded, ret,
+				  "Header wrongly encoded");
+	}
+
+	/* Shrinking the table evicts the entry and is signalled once. */
+	http_hpack_table_set_max_size(&test_table, 0);
+
+	ret = http_hpack_table_encode_header(&test_table, test_buf,
+					     sizeof(test_buf), &hdr);
+	zassert_equal(ret, 21, "Wrong encoding length");
+	zassert_equal(test_buf[0], 0x20, "Missing table size update");
+	zassert_mem_equal(&test_buf[1], test_enc_literal_not_indexed_headers[0].encoded,
+			  20, "Header wrongly encoded");
+
+	ret = http_hpack_table_encode_header(&test_table, test_buf,
+					     sizeof(test_buf), &hdr);
+	zassert_equal(ret, 20, "Wrong encoding length");
+}
+
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
+
 ZTEST_SUITE(http2_hpack, NULL, NULL, NULL, NULL, NULL);
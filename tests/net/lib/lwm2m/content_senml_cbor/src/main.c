@@ -5,10 +5,12 @@
  */
 
 #include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/ztest.h>
 
 #include "lwm2m_util.h"
 #include "lwm2m_rw_senml_cbor.h"
+#include "lwm2m_senml_cbor_decode.h"
 #include "lwm2m_engine.h"
 
 #define TEST_OBJ_ID 0xFFFF
@@ -1524,6 +1526,137 @@ ZTEST(net_content_senml_cbor_nodata, test_get_time_nodata)
 	zassert_equal(ret, -EBADMSG, "Invalid error code returned");
 }
 
+static int test_read_obj_inst(struct coap_packet *request, struct coap_packet *response)
+{
+	uint8_t *data = test_msg.msg_data;
+	int ret;
+
+	context_reset();
+
+	test_msg.path.level = LWM2M_PATH_LEVEL_OBJECT_INST;
+	test_msg.in.in_cpkt = request;
+
+	ret = coap_packet_init(&test_msg.cpkt, data, sizeof(test_msg.msg_data), COAP_VERSION_1,
+			       COAP_TYPE_ACK, 0, NULL, COAP_RESPONSE_CODE_CONTENT, 1);
+	zassert_ok(ret, "Cannot init response");
+
+	ret = do_read_op_senml_cbor(&test_msg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return coap_packet_parse(response, data, test_msg.cpkt.offset, NULL, 0);
+}
+
+static void test_request_init(struct coap_packet *request, uint8_t *buf, size_t len)
+{
+	int ret;
+
+	ret = coap_packet_init(request, buf, len, COAP_VERSION_1, COAP_TYPE_CON, 0, NULL,
+			       COAP_METHOD_GET, 1);
+	zassert_ok(ret, "Cannot init request");
+}
+
+ZTEST(net_content_senml_cbor, test_put_obj_inst)
+{
+	struct coap_packet request;
+	struct coap_packet response;
+	struct lwm2m_senml senml;
+	uint8_t buf[16];
+	const uint8_t *payload;
+	uint16_t len;
+	size_t decoded;
+
+	test_request_init(&request, buf, sizeof(buf));
+	zassert_ok(test_read_obj_inst(&request, &response), "Error reported");
+
+	/* All the resources, in an array of canonical length */
+	payload = coap_packet_get_payload(&response, &len);
+	zassert_not_null(payload, "No payload");
+	zassert_equal(payload[0], (0x04 << 5) | TEST_OBJ_RES_MAX_ID, "Invalid array head");
+	zassert_equal(coap_get_option_int(&response, COAP_OPTION_BLOCK2), -ENOENT,
+		      "Unexpected Block2 option");
+
+	zassert_equal(cbor_decode_lwm2m_senml(payload, len, &senml, &decoded), ZCBOR_SUCCESS,
+		      "Cannot decode payload");
+	zassert_equal(decoded, len, "Invalid payload length");
+	zassert_equal(senml.lwm2m_senml_record_m_count, TEST_OBJ_RES_MAX_ID,
+		      "Invalid record count");
+}
+
+ZTEST(net_content_senml_cbor, test_put_block2)
+{
+	static uint8_t full[CONFIG_LWM2M_COAP_MAX_MSG_SIZE];
+	static uint8_t blocks[CONFIG_LWM2M_COAP_MAX_MSG_SIZE + 2];
+	struct coap_packet request;
+	struct coap_packet response;
+	struct coap_option etag;
+	uint32_t first_etag = 0;
+	const uint8_t *payload;
+	uint8_t buf[16];
+	uint16_t full_len;
+	uint16_t len;
+	size_t offset = 0;
+	int block;
+	int opt;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_LWM2M_RW_SENML_CBOR_BLOCK2);
+
+	test_request_init(&request, buf, sizeof(buf));
+	zassert_ok(test_read_obj_inst(&request, &response), "Error reported");
+
+	payload = coap_packet_get_payload(&response, &full_len);
+	memcpy(full, payload, full_len);
+
+	/* Ask for the payload in 16 byte blocks */
+	for (block = 0; ; block++) {
+		test_request_init(&request, buf, sizeof(buf));
+		zassert_ok(coap_append_option_int(&request, COAP_OPTION_BLOCK2,
+						  (block << 4) | COAP_BLOCK_16));
+		zassert_ok(test_read_obj_inst(&request, &response), "Error reported");
+
+		opt = coap_get_option_int(&response, COAP_OPTION_BLOCK2);
+		zassert_equal(GET_BLOCK_NUM(opt), block, "Invalid block number");
+		zassert_equal(GET_BLOCK_SIZE(opt), COAP_BLOCK_16, "Invalid block size");
+
+		zassert_equal(coap_find_options(&response, COAP_OPTION_ETAG, &etag, 1), 1,
+			      "No ETag");
+		zassert_equal(etag.len, sizeof(first_etag), "Invalid ETag");
+		if (block == 0) {
+			memcpy(&first_etag, etag.value, sizeof(first_etag));
+		}
+
+		zassert_mem_equal(etag.value, &first_etag, sizeof(first_etag),
+				  "ETag changed in between blocks");
+		zassert_equal(coap_get_option_int(&response, COAP_OPTION_SIZE2), full_len + 2,
+			      "Invalid Size2 option");
+
+		payload = coap_packet_get_payload(&response, &len);
+		zassert_true(offset + len <= sizeof(blocks), "Too much data");
+		memcpy(&blocks[offset], payload, len);
+		offset += len;
+
+		if (!GET_MORE(opt)) {
+			break;
+		}
+
+		zassert_equal(len, 16, "Invalid block length");
+	}
+
+	/* The blocks hold the same records behind a two byte record count */
+	zassert_equal(offset, full_len + 2, "Invalid payload length");
+	zassert_equal(blocks[0], (0x04 << 5) | 25, "Invalid array head");
+	zassert_equal(sys_get_be16(&blocks[1]), TEST_OBJ_RES_MAX_ID, "Invalid record count");
+	zassert_mem_equal(&blocks[3], &full[1], full_len - 1, "Invalid payload");
+
+	/* Past the end of the payload */
+	test_request_init(&request, buf, sizeof(buf));
+	zassert_ok(coap_append_option_int(&request, COAP_OPTION_BLOCK2,
+					  ((block + 1) << 4) | COAP_BLOCK_16));
+	zassert_equal(test_read_obj_inst(&request, &response), -EINVAL,
+		      "Invalid error code returned");
+}
+
 ZTEST_SUITE(net_content_senml_cbor, NULL, test_obj_init, test_prepare, NULL, NULL);
 ZTEST_SUITE(net_content_senml_cbor_nomem, NULL, test_obj_init, test_prepare_nomem, NULL, NULL);
 ZTEST_SUITE(net_content_senml_cbor_nodata, NULL, test_obj_init, test_prepare_nodata, NULL, NULL);
@@ -1156,4 +1156,67 @@ ZTEST(mqtt_packet_fn, test_mqtt_packet)
 	mqtt_abort(&client);
 }
 
+ZTEST(mqtt_packet_fn, test_publish_window)
+{
+	struct mqtt_publish_param param = {
+		.message.topic = topic_qos_1,
+	};
+	int i;
+
+	mqtt_client_init(&client);
+
+	/* Fill the window with QoS 1 and QoS 2 publications */
+	for (i = 0; i < CONFIG_MQTT_PUBLISH_WINDOW; i++) {
+		param.message.topic.qos = (i % 2) ? MQTT_QOS_2_EXACTLY_ONCE :
+						    MQTT_QOS_1_AT_LEAST_ONCE;
+		param.message_id = i + 1;
+		zassert_ok(mqtt_inflight_check(&client, &param));
+		mqtt_inflight_add(&client, &param);
+	}
+
+	zassert_equal(mqtt_publish_inflight_count(&client),
+		      CONFIG_MQTT_PUBLISH_WINDOW);
+
+	/* QoS 0 publications are not tracked */
+	param.message.topic.qos = MQTT_QOS_0_AT_MOST_ONCE;
+	zassert_ok(mqtt_inflight_check(&client, &param));
+
+	param.message.topic.qos = MQTT_QOS_1_AT_LEAST_ONCE;
+	param.message_id = CONFIG_MQTT_PUBLISH_WINDOW + 1;
+	zassert_equal(mqtt_inflight_check(&client, &param), -EAGAIN);
+
+	/* An id in flight can only be reused by a retransmission */
+	param.message_id = 1;
+	zassert_equal(mqtt_inflight_check(&client, &param), -EEXIST);
+	param.dup_flag = 1;
+	zassert_ok(mqtt_inflight_check(&client, &param));
+	param.dup_flag = 0;
+
+	/* QoS 1 completes on PUBACK */
+	zassert_equal(mqtt_inflight_ack(&client, MQTT_PKT_TYPE_PUBCOMP, 1), -ENOENT);
+	zassert_ok(mqtt_inflight_ack(&client, MQTT_PKT_TYPE_PUBACK, 1));
+	zassert_equal(mqtt_inflight_ack(&client, MQTT_PKT_TYPE_PUBACK, 1), -ENOENT);
+	zassert_equal(mqtt_publish_inflight_count(&client),
+		      CONFIG_MQTT_PUBLISH_WINDOW - 1);
+
+	/* QoS 2 completes on PUBCOMP, after PUBREC */
+	zassert_equal(mqtt_inflight_ack(&client, MQTT_PKT_TYPE_PUBACK, 2), -ENOENT);
+	zassert_ok(mqtt_inflight_ack(&client, MQTT_PKT_TYPE_PUBREC, 2));
+	zassert_equal(mqtt_publish_inflight_count(&client),
+		      CONFIG_MQTT_PUBLISH_WINDOW - 1);
+	zassert_ok(mqtt_inflight_ack(&client, MQTT_PKT_TYPE_PUBCOMP, 2));
+	zassert_equal(mqtt_publish_inflight_count(&client),
+		      CONFIG_MQTT_PUBLISH_WINDOW - 2);
+
+	/* Released entries are reused */
+	param.message_id = CONFIG_MQTT_PUBLISH_WINDOW + 1;
+	zassert_ok(mqtt_inflight_check(&client, &param));
+	mqtt_inflight_add(&client, &param);
+	zassert_ok(mqtt_inflight_ack(&client, MQTT_PKT_TYPE_PUBACK,
+				     CONFIG_MQTT_PUBLISH_WINDOW + 1));
+
+	mqtt_inflight_reset(&client);
+	zassert_equal(mqtt_publish_inflight_count(&client), 0);
+}
+
 ZTEST_SUITE(mqtt_packet_fn, NULL, NULL, NULL, NULL, NULL);
@@ -339,6 +339,61 @@ ZTEST(net_pkt_filter_test_suite, test_npf_address_mask)
 	test_npf_eth_mac_addr_mask();
 }
 
+/*
+ * Rule order with rules on different fields. This exercises the field
+ * index when CONFIG_NET_PKT_FILTER_COMPILED is enabled.
+ */
+
+static struct net_eth_addr known_src_addr[1] = {
+	{ { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55 } },
+};
+static struct net_eth_addr known_dst_addr[1] = {
+	{ { 0x00, 0x66, 0x77, 0x88, 0x99, 0xaa } },
+};
+
+static NPF_ETH_SRC_ADDR_MATCH(match_known_src_addr, known_src_addr);
+static NPF_ETH_DST_ADDR_MATCH(match_known_dst_addr, known_dst_addr);
+
+static NPF_RULE(reject_known_src_addr, NET_DROP, match_known_src_addr);
+static NPF_RULE(accept_known_dst_addr, NET_OK, match_known_dst_addr);
+static NPF_RULE(accept_ip_pkt, NET_OK, ip_packet);
+
+ZTEST(net_pkt_filter_test_suite, test_npf_rule_order)
+{
+	struct net_pkt *ip_pkt = build_test_pkt(NET_ETH_PTYPE_IP, 100, NULL);
+	struct net_pkt *arp_pkt = build_test_pkt(NET_ETH_PTYPE_ARP, 100, NULL);
+	struct net_eth_addr other_addr = { { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 } };
+
+	npf_append_recv_rule(&reject_known_src_addr);
+	npf_append_recv_rule(&accept_ip_pkt);
+	npf_append_recv_rule(&npf_default_drop);
+
+	/* the source address rule comes first */
+	zassert_false(net_pkt_filter_recv_ok(ip_pkt), "");
+	zassert_false(net_pkt_filter_recv_ok(arp_pkt), "");
+
+	/* a rule inserted in front takes precedence */
+	npf_insert_recv_rule(&accept_known_dst_addr);
+	zassert_true(net_pkt_filter_recv_ok(ip_pkt), "");
+	zassert_true(net_pkt_filter_recv_ok(arp_pkt), "");
+	zassert_true(npf_remove_recv_rule(&accept_known_dst_addr), "");
+
+	/* other source addresses fall through to the type rule */
+	NET_ETH_HDR(ip_pkt)->src = other_addr;
+	NET_ETH_HDR(arp_pkt)->src = other_addr;
+	zassert_true(net_pkt_filter_recv_ok(ip_pkt), "");
+	zassert_false(net_pkt_filter_recv_ok(arp_pkt), "");
+
+	/* removing a rule is taken into account */
+	zassert_true(npf_remove_recv_rule(&accept_ip_pkt), "");
+	zassert_false(net_pkt_filter_recv_ok(ip_pkt), "");
+
+	zassert_true(npf_remove_all_recv_rules(), "");
+
+	net_pkt_unref(ip_pkt);
+	net_pkt_unref(arp_pkt);
+}
+
 /*
  * IP address filtering
  */
@@ -544,6 +544,60 @@ static void test_route_preference(void)
 	net_route_del(route_entry);
 }
 
+static void test_route_longest_prefix(void)
+{
+	struct net_route_entry *host_route, *prefix_route, *entry;
+	struct in6_addr other_addr;
+
+	/* The more specific route is added first, as adding it afterwards
+	 * would replace the covering route.
+	 */
+	host_route = net_route_add(my_iface,
+				   &dest_addr, 128,
+				   &peer_addr,
+				   NET_IPV6_ND_INFINITE_LIFETIME,
+				   NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(host_route, "Host route add failed");
+
+	prefix_route = net_route_add(my_iface,
+				     &generic_addr, 64,
+				     &peer_addr_alt,
+				     NET_IPV6_ND_INFINITE_LIFETIME,
+				     NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(prefix_route, "Prefix route add failed");
+	zassert_not_equal(prefix_route, host_route, "Routes are the same");
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, host_route, "Longest prefix not selected");
+
+	entry = net_route_lookup(NULL, &dest_addr);
+	zassert_equal_ptr(entry, host_route, "Longest prefix not selected");
+
+	net_ipaddr_copy(&other_addr, &dest_addr);
+	other_addr.s6_addr[15]++;
+
+	entry = net_route_lookup(my_iface, &other_addr);
+	zassert_equal_ptr(entry, prefix_route, "Prefix route not selected");
+
+	entry = net_route_lookup(peer_iface, &other_addr);
+	zassert_is_null(entry, "Route found for wrong interface");
+
+	other_addr.s6_addr[7]++;
+
+	entry = net_route_lookup(my_iface, &other_addr);
+	zassert_is_null(entry, "Route found outside of the prefix");
+
+	zassert_equal(net_route_del(host_route), 0, "Host route del failed");
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, prefix_route, "Prefix route not selected");
+
+	zassert_equal(net_route_del(prefix_route), 0,
+		      "Prefix route del failed");
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_is_null(entry, "Deleted route found");
+}
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +620,7 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_longest_prefix();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
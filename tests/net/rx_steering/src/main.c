@@ -0,0 +1,163 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+
+#define QUEUES     CONFIG_NET_RX_STEERING_QUEUES
+#define FLOW_COUNT 256
+
+static struct net_if *iface;
+
+static int fake_dev_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static void fake_dev_iface_init(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+}
+
+static struct dummy_api fake_dev_if_api = {
+	.iface_api.init = fake_dev_iface_init,
+	.send = fake_dev_send,
+};
+
+NET_DEVICE_INIT(fake_dev, "fake_dev", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &fake_dev_if_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+/* IPv4 header followed by the ports and a payload byte */
+static uint32_t ipv4_hash(uint16_t src_port, uint16_t id, uint16_t frag, uint8_t payload)
+{
+	uint8_t data[NET_IPV4H_LEN + 5] = {
+		0x45, 0x00, 0x00, sizeof(data), 0x00, 0x00, 0x00, 0x00,
+		0x40, IPPROTO_UDP, 0x00, 0x00,
+		192, 0, 2, 1,
+		192, 0, 2, 2,
+	};
+	struct net_pkt *pkt;
+	uint32_t hash;
+
+	sys_put_be16(id, &data[4]);
+	sys_put_be16(frag, &data[6]);
+	sys_put_be16(src_port, &data[NET_IPV4H_LEN]);
+	sys_put_be16(5001, &data[NET_IPV4H_LEN + 2]);
+	data[NET_IPV4H_LEN + 4] = payload;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(data), AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+	zassert_ok(net_pkt_write(pkt, data, sizeof(data)));
+
+	hash = net_if_flow_hash(iface, pkt);
+	net_pkt_unref(pkt);
+
+	return hash;
+}
+
+/* IPv6 header followed by the ports */
+static uint32_t ipv6_hash(uint8_t src_host, uint16_t dst_port)
+{
+	uint8_t data[NET_IPV6H_LEN + 4] = {
+		0x60, 0x00, 0x00, 0x00, 0x00, 0x04, IPPROTO_TCP, 0x40,
+		0x20, 0x01, 0x0d, 0xb8, [23] = 0x01,
+		0x20, 0x01, 0x0d, 0xb8, [39] = 0x02,
+	};
+	struct net_pkt *pkt;
+	uint32_t hash;
+
+	data[23] = src_host;
+	sys_put_be16(49152, &data[NET_IPV6H_LEN]);
+	sys_put_be16(dst_port, &data[NET_IPV6H_LEN + 2]);
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(data), AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+	zassert_ok(net_pkt_write(pkt, data, sizeof(data)));
+
+	hash = net_if_flow_hash(iface, pkt);
+	net_pkt_unref(pkt);
+
+	return hash;
+}
+
+static void check_spread(const int count[QUEUES])
+{
+	for (int i = 0; i < QUEUES; i++) {
+		/* Each queue gets at least half of an even share */
+		zassert_true(count[i] >= FLOW_COUNT / QUEUES / 2,
+			     "Queue %d only got %d flows out of %d", i, count[i], FLOW_COUNT);
+	}
+}
+
+ZTEST(net_rx_steering, test_same_flow_same_queue)
+{
+	uint32_t hash = ipv4_hash(49152, 0, 0, 0);
+
+	zassert_not_equal(hash, 0U, "Hash of a parsed packet is not known");
+
+	for (int i = 1; i < 16; i++) {
+		zassert_equal(ipv4_hash(49152, i, 0, i), hash,
+			      "Packet %d of the flow has a different hash", i);
+	}
+
+	hash = ipv6_hash(1, 80);
+
+	for (int i = 1; i < 16; i++) {
+		zassert_equal(ipv6_hash(1, 80), hash, "IPv6 flow has a different hash");
+	}
+}
+
+ZTEST(net_rx_steering, test_fragments_same_queue)
+{
+	/* The second fragment does not carry the ports, the first one is
+	 * hashed without them too.
+	 */
+	zassert_equal(ipv4_hash(49152, 7, NET_IPV4_MF << 13, 0),
+		      ipv4_hash(0xdead, 7, 185, 0),
+		      "Fragments of a datagram have different hashes");
+}
+
+ZTEST(net_rx_steering, test_flows_spread)
+{
+	int count[QUEUES] = { 0 };
+
+	for (int i = 0; i < FLOW_COUNT; i++) {
+		count[ipv4_hash(49152 + i, 0, 0, 0) % QUEUES]++;
+	}
+
+	check_spread(count);
+
+	memset(count, 0, sizeof(count));
+
+	for (int i = 0; i < FLOW_COUNT; i++) {
+		count[ipv6_hash(i, 80) % QUEUES]++;
+	}
+
+	check_spread(count);
+}
+
+static void *setup(void)
+{
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "No dummy interface");
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_rx_steering, NULL, setup, NULL, NULL, NULL);
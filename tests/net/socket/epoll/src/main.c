@@ -0,0 +1,335 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <stdio.h>
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/fdtable.h>
+
+#include "../../socket_helpers.h"
+
+#define BUF_AND_SIZE(buf) buf, sizeof(buf) - 1
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define TEST_STR_SMALL "test"
+
+#define MY_IPV6_ADDR "::1"
+
+#define ANY_PORT 0
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+#define WAIT_MS 100
+
+#define TCP_TEARDOWN_TIMEOUT K_SECONDS(3)
+
+static void prepare_udp_pair(int *c_sock, int *s_sock)
+{
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	int res;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, s_sock, &s_addr);
+
+	res = zsock_bind(*s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = zsock_connect(*c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+}
+
+static void epoll_add(int epfd, int fd, uint32_t events)
+{
+	struct zsock_epoll_event ev = {
+		.events = events,
+		.data.fd = fd,
+	};
+	int res;
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, fd, &ev);
+	zassert_equal(res, 0, "epoll_ctl ADD failed (%d)", errno);
+}
+
+static void send_small(int sock)
+{
+	ssize_t len;
+
+	len = zsock_send(sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+}
+
+static void recv_small(int sock)
+{
+	char buf[10];
+	ssize_t len;
+
+	len = zsock_recv(sock, buf, sizeof(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+}
+
+ZTEST(net_socket_epoll, test_epoll_level_triggered)
+{
+	struct zsock_epoll_event ev[2];
+	int c_sock;
+	int s_sock;
+	int epfd;
+	int res;
+
+	prepare_udp_pair(&c_sock, &s_sock);
+
+	epfd = zsock_epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed");
+
+	epoll_add(epfd, s_sock, ZSOCK_EPOLLIN);
+
+	/* Nothing is ready */
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), 0);
+	zassert_equal(res, 0, "unexpected event");
+
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 0, "unexpected event");
+
+	send_small(c_sock);
+
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 1, "no event");
+	zassert_equal(ev[0].events, ZSOCK_EPOLLIN, "wrong events");
+	zassert_equal(ev[0].data.fd, s_sock, "wrong data");
+
+	/* Level triggered, reported again until the data is read */
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), 0);
+	zassert_equal(res, 1, "no event");
+	zassert_equal(ev[0].events, ZSOCK_EPOLLIN, "wrong events");
+
+	recv_small(s_sock);
+
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), 0);
+	zassert_equal(res, 0, "unexpected event");
+
+	/* Removed sockets are not reported */
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "epoll_ctl DEL failed");
+
+	send_small(c_sock);
+
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 0, "unexpected event");
+
+	res = zsock_close(epfd);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(c_sock);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(s_sock);
+	zassert_equal(res, 0, "close failed");
+}
+
+ZTEST(net_socket_epoll, test_epoll_edge_triggered)
+{
+	struct zsock_epoll_event ev[2];
+	int c_sock;
+	int s_sock;
+	int epfd;
+	int res;
+
+	prepare_udp_pair(&c_sock, &s_sock);
+
+	epfd = zsock_epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed");
+
+	epoll_add(epfd, s_sock, ZSOCK_EPOLLIN | ZSOCK_EPOLLET);
+
+	send_small(c_sock);
+
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 1, "no event");
+	zassert_equal(ev[0].events, ZSOCK_EPOLLIN, "wrong events");
+
+	/* Edge triggered, the unread data is not reported again */
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), 0);
+	zassert_equal(res, 0, "unexpected event");
+
+	/* A new datagram is a new edge */
+	send_small(c_sock);
+
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 1, "no event");
+
+	recv_small(s_sock);
+	recv_small(s_sock);
+
+	res = zsock_close(epfd);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(c_sock);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(s_sock);
+	zassert_equal(res, 0, "close failed");
+}
+
+ZTEST(net_socket_epoll, test_epoll_oneshot)
+{
+	struct zsock_epoll_event ev[2];
+	struct zsock_epoll_event mod = {
+		.events = ZSOCK_EPOLLIN | ZSOCK_EPOLLONESHOT,
+	};
+	int c_sock;
+	int s_sock;
+	int epfd;
+	int res;
+
+	prepare_udp_pair(&c_sock, &s_sock);
+
+	epfd = zsock_epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed");
+
+	epoll_add(epfd, s_sock, ZSOCK_EPOLLIN | ZSOCK_EPOLLONESHOT);
+
+	send_small(c_sock);
+
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 1, "no event");
+
+	/* Disabled after the first event */
+	send_small(c_sock);
+
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 0, "unexpected event");
+
+	/* Re-arming reports the pending data */
+	mod.data.fd = s_sock;
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, s_sock, &mod);
+	zassert_equal(res, 0, "epoll_ctl MOD failed");
+
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), 0);
+	zassert_equal(res, 1, "no event");
+	zassert_equal(ev[0].data.fd, s_sock, "wrong data");
+
+	recv_small(s_sock);
+	recv_small(s_sock);
+
+	res = zsock_close(epfd);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(c_sock);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(s_sock);
+	zassert_equal(res, 0, "close failed");
+}
+
+ZTEST(net_socket_epoll, test_epoll_ctl_errors)
+{
+	struct zsock_epoll_event ev = { .events = ZSOCK_EPOLLIN };
+	int c_sock;
+	int s_sock;
+	int epfd;
+	int res;
+
+	prepare_udp_pair(&c_sock, &s_sock);
+
+	res = zsock_epoll_create(0);
+	zassert_equal(res, -1, "epoll_create accepted size 0");
+	zassert_equal(errno, EINVAL, "wrong errno");
+
+	epfd = zsock_epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed");
+
+	epoll_add(epfd, s_sock, ZSOCK_EPOLLIN);
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, -1, "duplicate add succeeded");
+	zassert_equal(errno, EEXIST, "wrong errno");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, c_sock, &ev);
+	zassert_equal(res, -1, "mod of unknown socket succeeded");
+	zassert_equal(errno, ENOENT, "wrong errno");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, epfd, &ev);
+	zassert_equal(res, -1, "adding epoll to itself succeeded");
+	zassert_equal(errno, EPERM, "wrong errno");
+
+	res = zsock_epoll_ctl(s_sock, ZSOCK_EPOLL_CTL_ADD, c_sock, &ev);
+	zassert_equal(res, -1, "socket used as epoll instance");
+	zassert_equal(errno, EINVAL, "wrong errno");
+
+	/* Closing a socket removes it from the interest list */
+	res = zsock_close(s_sock);
+	zassert_equal(res, 0, "close failed");
+
+	send_small(c_sock);
+
+	res = zsock_epoll_wait(epfd, &ev, 1, WAIT_MS);
+	zassert_equal(res, 0, "closed socket reported");
+
+	res = zsock_close(epfd);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(c_sock);
+	zassert_equal(res, 0, "close failed");
+}
+
+ZTEST(net_socket_epoll, test_epoll_tcp_accept)
+{
+	struct zsock_epoll_event ev[2];
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	int epfd;
+	int res;
+
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, ANY_PORT, &c_sock, &c_addr);
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = zsock_bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = zsock_listen(s_sock, 1);
+	zassert_equal(res, 0, "listen failed");
+
+	epfd = zsock_epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed");
+
+	epoll_add(epfd, s_sock, ZSOCK_EPOLLIN);
+
+	res = zsock_connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	/* A pending connection makes the listening socket readable */
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 1, "no event");
+	zassert_equal(ev[0].events, ZSOCK_EPOLLIN, "wrong events");
+	zassert_equal(ev[0].data.fd, s_sock, "wrong data");
+
+	new_sock = zsock_accept(s_sock, &addr, &addrlen);
+	zassert_true(new_sock >= 0, "accept failed");
+
+	/* A connected socket is writable */
+	epoll_add(epfd, new_sock, ZSOCK_EPOLLIN | ZSOCK_EPOLLOUT);
+
+	res = zsock_epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 1, "no event");
+	zassert_equal(ev[0].events, ZSOCK_EPOLLOUT, "wrong events");
+	zassert_equal(ev[0].data.fd, new_sock, "wrong data");
+
+	res = zsock_close(epfd);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(c_sock);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(new_sock);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(s_sock);
+	zassert_equal(res, 0, "close failed");
+
+	/* Let the TCP connections be torn down */
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+ZTEST_SUITE(net_socket_epoll, NULL, NULL, NULL, NULL, NULL);
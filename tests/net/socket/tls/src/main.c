@@ -407,6 +407,80 @@ static void test_prepare_dtls_connection(sa_family_t family)
 	test_work_wait(&test_data.work);
 }
 
+static void test_session_stats_get(int sock, struct tls_session_stats *stats)
+{
+	socklen_t optlen = sizeof(*stats);
+	int ret;
+
+	ret = zsock_getsockopt(sock, SOL_TLS, TLS_SESSION_STATS, stats, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+}
+
+ZTEST(net_socket_tls, test_v4_session_resumption)
+{
+	int cache = TLS_SESSION_CACHE_ENABLED;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen;
+	struct tls_session_stats before, after;
+	struct connect_data test_data;
+	int ret;
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, ANY_PORT, &s_sock, &s_saddr,
+			    IPPROTO_TLS_1_2);
+	test_config_psk(s_sock, -1);
+
+	ret = zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_CACHE, &cache,
+			       sizeof(cache));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_session_stats_get(s_sock, &before);
+
+	for (int i = 0; i < 2; i++) {
+		prepare_sock_tls_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr,
+				    IPPROTO_TLS_1_2);
+		test_config_psk(-1, c_sock);
+
+		ret = zsock_setsockopt(c_sock, SOL_TLS, TLS_SESSION_CACHE,
+				       &cache, sizeof(cache));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+		test_data.sock = c_sock;
+		test_data.addr = (struct sockaddr *)&s_saddr;
+		k_work_init_delayable(&test_data.work, client_connect_work_handler);
+		test_work_reschedule(&test_data.work, K_NO_WAIT);
+
+		addrlen = sizeof(addr);
+		test_accept(s_sock, &new_sock, &addr, &addrlen);
+		test_work_wait(&test_data.work);
+
+		test_close(c_sock);
+		c_sock = -1;
+		test_close(new_sock);
+		new_sock = -1;
+	}
+
+	test_session_stats_get(s_sock, &after);
+
+	/* Full handshake on both ends first, then both resume the session. */
+	zassert_equal(after.handshakes - before.handshakes, 4,
+		      "Wrong number of handshakes");
+	zassert_equal(after.resumed - before.resumed, 2,
+		      "Session not resumed");
+	zassert_equal(after.cache_misses - before.cache_misses, 1,
+		      "Wrong number of cache misses");
+	zassert_equal(after.cache_hits - before.cache_hits, 1,
+		      "Wrong number of cache hits");
+
+	test_sockets_close();
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
 ZTEST(net_socket_tls, test_v4_msg_waitall)
 {
 	struct test_msg_waitall_data test_data = {
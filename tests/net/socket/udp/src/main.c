@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/ztest_assert.h>
 
 #include <zephyr/net/socket.h>
+#include <zephyr/net/net_context.h>
 #include <zephyr/net/ethernet.h>
 #include <zephyr/net/net_mgmt.h>
 #include <zephyr/net/net_event.h>
@@ -2528,6 +2529,164 @@ ZTEST(net_socket_udp, test_37_ipv6_src_addr_select)
 				       &my_addr3, &dest);
 }
 
+static K_SEM_DEFINE(zc_tx_done, 0, 1);
+
+static void zc_tx_done_cb(struct net_zc_tx *zc)
+{
+	ARG_UNUSED(zc);
+
+	k_sem_give(&zc_tx_done);
+}
+
+ZTEST(net_socket_udp, test_38_v4_zerocopy)
+{
+	static const char part1[] = "The Zephyr Project, ";
+	static const char part2[] = "zero-copy datagram";
+	struct iovec io_vector[2];
+	struct msghdr msg = { 0 };
+	struct net_zc_tx zc;
+	struct net_buf *frags;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in addr;
+	socklen_t addrlen = sizeof(addr);
+	int client_sock;
+	int server_sock;
+	size_t off = 0;
+	ssize_t len;
+	int rv;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_CONTEXT_ZEROCOPY);
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	io_vector[0].iov_base = (void *)part1;
+	io_vector[0].iov_len = STRLEN(part1);
+	io_vector[1].iov_base = (void *)part2;
+	io_vector[1].iov_len = STRLEN(part2);
+
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+	msg.msg_name = &server_addr;
+	msg.msg_namelen = sizeof(server_addr);
+
+	len = zsock_sendmsg_zc(client_sock, &msg, 0, &zc, zc_tx_done_cb);
+	zassert_equal(len, STRLEN(part1) + STRLEN(part2), "sendmsg_zc failed");
+
+	/* Loopback copies the packet, so the data is released once sent */
+	rv = k_sem_take(&zc_tx_done, K_MSEC(100));
+	zassert_equal(rv, 0, "zero-copy completion not called");
+
+	len = zsock_recv_zc(server_sock, &frags, 0, (struct sockaddr *)&addr,
+			    &addrlen);
+	zassert_equal(len, STRLEN(part1) + STRLEN(part2), "recv_zc failed");
+	zassert_not_null(frags, "no fragments lent");
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "unexpected addrlen");
+	zassert_equal(net_buf_frags_len(frags), len, "fragment length mismatch");
+
+	clear_buf(rx_buf);
+	for (struct net_buf *buf = frags; buf != NULL; buf = buf->frags) {
+		memcpy(rx_buf + off, buf->data, buf->len);
+		off += buf->len;
+	}
+
+	zassert_mem_equal(rx_buf, part1, STRLEN(part1), "wrong data");
+	zassert_mem_equal(rx_buf + STRLEN(part1), part2, STRLEN(part2),
+			  "wrong data");
+
+	rv = zsock_recv_zc_release(server_sock, frags);
+	zassert_equal(rv, 0, "release failed");
+
+	/* Nothing left to receive */
+	len = zsock_recv_zc(server_sock, &frags, ZSOCK_MSG_DONTWAIT, NULL, NULL);
+	zassert_equal(len, -1, "unexpected data");
+	zassert_equal(errno, EAGAIN, "unexpected errno");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+ZTEST(net_socket_udp, test_39_v4_sendmmsg_recvmmsg)
+{
+	static const char * const payloads[] = { "first", "second datagram", "third" };
+	struct zsock_mmsghdr msgs[ARRAY_SIZE(payloads) + 1];
+	struct iovec iovs[ARRAY_SIZE(payloads) + 1];
+	char bufs[ARRAY_SIZE(payloads) + 1][32];
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	int client_sock;
+	int server_sock;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		iovs[i].iov_base = (void *)payloads[i];
+		iovs[i].iov_len = strlen(payloads[i]);
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+	}
+
+	rv = zsock_sendmmsg(client_sock, msgs, ARRAY_SIZE(payloads), 0);
+	zassert_equal(rv, ARRAY_SIZE(payloads), "sendmmsg failed (%d)", errno);
+
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		zassert_equal(msgs[i].msg_len, strlen(payloads[i]),
+			      "wrong sent length");
+	}
+
+	/* Let all the datagrams reach the receiving socket */
+	k_msleep(10);
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		iovs[i].iov_base = bufs[i];
+		iovs[i].iov_len = sizeof(bufs[i]);
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* Ask for more than was sent, the extra entry must not block */
+	rv = zsock_recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs),
+			    ZSOCK_MSG_WAITFORONE);
+	zassert_equal(rv, ARRAY_SIZE(payloads), "recvmmsg failed (%d)", errno);
+
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		zassert_equal(msgs[i].msg_len, strlen(payloads[i]),
+			      "wrong received length");
+		zassert_mem_equal(bufs[i], payloads[i], strlen(payloads[i]),
+				  "wrong data");
+	}
+
+	/* Nothing queued, so nothing is received */
+	rv = zsock_recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs),
+			    ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "unexpected data");
+	zassert_equal(errno, EAGAIN, "unexpected errno");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
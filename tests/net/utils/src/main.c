@@ -923,4 +923,53 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 }
 
+ZTEST(test_utils_fn, test_ip_checksum_incremental)
+{
+	uint8_t orig[64];
+	uint8_t modified[64];
+	uint16_t chksum;
+	uint16_t expected;
+	uint16_t updated;
+
+	for (int i = 0; i < sizeof(orig); i++) {
+		orig[i] = (uint8_t)(i * 37 + 11);
+	}
+
+	for (int offset = 0; offset < sizeof(orig) - 16; offset += 2) {
+		uint16_t old16 = sys_get_be16(&orig[offset]);
+		uint32_t old32 = sys_get_be32(&orig[offset]);
+		uint16_t new16 = old16 ^ (0x5a5a + offset);
+		uint32_t new32 = old32 ^ (0xa5a5a5a5 - offset);
+
+		chksum = ~calc_chksum(0, orig, sizeof(orig));
+
+		/* 16-bit field rewrite */
+		memcpy(modified, orig, sizeof(orig));
+		sys_put_be16(new16, &modified[offset]);
+		expected = ~calc_chksum(0, modified, sizeof(modified));
+		updated = net_chksum_update16(chksum, old16, new16);
+
+		zassert_equal(updated, expected, "16-bit update mismatch at %d", offset);
+
+		/* 32-bit field rewrite */
+		memcpy(modified, orig, sizeof(orig));
+		sys_put_be32(new32, &modified[offset]);
+		expected = ~calc_chksum(0, modified, sizeof(modified));
+		updated = net_chksum_update32(chksum, old32, new32);
+
+		zassert_equal(updated, expected, "32-bit update mismatch at %d", offset);
+
+		/* Multi-word rewrite, e.g. an IPv6 address */
+		memcpy(modified, orig, sizeof(orig));
+		for (int i = 0; i < 16; i++) {
+			modified[offset + i] = (uint8_t)(modified[offset + i] + i + 1);
+		}
+
+		expected = ~calc_chksum(0, modified, sizeof(modified));
+		updated = net_chksum_update(chksum, &orig[offset], &modified[offset], 16);
+
+		zassert_equal(updated, expected, "buffer update mismatch at %d", offset);
+	}
+}
+
 ZTEST_SUITE(test_utils_fn, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,121 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/debug/sampling_profiler.h>
+
+#define SAMPLE_FREQ 1000
+#define SAMPLE_TIME_MS 200
+
+struct hot_ctx {
+	uint32_t total;
+	uint32_t hot;
+	uint32_t hot_caller;
+};
+
+static __noinline void hot_function(int64_t end)
+{
+	while (k_uptime_get() < end) {
+		for (volatile int i = 0; i < 1000; i++) {
+		}
+	}
+}
+
+static __noinline void hot_caller(int64_t end)
+{
+	hot_function(end);
+}
+
+static void hot_count(const struct sampling_profiler_stack *stack, void *user_data)
+{
+	struct hot_ctx *ctx = user_data;
+
+	ctx->total += stack->count;
+
+	if ((stack->depth == 0) || (stack->addr[0] != (uintptr_t)hot_function)) {
+		return;
+	}
+
+	zassert_equal_ptr(stack->thread, k_current_get());
+	ctx->hot += stack->count;
+
+	if ((stack->depth > 1) && (stack->addr[1] == (uintptr_t)hot_caller)) {
+		ctx->hot_caller += stack->count;
+	}
+}
+
+ZTEST(sampling_profiler, test_start_stop)
+{
+	zassert_equal(sampling_profiler_start(0), -EINVAL);
+	zassert_equal(sampling_profiler_start(CONFIG_SYS_CLOCK_TICKS_PER_SEC + 1), -EINVAL);
+	zassert_equal(sampling_profiler_stop(), -EALREADY);
+
+	zassert_equal(sampling_profiler_start(SAMPLE_FREQ), 0);
+	zassert_true(sampling_profiler_is_running());
+	zassert_equal(sampling_profiler_start(SAMPLE_FREQ), -EALREADY);
+
+	zassert_equal(sampling_profiler_stop(), 0);
+	zassert_false(sampling_profiler_is_running());
+	zassert_equal(sampling_profiler_stop(), -EALREADY);
+}
+
+ZTEST(sampling_profiler, test_hot_function)
+{
+	struct sampling_profiler_stats stats;
+	struct hot_ctx ctx = { 0 };
+
+	zassert_equal(sampling_profiler_start(SAMPLE_FREQ), 0);
+	hot_caller(k_uptime_get() + SAMPLE_TIME_MS);
+	zassert_equal(sampling_profiler_stop(), 0);
+
+	sampling_profiler_stats_get(&stats);
+	zassert_true(stats.samples > (SAMPLE_FREQ * SAMPLE_TIME_MS / 1000) / 2,
+		     "Too few samples %u", stats.samples);
+	zassert_equal(stats.lost, 0);
+
+	zassert_equal(sampling_profiler_foreach(hot_count, &ctx), stats.stacks);
+	zassert_equal(ctx.total, stats.samples);
+
+	/* Most of the time is spent in the busy loop. */
+	zassert_true(ctx.hot > (ctx.total / 2), "Only %u of %u samples in the hot function",
+		     ctx.hot, ctx.total);
+
+	if (CONFIG_SAMPLING_PROFILER_STACK_DEPTH > 1) {
+		/* The caller is not known while the frame is being set up. */
+		zassert_true(ctx.hot_caller > (ctx.hot / 2), "Caller found in %u of %u samples",
+			     ctx.hot_caller, ctx.hot);
+	}
+}
+
+ZTEST(sampling_profiler, test_reset)
+{
+	struct sampling_profiler_stats stats;
+
+	zassert_equal(sampling_profiler_start(SAMPLE_FREQ), 0);
+	k_busy_wait(20 * USEC_PER_MSEC);
+	zassert_equal(sampling_profiler_stop(), 0);
+
+	sampling_profiler_stats_get(&stats);
+	zassert_true(stats.samples > 0);
+
+	sampling_profiler_reset();
+
+	sampling_profiler_stats_get(&stats);
+	zassert_equal(stats.samples, 0);
+	zassert_equal(stats.stacks, 0);
+	zassert_equal(stats.dropped, 0);
+	zassert_equal(sampling_profiler_foreach(hot_count, NULL), 0);
+}
+
+static void sampling_profiler_before(void *data)
+{
+	ARG_UNUSED(data);
+
+	sampling_profiler_reset();
+}
+
+ZTEST_SUITE(sampling_profiler, NULL, NULL, sampling_profiler_before, NULL, NULL);
@@ -73,6 +73,11 @@ int main(void)
 #endif
 #endif
 
+#if defined(CONFIG_LOG_MODE_DEFERRED)
+	/* Output the pending messages before the newline below. */
+	LOG_PANIC();
+#endif
+
 #if defined(CONFIG_STDOUT_CONSOLE)
 	/*
 	 * When running through twister with pytest, we need to add a newline
@@ -343,6 +343,59 @@ ZTEST(test_log_api, test_log_backend_runtime_filtering)
 	process_and_validate(true, false);
 }
 
+static void call_site_log(uint8_t *data, size_t len)
+{
+	LOG_WRN("test");
+	LOG_HEXDUMP_WRN(data, len, "hexdump");
+	LOG_ERR("test2");
+}
+
+/*
+ * Test is using 2 backends and call site filtering is enabled. Level of the
+ * module is reduced to error on all backends so call sites of warning messages
+ * are disabled. Then level is restored and the same call sites are expected to
+ * be enabled again.
+ */
+ZTEST(test_log_api, test_log_call_site_filtering)
+{
+	uint16_t s_id = LOG_CURRENT_MODULE_ID();
+	uint8_t d_id = Z_LOG_LOCAL_DOMAIN_ID;
+	log_timestamp_t exp_ts = TIMESTAMP_INIT_VAL;
+	uint8_t data[] = {1, 2, 4, 5, 6, 8};
+
+	if (!IS_ENABLED(CONFIG_LOG_CALL_SITE_FILTERING) ||
+	    IS_ENABLED(CONFIG_LOG_FRONTEND) || frontend_only()) {
+		ztest_test_skip();
+	}
+
+	log_setup(true);
+
+	log_filter_set(NULL, d_id, s_id, LOG_LEVEL_ERR);
+
+	/* Only ERR message expected */
+	mock_log_backend_record(&backend1, s_id, d_id, LOG_LEVEL_ERR, exp_ts, "test2");
+	mock_log_backend_record(&backend2, s_id, d_id, LOG_LEVEL_ERR, exp_ts++, "test2");
+
+	call_site_log(data, sizeof(data));
+
+	process_and_validate(true, false);
+
+	log_filter_set(NULL, d_id, s_id, LOG_LEVEL_DBG);
+
+	mock_log_backend_record(&backend1, s_id, d_id, LOG_LEVEL_WRN, exp_ts, "test");
+	mock_log_backend_record(&backend2, s_id, d_id, LOG_LEVEL_WRN, exp_ts++, "test");
+	mock_log_backend_generic_record(&backend1, s_id, d_id, LOG_LEVEL_WRN,
+					exp_ts, "hexdump", data, sizeof(data));
+	mock_log_backend_generic_record(&backend2, s_id, d_id, LOG_LEVEL_WRN,
+					exp_ts++, "hexdump", data, sizeof(data));
+	mock_log_backend_record(&backend1, s_id, d_id, LOG_LEVEL_ERR, exp_ts, "test2");
+	mock_log_backend_record(&backend2, s_id, d_id, LOG_LEVEL_ERR, exp_ts++, "test2");
+
+	call_site_log(data, sizeof(data));
+
+	process_and_validate(true, false);
+}
+
 static size_t get_max_hexdump(void)
 {
 	return CONFIG_LOG_BUFFER_SIZE - sizeof(struct log_msg_hdr);
@@ -0,0 +1,274 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_backend_retention.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/retention/retention.h>
+#include <zephyr/sys/cbprintf.h>
+#include <zephyr/sys/reboot.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_DBG);
+
+#define MAX_RECORDS 64
+#define REBOOT_MARKER "<reboot>"
+
+/* Layout of the header of the ring, at the beginning of the area. */
+#define HDR_IMAGE_ID_OFFSET 0
+#define HDR_RD_OFFSET 4
+#define HDR_SIZE 16
+
+#define REBOOT_MAGIC 0x4C4F4752U
+
+enum reboot_phase {
+	PHASE_RETAINED,
+	PHASE_IMAGE_CHANGED,
+	PHASE_HDR_CORRUPTED,
+	PHASE_RECORD_CORRUPTED,
+};
+
+/* Phase of test_warm_reboot, kept across the warm reboots. */
+static struct {
+	uint32_t magic;
+	uint32_t phase;
+} reboot_state __noinit;
+
+static const struct device *const retention_dev =
+	DEVICE_DT_GET(DT_CHOSEN(zephyr_log_retention));
+
+static char records[MAX_RECORDS][32];
+static int record_cnt;
+static int reboot_cnt;
+static int setup_reboot_cnt;
+
+/* Records retained from the previous boot, read before any test runs. */
+static char boot_records[MAX_RECORDS][32];
+static int boot_record_cnt;
+
+struct str_ctx {
+	char *str;
+	size_t len;
+	size_t max;
+};
+
+static int out(int c, void *ctx)
+{
+	struct str_ctx *s = ctx;
+
+	if (s->len < (s->max - 1)) {
+		s->str[s->len++] = (char)c;
+	}
+
+	return c;
+}
+
+static void retained_msg(struct log_msg *msg, void *user_data)
+{
+	struct str_ctx s;
+	size_t len;
+
+	ARG_UNUSED(user_data);
+
+	zassert_true(record_cnt < MAX_RECORDS);
+
+	if (msg == NULL) {
+		strcpy(records[record_cnt++], REBOOT_MARKER);
+		reboot_cnt++;
+		return;
+	}
+
+	s = (struct str_ctx){ .str = records[record_cnt], .max = sizeof(records[0]) };
+	(void)cbpprintf(out, &s, log_msg_get_package(msg, &len));
+	records[record_cnt][s.len] = '\0';
+	record_cnt++;
+}
+
+static int retained_get(void)
+{
+	record_cnt = 0;
+	reboot_cnt = 0;
+
+	return log_backend_retention_foreach(retained_msg, NULL);
+}
+
+static void flush_log(void)
+{
+	while (LOG_PROCESS()) {
+	}
+}
+
+ZTEST(log_backend_retention, test_reboot_record)
+{
+	/* Ring contains the record which marks the boot. */
+	zassert_true(setup_reboot_cnt > 0);
+}
+
+ZTEST(log_backend_retention, test_retained)
+{
+	LOG_INF("retained %d", 1);
+	LOG_WRN("retained %d", 2);
+	flush_log();
+
+	zassert_equal(retained_get(), 2);
+	zassert_equal(reboot_cnt, 0);
+	zassert_equal(strcmp(records[0], "retained 1"), 0, "Got %s", records[0]);
+	zassert_equal(strcmp(records[1], "retained 2"), 0, "Got %s", records[1]);
+}
+
+ZTEST(log_backend_retention, test_overwrite)
+{
+	char exp[32];
+	int first;
+	int cnt;
+
+	for (int i = 0; i < 100; i++) {
+		LOG_INF("msg %d", i);
+		flush_log();
+	}
+
+	cnt = retained_get();
+	zassert_true((cnt > 0) && (cnt < 100), "Unexpected count %d", cnt);
+
+	/* Oldest messages are overwritten, remaining ones are in order. */
+	zassert_equal(sscanf(records[0], "msg %d", &first), 1, "Got %s", records[0]);
+	zassert_equal(first, 100 - cnt);
+
+	for (int i = 0; i < cnt; i++) {
+		snprintf(exp, sizeof(exp), "msg %d", first + i);
+		zassert_equal(strcmp(records[i], exp), 0, "Got %s, exp %s", records[i], exp);
+	}
+}
+
+ZTEST(log_backend_retention, test_clear)
+{
+	LOG_INF("to be cleared");
+	flush_log();
+
+	zassert_equal(log_backend_retention_clear(), 0);
+	zassert_equal(retained_get(), 0);
+	zassert_equal(reboot_cnt, 0);
+}
+
+static void boot_records_check(const char *const *exp, int cnt)
+{
+	zassert_equal(boot_record_cnt, cnt, "Got %d records, expected %d",
+		      boot_record_cnt, cnt);
+
+	for (int i = 0; i < cnt; i++) {
+		zassert_equal(strcmp(boot_records[i], exp[i]), 0, "Got %s, expected %s",
+			      boot_records[i], exp[i]);
+	}
+}
+
+static void area_scribble(off_t off, uint32_t val)
+{
+	zassert_equal(retention_write(retention_dev, off, (const uint8_t *)&val,
+				      sizeof(val)), 0);
+}
+
+static void warm_reboot(enum reboot_phase next)
+{
+	reboot_state.phase = next;
+	sys_reboot(SYS_REBOOT_WARM);
+	zassert_unreachable("Failed to reboot");
+}
+
+ZTEST(log_backend_retention, test_warm_reboot)
+{
+	static const char *const retained[] = {
+		"before reboot 1", "before reboot 2", REBOOT_MARKER
+	};
+	static const char *const discarded[] = { REBOOT_MARKER };
+	uint32_t val;
+
+	if (reboot_state.magic != REBOOT_MAGIC) {
+		reboot_state.magic = REBOOT_MAGIC;
+
+		LOG_INF("before reboot %d", 1);
+		LOG_ERR("before reboot %d", 2);
+		flush_log();
+
+		warm_reboot(PHASE_RETAINED);
+	}
+
+	switch (reboot_state.phase) {
+	case PHASE_RETAINED:
+		/* Messages logged before the reboot are followed by its marker. */
+		boot_records_check(retained, ARRAY_SIZE(retained));
+
+		/* Records of another image are discarded. */
+		LOG_INF("other image");
+		flush_log();
+		zassert_equal(retention_read(retention_dev, HDR_IMAGE_ID_OFFSET,
+					     (uint8_t *)&val, sizeof(val)), 0);
+		area_scribble(HDR_IMAGE_ID_OFFSET, ~val);
+
+		warm_reboot(PHASE_IMAGE_CHANGED);
+		break;
+	case PHASE_IMAGE_CHANGED:
+		boot_records_check(discarded, ARRAY_SIZE(discarded));
+
+		/* Ring with a corrupted header is discarded. */
+		LOG_INF("corrupted header");
+		flush_log();
+		for (off_t off = HDR_RD_OFFSET; off < HDR_SIZE; off += sizeof(val)) {
+			area_scribble(off, 0xA5A5A5A5U);
+		}
+
+		warm_reboot(PHASE_HDR_CORRUPTED);
+		break;
+	case PHASE_HDR_CORRUPTED:
+		boot_records_check(discarded, ARRAY_SIZE(discarded));
+
+		/* Ring with a corrupted record is discarded. */
+		LOG_INF("corrupted record");
+		flush_log();
+		zassert_equal(retention_read(retention_dev, HDR_RD_OFFSET,
+					     (uint8_t *)&val, sizeof(val)), 0);
+		area_scribble(HDR_SIZE + val, 0xFFFFFFFFU);
+
+		warm_reboot(PHASE_RECORD_CORRUPTED);
+		break;
+	case PHASE_RECORD_CORRUPTED:
+		boot_records_check(discarded, ARRAY_SIZE(discarded));
+
+		/* Next reset starts over. */
+		reboot_state.magic = 0U;
+		break;
+	default:
+		zassert_unreachable("Unexpected phase %u", reboot_state.phase);
+	}
+}
+
+static void *log_backend_retention_setup(void)
+{
+	const struct log_backend *backend = log_backend_retention_get();
+
+	log_init();
+	zassert_true(log_backend_is_active(backend));
+
+	(void)retained_get();
+	setup_reboot_cnt = reboot_cnt;
+	boot_record_cnt = record_cnt;
+	memcpy(boot_records, records, sizeof(boot_records));
+
+	return NULL;
+}
+
+static void log_backend_retention_before(void *data)
+{
+	ARG_UNUSED(data);
+
+	flush_log();
+	zassert_equal(log_backend_retention_clear(), 0);
+}
+
+ZTEST_SUITE(log_backend_retention, NULL, log_backend_retention_setup,
+	    log_backend_retention_before, NULL, NULL);
@@ -21,7 +21,7 @@
 #include "test_helpers.h"
 
 #define LOG_MODULE_NAME test
-LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+LOG_MODULE_REGISTER(LOG_MODULE_NAME, LOG_LEVEL_DBG);
 
 #if LOG_BENCHMARK_DETAILED_PRINT
 #define DBG_PRINT(...) PRINT(__VA_ARGS__)
@@ -230,13 +230,36 @@ ZTEST(test_log_benchmark, test_log_message_with_string)
 		cyc / repeat, us / repeat);
 }
 
+ZTEST(test_log_benchmark, test_log_dbg_message)
+{
+	uint64_t val = 0x1122334455667788ULL;
+	void *ptr = &val;
+	int repeat = 8;
+
+	test_helpers_log_setup();
+	uint32_t cyc = test_helpers_cycle_get();
+
+	for (int i = 0; i < repeat; i++) {
+		LOG_DBG("dbg %d %p %llx", i, ptr, val);
+	}
+
+	cyc = test_helpers_cycle_get() - cyc;
+	uint32_t us = k_cyc_to_us_ceil32(cyc);
+
+	PRINT("%sLOG_DBG with 3 arguments %u cycles (%u us).\n",
+		k_is_user_context() ? "USERSPACE: " : "",
+		cyc / repeat, us / repeat);
+}
+
 /*test case main entry*/
 static void *log_benchmark_setup(void)
 {
 	PRINT("LOGGING MODE:%s\n", IS_ENABLED(CONFIG_LOG_MODE_DEFERRED) ? "DEFERRED" : "IMMEDIATE");
 	PRINT("\tOVERWRITE: %d\n", IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW));
 	PRINT("\tBUFFER_SIZE: %d\n", CONFIG_LOG_BUFFER_SIZE);
-	PRINT("\tSPEED: %d", IS_ENABLED(CONFIG_LOG_SPEED));
+	PRINT("\tSPEED: %d\n", IS_ENABLED(CONFIG_LOG_SPEED));
+	PRINT("\tRUNTIME: %d\n", IS_ENABLED(CONFIG_LOG_ALWAYS_RUNTIME));
+	PRINT("\tPACKAGE_LAYOUT: %d", IS_ENABLED(CONFIG_LOG_PACKAGE_LAYOUT));
 
 	return NULL;
 }
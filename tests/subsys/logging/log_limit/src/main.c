@@ -0,0 +1,243 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/sys/cbprintf.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_DBG);
+
+#define MAX_RECORDS 8
+
+struct record {
+	uint8_t level;
+	char str[64];
+};
+
+static struct record records[MAX_RECORDS];
+static int record_cnt;
+
+struct str_ctx {
+	char *str;
+	size_t len;
+	size_t max;
+};
+
+static int out(int c, void *ctx)
+{
+	struct str_ctx *s = ctx;
+
+	if (s->len < (s->max - 1)) {
+		s->str[s->len++] = (char)c;
+	}
+
+	return c;
+}
+
+static void process(const struct log_backend *const backend,
+		    union log_msg_generic *msg)
+{
+	struct record *r;
+	struct str_ctx s;
+	size_t len;
+	uint8_t *package;
+
+	if (record_cnt >= MAX_RECORDS) {
+		record_cnt++;
+		return;
+	}
+
+	r = &records[record_cnt++];
+	s = (struct str_ctx){ .str = r->str, .max = sizeof(r->str) };
+	package = log_msg_get_package(&msg->log, &len);
+
+	r->level = log_msg_get_level(&msg->log);
+	(void)cbpprintf(out, &s, package);
+	r->str[s.len] = '\0';
+}
+
+static const struct log_backend_api backend_api = {
+	.process = process,
+};
+
+LOG_BACKEND_DEFINE(test_backend, backend_api, false);
+
+static void flush_log(void)
+{
+	while (LOG_PROCESS()) {
+	}
+}
+
+static void record_check(int idx, uint8_t level, const char *str)
+{
+	zassert_true(idx < record_cnt, "Missing message %d", idx);
+	zassert_equal(records[idx].level, level);
+	zassert_equal(strcmp(records[idx].str, str), 0, "Got \"%s\", expected \"%s\"",
+		      records[idx].str, str);
+}
+
+ZTEST(log_limit, test_dedup_evicted)
+{
+	for (int i = 0; i < 4; i++) {
+		LOG_ERR("dedup %d", 1);
+	}
+
+	/* Only one message is tracked so repeats are reported on eviction. */
+	LOG_ERR("other");
+
+	flush_log();
+
+	zassert_equal(record_cnt, 3);
+	record_check(0, LOG_LEVEL_ERR, "dedup 1");
+	record_check(1, LOG_LEVEL_ERR, "other");
+	record_check(2, LOG_LEVEL_ERR, "3 repeated messages suppressed");
+}
+
+ZTEST(log_limit, test_dedup_sites)
+{
+	/* More sites repeat than there are entries. The report of the repeats
+	 * of an evicted site must not take the entry of the evicting site.
+	 */
+	for (int round = 0; round < 2; round++) {
+		for (int i = 0; i < 3; i++) {
+			LOG_ERR("site a");
+		}
+
+		for (int i = 0; i < 3; i++) {
+			LOG_WRN("site b");
+		}
+	}
+
+	flush_log();
+
+	zassert_equal(record_cnt, 7);
+	record_check(0, LOG_LEVEL_ERR, "site a");
+	record_check(1, LOG_LEVEL_WRN, "site b");
+	record_check(2, LOG_LEVEL_ERR, "2 repeated messages suppressed");
+	record_check(3, LOG_LEVEL_ERR, "site a");
+	record_check(4, LOG_LEVEL_WRN, "2 repeated messages suppressed");
+	record_check(5, LOG_LEVEL_WRN, "site b");
+	record_check(6, LOG_LEVEL_ERR, "2 repeated messages suppressed");
+}
+
+ZTEST(log_limit, test_dedup_window)
+{
+	for (int i = 0; i < 3; i++) {
+		LOG_WRN("window");
+	}
+
+	k_msleep(CONFIG_LOG_DEDUP_WINDOW_MS + 10);
+
+	/* Same message after the window is logged again. */
+	LOG_WRN("window");
+
+	flush_log();
+
+	zassert_equal(record_cnt, 3);
+	record_check(0, LOG_LEVEL_WRN, "window");
+	record_check(1, LOG_LEVEL_WRN, "2 repeated messages suppressed");
+	record_check(2, LOG_LEVEL_WRN, "window");
+}
+
+ZTEST(log_limit, test_dedup_flush)
+{
+	for (int i = 0; i < 3; i++) {
+		LOG_INF("flush %d", 2);
+	}
+
+	k_msleep(CONFIG_LOG_DEDUP_WINDOW_MS + 10);
+
+	/* Repeats are reported once the window expires, without any further
+	 * message. The processing thread is woken up by the report.
+	 */
+	if (!IS_ENABLED(CONFIG_LOG_PROCESS_THREAD)) {
+		flush_log();
+	}
+
+	zassert_equal(record_cnt, 2);
+	record_check(0, LOG_LEVEL_INF, "flush 2");
+	record_check(1, LOG_LEVEL_INF, "2 repeated messages suppressed");
+}
+
+ZTEST(log_limit, test_rate_limit)
+{
+	int16_t id = LOG_CURRENT_MODULE_ID();
+	uint32_t rate;
+	uint32_t burst;
+
+	zassert_equal(log_rate_limit_set(id, 1, 0), -EINVAL);
+	zassert_equal(log_rate_limit_set(-1, 1, 1), -EINVAL);
+
+	zassert_equal(log_rate_limit_set(id, 1, 2), 0);
+	zassert_equal(log_rate_limit_get(id, &rate, &burst), 0);
+	zassert_equal(rate, 1);
+	zassert_equal(burst, 2);
+
+	/* Burst of messages passes, following messages are dropped. */
+	for (int i = 0; i < 5; i++) {
+		LOG_INF("rate %d", i);
+	}
+
+	zassert_equal(log_rate_limit_set(id, 0, 0), 0);
+	zassert_equal(log_rate_limit_get(id, &rate, &burst), 0);
+	zassert_equal(rate, 0);
+
+	LOG_INF("rate %d", 5);
+
+	flush_log();
+
+	zassert_equal(record_cnt, 3);
+	record_check(0, LOG_LEVEL_INF, "rate 0");
+	record_check(1, LOG_LEVEL_INF, "rate 1");
+	record_check(2, LOG_LEVEL_INF, "rate 5");
+}
+
+ZTEST(log_limit, test_rate_limit_report)
+{
+	int16_t id = LOG_CURRENT_MODULE_ID();
+
+	/* Tokens for the messages only, the report is not rate limited. */
+	zassert_equal(log_rate_limit_set(id, 1, 4), 0);
+
+	for (int i = 0; i < 3; i++) {
+		LOG_INF("report %d", 1);
+	}
+
+	LOG_INF("report %d", 2);
+
+	zassert_equal(log_rate_limit_set(id, 0, 0), 0);
+
+	flush_log();
+
+	zassert_equal(record_cnt, 3);
+	record_check(0, LOG_LEVEL_INF, "report 1");
+	record_check(1, LOG_LEVEL_INF, "report 2");
+	record_check(2, LOG_LEVEL_INF, "2 repeated messages suppressed");
+}
+
+static void *log_limit_setup(void)
+{
+	log_init();
+	log_backend_enable(&test_backend, NULL, LOG_LEVEL_DBG);
+
+	return NULL;
+}
+
+static void log_limit_before(void *data)
+{
+	ARG_UNUSED(data);
+
+	/* Start each test with a message which evicts the previous one. */
+	LOG_DBG("start");
+	flush_log();
+
+	record_cnt = 0;
+}
+
+ZTEST_SUITE(log_limit, NULL, log_limit_setup, log_limit_before, NULL, NULL);
@@ -0,0 +1,74 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <tracing_buffer.h>
+
+#define PACKET_SIZE  10
+#define PACKET_COUNT 100
+
+/* Length of a packet in the buffer, including its 16-bit length */
+#define RECORD_SIZE (PACKET_SIZE + 2)
+
+static uint8_t ids[PACKET_COUNT];
+static uint32_t ids_count;
+static uint32_t put_fail_count;
+static uint32_t bad_length_count;
+
+static void record_and_read_back(void)
+{
+	uint8_t packet[PACKET_SIZE];
+	uint32_t length;
+
+	tracing_buffer_init();
+	put_fail_count = 0;
+	ids_count = 0;
+	bad_length_count = 0;
+
+	for (int i = 0; i < PACKET_COUNT; i++) {
+		memset(packet, i, sizeof(packet));
+		if (tracing_buffer_put(packet, sizeof(packet)) != sizeof(packet)) {
+			put_fail_count++;
+		}
+	}
+
+	while ((length = tracing_buffer_record_get(0, packet, sizeof(packet))) > 0) {
+		if (length != sizeof(packet)) {
+			bad_length_count++;
+			continue;
+		}
+
+		ids[ids_count++] = packet[0];
+	}
+}
+
+ZTEST(tracing_flight_recorder, test_wrap_keeps_newest)
+{
+	uint32_t capacity = tracing_buffer_capacity_get();
+	unsigned int key;
+
+	zassert_true(capacity < PACKET_COUNT * RECORD_SIZE, "Buffer does not wrap");
+
+	/* Kernel events are traced in the same buffer, keep them out */
+	key = irq_lock();
+	record_and_read_back();
+	irq_unlock(key);
+
+	zassert_equal(put_fail_count, 0, "Packet not recorded");
+	zassert_equal(bad_length_count, 0, "Truncated packet read back");
+	zassert_true(ids_count >= capacity / RECORD_SIZE - 1, "Only %u packets kept", ids_count);
+	zassert_true(ids_count <= capacity / RECORD_SIZE, "%u packets kept", ids_count);
+	zassert_equal(ids[ids_count - 1], PACKET_COUNT - 1, "Newest packet discarded");
+
+	for (int i = 1; i < ids_count; i++) {
+		zassert_equal(ids[i], ids[i - 1] + 1, "Packet %u missing", ids[i - 1] + 1);
+	}
+
+	zassert_true(tracing_buffer_is_empty());
+}
+
+ZTEST_SUITE(tracing_flight_recorder, NULL, NULL, NULL, NULL, NULL);
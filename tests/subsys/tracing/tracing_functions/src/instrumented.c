@@ -0,0 +1,23 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+static uint32_t square(uint32_t value)
+{
+	return value * value;
+}
+
+uint32_t sum_of_squares(uint32_t count)
+{
+	uint32_t sum = 0;
+
+	for (uint32_t i = 1; i <= count; i++) {
+		sum += square(i);
+	}
+
+	return sum;
+}
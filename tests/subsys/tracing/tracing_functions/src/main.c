@@ -0,0 +1,138 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <tracing_buffer.h>
+#include <ctf_top.h>
+
+/* Timestamp, event id and function address */
+#define FUNC_EVENT_SIZE 9
+#define MAX_EVENTS      32
+
+struct func_event {
+	uint32_t timestamp;
+	uint32_t func;
+	uint8_t id;
+};
+
+static struct func_event events[MAX_EVENTS];
+static uint32_t event_count;
+static uint32_t result;
+
+uint32_t sum_of_squares(uint32_t count);
+
+/* Run the function with interrupts locked, so that the buffer only holds the
+ * events it emits, then read back the function events. Reads are bounded as
+ * reading an instrumented tracing buffer would emit more events.
+ */
+static void record(void (*fn)(void))
+{
+	uint8_t packet[CONFIG_TRACING_PACKET_MAX_SIZE];
+	uint32_t length;
+	unsigned int key;
+
+	event_count = 0;
+
+	key = irq_lock();
+	tracing_buffer_init();
+
+	fn();
+
+	for (int i = 0; i < 2 * MAX_EVENTS; i++) {
+		length = tracing_buffer_record_get(0, packet, sizeof(packet));
+		if (length == 0) {
+			break;
+		}
+
+		if ((length != FUNC_EVENT_SIZE) || (event_count == MAX_EVENTS) ||
+		    ((packet[4] != CTF_EVENT_FUNC_ENTER) && (packet[4] != CTF_EVENT_FUNC_EXIT))) {
+			continue;
+		}
+
+		memcpy(&events[event_count].timestamp, &packet[0], sizeof(uint32_t));
+		events[event_count].id = packet[4];
+		memcpy(&events[event_count].func, &packet[5], sizeof(uint32_t));
+		event_count++;
+	}
+
+	irq_unlock(key);
+}
+
+static int find_event(uint8_t id, void *func)
+{
+	for (int i = 0; i < event_count; i++) {
+		if ((events[i].id == id) && (events[i].func == (uint32_t)(uintptr_t)func)) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static void call_sum_of_squares(void)
+{
+	result = sum_of_squares(3);
+}
+
+static void call_snprintk(void)
+{
+	char buf[8];
+
+	result = snprintk(buf, sizeof(buf), "%u", 42U);
+}
+
+static void call_tracing_buffer(void)
+{
+	result = tracing_buffer_space_get();
+}
+
+ZTEST(tracing_functions, test_app_source)
+{
+	int enter;
+	int exit;
+
+	record(call_sum_of_squares);
+
+	zassert_equal(result, 14);
+
+	enter = find_event(CTF_EVENT_FUNC_ENTER, sum_of_squares);
+	exit = find_event(CTF_EVENT_FUNC_EXIT, sum_of_squares);
+
+	zassert_true(enter >= 0, "No func_enter event for sum_of_squares");
+	zassert_true(exit > enter, "No func_exit event for sum_of_squares");
+	zassert_true((int32_t)(events[exit].timestamp - events[enter].timestamp) >= 0,
+		     "func_exit timestamp before func_enter");
+}
+
+ZTEST(tracing_functions, test_zephyr_source)
+{
+	int enter;
+	int exit;
+
+	record(call_snprintk);
+
+	zassert_equal(result, 2);
+
+	enter = find_event(CTF_EVENT_FUNC_ENTER, snprintk);
+	exit = find_event(CTF_EVENT_FUNC_EXIT, snprintk);
+
+	zassert_true(enter >= 0, "No func_enter event for snprintk");
+	zassert_true(exit > enter, "No func_exit event for snprintk");
+}
+
+ZTEST(tracing_functions, test_tracing_excluded)
+{
+	/* The tracing subsystem is part of the instrumented paths but its
+	 * sources must not be instrumented.
+	 */
+	record(call_tracing_buffer);
+
+	zassert_equal(event_count, 0, "Tracing sources are instrumented");
+}
+
+ZTEST_SUITE(tracing_functions, NULL, NULL, NULL, NULL, NULL);